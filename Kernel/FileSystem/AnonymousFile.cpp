@@ -30,4 +30,12 @@ ErrorOr<NonnullOwnPtr<KString>> AnonymousFile::pseudo_path(OpenFileDescription c
     return KString::try_create(":anonymous-file:"sv);
 }
 
+ErrorOr<struct stat> AnonymousFile::stat() const
+{
+    struct stat st = {};
+    st.st_mode = S_IFREG;
+    st.st_size = m_vmobject->size();
+    return st;
+}
+
 }
@@ -25,6 +25,7 @@ public:
 private:
     virtual StringView class_name() const override { return "AnonymousFile"sv; }
     virtual ErrorOr<NonnullOwnPtr<KString>> pseudo_path(OpenFileDescription const&) const override;
+    virtual ErrorOr<struct stat> stat() const override;
     virtual bool can_read(OpenFileDescription const&, u64) const override { return false; }
     virtual bool can_write(OpenFileDescription const&, u64) const override { return false; }
     virtual ErrorOr<size_t> read(OpenFileDescription&, u64, UserOrKernelBuffer&, size_t) override { return ENOTSUP; }
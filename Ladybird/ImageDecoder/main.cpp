@@ -9,8 +9,10 @@
 #include <ImageDecoder/ConnectionFromClient.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/EventLoop.h>
+#include <LibGfx/ImageFormats/JPEGLoader.h>
 #include <LibIPC/SingleServer.h>
 #include <LibMain/Main.h>
+#include <unistd.h>
 
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
@@ -26,6 +28,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     Core::EventLoop event_loop;
 
+    auto processor_count = sysconf(_SC_NPROCESSORS_ONLN);
+    Gfx::JPEGImageDecoderPlugin::set_default_thread_count(processor_count > 0 ? processor_count : 1);
+
     auto client = TRY(IPC::take_over_accepted_client_from_system_server<ImageDecoder::ConnectionFromClient>());
     client->set_fd_passing_socket(TRY(Core::LocalSocket::adopt_fd(fd_passing_socket)));
 
@@ -59,6 +59,8 @@ struct Endpoint {
     Vector<ByteString> includes;
     ByteString name;
     u32 magic;
+    bool uses_shared_memory_ring { false };
+    bool passes_large_payloads_in_shared_memory { false };
     Vector<Message> messages;
 };
 
@@ -236,6 +238,26 @@ Vector<Endpoint> parse(ByteBuffer const& file_contents)
         endpoints.last().name = lexer.consume_while([](char ch) { return !isspace(ch); });
         endpoints.last().magic = Traits<ByteString>::hash(endpoints.last().name);
         consume_whitespace();
+        if (lexer.consume_specific('[')) {
+            for (;;) {
+                consume_whitespace();
+                auto attribute = lexer.consume_until([](char ch) { return isspace(ch) || ch == ']' || ch == ','; });
+                if (attribute == "SharedMemoryRing") {
+                    endpoints.last().uses_shared_memory_ring = true;
+                } else if (attribute == "LargePayloadsInSharedMemory") {
+                    endpoints.last().passes_large_payloads_in_shared_memory = true;
+                } else {
+                    warnln("Unknown endpoint attribute '{}'", attribute);
+                    VERIFY_NOT_REACHED();
+                }
+                consume_whitespace();
+                if (lexer.consume_specific(','))
+                    continue;
+                assert_specific(']');
+                break;
+            }
+            consume_whitespace();
+        }
         assert_specific('{');
         parse_messages();
         assert_specific('}');
@@ -346,7 +368,7 @@ public:)~~~");
 
     static ErrorOr<NonnullOwnPtr<@message.pascal_name@>> decode(Stream& stream, Core::LocalSocket& socket)
     {
-        IPC::Decoder decoder { stream, socket };)~~~");
+        IPC::Decoder decoder { stream, socket, @endpoint.large_payloads@ };)~~~");
 
     for (auto const& parameter : parameters) {
         auto parameter_generator = message_generator.fork();
@@ -390,7 +412,7 @@ public:)~~~");
         VERIFY(valid());
 
         IPC::MessageBuffer buffer;
-        IPC::Encoder stream(buffer);
+        IPC::Encoder stream(buffer, @endpoint.large_payloads@);
         TRY(stream.encode(endpoint_magic()));
         TRY(stream.encode((int)MessageID::@message.pascal_name@));)~~~");
 
@@ -542,6 +564,8 @@ void build_endpoint(SourceGenerator generator, Endpoint const& endpoint)
 {
     generator.set("endpoint.name", endpoint.name);
     generator.set("endpoint.magic", ByteString::number(endpoint.magic));
+    generator.set("endpoint.uses_shared_memory_ring", endpoint.uses_shared_memory_ring ? "true"sv : "false"sv);
+    generator.set("endpoint.large_payloads", endpoint.passes_large_payloads_in_shared_memory ? "IPC::LargePayloads::InSharedMemory"sv : "IPC::LargePayloads::Inline"sv);
 
     generator.appendln("\nnamespace Messages::@endpoint.name@ {");
 
@@ -589,6 +613,7 @@ public:
     using Stub = @endpoint.name@Stub;
 
     static u32 static_magic() { return @endpoint.magic@; }
+    static bool uses_shared_memory_ring() { return @endpoint.uses_shared_memory_ring@; }
 
     static ErrorOr<NonnullOwnPtr<IPC::Message>> decode_message(ReadonlyBytes buffer, [[maybe_unused]] Core::LocalSocket& socket)
     {
@@ -819,7 +844,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     if constexpr (GENERATE_DEBUG) {
         for (auto& endpoint : endpoints) {
-            warnln("Endpoint '{}' (magic: {})", endpoint.name, endpoint.magic);
+            warnln("Endpoint '{}' (magic: {}, shared memory ring: {}, large payloads in shared memory: {})", endpoint.name, endpoint.magic, endpoint.uses_shared_memory_ring, endpoint.passes_large_payloads_in_shared_memory);
             for (auto& message : endpoint.messages) {
                 warnln("  Message: '{}'", message.name);
                 warnln("    Sync: {}", message.is_synchronous);
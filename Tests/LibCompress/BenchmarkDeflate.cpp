@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BitStream.h>
+#include <AK/MemoryStream.h>
+#include <LibCompress/Deflate.h>
+#include <LibCompress/Zlib.h>
+#include <LibTest/TestCase.h>
+
+static constexpr size_t uncompressed_size = 4 * MiB;
+
+// A fixed sequence keeps the compressed inputs, and thus the timings, identical between runs.
+static u32 next_pseudo_random()
+{
+    static u32 state = 1;
+    state = state * 1103515245 + 12345;
+    return state >> 16;
+}
+
+static ByteBuffer generate_text()
+{
+    static constexpr StringView words[] = { "the "sv, "quick "sv, "brown "sv, "fox "sv, "jumps "sv, "over "sv, "lazy "sv, "dog "sv, "<div class=\"content\">"sv, "</div>\n"sv, "    "sv };
+    ByteBuffer text;
+    while (text.size() < uncompressed_size)
+        text.append(words[next_pseudo_random() % array_size(words)].bytes());
+    text.resize(uncompressed_size);
+    return text;
+}
+
+static ByteBuffer generate_image_like()
+{
+    // Smooth gradients with a bit of noise, roughly what PNG filtering leaves behind.
+    auto data = MUST(ByteBuffer::create_uninitialized(uncompressed_size));
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<u8>((i % 4096) / 16 + (next_pseudo_random() & 3));
+    return data;
+}
+
+static ByteBuffer compress(ReadonlyBytes data)
+{
+    return MUST(Compress::DeflateCompressor::compress_all(data, Compress::DeflateCompressor::CompressionLevel::GOOD));
+}
+
+static auto text_data = generate_text();
+static auto compressed_text_data = compress(text_data);
+static auto image_data = generate_image_like();
+static auto compressed_image_data = compress(image_data);
+static auto compressed_zlib_data = Compress::ZlibCompressor::compress_all(image_data).release_value();
+
+static ByteBuffer inflate_with_stream(ReadonlyBytes compressed)
+{
+    FixedMemoryStream memory_stream { compressed };
+    LittleEndianInputBitStream bit_stream { MaybeOwned<Stream>(memory_stream) };
+    auto deflate_stream = MUST(Compress::DeflateDecompressor::construct(MaybeOwned<LittleEndianInputBitStream>(bit_stream)));
+    return MUST(deflate_stream->read_until_eof());
+}
+
+BENCHMARK_CASE(inflate_text_stream)
+{
+    auto output = inflate_with_stream(compressed_text_data);
+    EXPECT_EQ(output.size(), uncompressed_size);
+}
+
+BENCHMARK_CASE(inflate_text_all)
+{
+    auto output = MUST(Compress::DeflateDecompressor::decompress_all(compressed_text_data));
+    EXPECT_EQ(output.size(), uncompressed_size);
+}
+
+BENCHMARK_CASE(inflate_text_into)
+{
+    auto output = MUST(ByteBuffer::create_uninitialized(uncompressed_size));
+    EXPECT_EQ(MUST(Compress::DeflateDecompressor::decompress_into(compressed_text_data, output)), uncompressed_size);
+}
+
+BENCHMARK_CASE(inflate_image_stream)
+{
+    auto output = inflate_with_stream(compressed_image_data);
+    EXPECT_EQ(output.size(), uncompressed_size);
+}
+
+BENCHMARK_CASE(inflate_image_all)
+{
+    auto output = MUST(Compress::DeflateDecompressor::decompress_all(compressed_image_data));
+    EXPECT_EQ(output.size(), uncompressed_size);
+}
+
+BENCHMARK_CASE(inflate_image_into)
+{
+    auto output = MUST(ByteBuffer::create_uninitialized(uncompressed_size));
+    EXPECT_EQ(MUST(Compress::DeflateDecompressor::decompress_into(compressed_image_data, output)), uncompressed_size);
+}
+
+BENCHMARK_CASE(inflate_zlib_all)
+{
+    auto output = MUST(Compress::ZlibDecompressor::decompress_all(compressed_zlib_data));
+    EXPECT_EQ(output.size(), uncompressed_size);
+}
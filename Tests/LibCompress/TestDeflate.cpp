@@ -11,6 +11,7 @@
 #include <AK/MemoryStream.h>
 #include <AK/Random.h>
 #include <LibCompress/Deflate.h>
+#include <LibCompress/ParallelDeflate.h>
 #include <LibCore/File.h>
 #include <cstring>
 
@@ -156,6 +157,70 @@ TEST_CASE(deflate_round_trip_compress_large)
     EXPECT(uncompressed == original);
 }
 
+TEST_CASE(deflate_round_trip_sync_flush)
+{
+    auto original = ByteBuffer::create_uninitialized(100 * KiB).release_value();
+    fill_with_random(original.bytes().trim(1000));
+    for (size_t i = 1000; i < original.size(); ++i)
+        original[i] = original[i - 1000];
+
+    AllocatingMemoryStream output_stream;
+    auto compressor = TRY_OR_FAIL(Compress::DeflateCompressor::construct(MaybeOwned<Stream>(output_stream)));
+    TRY_OR_FAIL(compressor->write_until_depleted(original.bytes().trim(12345)));
+    TRY_OR_FAIL(compressor->sync_flush());
+    TRY_OR_FAIL(compressor->write_until_depleted(original.bytes().slice(12345)));
+    TRY_OR_FAIL(compressor->final_flush());
+
+    auto compressed = TRY_OR_FAIL(output_stream.read_until_eof());
+    auto uncompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+    EXPECT(uncompressed == original);
+}
+
+TEST_CASE(deflate_round_trip_parallel)
+{
+    // Without priming every chunk with the one before it, each of them would contain the 16 KiB of noise again.
+    auto original = ByteBuffer::create_uninitialized(8 * Compress::ParallelDeflateCompressor::chunk_size + 1234).release_value();
+    fill_with_random(original.bytes().trim(16 * KiB));
+    for (size_t i = 16 * KiB; i < original.size(); ++i)
+        original[i] = original[i - 16 * KiB];
+
+    for (size_t thread_count : { 1, 2, 3, 8 }) {
+        auto compressed = TRY_OR_FAIL(Compress::ParallelDeflateCompressor::compress_all(original, thread_count));
+        EXPECT(compressed.size() < 64 * KiB);
+        auto uncompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+        EXPECT(uncompressed == original);
+    }
+}
+
+TEST_CASE(deflate_parallel_with_failing_output_stream)
+{
+    class FailingStream final : public Stream {
+    public:
+        virtual ErrorOr<Bytes> read_some(Bytes) override { return Error::from_errno(EBADF); }
+        virtual ErrorOr<size_t> write_some(ReadonlyBytes) override { return Error::from_errno(ENOSPC); }
+        virtual bool is_eof() const override { return true; }
+        virtual bool is_open() const override { return true; }
+        virtual void close() override { }
+    };
+
+    auto original = ByteBuffer::create_zeroed(8 * Compress::ParallelDeflateCompressor::chunk_size).release_value();
+
+    // The first chunk fails to be written once its worker is needed again, while other chunks are still in progress.
+    // Destroying the compressor then has to let go of those without their output ever being written.
+    {
+        FailingStream output_stream;
+        auto deflate_stream = TRY_OR_FAIL(Compress::ParallelDeflateCompressor::construct(MaybeOwned<Stream>(output_stream), 3));
+        EXPECT(deflate_stream->write_until_depleted(original).is_error());
+    }
+
+    {
+        FailingStream output_stream;
+        auto deflate_stream = TRY_OR_FAIL(Compress::ParallelDeflateCompressor::construct(MaybeOwned<Stream>(output_stream), 3));
+        TRY_OR_FAIL(deflate_stream->write_until_depleted(original.bytes().trim(2 * Compress::ParallelDeflateCompressor::chunk_size)));
+        EXPECT(deflate_stream->final_flush().is_error());
+    }
+}
+
 TEST_CASE(deflate_compress_literals)
 {
     // This byte array is known to not produce any back references with our lz77 implementation even at the highest compression settings
@@ -172,3 +237,49 @@ TEST_CASE(ossfuzz_63183)
     auto decompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
     EXPECT(test_data == decompressed);
 }
+
+TEST_CASE(deflate_decompress_into)
+{
+    auto original = ByteBuffer::create_uninitialized(64 * KiB).release_value();
+    for (size_t i = 0; i < original.size(); ++i)
+        original[i] = "the quick brown fox jumps over the lazy dog "[(i * 7 + i / 100) % 44];
+    auto compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all(original, Compress::DeflateCompressor::CompressionLevel::GOOD));
+
+    auto exact = ByteBuffer::create_zeroed(original.size()).release_value();
+    EXPECT_EQ(TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_into(compressed, exact)), original.size());
+    EXPECT(exact == original);
+
+    auto too_small = ByteBuffer::create_zeroed(original.size() - 1).release_value();
+    EXPECT(Compress::DeflateDecompressor::decompress_into(compressed, too_small).is_error());
+
+    auto truncated = compressed.bytes().trim(compressed.size() / 2);
+    EXPECT(Compress::DeflateDecompressor::decompress_into(truncated, exact).is_error());
+}
+
+TEST_CASE(deflate_decompress_all_into_reports_consumed_input)
+{
+    auto original = ByteBuffer::create_uninitialized(4096).release_value();
+    fill_with_random(original);
+    auto compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all(original, Compress::DeflateCompressor::CompressionLevel::FAST));
+    auto compressed_size = compressed.size();
+    compressed.append("trailing data"sv.bytes());
+
+    auto output = TRY_OR_FAIL(ByteBuffer::copy("prefix"sv.bytes()));
+    EXPECT_EQ(TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all_into(compressed, output)), compressed_size);
+    EXPECT(output.bytes().slice(0, 6) == "prefix"sv.bytes());
+    EXPECT(output.bytes().slice(6) == original.bytes());
+}
+
+TEST_CASE(deflate_decompress_all_compression_levels)
+{
+    auto original = ByteBuffer::create_uninitialized(256 * KiB).release_value();
+    fill_with_random(original.bytes().trim(original.size() / 2));
+    for (size_t i = original.size() / 2; i < original.size(); ++i)
+        original[i] = original[i - 1 - (i % 300)];
+
+    for (auto level : { Compress::DeflateCompressor::CompressionLevel::STORE, Compress::DeflateCompressor::CompressionLevel::FAST, Compress::DeflateCompressor::CompressionLevel::GOOD }) {
+        auto compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all(original, level));
+        auto decompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+        EXPECT(decompressed == original);
+    }
+}
@@ -94,6 +94,17 @@ TEST_CASE(gzip_round_trip)
     EXPECT(uncompressed == original);
 }
 
+TEST_CASE(gzip_round_trip_parallel)
+{
+    auto original = ByteBuffer::create_uninitialized(1 * MiB).release_value();
+    fill_with_random(original.bytes().trim(64 * KiB));
+    for (size_t i = 64 * KiB; i < original.size(); ++i)
+        original[i] = original[i - 1 - (i % 1000)];
+    auto compressed = TRY_OR_FAIL(Compress::GzipCompressor::compress_all(original, 3));
+    auto uncompressed = TRY_OR_FAIL(Compress::GzipDecompressor::decompress_all(compressed));
+    EXPECT(uncompressed == original);
+}
+
 TEST_CASE(gzip_truncated_uncompressed_block)
 {
     Array<u8, 38> const compressed {
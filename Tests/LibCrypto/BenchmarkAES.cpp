@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <LibCrypto/Authentication/GHash.h>
+#include <LibCrypto/Cipher/AES.h>
+#include <LibTest/TestCase.h>
+
+static ByteBuffer generate_data(size_t size)
+{
+    auto data = ByteBuffer::create_uninitialized(size).release_value();
+    for (size_t i = 0; i < size; ++i)
+        data[i] = (i * i + 7 * i) % 251;
+    return data;
+}
+
+static auto large_data = generate_data(4 * MiB);
+
+// The largest amount of data a TLS record can hold.
+static auto record_data = generate_data(16 * KiB);
+
+static auto key = generate_data(32);
+static auto iv = generate_data(16);
+static auto aad = generate_data(13);
+
+BENCHMARK_CASE(aes_128_gcm_encrypt_large)
+{
+    Crypto::Cipher::AESCipher::GCMMode cipher(key.bytes().trim(16), 128, Crypto::Cipher::Intent::Encryption);
+    auto out = ByteBuffer::create_uninitialized(large_data.size()).release_value();
+    auto tag = ByteBuffer::create_uninitialized(16).release_value();
+    for (size_t i = 0; i < 4; ++i)
+        cipher.encrypt(large_data, out.bytes(), iv, aad, tag);
+    EXPECT_NE(out, large_data);
+}
+
+BENCHMARK_CASE(aes_256_gcm_encrypt_large)
+{
+    Crypto::Cipher::AESCipher::GCMMode cipher(key, 256, Crypto::Cipher::Intent::Encryption);
+    auto out = ByteBuffer::create_uninitialized(large_data.size()).release_value();
+    auto tag = ByteBuffer::create_uninitialized(16).release_value();
+    for (size_t i = 0; i < 4; ++i)
+        cipher.encrypt(large_data, out.bytes(), iv, aad, tag);
+    EXPECT_NE(out, large_data);
+}
+
+BENCHMARK_CASE(aes_128_gcm_decrypt_records)
+{
+    Crypto::Cipher::AESCipher::GCMMode cipher(key.bytes().trim(16), 128, Crypto::Cipher::Intent::Encryption);
+    auto ciphertext = ByteBuffer::create_uninitialized(record_data.size()).release_value();
+    auto tag = ByteBuffer::create_uninitialized(16).release_value();
+    cipher.encrypt(record_data, ciphertext.bytes(), iv, aad, tag);
+
+    auto out = ByteBuffer::create_uninitialized(record_data.size()).release_value();
+    size_t consistent_records = 0;
+    for (size_t i = 0; i < 1024; ++i) {
+        if (cipher.decrypt(ciphertext, out.bytes(), iv, aad, tag) == Crypto::VerificationConsistency::Consistent)
+            ++consistent_records;
+    }
+    EXPECT_EQ(consistent_records, 1024u);
+}
+
+BENCHMARK_CASE(aes_128_cbc_encrypt_large)
+{
+    Crypto::Cipher::AESCipher::CBCMode cipher(key.bytes().trim(16), 128, Crypto::Cipher::Intent::Encryption, Crypto::Cipher::PaddingMode::Null);
+    auto out = ByteBuffer::create_uninitialized(large_data.size()).release_value();
+    for (size_t i = 0; i < 4; ++i) {
+        auto out_bytes = out.bytes();
+        cipher.encrypt(large_data, out_bytes, iv);
+    }
+    EXPECT_NE(out, large_data);
+}
+
+BENCHMARK_CASE(aes_128_cbc_decrypt_large)
+{
+    Crypto::Cipher::AESCipher::CBCMode cipher(key.bytes().trim(16), 128, Crypto::Cipher::Intent::Decryption, Crypto::Cipher::PaddingMode::Null);
+    auto out = ByteBuffer::create_uninitialized(large_data.size()).release_value();
+    for (size_t i = 0; i < 4; ++i) {
+        auto out_bytes = out.bytes();
+        cipher.decrypt(large_data, out_bytes, iv);
+    }
+    EXPECT_NE(out, large_data);
+}
+
+BENCHMARK_CASE(ghash_large)
+{
+    Crypto::Authentication::GHash ghash(key);
+    auto first_tag = ghash.process(aad, large_data);
+    for (size_t i = 0; i < 3; ++i) {
+        auto tag = ghash.process(aad, large_data);
+        EXPECT_EQ(memcmp(tag.data, first_tag.data, sizeof(tag.data)), 0);
+    }
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <LibCrypto/Checksum/Adler32.h>
+#include <LibCrypto/Checksum/CRC32.h>
+#include <LibTest/TestCase.h>
+
+static ByteBuffer generate_data(size_t size)
+{
+    auto data = ByteBuffer::create_uninitialized(size).release_value();
+    for (size_t i = 0; i < size; ++i)
+        data[i] = (i * i + 7 * i) % 251;
+    return data;
+}
+
+static auto large_data = generate_data(16 * MiB);
+
+// Roughly the size of a PNG chunk or a network packet.
+static auto small_data = generate_data(1500);
+
+BENCHMARK_CASE(crc32_large)
+{
+    u32 result = 0;
+    for (size_t i = 0; i < 10; ++i)
+        result += Crypto::Checksum::CRC32(large_data).digest();
+    EXPECT_NE(result, 0u);
+}
+
+BENCHMARK_CASE(crc32_small)
+{
+    u32 result = 0;
+    for (size_t i = 0; i < 10000; ++i)
+        result += Crypto::Checksum::CRC32(small_data).digest();
+    EXPECT_NE(result, 0u);
+}
+
+BENCHMARK_CASE(adler32_large)
+{
+    u32 result = 0;
+    for (size_t i = 0; i < 10; ++i)
+        result += Crypto::Checksum::Adler32(large_data).digest();
+    EXPECT_NE(result, 0u);
+}
+
+BENCHMARK_CASE(adler32_small)
+{
+    u32 result = 0;
+    for (size_t i = 0; i < 10000; ++i)
+        result += Crypto::Checksum::Adler32(small_data).digest();
+    EXPECT_NE(result, 0u);
+}
@@ -454,3 +454,39 @@ TEST_CASE(test_AES_GCM_128bit_decrypt_multiple_blocks_with_aad)
     EXPECT(memcmp(result_pt, out.data(), out.size()) == 0);
     EXPECT_EQ(consistency, Crypto::VerificationConsistency::Consistent);
 }
+
+TEST_CASE(test_AES_GCM_256bit_long_with_aad)
+{
+    // Long enough to go through the paths that handle many blocks at once, and not a multiple of the block size.
+    u8 key[32];
+    for (size_t i = 0; i < sizeof(key); ++i)
+        key[i] = i;
+    u8 aad[20];
+    for (size_t i = 0; i < sizeof(aad); ++i)
+        aad[i] = 0x40 + i;
+    auto plaintext = ByteBuffer::create_uninitialized(1000).release_value();
+    for (size_t i = 0; i < plaintext.size(); ++i)
+        plaintext[i] = (i * 7) % 251;
+
+    Crypto::Cipher::AESCipher::GCMMode cipher(ReadonlyBytes { key, sizeof(key) }, 256, Crypto::Cipher::Intent::Encryption);
+    u8 result_tag[] { 0x37, 0x1b, 0xfe, 0x97, 0x13, 0x65, 0x91, 0xfa, 0xd7, 0xe4, 0x62, 0xc7, 0x91, 0x77, 0xf7, 0x73 };
+    u8 result_ct_end[] { 0xe1, 0xab, 0x8c, 0xaa, 0x28, 0x0d, 0x5b, 0xa7, 0xc6, 0x99, 0x13, 0xd7, 0xb2, 0xe4, 0x8f, 0xc7 };
+    auto iv = "\xa0\xa1\xa2\xa3\xa4\xa5\xa6\xa7\xa8\xa9\xaa\xab\x00\x00\x00\x00"_b;
+
+    auto tag = ByteBuffer::create_uninitialized(16).release_value();
+    auto out = ByteBuffer::create_uninitialized(plaintext.size()).release_value();
+    auto out_bytes = out.bytes();
+    cipher.encrypt(plaintext, out_bytes, iv, AS_BB(aad), tag);
+    EXPECT(memcmp(result_tag, tag.data(), tag.size()) == 0);
+    EXPECT(memcmp(result_ct_end, out.data() + out.size() - 16, 16) == 0);
+
+    auto decrypted = ByteBuffer::create_uninitialized(out.size()).release_value();
+    auto decrypted_bytes = decrypted.bytes();
+    auto consistency = cipher.decrypt(out, decrypted_bytes, iv, AS_BB(aad), tag);
+    EXPECT_EQ(consistency, Crypto::VerificationConsistency::Consistent);
+    EXPECT_EQ(decrypted, plaintext);
+
+    out[500] ^= 1;
+    consistency = cipher.decrypt(out, decrypted_bytes, iv, AS_BB(aad), tag);
+    EXPECT_EQ(consistency, Crypto::VerificationConsistency::Inconsistent);
+}
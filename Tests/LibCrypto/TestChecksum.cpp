@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ByteBuffer.h>
 #include <LibCrypto/Checksum/Adler32.h>
 #include <LibCrypto/Checksum/CRC32.h>
 #include <LibTest/TestCase.h>
@@ -33,3 +34,80 @@ TEST_CASE(test_crc32)
     do_test(ByteString("The quick brown fox jumps over the lazy dog").bytes(), 0x414FA339);
     do_test(ByteString("various CRC algorithms input data").bytes(), 0x9BD366AE);
 }
+
+// Long enough inputs take the vectorized paths where they are available.
+static ByteBuffer long_checksum_input(size_t size)
+{
+    auto data = MUST(ByteBuffer::create_uninitialized(size));
+    for (size_t i = 0; i < size; ++i)
+        data[i] = (i * i + 7 * i) % 251;
+    return data;
+}
+
+TEST_CASE(test_adler32_long)
+{
+    auto do_test = [](size_t size, u32 expected_result) {
+        auto data = long_checksum_input(size);
+        EXPECT_EQ(Crypto::Checksum::Adler32(data).digest(), expected_result);
+
+        // The result must not depend on how the data is split up.
+        Crypto::Checksum::Adler32 checksum;
+        checksum.update(data.bytes().trim(size / 3));
+        checksum.update(data.bytes().slice(size / 3));
+        EXPECT_EQ(checksum.digest(), expected_result);
+    };
+
+    do_test(63, 0x73861c1d);
+    do_test(64, 0x90321cac);
+    do_test(65, 0xacf81cc6);
+    do_test(100, 0xc10e2d51);
+    do_test(1000, 0xd317e29c);
+    do_test(4096, 0x64d0bd55);
+    do_test(100003, 0xe2633ef3);
+
+    auto all_ones = MUST(ByteBuffer::create_uninitialized(100000));
+    all_ones.bytes().fill(0xff);
+    EXPECT_EQ(Crypto::Checksum::Adler32(all_ones).digest(), 0x149a302cu);
+}
+
+TEST_CASE(test_crc32_long)
+{
+    auto do_test = [](size_t size, u32 expected_result) {
+        auto data = long_checksum_input(size);
+        EXPECT_EQ(Crypto::Checksum::CRC32(data).digest(), expected_result);
+
+        // Misaligned data, and data split into parts that are not a multiple of 16 bytes long.
+        auto misaligned = MUST(ByteBuffer::create_uninitialized(size + 1));
+        misaligned.overwrite(1, data.data(), size);
+        EXPECT_EQ(Crypto::Checksum::CRC32(misaligned.bytes().slice(1)).digest(), expected_result);
+
+        Crypto::Checksum::CRC32 checksum;
+        checksum.update(data.bytes().trim(size / 3));
+        checksum.update(data.bytes().slice(size / 3));
+        EXPECT_EQ(checksum.digest(), expected_result);
+    };
+
+    do_test(63, 0x1e343936);
+    do_test(64, 0x60a1d09c);
+    do_test(65, 0xd6b96848);
+    do_test(100, 0xfd16f4b2);
+    do_test(1000, 0x5c0381a1);
+    do_test(4096, 0x633056ae);
+    do_test(100003, 0xf6e29940);
+
+    auto all_ones = MUST(ByteBuffer::create_uninitialized(100000));
+    all_ones.bytes().fill(0xff);
+    EXPECT_EQ(Crypto::Checksum::CRC32(all_ones).digest(), 0x68c6cec4u);
+}
+
+TEST_CASE(test_crc32_combine)
+{
+    auto data = "The quick brown fox jumps over the lazy dog"sv.bytes();
+    auto expected = Crypto::Checksum::CRC32(data).digest();
+
+    for (size_t split = 0; split <= data.size(); ++split) {
+        auto first = Crypto::Checksum::CRC32(data.trim(split)).digest();
+        auto second = Crypto::Checksum::CRC32(data.slice(split)).digest();
+        EXPECT_EQ(Crypto::Checksum::CRC32::combine(first, second, data.size() - split), expected);
+    }
+}
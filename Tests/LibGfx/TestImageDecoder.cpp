@@ -52,6 +52,36 @@ static ErrorOr<Gfx::ImageFrameDescriptor> expect_single_frame_of_size(Gfx::Image
     return frame;
 }
 
+// The mean difference between the channels of a reduced-size image and the averages of the pixels they cover in the
+// full-size one.
+static float mean_difference_from_downscaled(Gfx::Bitmap const& full_size, Gfx::Bitmap const& reduced_size, int factor)
+{
+    u64 total_difference = 0;
+    for (int y = 0; y < reduced_size.height(); ++y) {
+        for (int x = 0; x < reduced_size.width(); ++x) {
+            u64 red = 0, green = 0, blue = 0, alpha = 0, count = 0;
+            for (int full_y = y * factor; full_y < min((y + 1) * factor, full_size.height()); ++full_y) {
+                for (int full_x = x * factor; full_x < min((x + 1) * factor, full_size.width()); ++full_x) {
+                    auto color = full_size.get_pixel(full_x, full_y);
+                    red += color.red() * color.alpha();
+                    green += color.green() * color.alpha();
+                    blue += color.blue() * color.alpha();
+                    alpha += color.alpha();
+                    ++count;
+                }
+            }
+            auto color = reduced_size.get_pixel(x, y);
+            total_difference += abs(static_cast<int>(color.alpha()) - static_cast<int>(alpha / count));
+            if (alpha == 0)
+                continue;
+            total_difference += abs(static_cast<int>(color.red()) - static_cast<int>(red / alpha));
+            total_difference += abs(static_cast<int>(color.green()) - static_cast<int>(green / alpha));
+            total_difference += abs(static_cast<int>(color.blue()) - static_cast<int>(blue / alpha));
+        }
+    }
+    return total_difference / (4.0f * reduced_size.width() * reduced_size.height());
+}
+
 TEST_CASE(test_bmp)
 {
     auto file = MUST(Core::MappedFile::map(TEST_INPUT("bmp/rgba32-1.bmp"sv)));
@@ -311,6 +341,90 @@ TEST_CASE(test_jpeg_grayscale_with_app14)
     TRY_OR_FAIL(expect_single_frame_of_size(*plugin_decoder, { 80, 80 }));
 }
 
+TEST_CASE(test_jpeg_reduced_size)
+{
+    auto file = MUST(Core::MappedFile::map(TEST_INPUT("jpg/successive_approximation.jpg"sv)));
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes()));
+
+    // 600x800 can be shrunk by 5 while staying at least as large as 100x150, so the inverse DCT is scaled by 1/4.
+    auto frame = TRY_OR_FAIL(plugin_decoder->frame(0, Gfx::IntSize { 100, 150 }));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(150, 200));
+
+    // The full-size image can still be decoded afterwards.
+    auto full_size_frame = TRY_OR_FAIL(expect_single_frame_of_size(*plugin_decoder, { 600, 800 }));
+    EXPECT(mean_difference_from_downscaled(*full_size_frame.image, *frame.image, 4) < 2.0f);
+
+    // Once it has been decoded, it's returned regardless of the ideal size.
+    auto cached_frame = TRY_OR_FAIL(plugin_decoder->frame(0, Gfx::IntSize { 100, 150 }));
+    EXPECT_EQ(cached_frame.image->size(), Gfx::IntSize(600, 800));
+
+    // The inverse DCT can't be scaled further than 1/8, which only keeps the DC coefficients.
+    plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes()));
+    auto one_eighth_size_frame = TRY_OR_FAIL(plugin_decoder->frame(0, Gfx::IntSize { 10, 10 }));
+    EXPECT_EQ(one_eighth_size_frame.image->size(), Gfx::IntSize(75, 100));
+    EXPECT(mean_difference_from_downscaled(*full_size_frame.image, *one_eighth_size_frame.image, 8) < 2.0f);
+}
+
+static void expect_same_pixels(Gfx::Bitmap const& bitmap, Gfx::Bitmap const& expected_bitmap)
+{
+    EXPECT_EQ(bitmap.size(), expected_bitmap.size());
+    if (bitmap.size() != expected_bitmap.size())
+        return;
+    for (int y = 0; y < bitmap.height(); ++y) {
+        for (int x = 0; x < bitmap.width(); ++x) {
+            if (bitmap.get_pixel(x, y) != expected_bitmap.get_pixel(x, y)) {
+                FAIL(ByteString::formatted("Pixel ({}, {}) differs", x, y));
+                return;
+            }
+        }
+    }
+}
+
+TEST_CASE(test_jpeg_restart_intervals)
+{
+    // Restart markers leave the coefficients alone, so these images decode to the same pixels as the same ones without
+    // restart markers, whether the restart intervals are decoded one after the other or on several threads.
+    struct TestInput {
+        StringView path;
+        StringView path_with_restart_intervals;
+    };
+    Array test_inputs = {
+        TestInput { TEST_INPUT("jpg/baseline_444.jpg"sv), TEST_INPUT("jpg/baseline_444_restart_intervals.jpg"sv) },
+        TestInput { TEST_INPUT("jpg/baseline_420.jpg"sv), TEST_INPUT("jpg/baseline_420_restart_intervals.jpg"sv) },
+        TestInput { TEST_INPUT("jpg/progressive_422.jpg"sv), TEST_INPUT("jpg/progressive_422_restart_intervals.jpg"sv) },
+    };
+
+    for (auto const& test_input : test_inputs) {
+        auto file = MUST(Core::MappedFile::map(test_input.path));
+        auto plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes()));
+        auto expected_frame = TRY_OR_FAIL(expect_single_frame_of_size(*plugin_decoder, { 296, 400 }));
+
+        auto file_with_restart_intervals = MUST(Core::MappedFile::map(test_input.path_with_restart_intervals));
+        for (size_t thread_count : { 1, 4 }) {
+            plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create_with_options(file_with_restart_intervals->bytes(), { .thread_count = thread_count }));
+            auto frame = TRY_OR_FAIL(expect_single_frame_of_size(*plugin_decoder, { 296, 400 }));
+            expect_same_pixels(*frame.image, *expected_frame.image);
+        }
+    }
+}
+
+TEST_CASE(test_jpeg_restart_intervals_partial_frame)
+{
+    // Restart intervals that weren't received completely are decoded as far as they go, with threads or without.
+    auto file = MUST(Core::MappedFile::map(TEST_INPUT("jpg/baseline_444_restart_intervals.jpg"sv)));
+    auto truncated_bytes = file->bytes().trim(file->bytes().size() / 2);
+
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create_with_options(truncated_bytes, { .thread_count = 1 }));
+    auto expected_frame = TRY_OR_FAIL(plugin_decoder->partial_frame(0));
+
+    plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create_with_options(truncated_bytes, { .thread_count = 4 }));
+    EXPECT(plugin_decoder->frame(0).is_error());
+
+    plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create_with_options(truncated_bytes, { .thread_count = 4 }));
+    auto frame = TRY_OR_FAIL(plugin_decoder->partial_frame(0));
+    expect_same_pixels(*frame.image, *expected_frame.image);
+}
+
 TEST_CASE(test_jpeg_malformed_header)
 {
     Array test_inputs = {
@@ -339,6 +453,19 @@ TEST_CASE(test_jpeg_malformed_frame)
     }
 }
 
+TEST_CASE(test_jpeg_sof2_partial_frame)
+{
+    auto file = MUST(Core::MappedFile::map(TEST_INPUT("jpg/successive_approximation.jpg"sv)));
+    auto truncated_bytes = file->bytes().trim(file->bytes().size() / 2);
+
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(truncated_bytes));
+    EXPECT(plugin_decoder->frame(0).is_error());
+
+    plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(truncated_bytes));
+    auto frame = TRY_OR_FAIL(plugin_decoder->partial_frame(0));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(600, 800));
+}
+
 TEST_CASE(test_pbm)
 {
     auto file = MUST(Core::MappedFile::map(TEST_INPUT("pnm/buggie-raw.pbm"sv)));
@@ -366,6 +493,20 @@ TEST_CASE(test_png)
     TRY_OR_FAIL(expect_single_frame(*plugin_decoder));
 }
 
+TEST_CASE(test_png_reduced_size)
+{
+    auto file = MUST(Core::MappedFile::map(TEST_INPUT("png/buggie.png"sv)));
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes()));
+    auto size = plugin_decoder->size();
+
+    auto frame = TRY_OR_FAIL(plugin_decoder->frame(0, Gfx::IntSize { size.width() / 3, size.height() / 3 }));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize((size.width() + 2) / 3, (size.height() + 2) / 3));
+
+    // The full-size image can still be decoded afterwards.
+    auto full_size_frame = TRY_OR_FAIL(expect_single_frame_of_size(*plugin_decoder, size));
+    EXPECT(mean_difference_from_downscaled(*full_size_frame.image, *frame.image, 3) < 1.0f);
+}
+
 TEST_CASE(test_png_malformed_frame)
 {
     Array test_inputs = {
@@ -381,6 +522,22 @@ TEST_CASE(test_png_malformed_frame)
     }
 }
 
+TEST_CASE(test_png_partial_frame)
+{
+    auto file = MUST(Core::MappedFile::map(TEST_INPUT("png/buggie.png"sv)));
+    auto complete_plugin_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes()));
+    auto complete_frame = TRY_OR_FAIL(complete_plugin_decoder->frame(0));
+
+    auto truncated_bytes = file->bytes().trim(file->bytes().size() / 2);
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(truncated_bytes));
+    auto frame = TRY_OR_FAIL(plugin_decoder->partial_frame(0));
+    EXPECT_EQ(frame.image->size(), complete_frame.image->size());
+
+    // The rows that were available match the complete image, and the missing ones are left transparent.
+    EXPECT_EQ(frame.image->get_pixel(0, 0), complete_frame.image->get_pixel(0, 0));
+    EXPECT_EQ(frame.image->get_pixel(0, frame.image->height() - 1).alpha(), 0);
+}
+
 TEST_CASE(test_ppm)
 {
     auto file = MUST(Core::MappedFile::map(TEST_INPUT("pnm/buggie-raw.ppm"sv)));
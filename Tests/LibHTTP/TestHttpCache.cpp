@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Hex.h>
+#include <AK/MemoryStream.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/File.h>
+#include <LibCore/LockFile.h>
+#include <LibCore/Socket.h>
+#include <LibCore/System.h>
+#include <LibCore/TCPServer.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibFileSystem/FileSystem.h>
+#include <LibHTTP/Job.h>
+#include <LibTest/TestCase.h>
+#include <RequestServer/HttpCache.h>
+#include <stdlib.h>
+
+using RequestServer::HttpCache;
+
+// A minimal HTTP server on the loopback interface, answering every request with the same response.
+class LocalWebServer {
+public:
+    explicit LocalWebServer(StringView headers, StringView body)
+        : m_response(ByteString::formatted("HTTP/1.1 200 OK\r\nContent-Length: {}\r\nConnection: close\r\n{}\r\n{}", body.length(), headers, body))
+    {
+        m_server = MUST(Core::TCPServer::try_create());
+        MUST(m_server->listen({ 127, 0, 0, 1 }, 0));
+        m_server->on_ready_to_accept = [this] {
+            auto client = make<Client>(MUST(m_server->accept()));
+            client->socket->on_ready_to_read = [this, &client = *client] { handle_ready_to_read(client); };
+            client->socket->set_notifications_enabled(true);
+            m_clients.append(move(client));
+        };
+    }
+
+    URL url(StringView path) const { return ByteString::formatted("http://127.0.0.1:{}{}", m_server->local_port().value(), path); }
+    size_t request_count() const { return m_request_count; }
+
+private:
+    struct Client {
+        NonnullOwnPtr<Core::TCPSocket> socket;
+        StringBuilder request {};
+    };
+
+    void handle_ready_to_read(Client& client)
+    {
+        u8 buffer[4096];
+        auto bytes = MUST(client.socket->read_some(buffer));
+        if (bytes.is_empty()) {
+            client.socket->close();
+            return;
+        }
+        client.request.append(StringView { bytes });
+        if (!client.request.string_view().contains("\r\n\r\n"sv))
+            return;
+
+        ++m_request_count;
+        MUST(client.socket->write_until_depleted(m_response.bytes()));
+        client.socket->close();
+    }
+
+    ByteString m_response;
+    RefPtr<Core::TCPServer> m_server;
+    Vector<NonnullOwnPtr<Client>> m_clients;
+    size_t m_request_count { 0 };
+};
+
+static ByteString s_cache_directory;
+static ByteString s_directory_locked_by_other_process;
+static ByteString s_directory_left_by_exited_process;
+
+// The cache reads its location from the environment the first time it's used, so set up a fresh one before that. The
+// first directory is locked by a process that's still running, and the second one was left behind by one that isn't.
+static HttpCache& cache()
+{
+    if (!s_cache_directory.is_empty())
+        return HttpCache::the();
+
+    char cache_directory_template[] = "/tmp/TestHttpCache.XXXXXX";
+    s_cache_directory = MUST(Core::System::mkdtemp(cache_directory_template)).to_byte_string();
+    MUST(Core::System::setenv("XDG_CACHE_HOME"sv, s_cache_directory, true));
+    atexit([] { (void)FileSystem::remove(s_cache_directory, FileSystem::RecursionMode::Allowed); });
+    s_directory_locked_by_other_process = ByteString::formatted("{}/RequestServer/0", s_cache_directory);
+    s_directory_left_by_exited_process = ByteString::formatted("{}/RequestServer/1", s_cache_directory);
+    MUST(Core::System::mkdir(ByteString::formatted("{}/RequestServer", s_cache_directory), 0700));
+    MUST(Core::System::mkdir(s_directory_locked_by_other_process, 0700));
+    MUST(Core::System::mkdir(s_directory_left_by_exited_process, 0700));
+    for (auto const& directory : { s_directory_locked_by_other_process, s_directory_left_by_exited_process })
+        (void)MUST(Core::File::open(ByteString::formatted("{}/key.12345.0", directory), Core::File::OpenMode::Write));
+
+    // The lock holder exits once it reads the end of the pipe, which happens when we exit.
+    auto lock_acquired = MUST(Core::System::pipe2(0));
+    auto exit_requested = MUST(Core::System::pipe2(O_CLOEXEC));
+    auto pid = MUST(Core::System::fork());
+    if (pid == 0) {
+        MUST(Core::System::close(exit_requested[1]));
+        auto lock_file_path = ByteString::formatted("{}/lock", s_directory_locked_by_other_process);
+        Core::LockFile lock_file(lock_file_path.characters());
+        VERIFY(lock_file.is_held());
+        MUST(Core::System::write(lock_acquired[1], "x"sv.bytes()));
+        u8 byte;
+        (void)Core::System::read(exit_requested[0], { &byte, 1 });
+        _exit(0);
+    }
+    MUST(Core::System::close(lock_acquired[1]));
+    MUST(Core::System::close(exit_requested[0]));
+    u8 byte;
+    VERIFY(MUST(Core::System::read(lock_acquired[0], { &byte, 1 })) == 1);
+    MUST(Core::System::close(lock_acquired[0]));
+
+    return HttpCache::the();
+}
+
+// Mirrors how RequestServer uses the cache.
+static ByteString fetch(URL const& url)
+{
+    auto request_time = UnixDateTime::now();
+    HTTP::RequestHeaders headers;
+    if (auto entry = cache().find(url, headers); entry.has_value()) {
+        if (!HTTP::needs_revalidation(headers, entry->response_headers, entry->request_time, entry->response_time, request_time)) {
+            if (auto body = cache().map_body(*entry); !body.is_error()) {
+                cache().did_reuse(*entry, false);
+                return ByteString { body.value() ? body.value()->bytes() : ReadonlyBytes {} };
+            }
+        }
+    }
+    cache().did_miss();
+
+    AllocatingMemoryStream output_stream;
+    auto cache_writer = cache().create_writer(output_stream, url, headers, request_time);
+    VERIFY(cache_writer);
+
+    HTTP::HttpRequest request;
+    request.set_method(HTTP::HttpRequest::Method::GET);
+    request.set_url(url);
+    request.set_headers(headers);
+    auto job = HTTP::Job::construct(move(request), *cache_writer);
+
+    Optional<bool> success;
+    job->on_finish = [&](bool job_success) { success = job_success; };
+    auto socket = MUST(Core::BufferedTCPSocket::create(MUST(Core::TCPSocket::connect(url.serialized_host().release_value().to_byte_string(), url.port_or_default()))));
+    socket->set_notifications_enabled(true);
+    job->start(*socket);
+    Core::EventLoop::current().spin_until([&] { return success.has_value(); });
+    VERIFY(*success);
+
+    cache_writer->commit(job->response()->code(), job->response()->headers());
+    return ByteString { MUST(output_stream.read_until_eof()).bytes() };
+}
+
+static ByteString body_path(URL const& url)
+{
+    auto digest = Crypto::Hash::SHA256::hash(url.serialize(URL::ExcludeFragment::Yes));
+    return ByteString::formatted("{}/{}.body", cache().directory(), encode_hex(digest.bytes()));
+}
+
+TEST_CASE(fresh_responses_are_reused_without_asking_the_server)
+{
+    Core::EventLoop event_loop;
+    LocalWebServer server("Cache-Control: max-age=3600\r\n"sv, "Hello, cache!"sv);
+    auto url = server.url("/fresh"sv);
+    auto hit_count = cache().statistics().hit_count;
+
+    EXPECT_EQ(fetch(url), "Hello, cache!"sv);
+    EXPECT_EQ(fetch(url), "Hello, cache!"sv);
+    EXPECT_EQ(server.request_count(), 1u);
+    EXPECT_EQ(cache().statistics().hit_count, hit_count + 1);
+}
+
+TEST_CASE(responses_that_may_not_be_stored_are_fetched_again)
+{
+    Core::EventLoop event_loop;
+    LocalWebServer server("Cache-Control: no-store\r\n"sv, "Hello, network!"sv);
+    auto url = server.url("/no-store"sv);
+
+    EXPECT_EQ(fetch(url), "Hello, network!"sv);
+    EXPECT_EQ(fetch(url), "Hello, network!"sv);
+    EXPECT_EQ(server.request_count(), 2u);
+    EXPECT(!cache().find(url, {}).has_value());
+}
+
+TEST_CASE(bodies_that_changed_on_disk_are_not_used)
+{
+    Core::EventLoop event_loop;
+    LocalWebServer server("Cache-Control: max-age=3600\r\n"sv, "Hello, again!"sv);
+    auto url = server.url("/truncated"sv);
+
+    EXPECT_EQ(fetch(url), "Hello, again!"sv);
+    MUST(Core::File::open(body_path(url), Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+
+    auto entry = cache().find(url, {});
+    EXPECT(entry.has_value());
+    EXPECT(cache().map_body(*entry).is_error());
+    EXPECT(!cache().find(url, {}).has_value());
+
+    EXPECT_EQ(fetch(url), "Hello, again!"sv);
+    EXPECT_EQ(server.request_count(), 2u);
+}
+
+TEST_CASE(directories_of_running_processes_are_left_alone)
+{
+    cache();
+    EXPECT_EQ(cache().directory(), s_directory_left_by_exited_process);
+    EXPECT(Core::System::access(ByteString::formatted("{}/key.12345.0", s_directory_left_by_exited_process), F_OK).is_error());
+    EXPECT(!Core::System::access(ByteString::formatted("{}/key.12345.0", s_directory_locked_by_other_process), F_OK).is_error());
+}
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibHTTP/CachePolicy.h>
+#include <LibTest/TestCase.h>
+
+static UnixDateTime at(i64 seconds)
+{
+    return UnixDateTime::from_seconds_since_epoch(seconds);
+}
+
+static Optional<i64> parse_http_date(StringView value)
+{
+    auto date = HTTP::parse_http_date(value);
+    if (!date.has_value())
+        return {};
+    return date->seconds_since_epoch();
+}
+
+TEST_CASE(parse_http_date)
+{
+    // Sun, 06 Nov 1994 08:49:37 GMT
+    EXPECT_EQ(parse_http_date("Sun, 06 Nov 1994 08:49:37 GMT"sv), 784111777);
+    EXPECT_EQ(parse_http_date("Sunday, 06-Nov-94 08:49:37 GMT"sv), 784111777);
+    EXPECT_EQ(parse_http_date("Sun Nov  6 08:49:37 1994"sv), 784111777);
+
+    EXPECT(!parse_http_date("0"sv).has_value());
+    EXPECT(!parse_http_date(""sv).has_value());
+    EXPECT(!parse_http_date("Sun, 31 Feb 1994 08:49:37 GMT"sv).has_value());
+    EXPECT(!parse_http_date("Sun, 06 Nov 1994 25:49:37 GMT"sv).has_value());
+}
+
+TEST_CASE(parse_cache_control)
+{
+    auto cache_control = HTTP::CacheControl::parse("public, max-age=\"600\", Must-Revalidate, immutable"sv);
+    EXPECT_EQ(cache_control.max_age, 600);
+    EXPECT(cache_control.must_revalidate);
+    EXPECT(cache_control.immutable);
+    EXPECT(!cache_control.no_cache);
+    EXPECT(!cache_control.no_store);
+
+    EXPECT_EQ(HTTP::CacheControl::parse("max-age=-5"sv).max_age, 0);
+    EXPECT_EQ(HTTP::CacheControl::parse("max-age=soon"sv).max_age, 0);
+    EXPECT(HTTP::CacheControl::parse("no-store"sv).no_store);
+    EXPECT(HTTP::CacheControl::parse("no-cache=\"Set-Cookie\""sv).no_cache);
+}
+
+TEST_CASE(freshness_lifetime)
+{
+    HTTP::ResponseHeaders headers;
+    headers.set("Date", "Sun, 06 Nov 1994 08:49:37 GMT");
+    EXPECT_EQ(HTTP::freshness_lifetime(headers).to_seconds(), 0);
+
+    headers.set("Last-Modified", "Sun, 06 Nov 1994 08:32:57 GMT");
+    EXPECT_EQ(HTTP::freshness_lifetime(headers).to_seconds(), 100);
+
+    headers.set("Expires", "Sun, 06 Nov 1994 09:49:37 GMT");
+    EXPECT_EQ(HTTP::freshness_lifetime(headers).to_seconds(), 3600);
+
+    headers.set("Expires", "0");
+    EXPECT_EQ(HTTP::freshness_lifetime(headers).to_seconds(), 0);
+
+    headers.set("cache-control", "max-age=60");
+    EXPECT_EQ(HTTP::freshness_lifetime(headers).to_seconds(), 60);
+}
+
+TEST_CASE(heuristic_freshness_is_capped)
+{
+    HTTP::ResponseHeaders headers;
+    headers.set("Date", "Sun, 06 Nov 1994 08:49:37 GMT");
+    headers.set("Last-Modified", "Sun, 06 Nov 1984 08:49:37 GMT");
+    EXPECT_EQ(HTTP::freshness_lifetime(headers).to_seconds(), 7 * 24 * 60 * 60);
+}
+
+TEST_CASE(current_age)
+{
+    HTTP::ResponseHeaders headers;
+    headers.set("Date", "Sun, 06 Nov 1994 08:49:37 GMT");
+    auto date = at(784111777);
+
+    EXPECT_EQ(HTTP::current_age(headers, date, date, date + Duration::from_seconds(30)).to_seconds(), 30);
+
+    // A response that arrived late is older than its Date header says.
+    EXPECT_EQ(HTTP::current_age(headers, date, date + Duration::from_seconds(5), date + Duration::from_seconds(5)).to_seconds(), 5);
+
+    headers.set("Age", "100");
+    EXPECT_EQ(HTTP::current_age(headers, date, date + Duration::from_seconds(2), date + Duration::from_seconds(12)).to_seconds(), 112);
+}
+
+TEST_CASE(requests_that_bypass_the_cache)
+{
+    HTTP::RequestHeaders headers;
+    EXPECT(HTTP::can_use_cache_for_request("GET"sv, headers));
+    EXPECT(!HTTP::can_use_cache_for_request("POST"sv, headers));
+    EXPECT(!HTTP::can_use_cache_for_request("HEAD"sv, headers));
+
+    headers.set("Cache-Control", "no-cache");
+    EXPECT(HTTP::can_use_cache_for_request("GET"sv, headers));
+    headers.set("Cache-Control", "no-store");
+    EXPECT(!HTTP::can_use_cache_for_request("GET"sv, headers));
+
+    HTTP::RequestHeaders range_headers;
+    range_headers.set("range", "bytes=0-99");
+    EXPECT(!HTTP::can_use_cache_for_request("GET"sv, range_headers));
+
+    HTTP::RequestHeaders conditional_headers;
+    conditional_headers.set("If-None-Match", "\"abc\"");
+    EXPECT(!HTTP::can_use_cache_for_request("GET"sv, conditional_headers));
+}
+
+TEST_CASE(storable_responses)
+{
+    HTTP::ResponseHeaders headers;
+    headers.set("Cache-Control", "max-age=60");
+    EXPECT(HTTP::is_response_storable(200, headers));
+    EXPECT(HTTP::is_response_storable(404, headers));
+    EXPECT(!HTTP::is_response_storable(206, headers));
+    EXPECT(!HTTP::is_response_storable(500, headers));
+
+    headers.set("Cache-Control", "max-age=60, no-store");
+    EXPECT(!HTTP::is_response_storable(200, headers));
+
+    HTTP::ResponseHeaders uncacheable_headers;
+    EXPECT(!HTTP::is_response_storable(200, uncacheable_headers));
+    uncacheable_headers.set("ETag", "\"abc\"");
+    EXPECT(HTTP::is_response_storable(200, uncacheable_headers));
+}
+
+TEST_CASE(needs_revalidation)
+{
+    HTTP::RequestHeaders request_headers;
+    HTTP::ResponseHeaders response_headers;
+    response_headers.set("Date", "Sun, 06 Nov 1994 08:49:37 GMT");
+    response_headers.set("Cache-Control", "max-age=60");
+    auto date = at(784111777);
+
+    EXPECT(!HTTP::needs_revalidation(request_headers, response_headers, date, date, date + Duration::from_seconds(59)));
+    EXPECT(HTTP::needs_revalidation(request_headers, response_headers, date, date, date + Duration::from_seconds(60)));
+
+    HTTP::RequestHeaders reload_headers;
+    reload_headers.set("Cache-Control", "no-cache");
+    EXPECT(HTTP::needs_revalidation(reload_headers, response_headers, date, date, date));
+    HTTP::RequestHeaders pragma_headers;
+    pragma_headers.set("Pragma", "no-cache");
+    EXPECT(HTTP::needs_revalidation(pragma_headers, response_headers, date, date, date));
+
+    HTTP::RequestHeaders max_age_headers;
+    max_age_headers.set("Cache-Control", "max-age=10");
+    EXPECT(!HTTP::needs_revalidation(max_age_headers, response_headers, date, date, date + Duration::from_seconds(10)));
+    EXPECT(HTTP::needs_revalidation(max_age_headers, response_headers, date, date, date + Duration::from_seconds(11)));
+
+    response_headers.set("Cache-Control", "max-age=60, immutable");
+    EXPECT(!HTTP::needs_revalidation(reload_headers, response_headers, date, date, date));
+    EXPECT(HTTP::needs_revalidation(reload_headers, response_headers, date, date, date + Duration::from_seconds(60)));
+
+    response_headers.set("Cache-Control", "max-age=60, no-cache");
+    EXPECT(HTTP::needs_revalidation(request_headers, response_headers, date, date, date));
+}
+
+TEST_CASE(revalidation)
+{
+    HTTP::ResponseHeaders stored_headers;
+    HTTP::RequestHeaders request_headers;
+    EXPECT(!HTTP::add_validators_to_request(request_headers, stored_headers));
+    EXPECT(request_headers.is_empty());
+
+    stored_headers.set("ETag", "\"abc\"");
+    stored_headers.set("Last-Modified", "Sun, 06 Nov 1994 08:49:37 GMT");
+    stored_headers.set("Content-Length", "1234");
+    stored_headers.set("Cache-Control", "max-age=60");
+    EXPECT(HTTP::add_validators_to_request(request_headers, stored_headers));
+    EXPECT_EQ(request_headers.get("If-None-Match"sv), "\"abc\""sv);
+    EXPECT_EQ(request_headers.get("If-Modified-Since"sv), "Sun, 06 Nov 1994 08:49:37 GMT"sv);
+
+    HTTP::ResponseHeaders not_modified_headers;
+    not_modified_headers.set("cache-control", "max-age=120");
+    not_modified_headers.set("Content-Length", "0");
+    HTTP::update_stored_headers(stored_headers, not_modified_headers);
+    EXPECT_EQ(stored_headers.get("Cache-Control"sv), "max-age=120"sv);
+    EXPECT_EQ(stored_headers.get("Content-Length"sv), "1234"sv);
+    EXPECT_EQ(stored_headers.get("ETag"sv), "\"abc\""sv);
+}
+
+TEST_CASE(varying_request_headers)
+{
+    HTTP::RequestHeaders request_headers;
+    request_headers.set("Accept-Language", "en");
+    request_headers.set("User-Agent", "Ladybird");
+
+    HTTP::ResponseHeaders response_headers;
+    auto varying_headers = HTTP::varying_request_headers(request_headers, response_headers);
+    EXPECT(varying_headers.has_value());
+    EXPECT(varying_headers->is_empty());
+
+    response_headers.set("Vary", "accept-language, Accept-Encoding");
+    varying_headers = HTTP::varying_request_headers(request_headers, response_headers);
+    EXPECT(varying_headers.has_value());
+    EXPECT_EQ(varying_headers->size(), 1u);
+    EXPECT_EQ(varying_headers->get("accept-language"sv), "en"sv);
+
+    response_headers.set("Vary", "User-Agent, *");
+    EXPECT(!HTTP::varying_request_headers(request_headers, response_headers).has_value());
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <LibIPC/Connection.h>
+#include <LibTest/TestCase.h>
+#include <Tests/LibIPC/TestConnections.h>
+
+BENCHMARK_CASE(ipc_sync_round_trips)
+{
+    TestConnections connections;
+
+    for (size_t i = 0; i < 10000; ++i)
+        connections.client().ping();
+}
+
+static void send_small_messages(TestConnections& connections)
+{
+    auto bytes = MUST(ByteBuffer::create_zeroed(64));
+    for (size_t i = 0; i < 20000; ++i)
+        connections.client().async_append_bytes(bytes);
+    EXPECT_EQ(connections.client().take_appended_bytes().size(), 20000u * 64);
+}
+
+BENCHMARK_CASE(ipc_small_async_messages)
+{
+    TestConnections connections;
+    send_small_messages(connections);
+}
+
+BENCHMARK_CASE(ipc_small_async_messages_batched)
+{
+    TestConnections connections;
+    IPC::MessageBatch batch { connections.client() };
+    send_small_messages(connections);
+}
+
+static void echo_payloads(size_t size, size_t count)
+{
+    TestConnections connections;
+
+    auto bytes = MUST(ByteBuffer::create_zeroed(size));
+    for (size_t i = 0; i < count; ++i)
+        EXPECT_EQ(connections.client().echo_bytes(bytes).size(), size);
+}
+
+BENCHMARK_CASE(ipc_echo_64_kib_payloads)
+{
+    echo_payloads(64 * KiB, 2000);
+}
+
+BENCHMARK_CASE(ipc_echo_1_mib_payloads)
+{
+    echo_payloads(1 * MiB, 200);
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/Socket.h>
+#include <LibCore/System.h>
+#include <LibIPC/ConnectionFromClient.h>
+#include <LibIPC/ConnectionToServer.h>
+#include <LibThreading/Thread.h>
+#include <Tests/LibIPC/TestClientEndpoint.h>
+#include <Tests/LibIPC/TestServerEndpoint.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+class TestConnectionFromClient final : public IPC::ConnectionFromClient<TestClientEndpoint, TestServerEndpoint> {
+    C_OBJECT(TestConnectionFromClient);
+
+public:
+    virtual void die() override { Core::EventLoop::current().quit(0); }
+
+    static void release_stalled_server() { s_stalled_server_is_released = true; }
+
+private:
+    explicit TestConnectionFromClient(NonnullOwnPtr<Core::LocalSocket> socket)
+        : IPC::ConnectionFromClient<TestClientEndpoint, TestServerEndpoint>(*this, move(socket), 1)
+    {
+    }
+
+    virtual void ping() override { }
+    virtual Messages::TestServer::EchoBytesResponse echo_bytes(ByteBuffer const& data) override { return data; }
+    virtual Messages::TestServer::EchoStringResponse echo_string(String const& text) override { return text; }
+    virtual Messages::TestServer::EchoByteStringResponse echo_byte_string(ByteString const& text) override { return text; }
+
+    virtual void append_bytes(ByteBuffer const& data) override { m_appended_bytes.append(data); }
+    virtual Messages::TestServer::TakeAppendedBytesResponse take_appended_bytes() override { return move(m_appended_bytes); }
+
+    // Stands in for a server that is busy with something else and doesn't read its messages for a while. It gives up
+    // after a while, so that a client that waits for it fails instead of hanging.
+    virtual void stall_until_released() override
+    {
+        auto give_up_time = MonotonicTime::now() + Duration::from_seconds(10);
+        while (!s_stalled_server_is_released && MonotonicTime::now() < give_up_time)
+            usleep(1000);
+        s_stalled_server_is_released = false;
+    }
+
+    static inline Atomic<bool> s_stalled_server_is_released { false };
+
+    ByteBuffer m_appended_bytes;
+};
+
+class TestConnectionToServer final
+    : public IPC::ConnectionToServer<TestClientEndpoint, TestServerEndpoint>
+    , public TestClientEndpoint {
+    C_OBJECT(TestConnectionToServer);
+
+public:
+    // Losing the connection is what ends a test, so don't exit.
+    virtual void die() override { }
+
+private:
+    explicit TestConnectionToServer(NonnullOwnPtr<Core::LocalSocket> socket)
+        : IPC::ConnectionToServer<TestClientEndpoint, TestServerEndpoint>(*this, move(socket))
+    {
+    }
+};
+
+// Connects a client on the current thread to a server that runs its own event loop on a separate thread, just like
+// two processes would be connected. File descriptors are passed over a separate socket, as Lagom requires.
+class TestConnections {
+public:
+    TestConnections()
+    {
+        int sockets[2];
+        int fd_passing_sockets[2];
+        MUST(Core::System::socketpair(AF_LOCAL, SOCK_STREAM, 0, sockets));
+        MUST(Core::System::socketpair(AF_LOCAL, SOCK_STREAM, 0, fd_passing_sockets));
+
+        m_server_thread = Threading::Thread::construct([server_socket = sockets[1], server_fd_passing_socket = fd_passing_sockets[1]] {
+            Core::EventLoop event_loop;
+            // Like the sockets that Core::LocalServer accepts, so that a client that hangs up first doesn't kill the test.
+            auto socket = MUST(Core::LocalSocket::adopt_fd(server_socket, Core::LocalSocket::PreventSIGPIPE::Yes));
+            MUST(socket->set_blocking(false));
+            auto server = MUST(TestConnectionFromClient::try_create(move(socket)));
+            server->set_fd_passing_socket(MUST(Core::LocalSocket::adopt_fd(server_fd_passing_socket, Core::LocalSocket::PreventSIGPIPE::Yes)));
+            return static_cast<intptr_t>(event_loop.exec());
+        },
+            "IPC test server"sv);
+        m_server_thread->start();
+
+        auto socket = MUST(Core::LocalSocket::adopt_fd(sockets[0]));
+        MUST(socket->set_blocking(true));
+        m_client = MUST(TestConnectionToServer::try_create(move(socket)));
+        m_client->set_fd_passing_socket(MUST(Core::LocalSocket::adopt_fd(fd_passing_sockets[0])));
+    }
+
+    ~TestConnections()
+    {
+        // Closing the client's end makes the server shut down and leave its event loop.
+        m_client->shutdown();
+        m_client = nullptr;
+        (void)m_server_thread->join();
+    }
+
+    TestConnectionToServer& client() { return *m_client; }
+
+private:
+    Core::EventLoop m_event_loop;
+    RefPtr<Threading::Thread> m_server_thread;
+    RefPtr<TestConnectionToServer> m_client;
+};
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <AK/StringBuilder.h>
+#include <LibIPC/Connection.h>
+#include <LibIPC/Encoder.h>
+#include <LibTest/TestCase.h>
+#include <Tests/LibIPC/TestConnections.h>
+
+static ByteBuffer make_bytes(size_t size, u8 seed)
+{
+    auto bytes = MUST(ByteBuffer::create_uninitialized(size));
+    for (size_t i = 0; i < size; ++i)
+        bytes[i] = static_cast<u8>(i * 31 + seed);
+    return bytes;
+}
+
+static constexpr size_t payload_sizes[] = {
+    0,
+    1,
+    1000,
+    IPC::large_payload_threshold - 1,
+    IPC::large_payload_threshold,
+    IPC::large_payload_threshold + 1,
+    1 * MiB,
+};
+
+TEST_CASE(byte_buffers_round_trip)
+{
+    TestConnections connections;
+
+    for (auto size : payload_sizes) {
+        auto bytes = make_bytes(size, 7);
+        auto echoed = connections.client().echo_bytes(bytes);
+        EXPECT_EQ(echoed, bytes);
+    }
+}
+
+TEST_CASE(strings_round_trip)
+{
+    TestConnections connections;
+
+    for (auto size : payload_sizes) {
+        StringBuilder builder;
+        for (size_t i = 0; i < size; ++i)
+            builder.append(static_cast<char>('a' + i % 26));
+
+        auto text = MUST(builder.to_string());
+        EXPECT_EQ(connections.client().echo_string(text), text);
+
+        auto byte_string = builder.to_byte_string();
+        EXPECT_EQ(connections.client().echo_byte_string(byte_string), byte_string);
+    }
+}
+
+TEST_CASE(large_payloads_are_only_passed_in_shared_memory_if_the_endpoint_allows_it)
+{
+    auto bytes = make_bytes(IPC::large_payload_threshold, 7);
+
+    IPC::MessageBuffer inline_buffer;
+    IPC::Encoder inline_encoder(inline_buffer);
+    MUST(inline_encoder.encode(bytes));
+    EXPECT(inline_buffer.fds.is_empty());
+    EXPECT(inline_buffer.data.size() > bytes.size());
+
+    IPC::MessageBuffer shared_memory_buffer;
+    IPC::Encoder shared_memory_encoder(shared_memory_buffer, IPC::LargePayloads::InSharedMemory);
+    MUST(shared_memory_encoder.encode(bytes));
+    EXPECT_EQ(shared_memory_buffer.fds.size(), 1u);
+    EXPECT(shared_memory_buffer.data.size() < bytes.size());
+}
+
+TEST_CASE(messages_keep_their_order)
+{
+    TestConnections connections;
+
+    ByteBuffer expected;
+    for (size_t i = 0; i < 200; ++i) {
+        // Mix inline and shared memory payloads.
+        auto bytes = make_bytes(i % 50 == 0 ? IPC::large_payload_threshold : i, static_cast<u8>(i));
+        expected.append(bytes);
+        connections.client().async_append_bytes(bytes);
+    }
+
+    EXPECT_EQ(connections.client().take_appended_bytes(), expected);
+}
+
+TEST_CASE(batched_messages_keep_their_order)
+{
+    TestConnections connections;
+
+    ByteBuffer expected;
+    {
+        IPC::MessageBatch batch { connections.client() };
+        IPC::MessageBatch nested_batch { connections.client() };
+
+        // Enough to exceed the size of a single batch several times.
+        for (size_t i = 0; i < 1000; ++i) {
+            auto bytes = make_bytes(i % 300, static_cast<u8>(i));
+            expected.append(bytes);
+            connections.client().async_append_bytes(bytes);
+        }
+
+        // Waiting for the response sends everything held back so far.
+        EXPECT_EQ(connections.client().take_appended_bytes(), expected);
+        expected.clear();
+
+        for (size_t i = 0; i < 10; ++i) {
+            auto bytes = make_bytes(i, static_cast<u8>(i));
+            expected.append(bytes);
+            connections.client().async_append_bytes(bytes);
+        }
+    }
+
+    EXPECT_EQ(connections.client().take_appended_bytes(), expected);
+}
+
+TEST_CASE(shared_memory_ring_is_set_up_by_the_first_round_trip)
+{
+    TestConnections connections;
+    EXPECT(!connections.client().is_sending_through_shared_memory_ring());
+
+    connections.client().ping();
+    EXPECT(connections.client().is_sending_through_shared_memory_ring());
+}
+
+TEST_CASE(messages_keep_their_order_through_a_full_shared_memory_ring)
+{
+    TestConnections connections;
+    connections.client().ping();
+
+    ByteBuffer expected;
+    for (size_t i = 0; i < 1000; ++i) {
+        // Messages that are too large for the ring or carry file descriptors go through the socket instead.
+        size_t size = 1 * KiB;
+        if (i % 100 == 0)
+            size = IPC::large_payload_threshold;
+        else if (i % 10 == 0)
+            size = IPC::SharedMemoryRing::max_message_size + 1;
+
+        auto bytes = make_bytes(size, static_cast<u8>(i));
+        expected.append(bytes);
+        connections.client().async_append_bytes(bytes);
+    }
+
+    EXPECT(connections.client().is_sending_through_shared_memory_ring());
+    EXPECT_EQ(connections.client().take_appended_bytes(), expected);
+}
+
+TEST_CASE(a_full_shared_memory_ring_does_not_block_the_sender)
+{
+    TestConnections connections;
+    connections.client().ping();
+    connections.client().async_stall_until_released();
+
+    // Several times what fits into the ring, all posted while the server doesn't read any of it.
+    ByteBuffer expected;
+    for (size_t i = 0; i < 4 * IPC::SharedMemoryRing::capacity / KiB; ++i) {
+        auto bytes = make_bytes(1 * KiB, static_cast<u8>(i));
+        expected.append(bytes);
+        connections.client().async_append_bytes(bytes);
+    }
+    TestConnectionFromClient::release_stalled_server();
+
+    EXPECT(connections.client().is_sending_through_shared_memory_ring());
+    EXPECT_EQ(connections.client().take_appended_bytes(), expected);
+}
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <ImageDecoder/ConnectionFromClient.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/MappedFile.h>
+#include <LibCore/Socket.h>
+#include <LibCore/System.h>
+#include <LibGfx/Bitmap.h>
+#include <LibImageDecoderClient/Client.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/Thread.h>
+#include <sys/socket.h>
+
+#ifdef AK_OS_SERENITY
+#    define TEST_INPUT(x) ("/usr/Tests/LibGfx/test-inputs/" x)
+#else
+#    define TEST_INPUT(x) ("../LibGfx/test-inputs/" x)
+#endif
+
+// Connects a client on the current thread to an ImageDecoder server that runs its own event loop on a separate thread,
+// just like the two processes would be connected.
+class ImageDecoderConnections {
+public:
+    ImageDecoderConnections()
+    {
+        int sockets[2];
+        int fd_passing_sockets[2];
+        MUST(Core::System::socketpair(AF_LOCAL, SOCK_STREAM, 0, sockets));
+        MUST(Core::System::socketpair(AF_LOCAL, SOCK_STREAM, 0, fd_passing_sockets));
+
+        m_server_thread = Threading::Thread::construct([server_socket = sockets[1], server_fd_passing_socket = fd_passing_sockets[1]] {
+            Core::EventLoop event_loop;
+            auto socket = MUST(Core::LocalSocket::adopt_fd(server_socket, Core::LocalSocket::PreventSIGPIPE::Yes));
+            MUST(socket->set_blocking(false));
+            auto server = MUST(ImageDecoder::ConnectionFromClient::try_create(move(socket)));
+            server->set_fd_passing_socket(MUST(Core::LocalSocket::adopt_fd(server_fd_passing_socket, Core::LocalSocket::PreventSIGPIPE::Yes)));
+            return static_cast<intptr_t>(event_loop.exec());
+        },
+            "ImageDecoder test server"sv);
+        m_server_thread->start();
+
+        auto socket = MUST(Core::LocalSocket::adopt_fd(sockets[0]));
+        MUST(socket->set_blocking(true));
+        m_client = MUST(try_make_ref_counted<ImageDecoderClient::Client>(move(socket)));
+        m_client->set_fd_passing_socket(MUST(Core::LocalSocket::adopt_fd(fd_passing_sockets[0])));
+    }
+
+    ~ImageDecoderConnections()
+    {
+        // Closing the client's end makes the server shut down and leave its event loop.
+        m_client->shutdown();
+        m_client = nullptr;
+        (void)m_server_thread->join();
+    }
+
+    ImageDecoderClient::Client& client() { return *m_client; }
+
+private:
+    Core::EventLoop m_event_loop;
+    RefPtr<Threading::Thread> m_server_thread;
+    RefPtr<ImageDecoderClient::Client> m_client;
+};
+
+// Everything a decode session reported, in the order it arrived.
+struct DecodeSessionResults {
+    Vector<Gfx::IntSize> sizes;
+    bool did_receive_metadata { false };
+    bool is_animated { false };
+    u32 frame_count { 0 };
+    Vector<ImageDecoderClient::Frame> partial_frames;
+    HashMap<u32, ImageDecoderClient::Frame> complete_frames;
+    bool did_fail { false };
+    // Whether the size was reported before any frame was.
+    bool did_receive_size_first { true };
+};
+
+static i32 begin_decode_session(ImageDecoderClient::Client& client, DecodeSessionResults& results)
+{
+    ImageDecoderClient::DecodeSessionCallbacks callbacks;
+    callbacks.on_size = [&](Gfx::IntSize size) { results.sizes.append(size); };
+    callbacks.on_metadata = [&](bool is_animated, u32, u32 frame_count) {
+        results.did_receive_metadata = true;
+        results.is_animated = is_animated;
+        results.frame_count = frame_count;
+    };
+    callbacks.on_frame = [&](u32 frame_index, ImageDecoderClient::Frame frame, bool is_complete) {
+        if (results.sizes.is_empty())
+            results.did_receive_size_first = false;
+        if (is_complete) {
+            results.complete_frames.set(frame_index, move(frame));
+        } else {
+            EXPECT_EQ(frame_index, 0u);
+            results.partial_frames.append(move(frame));
+        }
+    };
+    callbacks.on_failure = [&] { results.did_fail = true; };
+    return client.begin_decode_session(move(callbacks)).release_value();
+}
+
+// Sends the first part of the data on its own, so that a partial frame is decoded from it, and the rest in small chunks.
+static void append_in_chunks(ImageDecoderClient::Client& client, i32 session_id, ReadonlyBytes data, size_t first_chunk_size, size_t chunk_size)
+{
+    client.append_encoded_data(session_id, data.trim(first_chunk_size));
+    for (size_t offset = first_chunk_size; offset < data.size(); offset += chunk_size)
+        client.append_encoded_data(session_id, data.slice(offset, min(chunk_size, data.size() - offset)));
+}
+
+static void wait_for_frame(DecodeSessionResults const& results, u32 frame_index)
+{
+    Core::EventLoop::current().spin_until([&] { return results.did_fail || results.complete_frames.contains(frame_index); });
+}
+
+static void expect_same_bitmap(Gfx::Bitmap const& bitmap, Gfx::Bitmap const& expected_bitmap)
+{
+    EXPECT_EQ(bitmap.size(), expected_bitmap.size());
+    if (bitmap.size() != expected_bitmap.size())
+        return;
+    for (int y = 0; y < bitmap.height(); ++y) {
+        for (int x = 0; x < bitmap.width(); ++x) {
+            if (bitmap.get_pixel(x, y) != expected_bitmap.get_pixel(x, y)) {
+                FAIL(ByteString::formatted("Pixel ({}, {}) differs", x, y));
+                return;
+            }
+        }
+    }
+}
+
+TEST_CASE(png_partial_and_complete_frames)
+{
+    ImageDecoderConnections connections;
+    auto& client = connections.client();
+    auto file = MUST(Core::MappedFile::map(TEST_INPUT("png/buggie.png"sv)));
+    auto expected_image = client.decode_image(file->bytes()).release_value();
+    auto const& expected_bitmap = *expected_image.frames[0].bitmap;
+
+    DecodeSessionResults results;
+    auto session_id = begin_decode_session(client, results);
+    append_in_chunks(client, session_id, file->bytes(), file->bytes().size() / 2, 512);
+    client.finish_encoded_data(session_id);
+    wait_for_frame(results, 0);
+    client.end_decode_session(session_id);
+
+    EXPECT(!results.did_fail);
+    EXPECT(results.did_receive_size_first);
+    EXPECT_EQ(results.sizes, Vector { expected_bitmap.size() });
+
+    // The partial frame has the rows that were received, and leaves the rest transparent.
+    EXPECT_EQ(results.partial_frames.size(), 1u);
+    auto const& partial_bitmap = *results.partial_frames[0].bitmap;
+    EXPECT_EQ(partial_bitmap.size(), expected_bitmap.size());
+    EXPECT_EQ(partial_bitmap.get_pixel(0, 0), expected_bitmap.get_pixel(0, 0));
+    EXPECT_EQ(partial_bitmap.get_pixel(0, partial_bitmap.height() - 1).alpha(), 0);
+
+    EXPECT(results.did_receive_metadata);
+    EXPECT(!results.is_animated);
+    EXPECT_EQ(results.frame_count, 1u);
+    EXPECT_EQ(results.complete_frames.size(), 1u);
+    expect_same_bitmap(*results.complete_frames.get(0)->bitmap, expected_bitmap);
+}
+
+TEST_CASE(progressive_jpeg_partial_and_complete_frames)
+{
+    ImageDecoderConnections connections;
+    auto& client = connections.client();
+    auto file = MUST(Core::MappedFile::map(TEST_INPUT("jpg/successive_approximation.jpg"sv)));
+    auto expected_image = client.decode_image(file->bytes()).release_value();
+    auto const& expected_bitmap = *expected_image.frames[0].bitmap;
+
+    DecodeSessionResults results;
+    auto session_id = begin_decode_session(client, results);
+    append_in_chunks(client, session_id, file->bytes(), file->bytes().size() / 2, 1000);
+    client.finish_encoded_data(session_id);
+    wait_for_frame(results, 0);
+    client.end_decode_session(session_id);
+
+    EXPECT(!results.did_fail);
+    EXPECT(results.did_receive_size_first);
+    EXPECT_EQ(results.sizes, Vector { Gfx::IntSize(600, 800) });
+    EXPECT_EQ(results.partial_frames.size(), 1u);
+    EXPECT_EQ(results.partial_frames[0].bitmap->size(), expected_bitmap.size());
+    EXPECT_EQ(results.complete_frames.size(), 1u);
+    expect_same_bitmap(*results.complete_frames.get(0)->bitmap, expected_bitmap);
+}
+
+TEST_CASE(animation_frames_are_decoded_when_asked_for)
+{
+    ImageDecoderConnections connections;
+    auto& client = connections.client();
+    auto file = MUST(Core::MappedFile::map(TEST_INPUT("download-animation.gif"sv)));
+    auto expected_image = client.decode_image(file->bytes()).release_value();
+
+    DecodeSessionResults results;
+    auto session_id = begin_decode_session(client, results);
+    append_in_chunks(client, session_id, file->bytes(), 100, 100);
+    client.finish_encoded_data(session_id);
+    wait_for_frame(results, 0);
+
+    EXPECT(results.did_receive_metadata);
+    EXPECT(results.is_animated);
+    EXPECT_EQ(results.frame_count, expected_image.frames.size());
+    EXPECT_EQ(results.complete_frames.size(), 1u);
+
+    client.decode_frame(session_id, 1);
+    wait_for_frame(results, 1);
+    client.end_decode_session(session_id);
+
+    EXPECT(!results.did_fail);
+    EXPECT_EQ(results.complete_frames.size(), 2u);
+    EXPECT_EQ(results.complete_frames.get(1)->duration, 400u);
+    expect_same_bitmap(*results.complete_frames.get(0)->bitmap, *expected_image.frames[0].bitmap);
+    expect_same_bitmap(*results.complete_frames.get(1)->bitmap, *expected_image.frames[1].bitmap);
+}
+
+TEST_CASE(undecodable_data_fails_the_session)
+{
+    ImageDecoderConnections connections;
+    auto& client = connections.client();
+    auto garbage = MUST(ByteBuffer::create_zeroed(4 * KiB));
+
+    DecodeSessionResults results;
+    auto session_id = begin_decode_session(client, results);
+    append_in_chunks(client, session_id, garbage, 1000, 1000);
+    client.finish_encoded_data(session_id);
+    Core::EventLoop::current().spin_until([&] { return results.did_fail; });
+    client.end_decode_session(session_id);
+
+    EXPECT(results.sizes.is_empty());
+    EXPECT(results.partial_frames.is_empty());
+    EXPECT(results.complete_frames.is_empty());
+}
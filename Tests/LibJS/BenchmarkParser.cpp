@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/StringBuilder.h>
+#include <LibJS/AST.h>
+#include <LibJS/Lexer.h>
+#include <LibJS/Parser.h>
+#include <LibTest/TestCase.h>
+
+// Approximates a large bundle: a module wrapper function containing many small functions,
+// each with a couple of nested helpers, of which only a handful are ever called.
+static ByteString make_bundle(size_t module_count, size_t functions_per_module)
+{
+    StringBuilder builder;
+    builder.append("(function (modules) {\n"sv);
+    for (size_t module = 0; module < module_count; ++module) {
+        builder.appendff("modules[{}] = function (exports, require) {{\n", module);
+        for (size_t function = 0; function < functions_per_module; ++function) {
+            builder.appendff("    function f{}_{}(a, b) {{\n", module, function);
+            builder.append("        const helper = (x) => { let y = x * 2; return y + a; };\n"sv);
+            builder.append("        class C { constructor(v) { this.v = v; } get value() { return this.v; } }\n"sv);
+            builder.append("        return new C(helper(b)).value;\n"sv);
+            builder.append("    }\n"sv);
+            builder.appendff("    exports.f{} = f{}_{};\n", function, module, function);
+        }
+        builder.append("};\n"sv);
+    }
+    builder.append("})([]);\n"sv);
+    return builder.to_byte_string();
+}
+
+static ByteString const s_bundle = make_bundle(200, 50);
+
+BENCHMARK_CASE(parse_large_bundle)
+{
+    auto parser = JS::Parser(JS::Lexer(s_bundle));
+    auto program = parser.parse_program();
+    EXPECT(!parser.has_errors());
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteString.h>
+#include <LibJS/Lexer.h>
+#include <LibJS/Parser.h>
+#include <LibJS/ProgramCache.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Script.h>
+#include <LibJS/SourceTextModule.h>
+#include <LibTest/TestCase.h>
+
+// Long enough to be cached, and different for every index.
+static ByteString make_source(size_t index)
+{
+    StringBuilder builder;
+    builder.appendff("var value{} = {};\n", index, index);
+    while (builder.length() < JS::ProgramCache::minimum_cached_source_length)
+        builder.append("// Padding to make the source worth caching.\n"sv);
+    return builder.to_byte_string();
+}
+
+static NonnullRefPtr<JS::Program> parse(StringView source, StringView filename)
+{
+    auto parser = JS::Parser(JS::Lexer(source, filename));
+    auto program = parser.parse_program();
+    VERIFY(!parser.has_errors());
+    return program;
+}
+
+TEST_CASE(finds_inserted_programs)
+{
+    JS::ProgramCache cache;
+    auto source = make_source(0);
+    auto program = parse(source, "a.js"sv);
+
+    EXPECT(!cache.find(source, "a.js"sv, JS::Program::Type::Script, 1));
+    cache.insert(source, "a.js"sv, JS::Program::Type::Script, 1, program);
+    EXPECT_EQ(cache.find(source, "a.js"sv, JS::Program::Type::Script, 1).ptr(), program.ptr());
+
+    EXPECT_EQ(cache.hit_count(), 1u);
+    EXPECT_EQ(cache.miss_count(), 1u);
+}
+
+TEST_CASE(only_finds_programs_with_the_same_source_filename_type_and_offset)
+{
+    JS::ProgramCache cache;
+    auto source = make_source(0);
+    cache.insert(source, "a.js"sv, JS::Program::Type::Script, 1, parse(source, "a.js"sv));
+
+    EXPECT(!cache.find(make_source(1), "a.js"sv, JS::Program::Type::Script, 1));
+    EXPECT(!cache.find(source, "b.js"sv, JS::Program::Type::Script, 1));
+    EXPECT(!cache.find(source, "a.js"sv, JS::Program::Type::Module, 1));
+    EXPECT(!cache.find(source, "a.js"sv, JS::Program::Type::Script, 2));
+    EXPECT(cache.find(source, "a.js"sv, JS::Program::Type::Script, 1));
+}
+
+TEST_CASE(does_not_cache_short_sources)
+{
+    JS::ProgramCache cache;
+    auto source = "var x = 1;"sv;
+    cache.insert(source, "a.js"sv, JS::Program::Type::Script, 1, parse(source, "a.js"sv));
+    EXPECT(!cache.find(source, "a.js"sv, JS::Program::Type::Script, 1));
+}
+
+TEST_CASE(evicts_the_least_recently_used_program)
+{
+    JS::ProgramCache cache;
+    for (size_t i = 0; i < JS::ProgramCache::maximum_cached_program_count; ++i) {
+        auto source = make_source(i);
+        cache.insert(source, "a.js"sv, JS::Program::Type::Script, 1, parse(source, "a.js"sv));
+    }
+
+    // Using the oldest program makes the second oldest one the next to go.
+    EXPECT(cache.find(make_source(0), "a.js"sv, JS::Program::Type::Script, 1));
+
+    auto source = make_source(JS::ProgramCache::maximum_cached_program_count);
+    cache.insert(source, "a.js"sv, JS::Program::Type::Script, 1, parse(source, "a.js"sv));
+
+    EXPECT(cache.find(make_source(0), "a.js"sv, JS::Program::Type::Script, 1));
+    EXPECT(!cache.find(make_source(1), "a.js"sv, JS::Program::Type::Script, 1));
+    EXPECT(cache.find(make_source(2), "a.js"sv, JS::Program::Type::Script, 1));
+    EXPECT(cache.find(source, "a.js"sv, JS::Program::Type::Script, 1));
+}
+
+TEST_CASE(disabling_clears_the_cache)
+{
+    JS::ProgramCache cache;
+    auto source = make_source(0);
+    cache.insert(source, "a.js"sv, JS::Program::Type::Script, 1, parse(source, "a.js"sv));
+
+    cache.set_enabled(false);
+    EXPECT(!cache.find(source, "a.js"sv, JS::Program::Type::Script, 1));
+
+    cache.set_enabled(true);
+    EXPECT(!cache.find(source, "a.js"sv, JS::Program::Type::Script, 1));
+}
+
+TEST_CASE(scripts_and_modules_share_programs_through_the_vm)
+{
+    auto vm = MUST(JS::VM::create());
+    auto root_execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+    auto& realm = *root_execution_context->realm;
+    auto source = make_source(0);
+
+    auto script = MUST(JS::Script::parse(source, realm, "a.js"sv));
+    auto same_script = MUST(JS::Script::parse(source, realm, "a.js"sv));
+    EXPECT_EQ(&same_script->parse_node(), &script->parse_node());
+
+    auto script_from_other_url = MUST(JS::Script::parse(source, realm, "b.js"sv));
+    EXPECT_NE(&script_from_other_url->parse_node(), &script->parse_node());
+
+    auto module = MUST(JS::SourceTextModule::parse(source, realm, "a.js"sv));
+    auto same_module = MUST(JS::SourceTextModule::parse(source, realm, "a.js"sv));
+    EXPECT_NE(&module->parse_node(), &script->parse_node());
+    EXPECT_EQ(&same_module->parse_node(), &module->parse_node());
+}
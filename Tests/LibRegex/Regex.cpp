@@ -1175,3 +1175,151 @@ TEST_CASE(inversion_state_in_char_class)
         EXPECT_EQ(result.capture_group_matches.first()[1].view.to_byte_string(), "}"sv);
     }
 }
+
+TEST_CASE(optimizer_starting_ranges)
+{
+    Array tests {
+        // Pattern, Subject, Expected match
+        Tuple { "b\\d+"sv, "aaab123c"sv, "b123"sv },
+        Tuple { "[x-z]+\\d"sv, "aaayz1"sv, "yz1"sv },
+        Tuple { "(c|d)e"sv, "abde"sv, "de"sv },
+        Tuple { "^b\\d"sv, "ab1"sv, ""sv },
+        Tuple { "\\bfoo\\w"sv, "a foox"sv, "foox"sv },
+        Tuple { "(?:)x\\d"sv, "ax1"sv, "x1"sv },
+    };
+
+    for (auto& test : tests) {
+        Regex<ECMA262> re(test.get<0>(), ECMAScriptFlags::Global);
+        auto result = re.match(test.get<1>());
+        if (test.get<2>().is_empty()) {
+            EXPECT_EQ(result.success, false);
+            continue;
+        }
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.matches.first().view.to_byte_string(), test.get<2>());
+    }
+
+    {
+        // The prefilter must not skip characters that only match case-insensitively.
+        Regex<ECMA262> re("b\\d"sv, ECMAScriptFlags::Global | ECMAScriptFlags::Insensitive);
+        auto result = re.match("aB1"sv);
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.matches.first().view.to_byte_string(), "B1"sv);
+    }
+}
+
+BENCHMARK_CASE(starting_ranges_performance)
+{
+    Regex<ECMA262> re("needle\\d+", ECMAScriptFlags::Global);
+    auto haystack = ByteString::formatted("{}needle42", g_lots_of_a_s);
+    auto result = re.match(haystack);
+    EXPECT_EQ(result.success, true);
+    EXPECT_EQ(result.matches.first().view.to_byte_string(), "needle42"sv);
+}
+
+TEST_CASE(linear_matcher)
+{
+    Array tests {
+        // Pattern, Subject, Expected match
+        Tuple { "(?:a|ab)"sv, "ab"sv, "a"sv },
+        Tuple { "(?:ab|a)c?"sv, "abc"sv, "abc"sv },
+        Tuple { "a*"sv, "aaab"sv, "aaa"sv },
+        Tuple { "a*?"sv, "aaab"sv, ""sv },
+        Tuple { "a+?b"sv, "aaab"sv, "aaab"sv },
+        Tuple { "(?:a|b)+c"sv, "xababc"sv, "ababc"sv },
+        Tuple { "[^x]+y"sv, "xxayy"sv, "ayy"sv },
+        Tuple { "\\bfoo\\b"sv, "a foo b"sv, "foo"sv },
+        Tuple { "^ab|cd$"sv, "xabcd"sv, "cd"sv },
+        Tuple { "(?:a|aa)*b"sv, "aaaaab"sv, "aaaaab"sv },
+    };
+
+    for (auto& test : tests) {
+        Regex<ECMA262> re(test.get<0>(), ECMAScriptFlags::Global);
+        EXPECT(re.parser_result.optimization_data.supports_linear_matching);
+        auto result = re.match(test.get<1>());
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.matches.first().view.to_byte_string(), test.get<2>());
+    }
+
+    {
+        // This would take exponential time to fail with backtracking.
+        Regex<ECMA262> re("(?:a|aa)*b"sv);
+        EXPECT_EQ(re.match(ByteString::repeated('a', 100)).success, false);
+    }
+    {
+        Regex<ECMA262> re("AB+"sv, ECMAScriptFlags::Global | ECMAScriptFlags::Insensitive);
+        auto result = re.match("xabbb"sv);
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.matches.first().view.to_byte_string(), "abbb"sv);
+    }
+    {
+        // Captures, back-references and loops that can match the empty string still need the backtracking matcher.
+        EXPECT(!Regex<ECMA262>("(a)b"sv).parser_result.optimization_data.supports_linear_matching);
+        EXPECT(!Regex<ECMA262>("(?:a)\\1"sv).parser_result.optimization_data.supports_linear_matching);
+        EXPECT(!Regex<ECMA262>("(?:a*)*b"sv).parser_result.optimization_data.supports_linear_matching);
+        EXPECT(!Regex<ECMA262>("a(?=b)"sv).parser_result.optimization_data.supports_linear_matching);
+    }
+}
+
+BENCHMARK_CASE(linear_matcher_performance)
+{
+    Regex<ECMA262> re("(?:a|aa)*b");
+    auto result = re.match(g_lots_of_a_s);
+    EXPECT_EQ(result.success, false);
+}
+
+TEST_CASE(linear_matcher_search)
+{
+    // Wrapping a pattern in a capture group makes the backtracking matcher match it, which has to find the same matches.
+    Array patterns {
+        "a|ab"sv,
+        "(?:a|b)+c"sv,
+        "a*"sv,
+        "a*?b"sv,
+        "[^x]+y"sv,
+        "(?:a|aa)*b"sv,
+        "\\bab\\b"sv,
+        "^a|b$"sv,
+    };
+    Array subjects {
+        ""sv,
+        "abab"sv,
+        "xabcyabbc"sv,
+        "baab"sv,
+        "xxayy xy"sv,
+        "aaaxaab"sv,
+        "ab ab cab"sv,
+        "abba"sv,
+    };
+
+    for (auto pattern : patterns) {
+        for (auto flags : { ECMAScriptFlags::Global, ECMAScriptFlags::Multiline }) {
+            Regex<ECMA262> linear(pattern, flags);
+            Regex<ECMA262> backtracking(ByteString::formatted("({})", pattern), flags);
+            EXPECT(linear.parser_result.optimization_data.supports_linear_matching);
+            EXPECT(!backtracking.parser_result.optimization_data.supports_linear_matching);
+
+            for (auto subject : subjects) {
+                // Global matches are stateful, make every subject start from the beginning.
+                linear.start_offset = 0;
+                backtracking.start_offset = 0;
+                auto linear_result = linear.match(subject);
+                auto backtracking_result = backtracking.match(subject);
+                EXPECT_EQ(linear_result.success, backtracking_result.success);
+                EXPECT_EQ(linear_result.matches.size(), backtracking_result.matches.size());
+                for (size_t i = 0; i < min(linear_result.matches.size(), backtracking_result.matches.size()); ++i) {
+                    EXPECT_EQ(linear_result.matches[i].global_offset, backtracking_result.matches[i].global_offset);
+                    EXPECT_EQ(linear_result.matches[i].view.to_byte_string(), backtracking_result.matches[i].view.to_byte_string());
+                }
+            }
+        }
+    }
+}
+
+BENCHMARK_CASE(linear_matcher_search_performance)
+{
+    // Searching would take quadratic time if the matcher was started over at every position.
+    Regex<ECMA262> re("(?:a|aa)*b", ECMAScriptFlags::Global);
+    auto result = re.match(g_lots_of_a_s);
+    EXPECT_EQ(result.success, false);
+}
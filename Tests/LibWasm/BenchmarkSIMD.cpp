@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/MemoryStream.h>
+#include <LibTest/TestCase.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/Types.h>
+
+// Each kernel walks the first half of a single page of memory in 16-byte steps, pairing every vector
+// with the one 32KiB further along, which is the shape of most image and audio processing loops.
+static constexpr u32 half_page_size = Wasm::Constants::page_size / 2;
+static constexpr size_t iterations = 1000;
+
+static void append_leb(Vector<u8>& output, i64 value, bool is_signed)
+{
+    while (true) {
+        u8 byte = value & 0x7f;
+        value >>= 7;
+        bool done = is_signed
+            ? (value == 0 && !(byte & 0x40)) || (value == -1 && (byte & 0x40))
+            : value == 0;
+        if (done) {
+            output.append(byte);
+            return;
+        }
+        output.append(byte | 0x80);
+    }
+}
+
+static void append_simd(Vector<u8>& output, u32 opcode)
+{
+    output.append(0xfd);
+    append_leb(output, opcode, false);
+}
+
+static void append_load(Vector<u8>& output, u32 offset)
+{
+    output.extend(Vector<u8> { 0x20, 0x01 }); // local.get $i
+    append_simd(output, 0x00); // v128.load
+    output.append(0x04);
+    append_leb(output, offset, false);
+}
+
+static void append_section(Vector<u8>& output, u8 id, Vector<u8> const& contents)
+{
+    output.append(id);
+    append_leb(output, contents.size(), false);
+    output.extend(contents);
+}
+
+// Builds a module exporting `kernel(n: i32)`, with locals `$i: i32` and `$acc: v128`, which runs `body` once for every `$i` in [0, n) in steps of 16.
+static Vector<u8> make_module(Vector<u8> const& body)
+{
+    Vector<u8> code {
+        0x02, 0x01, 0x7f, 0x01, 0x7b, // locals
+        0x02, 0x40,                   // block
+        0x03, 0x40,                   // loop
+        0x20, 0x01, 0x20, 0x00, 0x4f, // $i >= n
+        0x0d, 0x01,                   // br_if 1
+    };
+    code.extend(body);
+    code.extend(Vector<u8> {
+        0x20, 0x01, 0x41, 0x10, 0x6a, 0x21, 0x01, // $i += 16
+        0x0c, 0x00,                               // br 0
+        0x0b, 0x0b, 0x0b,                         // end end end
+    });
+
+    Vector<u8> code_section { 0x01 };
+    append_leb(code_section, code.size(), false);
+    code_section.extend(code);
+
+    Vector<u8> module { 0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00 };
+    append_section(module, 1, { 0x01, 0x60, 0x01, 0x7f, 0x00 });
+    append_section(module, 3, { 0x01, 0x00 });
+    append_section(module, 5, { 0x01, 0x00, 0x01 });
+    append_section(module, 7, { 0x01, 0x06, 'k', 'e', 'r', 'n', 'e', 'l', 0x00, 0x00 });
+    append_section(module, 10, code_section);
+    return module;
+}
+
+static void run_kernel(Vector<u8> const& bytes)
+{
+    FixedMemoryStream stream { bytes.span() };
+    auto module = Wasm::Module::parse(stream);
+    EXPECT(!module.is_error());
+    if (module.is_error())
+        return;
+
+    Wasm::AbstractMachine machine;
+    auto instance = machine.instantiate(module.value(), {});
+    EXPECT(!instance.is_error());
+    if (instance.is_error())
+        return;
+
+    Optional<Wasm::FunctionAddress> kernel;
+    for (auto& entry : instance.value()->exports()) {
+        if (entry.name() == "kernel"sv)
+            kernel = *entry.value().get_pointer<Wasm::FunctionAddress>();
+    }
+    EXPECT(kernel.has_value());
+
+    for (size_t i = 0; i < iterations; ++i) {
+        auto result = machine.invoke(*kernel, { Wasm::Value(static_cast<i32>(half_page_size)) });
+        EXPECT(!result.is_trap());
+    }
+}
+
+BENCHMARK_CASE(i8x16_add_saturate_blend)
+{
+    Vector<u8> body { 0x20, 0x01 }; // address for the store
+    append_load(body, 0);
+    append_load(body, half_page_size);
+    append_simd(body, 0x70); // i8x16.add_sat_u
+    append_simd(body, 0x0b); // v128.store
+    body.extend(Vector<u8> { 0x04, 0x00 });
+    run_kernel(make_module(body));
+}
+
+BENCHMARK_CASE(f32x4_dot_product)
+{
+    Vector<u8> body { 0x20, 0x02 }; // $acc
+    append_load(body, 0);
+    append_load(body, half_page_size);
+    append_simd(body, 0xe6); // f32x4.mul
+    append_simd(body, 0xe4); // f32x4.add
+    body.extend(Vector<u8> { 0x21, 0x02 });
+    run_kernel(make_module(body));
+}
+
+BENCHMARK_CASE(i16x8_clamp)
+{
+    Vector<u8> body { 0x20, 0x01 }; // address for the store
+    append_load(body, 0);
+    body.append(0x41);
+    append_leb(body, -1000, true);
+    append_simd(body, 0x10); // i16x8.splat
+    append_simd(body, 0x98); // i16x8.max_s
+    body.append(0x41);
+    append_leb(body, 1000, true);
+    append_simd(body, 0x10); // i16x8.splat
+    append_simd(body, 0x96); // i16x8.min_s
+    append_simd(body, 0x0b); // v128.store
+    body.extend(Vector<u8> { 0x04, 0x00 });
+    run_kernel(make_module(body));
+}
@@ -0,0 +1,621 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/MemoryStream.h>
+#include <AK/StringBuilder.h>
+#include <LibJIT/Assembler.h>
+#include <LibTest/TestCase.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/AbstractMachine/Configuration.h>
+#include <LibWasm/Constants.h>
+#include <LibWasm/Types.h>
+
+// These tests run the same modules in the interpreter and with the JIT, and expect both to produce the same results,
+// traps, memory contents and globals. Every function is expected to actually be compiled to native code.
+
+static constexpr u8 i32_type = 0x7f;
+static constexpr u8 i64_type = 0x7e;
+
+static void append_leb(Vector<u8>& output, i64 value, bool is_signed)
+{
+    while (true) {
+        u8 byte = value & 0x7f;
+        value >>= 7;
+        bool done = is_signed
+            ? (value == 0 && !(byte & 0x40)) || (value == -1 && (byte & 0x40))
+            : value == 0;
+        if (done) {
+            output.append(byte);
+            return;
+        }
+        output.append(byte | 0x80);
+    }
+}
+
+static void append_name(Vector<u8>& output, StringView name)
+{
+    append_leb(output, name.length(), false);
+    output.append(name.bytes().data(), name.length());
+}
+
+static void append_section(Vector<u8>& output, u8 id, Vector<u8> const& contents)
+{
+    output.append(id);
+    append_leb(output, contents.size(), false);
+    output.extend(contents);
+}
+
+static Vector<u8> i32_const(i32 value)
+{
+    Vector<u8> output { 0x41 };
+    append_leb(output, value, true);
+    return output;
+}
+
+static Vector<u8> i64_const(i64 value)
+{
+    Vector<u8> output { 0x42 };
+    append_leb(output, value, true);
+    return output;
+}
+
+static Vector<u8> concatenate(std::initializer_list<Vector<u8>> parts)
+{
+    Vector<u8> output;
+    for (auto const& part : parts)
+        output.extend(part);
+    return output;
+}
+
+struct Signature {
+    Vector<u8> parameters;
+    Vector<u8> results;
+};
+
+struct TestFunction {
+    Signature signature;
+    Vector<u8> locals;
+    // Without the final `end`.
+    Vector<u8> body;
+};
+
+// Every test module imports its imports as env.import0, env.import1..., has a page of memory that can grow up to three
+// pages, a mutable i32 and a mutable i64 global, and exports its functions as f0, f1...
+struct TestModule {
+    Vector<Signature> imports;
+    Vector<TestFunction> functions;
+};
+
+static Vector<u8> encode(TestModule const& description)
+{
+    auto append_signature = [](Vector<u8>& output, Signature const& signature) {
+        output.append(0x60);
+        append_leb(output, signature.parameters.size(), false);
+        output.extend(signature.parameters);
+        append_leb(output, signature.results.size(), false);
+        output.extend(signature.results);
+    };
+    auto import_count = description.imports.size();
+
+    Vector<u8> types;
+    append_leb(types, import_count + description.functions.size(), false);
+    for (auto const& signature : description.imports)
+        append_signature(types, signature);
+    for (auto const& function : description.functions)
+        append_signature(types, function.signature);
+
+    Vector<u8> imports;
+    append_leb(imports, import_count, false);
+    for (size_t i = 0; i < import_count; ++i) {
+        append_name(imports, "env"sv);
+        append_name(imports, ByteString::formatted("import{}", i));
+        imports.append(0x00);
+        append_leb(imports, i, false);
+    }
+
+    Vector<u8> functions;
+    Vector<u8> exports;
+    Vector<u8> code;
+    append_leb(functions, description.functions.size(), false);
+    append_leb(exports, description.functions.size(), false);
+    append_leb(code, description.functions.size(), false);
+    for (size_t i = 0; i < description.functions.size(); ++i) {
+        auto const& function = description.functions[i];
+        append_leb(functions, import_count + i, false);
+
+        append_name(exports, ByteString::formatted("f{}", i));
+        exports.append(0x00);
+        append_leb(exports, import_count + i, false);
+
+        Vector<u8> function_code;
+        append_leb(function_code, function.locals.size(), false);
+        for (auto type : function.locals)
+            function_code.extend(Vector<u8> { 0x01, type });
+        function_code.extend(function.body);
+        function_code.append(0x0b);
+        append_leb(code, function_code.size(), false);
+        code.extend(function_code);
+    }
+
+    Vector<u8> module { 0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00 };
+    append_section(module, 1, types);
+    if (import_count > 0)
+        append_section(module, 2, imports);
+    append_section(module, 3, functions);
+    append_section(module, 5, { 0x01, 0x01, 0x01, 0x03 });
+    append_section(module, 6, { 0x02, i32_type, 0x01, 0x41, 0x00, 0x0b, i64_type, 0x01, 0x42, 0x00, 0x0b });
+    append_section(module, 7, exports);
+    append_section(module, 10, code);
+    return module;
+}
+
+static NonnullOwnPtr<Wasm::Module> parse_module(Vector<u8> const& bytes)
+{
+    FixedMemoryStream stream { bytes.span() };
+    auto module = Wasm::Module::parse(stream);
+    VERIFY(!module.is_error());
+    return make<Wasm::Module>(module.release_value());
+}
+
+static Optional<Wasm::FunctionAddress> find_export(Wasm::ModuleInstance const& instance, StringView name)
+{
+    for (auto& entry : instance.exports()) {
+        if (entry.name() == name)
+            return *entry.value().get_pointer<Wasm::FunctionAddress>();
+    }
+    return {};
+}
+
+enum class CompareTrapReasons {
+    Yes,
+    No,
+};
+
+static ByteString describe(Wasm::Result const& result, CompareTrapReasons compare_trap_reasons)
+{
+    if (result.is_trap())
+        return compare_trap_reasons == CompareTrapReasons::Yes ? ByteString::formatted("trap: {}", result.trap().reason) : ByteString("trap"sv);
+    if (result.is_completion())
+        return ByteString("completion"sv);
+
+    StringBuilder builder;
+    for (auto const& value : result.values()) {
+        if (value.type().kind() == Wasm::ValueType::I32)
+            builder.appendff("i32:{} ", *value.to<i32>());
+        else
+            builder.appendff("i64:{} ", *value.to<i64>());
+    }
+    return builder.to_byte_string();
+}
+
+// Gives each module instance the imports it needs, allocated in the given machine.
+using ImportProvider = Function<Vector<Wasm::ExternValue>(Wasm::AbstractMachine&)>;
+
+class DifferentialTest {
+public:
+    explicit DifferentialTest(TestModule const& description, ImportProvider provide_imports = {})
+        : m_module(parse_module(encode(description)))
+    {
+        m_jit_machine.enable_jit();
+        for (auto* machine : { &m_interpreter_machine, &m_jit_machine }) {
+            auto imports = provide_imports ? provide_imports(*machine) : Vector<Wasm::ExternValue> {};
+            auto instance = machine->instantiate(*m_module, move(imports));
+            VERIFY(!instance.is_error());
+            m_instances.append(instance.release_value());
+        }
+
+#ifdef JIT_ARCH_SUPPORTED
+        // Anything that falls back to the interpreter wouldn't be testing the JIT at all.
+        for (size_t i = 0; i < description.functions.size(); ++i) {
+            auto address = find_export(jit_instance(), ByteString::formatted("f{}", i));
+            auto* function = m_jit_machine.store().get(*address)->get_pointer<Wasm::WasmFunction>();
+            EXPECT(function->native_function(m_jit_machine.store()) != nullptr);
+        }
+#endif
+    }
+
+    Wasm::AbstractMachine& interpreter_machine() { return m_interpreter_machine; }
+    Wasm::AbstractMachine& jit_machine() { return m_jit_machine; }
+    Wasm::ModuleInstance& interpreter_instance() { return *m_instances[0]; }
+    Wasm::ModuleInstance& jit_instance() { return *m_instances[1]; }
+
+    void call(size_t function_index, Vector<Wasm::Value> const& arguments, CompareTrapReasons compare_trap_reasons = CompareTrapReasons::Yes)
+    {
+        auto name = ByteString::formatted("f{}", function_index);
+        auto interpreter_result = m_interpreter_machine.invoke(*find_export(interpreter_instance(), name), arguments);
+        auto jit_result = m_jit_machine.invoke(*find_export(jit_instance(), name), arguments);
+        EXPECT_EQ(describe(jit_result, compare_trap_reasons), describe(interpreter_result, compare_trap_reasons));
+        expect_same_state();
+    }
+
+private:
+    void expect_same_state()
+    {
+        auto& interpreter_memory = *m_interpreter_machine.store().get(interpreter_instance().memories().first());
+        auto& jit_memory = *m_jit_machine.store().get(jit_instance().memories().first());
+        EXPECT_EQ(jit_memory.size(), interpreter_memory.size());
+        EXPECT(jit_memory.data() == interpreter_memory.data());
+
+        for (size_t i = 0; i < interpreter_instance().globals().size(); ++i) {
+            auto interpreter_global = Wasm::Result { Vector { m_interpreter_machine.store().get(interpreter_instance().globals()[i])->value() } };
+            auto jit_global = Wasm::Result { Vector { m_jit_machine.store().get(jit_instance().globals()[i])->value() } };
+            EXPECT_EQ(describe(jit_global, CompareTrapReasons::Yes), describe(interpreter_global, CompareTrapReasons::Yes));
+        }
+    }
+
+    NonnullOwnPtr<Wasm::Module> m_module;
+    Wasm::AbstractMachine m_interpreter_machine;
+    Wasm::AbstractMachine m_jit_machine;
+    Vector<NonnullOwnPtr<Wasm::ModuleInstance>> m_instances;
+};
+
+static Wasm::Value value_of_type(u8 type, i64 value)
+{
+    if (type == i32_type)
+        return Wasm::Value(static_cast<i32>(value));
+    return Wasm::Value(value);
+}
+
+static constexpr Array<i64, 19> interesting_values {
+    0ll, 1ll, 2ll, 7ll, -1ll, -7ll, 31ll, 32ll, 33ll, 63ll, 64ll, 0x12345678ll, -0x12345678ll,
+    static_cast<i64>(NumericLimits<i32>::min()), static_cast<i64>(NumericLimits<i32>::max()), static_cast<i64>(NumericLimits<u32>::max()),
+    NumericLimits<i64>::min(), NumericLimits<i64>::max(), 0x123456789abcdefll
+};
+
+// Runs every opcode as the body of its own function, on all combinations of the interesting values.
+static void test_operators(u8 operand_type, u8 result_type, size_t operand_count, Vector<u8> const& opcodes)
+{
+    TestModule description;
+    for (auto opcode : opcodes) {
+        TestFunction function { { {}, { result_type } }, {}, {} };
+        for (size_t i = 0; i < operand_count; ++i) {
+            function.signature.parameters.append(operand_type);
+            function.body.extend(Vector<u8> { 0x20, static_cast<u8>(i) });
+        }
+        function.body.append(opcode);
+        description.functions.append(move(function));
+    }
+
+    DifferentialTest test { description };
+    for (size_t i = 0; i < opcodes.size(); ++i) {
+        for (auto lhs : interesting_values) {
+            if (operand_count == 1) {
+                test.call(i, { value_of_type(operand_type, lhs) });
+                continue;
+            }
+            for (auto rhs : interesting_values)
+                test.call(i, { value_of_type(operand_type, lhs), value_of_type(operand_type, rhs) });
+        }
+    }
+}
+
+TEST_CASE(i32_arithmetic)
+{
+    // add, sub, mul, div_s, div_u, rem_s, rem_u, and, or, xor, shl, shr_s, shr_u, rotl, rotr
+    test_operators(i32_type, i32_type, 2, { 0x6a, 0x6b, 0x6c, 0x6d, 0x6e, 0x6f, 0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78 });
+}
+
+TEST_CASE(i64_arithmetic)
+{
+    test_operators(i64_type, i64_type, 2, { 0x7c, 0x7d, 0x7e, 0x7f, 0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a });
+}
+
+TEST_CASE(comparisons)
+{
+    // eq, ne, lt_s, lt_u, gt_s, gt_u, le_s, le_u, ge_s, ge_u, and eqz on its own.
+    test_operators(i32_type, i32_type, 2, { 0x46, 0x47, 0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f });
+    test_operators(i32_type, i32_type, 1, { 0x45 });
+    test_operators(i64_type, i32_type, 2, { 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a });
+    test_operators(i64_type, i32_type, 1, { 0x50 });
+}
+
+TEST_CASE(conversions)
+{
+    // i32.extend8_s, i32.extend16_s
+    test_operators(i32_type, i32_type, 1, { 0xc0, 0xc1 });
+    // i64.extend_i32_s, i64.extend_i32_u
+    test_operators(i32_type, i64_type, 1, { 0xac, 0xad });
+    // i32.wrap_i64
+    test_operators(i64_type, i32_type, 1, { 0xa7 });
+    // i64.extend8_s, i64.extend16_s, i64.extend32_s
+    test_operators(i64_type, i64_type, 1, { 0xc2, 0xc3, 0xc4 });
+}
+
+TEST_CASE(locals_globals_and_select)
+{
+    TestModule description;
+    // (param i32 i64) (result i64) (local i64 i32): swaps things around through locals, select and the globals.
+    description.functions.append({
+        { { i32_type, i64_type }, { i64_type } },
+        { i64_type, i32_type },
+        concatenate({
+            { 0x20, 0x01, 0x22, 0x02, 0x1a },                     // local.tee 2 (drop)
+            { 0x20, 0x00, 0x21, 0x03 },                           // local.set 3
+            { 0x23, 0x00, 0x20, 0x03, 0x6a, 0x24, 0x00 },         // global0 += local3
+            { 0x23, 0x01, 0x20, 0x02, 0x7c, 0x24, 0x01 },         // global1 += local2
+            { 0x20, 0x02 }, i64_const(-5), { 0x20, 0x03, 0x1b },  // select(local2, -5, local3)
+            { 0x20, 0x02 }, i64_const(9), { 0x20, 0x03, 0x45, 0x1c, 0x01, i64_type }, // select (i64) (local2, 9, !local3)
+            { 0x7c, 0x23, 0x01, 0x7c },                           // + + global1
+        }),
+    });
+
+    DifferentialTest test { description };
+    for (auto lhs : interesting_values) {
+        for (auto rhs : interesting_values)
+            test.call(0, { Wasm::Value(static_cast<i32>(lhs)), Wasm::Value(rhs) });
+    }
+}
+
+TEST_CASE(control_flow)
+{
+    TestModule description;
+    // (param i32) (result i32) (local i32): sums up 1..n in a loop, but returns early once the sum goes past 1000.
+    description.functions.append({
+        { { i32_type }, { i32_type } },
+        { i32_type },
+        concatenate({
+            { 0x02, 0x40, 0x03, 0x40 },                             // block loop
+            { 0x20, 0x00, 0x45, 0x0d, 0x01 },                       // br_if 1 (n == 0)
+            { 0x20, 0x01, 0x20, 0x00, 0x6a, 0x22, 0x01 },           // sum += n
+            i32_const(1000), { 0x4a, 0x04, 0x40, 0x20, 0x01, 0x0f, 0x0b }, // if (sum > 1000) return sum
+            { 0x20, 0x00 }, i32_const(1), { 0x6b, 0x21, 0x00 },    // n -= 1
+            { 0x0c, 0x00, 0x0b, 0x0b },                             // br 0 end end
+            { 0x20, 0x01 },
+        }),
+    });
+    // (param i32) (result i32): dispatches with br_table through nested blocks, passing a value along.
+    description.functions.append({
+        { { i32_type }, { i32_type } },
+        {},
+        concatenate({
+            { 0x02, i32_type, 0x02, i32_type, 0x02, i32_type },    // block (result i32) x3
+            i32_const(100), { 0x20, 0x00 },
+            { 0x0e, 0x03, 0x00, 0x01, 0x02, 0x00 },                 // br_table 0 1 2 (default 0)
+            { 0x0b }, i32_const(1), { 0x6a },                       // end, +1
+            { 0x0b }, i32_const(10), { 0x6a },                      // end, +10
+            { 0x0b },                                               // end
+        }),
+    });
+    // (param i32) (result i64): if/else with results, and an unconditional branch out of the middle of a block.
+    description.functions.append({
+        { { i32_type }, { i64_type } },
+        {},
+        concatenate({
+            { 0x20, 0x00, 0x04, i64_type }, i64_const(-3),          // if (result i64)
+            { 0x05 }, i64_const(NumericLimits<i64>::max()), { 0x0b }, // else end
+            { 0x02, i64_type }, i64_const(4), { 0x0c, 0x00 }, i64_const(5), { 0x0b }, // block: br 0 with 4, skipping 5
+            { 0x7c, 0x01 },                                          // add, nop
+        }),
+    });
+
+    DifferentialTest test { description };
+    for (auto value : interesting_values) {
+        for (size_t i = 1; i < 3; ++i)
+            test.call(i, { Wasm::Value(static_cast<i32>(value)) });
+    }
+    // Negative values would take the loop a few billion iterations.
+    for (i32 n : { 0, 1, 2, 3, 10, 44, 45, 46, 100000, NumericLimits<i32>::max() })
+        test.call(0, { Wasm::Value(n) });
+}
+
+TEST_CASE(memory)
+{
+    // Each function stores the second parameter at the address in the first one, loads it back and returns it.
+    // Offsets put some accesses past the end of memory.
+    struct Access {
+        u8 type;
+        u8 store;
+        u8 load;
+        u32 offset;
+    };
+    Array accesses {
+        Access { i32_type, 0x36, 0x28, 0 },      // i32.store, i32.load
+        Access { i32_type, 0x3a, 0x2c, 3 },      // i32.store8, i32.load8_s
+        Access { i32_type, 0x3a, 0x2d, 5 },      // i32.store8, i32.load8_u
+        Access { i32_type, 0x3b, 0x2e, 0 },      // i32.store16, i32.load16_s
+        Access { i32_type, 0x3b, 0x2f, 65535 },  // i32.store16, i32.load16_u
+        Access { i64_type, 0x37, 0x29, 16 },     // i64.store, i64.load
+        Access { i64_type, 0x3c, 0x30, 0 },      // i64.store8, i64.load8_s
+        Access { i64_type, 0x3c, 0x31, 1 },      // i64.store8, i64.load8_u
+        Access { i64_type, 0x3d, 0x32, 0 },      // i64.store16, i64.load16_s
+        Access { i64_type, 0x3d, 0x33, 0 },      // i64.store16, i64.load16_u
+        Access { i64_type, 0x3e, 0x34, 65532 },  // i64.store32, i64.load32_s
+        Access { i64_type, 0x3e, 0x35, 0 },      // i64.store32, i64.load32_u
+    };
+
+    TestModule description;
+    for (auto const& access : accesses) {
+        TestFunction function { { { i32_type, access.type }, { access.type } }, {}, { 0x20, 0x00, 0x20, 0x01, access.store, 0x00 } };
+        append_leb(function.body, access.offset, false);
+        function.body.extend(Vector<u8> { 0x20, 0x00, access.load, 0x00 });
+        append_leb(function.body, access.offset, false);
+        description.functions.append(move(function));
+    }
+    // (param i32) (result i32): grows the memory, and returns the old size combined with the new one.
+    description.functions.append({
+        { { i32_type }, { i32_type } },
+        {},
+        concatenate({ { 0x20, 0x00, 0x40, 0x00 }, i32_const(16), { 0x74, 0x3f, 0x00, 0x72 } }),
+    });
+
+    DifferentialTest test { description };
+    Array addresses { 0, 1, 7, 100, 65528, 65532, 65534, 65535, 65536, 131068, -1, -8, NumericLimits<i32>::max() };
+    for (size_t i = 0; i < accesses.size(); ++i) {
+        for (auto address : addresses) {
+            for (auto value : interesting_values)
+                test.call(i, { Wasm::Value(address), value_of_type(accesses[i].type, value) });
+        }
+    }
+
+    // Growing past the maximum fails, growing by nothing doesn't change anything.
+    auto grow = accesses.size();
+    for (auto pages : { 0, 1, 5, -1, 1, 1 })
+        test.call(grow, { Wasm::Value(pages) });
+
+    // Accesses that were out of bounds before may not be anymore.
+    for (size_t i = 0; i < accesses.size(); ++i) {
+        for (auto address : addresses)
+            test.call(i, { Wasm::Value(address), value_of_type(accesses[i].type, 0x5a5a5a5a5a5a5a5all) });
+    }
+}
+
+TEST_CASE(traps)
+{
+    TestModule description;
+    // (param i32) (result i32): traps with unreachable only if the parameter is non-zero.
+    description.functions.append({
+        { { i32_type }, { i32_type } },
+        {},
+        concatenate({ { 0x20, 0x00, 0x04, 0x40, 0x00, 0x0b }, i32_const(1) }),
+    });
+    // (param i32) (result i32): recurses forever, until the stack runs out.
+    description.functions.append({
+        { { i32_type }, { i32_type } },
+        {},
+        concatenate({ { 0x20, 0x00 }, i32_const(1), { 0x6a, 0x10, 0x01 } }),
+    });
+    // (param i32 i32) (result i32): divides a by a decreasing b until a is zero, so that dividing by zero happens
+    // after some state was changed.
+    description.functions.append({
+        { { i32_type, i32_type }, { i32_type } },
+        {},
+        concatenate({
+            { 0x03, 0x40 },
+            { 0x23, 0x00 }, i32_const(1), { 0x6a, 0x24, 0x00 },     // global0 += 1
+            { 0x20, 0x00, 0x20, 0x01, 0x6d, 0x21, 0x00 },           // a /= b
+            { 0x20, 0x01 }, i32_const(1), { 0x6b, 0x21, 0x01 },     // b -= 1
+            { 0x20, 0x00, 0x0d, 0x00, 0x0b },                       // br_if 0 (a != 0)
+            { 0x20, 0x00 },
+        }),
+    });
+
+    DifferentialTest test { description };
+    test.call(0, { Wasm::Value(0) });
+    test.call(0, { Wasm::Value(1) });
+    // The interpreter and the JIT notice the exhaustion in different places, which gives different trap reasons.
+    test.call(1, { Wasm::Value(0) }, CompareTrapReasons::No);
+    test.call(2, { Wasm::Value(5), Wasm::Value(3) });
+    test.call(2, { Wasm::Value(1000), Wasm::Value(3) });
+    test.call(2, { Wasm::Value(NumericLimits<i32>::min()), Wasm::Value(-1) });
+
+    // Traps must leave nothing behind that would break later calls.
+    test.call(0, { Wasm::Value(0) });
+}
+
+TEST_CASE(calls)
+{
+    TestModule description;
+    // import0: (param i32 i32) (result i32), import1: (param i64) (result i64 i32), import2: (param i32) (result i32)
+    description.imports.append({ { i32_type, i32_type }, { i32_type } });
+    description.imports.append({ { i64_type }, { i64_type, i32_type } });
+    description.imports.append({ { i32_type }, { i32_type } });
+    // f0 (param i32) (result i32): fib(n), calling itself.
+    description.functions.append({
+        { { i32_type }, { i32_type } },
+        {},
+        concatenate({
+            { 0x20, 0x00 }, i32_const(2), { 0x48, 0x04, 0x40, 0x20, 0x00, 0x0f, 0x0b },
+            { 0x20, 0x00 }, i32_const(1), { 0x6b, 0x10, 0x03 },
+            { 0x20, 0x00 }, i32_const(2), { 0x6b, 0x10, 0x03, 0x6a },
+        }),
+    });
+    // f1 (param i32 i32) (result i32): calls the host through import0, with values on the stack below the arguments.
+    description.functions.append({
+        { { i32_type, i32_type }, { i32_type } },
+        {},
+        concatenate({ i32_const(1000), { 0x20, 0x00, 0x20, 0x01, 0x10, 0x00, 0x6a } }),
+    });
+    // f2 (param i64) (result i64): calls import1, which returns several values.
+    description.functions.append({
+        { { i64_type }, { i64_type } },
+        {},
+        { 0x20, 0x00, 0x10, 0x01, 0xad, 0x7d },
+    });
+    // f3 (param i32) (result i32): calls import2, which is wasm from another module, then reads the memory the other
+    // module can't see, and the memory size.
+    description.functions.append({
+        { { i32_type }, { i32_type } },
+        {},
+        concatenate({ { 0x20, 0x00, 0x10, 0x02 }, i32_const(0), { 0x28, 0x02, 0x00, 0x6a, 0x3f, 0x00, 0x6a } }),
+    });
+    // f4 (param i32) (result i32): makes the host grow the memory while it's running, then stores at the end of it.
+    description.functions.append({
+        { { i32_type }, { i32_type } },
+        {},
+        concatenate({
+            { 0x20, 0x00 }, i32_const(0), { 0x10, 0x00, 0x1a },    // import0(n, 0) grows the memory by n pages
+            { 0x3f, 0x00 }, i32_const(16), { 0x74 }, i32_const(4), { 0x6b }, // memory.size * 65536 - 4
+            i32_const(42), { 0x36, 0x02, 0x00 },                    // i32.store
+            { 0x3f, 0x00 },
+        }),
+    });
+
+    // The other module's f0 (param i32) (result i32) multiplies by 3, and traps on zero.
+    TestModule other_description;
+    other_description.functions.append({
+        { { i32_type }, { i32_type } },
+        {},
+        concatenate({ { 0x20, 0x00, 0x45, 0x04, 0x40, 0x00, 0x0b, 0x20, 0x00 }, i32_const(3), { 0x6c } }),
+    });
+    auto other_module = parse_module(encode(other_description));
+    Vector<NonnullOwnPtr<Wasm::ModuleInstance>> other_instances;
+
+    // The memory of the module under test in each machine, for the host to grow while it's being called.
+    Vector<Wasm::MemoryAddress> memories;
+
+    auto provide_imports = [&](Wasm::AbstractMachine& machine) {
+        auto machine_index = other_instances.size();
+        Wasm::ValueType i32_value_type { Wasm::ValueType::I32 };
+        Wasm::ValueType i64_value_type { Wasm::ValueType::I64 };
+
+        // Adds its arguments. Traps if the first one is negative, and grows the memory by that many pages if the
+        // second one is zero.
+        auto add = machine.store().allocate(Wasm::HostFunction {
+            [&memories, machine_index](Wasm::Configuration& configuration, Vector<Wasm::Value>& arguments) -> Wasm::Result {
+                auto lhs = *arguments[0].to<i32>();
+                auto rhs = *arguments[1].to<i32>();
+                if (lhs < 0)
+                    return Wasm::Trap { "Negative"sv };
+                if (rhs == 0)
+                    (void)configuration.store().get(memories[machine_index])->grow(lhs * Wasm::Constants::page_size);
+                return Wasm::Result { Vector { Wasm::Value(lhs + rhs) } };
+            },
+            Wasm::FunctionType { { i32_value_type, i32_value_type }, { i32_value_type } } });
+
+        // Splits an i64 into its upper and lower halves.
+        auto split = machine.store().allocate(Wasm::HostFunction {
+            [](Wasm::Configuration&, Vector<Wasm::Value>& arguments) -> Wasm::Result {
+                auto value = *arguments[0].to<i64>();
+                // Results are handed out in reverse stack order.
+                return Wasm::Result { Vector { Wasm::Value(static_cast<i32>(value)), Wasm::Value(value >> 32) } };
+            },
+            Wasm::FunctionType { { i64_value_type }, { i64_value_type, i32_value_type } } });
+
+        auto other_instance = machine.instantiate(*other_module, {});
+        VERIFY(!other_instance.is_error());
+        auto multiply = find_export(*other_instance.value(), "f0"sv);
+        other_instances.append(other_instance.release_value());
+
+        return Vector<Wasm::ExternValue> { *add, *split, *multiply };
+    };
+
+    DifferentialTest test { description, move(provide_imports) };
+    memories.append(test.interpreter_instance().memories().first());
+    memories.append(test.jit_instance().memories().first());
+
+    for (i32 n = 0; n < 20; ++n)
+        test.call(0, { Wasm::Value(n) });
+    for (auto lhs : { 0, 1, -1, 1000, NumericLimits<i32>::max(), NumericLimits<i32>::min() }) {
+        for (auto rhs : { 1, -1, 7, NumericLimits<i32>::max() })
+            test.call(1, { Wasm::Value(lhs), Wasm::Value(rhs) });
+    }
+    for (auto value : interesting_values) {
+        test.call(2, { Wasm::Value(value) });
+        test.call(3, { Wasm::Value(static_cast<i32>(value)) });
+    }
+    for (auto pages : { 0, 1, 1, 5, -1, 0 })
+        test.call(4, { Wasm::Value(pages) });
+}
@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Matrix4x4.h>
+#include <LibTest/TestCase.h>
+#include <LibWeb/Painting/PaintingCommandExecutorCPU.h>
+#include <LibWeb/Painting/RecordingPainter.h>
+#include <LibWeb/Painting/TiledPainter.h>
+
+using Web::Painting::RecordingPainter;
+
+static Web::Painting::StackingContextTransform translation(int x, int y)
+{
+    return { .origin = {}, .matrix = Gfx::translation_matrix(Gfx::Vector3<float>(x, y, 0)) };
+}
+
+// Records something resembling a long page: lots of boxes, some with rounded corners, clipped areas,
+// translucent and translated stacking contexts, and a fixed position header.
+static void record_page(RecordingPainter& painter, Gfx::IntSize size)
+{
+    u32 seed = 1;
+    auto next_random = [&](u32 limit) {
+        seed = seed * 1103515245 + 12345;
+        return static_cast<int>((seed >> 8) % limit);
+    };
+    auto random_color = [&] {
+        return Color(next_random(256), next_random(256), next_random(256));
+    };
+
+    painter.fill_rect({ {}, size }, Color::White);
+    for (int i = 0; i < 2000; ++i) {
+        Gfx::IntRect rect { next_random(size.width()), next_random(size.height()), 10 + next_random(200), 10 + next_random(100) };
+        switch (i % 5) {
+        case 0:
+            painter.fill_rect(rect, random_color());
+            break;
+        case 1:
+            painter.fill_rect_with_rounded_corners(rect, random_color(), 8);
+            break;
+        case 2:
+            painter.fill_ellipse(rect, random_color());
+            break;
+        case 3:
+            painter.draw_line(rect.top_left(), rect.bottom_right(), random_color(), 3);
+            break;
+        case 4:
+            painter.save();
+            painter.add_clip_rect(rect);
+            painter.fill_rect(rect.inflated(40, 40), random_color());
+            painter.restore();
+            break;
+        }
+
+        if (i % 100 == 50) {
+            painter.push_stacking_context({
+                .opacity = 0.5f,
+                .is_fixed_position = false,
+                .source_paintable_rect = rect.inflated(100, 100),
+                .image_rendering = Web::CSS::ImageRendering::Auto,
+                .transform = translation(30, 20),
+            });
+            painter.fill_rect(rect, random_color());
+            painter.fill_rect_with_rounded_corners(rect.translated(20, 20), random_color(), 12);
+            painter.pop_stacking_context();
+        }
+    }
+
+    painter.push_stacking_context({
+        .opacity = 1.0f,
+        .is_fixed_position = true,
+        .source_paintable_rect = { 0, 0, size.width(), 60 },
+        .image_rendering = Web::CSS::ImageRendering::Auto,
+        .transform = translation(0, 0),
+    });
+    painter.fill_rect({ 0, 0, size.width(), 60 }, Color::DarkBlue);
+    painter.pop_stacking_context();
+}
+
+static NonnullRefPtr<Gfx::Bitmap> paint_serially(RecordingPainter& painter, Gfx::IntSize size)
+{
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, size));
+    Web::Painting::PaintingCommandExecutorCPU executor { *bitmap };
+    painter.execute(executor);
+    return bitmap;
+}
+
+static NonnullRefPtr<Gfx::Bitmap> paint_in_tiles(RecordingPainter& painter, Gfx::IntSize size, size_t thread_count)
+{
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, size));
+    Web::Painting::TiledPainter::the().set_thread_count(thread_count);
+    Web::Painting::TiledPainter::the().execute(painter, *bitmap);
+    return bitmap;
+}
+
+static size_t count_differing_pixels(Gfx::Bitmap const& a, Gfx::Bitmap const& b)
+{
+    size_t differing_pixels = 0;
+    for (int y = 0; y < a.height(); ++y) {
+        for (int x = 0; x < a.width(); ++x) {
+            if (a.get_pixel(x, y) != b.get_pixel(x, y))
+                ++differing_pixels;
+        }
+    }
+    return differing_pixels;
+}
+
+TEST_CASE(tiles_match_serial_painting)
+{
+    // Deliberately not a multiple of the tile size.
+    Gfx::IntSize size { 1000, 700 };
+    RecordingPainter painter;
+    record_page(painter, size);
+    EXPECT(painter.can_execute_in_tiles());
+
+    auto expected = paint_serially(painter, size);
+    for (size_t thread_count : { 1, 2, 3, 4 }) {
+        auto actual = paint_in_tiles(painter, size, thread_count);
+        EXPECT_EQ(count_differing_pixels(expected, actual), 0u);
+    }
+}
+
+TEST_CASE(commands_are_binned_by_bounding_rect)
+{
+    RecordingPainter painter;
+    painter.fill_rect({ 10, 10, 20, 20 }, Color::Red);
+    painter.fill_rect({ 250, 10, 20, 20 }, Color::Green);
+    painter.push_stacking_context({
+        .opacity = 1.0f,
+        .is_fixed_position = false,
+        .source_paintable_rect = { 0, 0, 20, 20 },
+        .image_rendering = Web::CSS::ImageRendering::Auto,
+        .transform = translation(300, 0),
+    });
+    painter.fill_rect({ 0, 0, 20, 20 }, Color::Blue);
+    painter.pop_stacking_context();
+
+    Vector<Gfx::IntRect> tiles { { 0, 0, 256, 256 }, { 256, 0, 256, 256 } };
+    auto command_indices_per_tile = painter.bin_commands_into_tiles(tiles);
+    EXPECT_EQ(command_indices_per_tile[0], (Vector<size_t> { 0, 1, 2, 4 }));
+    EXPECT_EQ(command_indices_per_tile[1], (Vector<size_t> { 1, 2, 3, 4 }));
+}
+
+TEST_CASE(rotated_stacking_contexts_are_painted_serially)
+{
+    RecordingPainter painter;
+    painter.push_stacking_context({
+        .opacity = 1.0f,
+        .is_fixed_position = false,
+        .source_paintable_rect = { 0, 0, 100, 100 },
+        .image_rendering = Web::CSS::ImageRendering::Auto,
+        .transform = { .origin = {}, .matrix = Gfx::rotation_matrix(Gfx::Vector3<float>(0, 0, 1), 0.5f) },
+    });
+    painter.fill_rect({ 0, 0, 100, 100 }, Color::Red);
+    painter.pop_stacking_context();
+    EXPECT(!painter.can_execute_in_tiles());
+}
+
+TEST_CASE(damaged_rect_matches_full_repaint)
+{
+    Gfx::IntSize size { 1000, 700 };
+    Gfx::IntRect changed_rect { 300, 200, 120, 40 };
+
+    RecordingPainter painter;
+    record_page(painter, size);
+    auto bitmap = paint_serially(painter, size);
+
+    RecordingPainter changed_painter;
+    record_page(changed_painter, size);
+    changed_painter.fill_rect(changed_rect, Color::Magenta);
+    auto expected = paint_serially(changed_painter, size);
+
+    for (size_t thread_count : { 1, 4 }) {
+        auto actual = MUST(bitmap->clone());
+        Web::Painting::TiledPainter::the().set_thread_count(thread_count);
+        Web::Painting::TiledPainter::the().execute(changed_painter, *actual, changed_rect);
+        EXPECT_EQ(count_differing_pixels(expected, actual), 0u);
+    }
+}
+
+TEST_CASE(appended_commands_get_new_corner_clipper_ids)
+{
+    RecordingPainter recorded_painter;
+    recorded_painter.sample_under_corners(0, {}, { 0, 0, 10, 10 }, Web::Painting::CornerClip::Outside);
+    recorded_painter.fill_rect({ 0, 0, 10, 10 }, Color::Red);
+    recorded_painter.blit_corner_clipping(0, { 0, 0, 10, 10 });
+    auto commands = recorded_painter.copy_commands_since(1);
+    EXPECT_EQ(commands.size(), 2u);
+
+    RecordingPainter painter;
+    painter.sample_under_corners(0, {}, { 0, 0, 10, 10 }, Web::Painting::CornerClip::Outside);
+    painter.append_commands(commands, [](u32 id) { return id + 1; });
+    painter.blit_corner_clipping(0, { 0, 0, 10, 10 });
+    EXPECT_EQ(painter.command_count(), 4u);
+
+    auto appended_commands = painter.copy_commands_since(1);
+    EXPECT(appended_commands[0].command.has<Web::Painting::FillRect>());
+    EXPECT_EQ(appended_commands[1].command.get<Web::Painting::BlitCornerClipping>().id, 1u);
+    EXPECT_EQ(appended_commands[2].command.get<Web::Painting::BlitCornerClipping>().id, 0u);
+}
+
+static void benchmark_full_page_repaint(size_t thread_count)
+{
+    Gfx::IntSize size { 1920, 1080 };
+    RecordingPainter painter;
+    record_page(painter, size);
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, size));
+    Web::Painting::TiledPainter::the().set_thread_count(thread_count);
+    for (size_t i = 0; i < 50; ++i)
+        Web::Painting::TiledPainter::the().execute(painter, *bitmap);
+}
+
+BENCHMARK_CASE(full_page_repaint_1_thread)
+{
+    benchmark_full_page_repaint(1);
+}
+
+BENCHMARK_CASE(full_page_repaint_2_threads)
+{
+    benchmark_full_page_repaint(2);
+}
+
+BENCHMARK_CASE(full_page_repaint_4_threads)
+{
+    benchmark_full_page_repaint(4);
+}
+
+BENCHMARK_CASE(full_page_repaint_8_threads)
+{
+    benchmark_full_page_repaint(8);
+}
+
+BENCHMARK_CASE(caret_sized_repaint)
+{
+    Gfx::IntSize size { 1920, 1080 };
+    RecordingPainter painter;
+    record_page(painter, size);
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, size));
+    Web::Painting::TiledPainter::the().set_thread_count(1);
+    for (size_t i = 0; i < 50; ++i)
+        Web::Painting::TiledPainter::the().execute(painter, *bitmap, { 700, 500, 2, 20 });
+}
@@ -7,6 +7,7 @@
 
 #include <LibArchive/Zip.h>
 #include <LibCompress/Deflate.h>
+#include <LibCompress/ParallelDeflate.h>
 #include <LibCrypto/Checksum/CRC32.h>
 
 namespace Archive {
@@ -122,8 +123,9 @@ ErrorOr<Statistics> Zip::calculate_statistics() const
     return Statistics(file_count, directory_count, uncompressed_bytes);
 }
 
-ZipOutputStream::ZipOutputStream(NonnullOwnPtr<Stream> stream)
+ZipOutputStream::ZipOutputStream(NonnullOwnPtr<Stream> stream, size_t compression_thread_count)
     : m_stream(move(stream))
+    , m_compression_thread_count(compression_thread_count)
 {
 }
 
@@ -170,7 +172,9 @@ ErrorOr<ZipOutputStream::MemberInformation> ZipOutputStream::add_member_from_str
         member.modification_time = to_packed_dos_time(modification_time->hour(), modification_time->minute(), modification_time->second());
     }
 
-    auto deflate_buffer = Compress::DeflateCompressor::compress_all(buffer);
+    auto deflate_buffer = m_compression_thread_count > 1
+        ? Compress::ParallelDeflateCompressor::compress_all(buffer, m_compression_thread_count)
+        : Compress::DeflateCompressor::compress_all(buffer);
     auto compression_ratio = 1.f;
     auto compressed_size = buffer.size();
 
@@ -371,22 +371,543 @@ void DeflateDecompressor::close()
 {
 }
 
-ErrorOr<ByteBuffer> DeflateDecompressor::decompress_all(ReadonlyBytes bytes)
+// Decodes DEFLATE streams that are completely held in memory. This avoids most of the overhead of the streaming
+// decompressor: up to 64 bits of input are kept in a register, symbols are decoded through two-level lookup tables,
+// and the output is written straight into its final destination, which also serves as the window for back-references.
+class InMemoryInflater {
+public:
+    InMemoryInflater(ReadonlyBytes input, Bytes output)
+        : m_input(input.data())
+        , m_input_start(input.data())
+        , m_input_end(input.data() + input.size())
+        , m_output(output.data())
+        , m_output_start(output.data())
+        , m_output_end(output.data() + output.size())
+    {
+    }
+
+    InMemoryInflater(ReadonlyBytes input, ByteBuffer& output)
+        : InMemoryInflater(input, Bytes {})
+    {
+        m_growable_output = &output;
+        m_growable_output_start_offset = output.size();
+        m_output_start = m_output = output.data() + output.size();
+        m_output_end = m_output;
+    }
+
+    ErrorOr<void> inflate();
+
+    size_t input_size() const { return m_input_size; }
+    size_t output_size() const { return m_output - m_output_start; }
+
+private:
+    struct TableEntry {
+        enum Kind : u8 {
+            Invalid = 0,
+            Literal = 1 << 4,
+            LengthOrDistance = 2 << 4,
+            EndOfBlock = 3 << 4,
+            Subtable = 4 << 4,
+        };
+
+        Kind kind() const { return static_cast<Kind>(kind_and_extra_bits & 0xf0); }
+        u8 extra_bits() const { return kind_and_extra_bits & 0x0f; }
+
+        u16 value { 0 };                    // The literal, the base length or distance, or the index of the subtable.
+        u8 code_length { 0 };               // The number of bits taken up by the code.
+        u8 kind_and_extra_bits { Invalid }; // The number of extra bits, or the number of bits indexing the subtable.
+    };
+    static_assert(sizeof(TableEntry) == 4);
+
+    // Literals and lengths are decoded with a 10-bit primary table, distances and code lengths with an 8-bit one.
+    // Longer codes continue into subtables.
+    static constexpr u8 literal_table_bits = 10;
+    static constexpr u8 distance_table_bits = 8;
+    static constexpr u8 code_length_table_bits = 7;
+
+    using Table = Vector<TableEntry, (1 << literal_table_bits)>;
+
+    static ErrorOr<void> build_table(Table&, u8 primary_bits, ReadonlyBytes code_lengths, TableEntry (*entry_for_symbol)(size_t symbol));
+    static TableEntry literal_entry_for_symbol(size_t symbol);
+    static TableEntry distance_entry_for_symbol(size_t symbol);
+    static TableEntry code_length_entry_for_symbol(size_t symbol);
+    static Table const& fixed_literal_table();
+    static Table const& fixed_distance_table();
+
+    ErrorOr<void> read_dynamic_tables();
+    ErrorOr<void> inflate_stored_block();
+    ErrorOr<void> inflate_compressed_block(Table const& literal_table, Table const& distance_table);
+
+    // Makes sure that at least 56 bits are available, padding the input with zeroes once it runs out. Returns false
+    // if the decoder has wandered too far past the end of the input.
+    ALWAYS_INLINE bool refill()
+    {
+        if (m_input_end - m_input >= 8) [[likely]] {
+            u64 word;
+            __builtin_memcpy(&word, m_input, sizeof(word));
+            m_bit_buffer |= AK::convert_between_host_and_little_endian(word) << m_bit_count;
+            m_input += (63 - m_bit_count) / 8;
+            m_bit_count |= 56;
+            return true;
+        }
+        return refill_slowly();
+    }
+    bool refill_slowly();
+
+    ALWAYS_INLINE u32 peek_bits(u8 count) const { return m_bit_buffer & ((1ull << count) - 1); }
+    ALWAYS_INLINE void discard_bits(u8 count)
+    {
+        m_bit_buffer >>= count;
+        m_bit_count -= count;
+    }
+    ALWAYS_INLINE u32 read_bits(u8 count)
+    {
+        auto bits = peek_bits(count);
+        discard_bits(count);
+        return bits;
+    }
+
+    ALWAYS_INLINE static TableEntry lookup(TableEntry const* table, u8 primary_bits, u64 bit_buffer)
+    {
+        auto entry = table[bit_buffer & ((1u << primary_bits) - 1)];
+        if (entry.kind() == TableEntry::Subtable) [[unlikely]]
+            entry = table[entry.value + ((bit_buffer >> primary_bits) & ((1u << entry.extra_bits()) - 1))];
+        return entry;
+    }
+
+    // Gives back the whole bytes that are still in the bit buffer, after dropping the bits of a partially read one.
+    ErrorOr<void> return_unread_bytes_to_input();
+
+    ALWAYS_INLINE ErrorOr<void> reserve_output(size_t size)
+    {
+        if (static_cast<size_t>(m_output_end - m_output) >= size) [[likely]]
+            return {};
+        return grow_output(size);
+    }
+    ErrorOr<void> grow_output(size_t size);
+
+    u8 const* m_input { nullptr };
+    u8 const* m_input_start { nullptr };
+    u8 const* m_input_end { nullptr };
+    u64 m_bit_buffer { 0 };
+    u8 m_bit_count { 0 };
+    u8 m_padding_bytes { 0 };
+    size_t m_input_size { 0 };
+
+    u8* m_output { nullptr };
+    u8* m_output_start { nullptr };
+    u8* m_output_end { nullptr };
+    ByteBuffer* m_growable_output { nullptr };
+    size_t m_growable_output_start_offset { 0 };
+
+    Table m_literal_table;
+    Table m_distance_table;
+};
+
+bool InMemoryInflater::refill_slowly()
+{
+    while (m_bit_count <= 56) {
+        if (m_input < m_input_end) {
+            m_bit_buffer |= static_cast<u64>(*m_input++) << m_bit_count;
+        } else {
+            // Reading a few bytes past the end is harmless as long as none of them end up being used, which is
+            // checked once the stream is complete.
+            if (m_padding_bytes == 16)
+                return false;
+            ++m_padding_bytes;
+        }
+        m_bit_count += 8;
+    }
+    return true;
+}
+
+ErrorOr<void> InMemoryInflater::return_unread_bytes_to_input()
+{
+    discard_bits(m_bit_count % 8);
+    if (m_bit_count / 8 < m_padding_bytes)
+        return Error::from_string_literal("Unexpected end of DEFLATE data");
+    m_input -= m_bit_count / 8 - m_padding_bytes;
+    m_bit_buffer = 0;
+    m_bit_count = 0;
+    m_padding_bytes = 0;
+    return {};
+}
+
+ErrorOr<void> InMemoryInflater::grow_output(size_t size)
+{
+    if (!m_growable_output)
+        return Error::from_string_literal("Decompressed data does not fit in the output buffer");
+
+    auto& buffer = *m_growable_output;
+    auto const output_offset = m_output - buffer.data();
+    TRY(buffer.try_resize(max(max(buffer.size() * 2, output_offset + size), 4 * KiB)));
+
+    m_output_start = buffer.data() + m_growable_output_start_offset;
+    m_output = buffer.data() + output_offset;
+    m_output_end = buffer.data() + buffer.size();
+    return {};
+}
+
+ErrorOr<void> InMemoryInflater::build_table(Table& table, u8 primary_bits, ReadonlyBytes code_lengths, TableEntry (*entry_for_symbol)(size_t symbol))
+{
+    Array<u16, 16> length_counts {};
+    size_t non_zero_symbols = 0;
+    size_t last_non_zero = 0;
+    for (size_t symbol = 0; symbol < code_lengths.size(); ++symbol) {
+        if (code_lengths[symbol] == 0)
+            continue;
+        if (code_lengths[symbol] > 15)
+            return Error::from_string_literal("Failed to decode code lengths");
+        ++length_counts[code_lengths[symbol]];
+        ++non_zero_symbols;
+        last_non_zero = symbol;
+    }
+
+    table.clear_with_capacity();
+    TRY(table.try_resize(1 << primary_bits));
+
+    if (non_zero_symbols == 1) {
+        // Like CanonicalCode, a lone symbol is encoded as a single bit of either value.
+        auto entry = entry_for_symbol(last_non_zero);
+        entry.code_length = 1;
+        for (auto& table_entry : table)
+            table_entry = entry;
+        return {};
+    }
+
+    // The code has to be complete, which also rejects codes without any symbols.
+    i32 unused_codes = 1;
+    for (size_t length = 1; length <= 15; ++length) {
+        unused_codes = (unused_codes << 1) - length_counts[length];
+        if (unused_codes < 0)
+            return Error::from_string_literal("Failed to decode code lengths");
+    }
+    if (unused_codes != 0)
+        return Error::from_string_literal("Failed to decode code lengths");
+
+    Array<u16, 16> next_code {};
+    u16 code = 0;
+    for (size_t length = 1; length <= 15; ++length) {
+        code = (code + length_counts[length - 1]) << 1;
+        next_code[length] = code;
+    }
+
+    // DEFLATE stores codes starting from their most significant bit, so the tables are indexed by reversed codes.
+    Vector<u16, 320> reversed_codes;
+    TRY(reversed_codes.try_resize(code_lengths.size()));
+    Array<u8, 1 << literal_table_bits> subtable_bits {};
+    u32 const primary_mask = (1u << primary_bits) - 1;
+    for (size_t symbol = 0; symbol < code_lengths.size(); ++symbol) {
+        auto const length = code_lengths[symbol];
+        if (length == 0)
+            continue;
+        reversed_codes[symbol] = fast_reverse16(next_code[length]++, length);
+        if (length > primary_bits) {
+            auto& bits = subtable_bits[reversed_codes[symbol] & primary_mask];
+            bits = max<u8>(bits, length - primary_bits);
+        }
+    }
+
+    for (u32 prefix = 0; prefix <= primary_mask; ++prefix) {
+        if (subtable_bits[prefix] == 0)
+            continue;
+        table[prefix] = TableEntry { static_cast<u16>(table.size()), primary_bits, static_cast<u8>(TableEntry::Subtable | subtable_bits[prefix]) };
+        TRY(table.try_resize(table.size() + (1 << subtable_bits[prefix])));
+    }
+
+    for (size_t symbol = 0; symbol < code_lengths.size(); ++symbol) {
+        auto const length = code_lengths[symbol];
+        if (length == 0)
+            continue;
+
+        auto entry = entry_for_symbol(symbol);
+        entry.code_length = length;
+        auto const reversed_code = reversed_codes[symbol];
+
+        // Every index that starts with the code gets the entry.
+        if (length <= primary_bits) {
+            for (u32 index = reversed_code; index <= primary_mask; index += 1u << length)
+                table[index] = entry;
+        } else {
+            auto const subtable = table[reversed_code & primary_mask];
+            for (u32 index = reversed_code >> primary_bits; index < (1u << subtable.extra_bits()); index += 1u << (length - primary_bits))
+                table[subtable.value + index] = entry;
+        }
+    }
+
+    return {};
+}
+
+InMemoryInflater::TableEntry InMemoryInflater::literal_entry_for_symbol(size_t symbol)
+{
+    if (symbol < 256)
+        return { static_cast<u16>(symbol), 0, TableEntry::Literal };
+    if (symbol == 256)
+        return { 0, 0, TableEntry::EndOfBlock };
+    if (symbol < 286) {
+        auto const& length = packed_length_symbols[symbol - 257];
+        return { length.base_length, 0, static_cast<u8>(TableEntry::LengthOrDistance | length.extra_bits) };
+    }
+    return { 0, 0, TableEntry::Invalid };
+}
+
+InMemoryInflater::TableEntry InMemoryInflater::distance_entry_for_symbol(size_t symbol)
+{
+    if (symbol < 30) {
+        auto const& distance = packed_distances[symbol];
+        return { distance.base_distance, 0, static_cast<u8>(TableEntry::LengthOrDistance | distance.extra_bits) };
+    }
+    return { 0, 0, TableEntry::Invalid };
+}
+
+InMemoryInflater::TableEntry InMemoryInflater::code_length_entry_for_symbol(size_t symbol)
+{
+    return { static_cast<u16>(symbol), 0, TableEntry::Literal };
+}
+
+InMemoryInflater::Table const& InMemoryInflater::fixed_literal_table()
+{
+    static Table const table = [] {
+        Table table;
+        MUST(build_table(table, literal_table_bits, fixed_literal_bit_lengths, literal_entry_for_symbol));
+        return table;
+    }();
+    return table;
+}
+
+InMemoryInflater::Table const& InMemoryInflater::fixed_distance_table()
+{
+    static Table const table = [] {
+        Table table;
+        MUST(build_table(table, distance_table_bits, fixed_distance_bit_lengths, distance_entry_for_symbol));
+        return table;
+    }();
+    return table;
+}
+
+ErrorOr<void> InMemoryInflater::read_dynamic_tables()
 {
-    FixedMemoryStream memory_stream { bytes };
-    LittleEndianInputBitStream bit_stream { MaybeOwned<Stream>(memory_stream) };
-    auto deflate_stream = TRY(DeflateDecompressor::construct(MaybeOwned<LittleEndianInputBitStream>(bit_stream)));
-    AllocatingMemoryStream output_stream;
-
-    auto buffer = TRY(ByteBuffer::create_uninitialized(4096));
-    while (!deflate_stream->is_eof()) {
-        auto const slice = TRY(deflate_stream->read_some(buffer));
-        TRY(output_stream.write_until_depleted(slice));
+    if (!refill())
+        return Error::from_string_literal("Unexpected end of DEFLATE data");
+
+    auto const literal_code_count = read_bits(5) + 257;
+    auto const distance_code_count = read_bits(5) + 1;
+    auto const code_length_count = read_bits(4) + 4;
+
+    Array<u8, 19> code_lengths_code_lengths {};
+    for (size_t i = 0; i < code_length_count; ++i) {
+        if (!refill())
+            return Error::from_string_literal("Unexpected end of DEFLATE data");
+        code_lengths_code_lengths[code_lengths_code_lengths_order[i]] = read_bits(3);
+    }
+
+    Table code_length_table;
+    TRY(build_table(code_length_table, code_length_table_bits, code_lengths_code_lengths, code_length_entry_for_symbol));
+
+    Array<u8, 288 + 32> code_lengths;
+    size_t code_lengths_size = 0;
+    while (code_lengths_size < literal_code_count + distance_code_count) {
+        if (!refill())
+            return Error::from_string_literal("Unexpected end of DEFLATE data");
+
+        auto const entry = lookup(code_length_table.data(), code_length_table_bits, m_bit_buffer);
+        discard_bits(entry.code_length);
+        auto const symbol = entry.value;
+
+        u8 repeated_length = 0;
+        size_t repeat_count = 0;
+        if (symbol < deflate_special_code_length_copy) {
+            code_lengths[code_lengths_size++] = symbol;
+            continue;
+        } else if (symbol == deflate_special_code_length_copy) {
+            if (code_lengths_size == 0)
+                return Error::from_string_literal("Found no codes to copy before a copy block");
+            repeated_length = code_lengths[code_lengths_size - 1];
+            repeat_count = 3 + read_bits(2);
+        } else if (symbol == deflate_special_code_length_zeros) {
+            repeat_count = 3 + read_bits(3);
+        } else {
+            VERIFY(symbol == deflate_special_code_length_long_zeros);
+            repeat_count = 11 + read_bits(7);
+        }
+
+        if (code_lengths_size + repeat_count > literal_code_count + distance_code_count)
+            return Error::from_string_literal("Number of code lengths does not match the sum of codes");
+        for (size_t i = 0; i < repeat_count; ++i)
+            code_lengths[code_lengths_size++] = repeated_length;
     }
 
-    auto output_buffer = TRY(ByteBuffer::create_uninitialized(output_stream.used_buffer_size()));
-    TRY(output_stream.read_until_filled(output_buffer));
-    return output_buffer;
+    auto const code_lengths_span = ReadonlyBytes { code_lengths.data(), code_lengths_size };
+    TRY(build_table(m_literal_table, literal_table_bits, code_lengths_span.trim(literal_code_count), literal_entry_for_symbol));
+
+    // A single unused distance code means that the block only contains literals.
+    auto const distance_code_lengths = code_lengths_span.slice(literal_code_count);
+    if (distance_code_count == 1 && distance_code_lengths[0] == 0) {
+        m_distance_table.clear_with_capacity();
+        TRY(m_distance_table.try_resize(1 << distance_table_bits));
+        return {};
+    }
+    if (distance_code_count == 1 && distance_code_lengths[0] != 1)
+        return Error::from_string_literal("Length for a single distance code is longer than 1");
+
+    TRY(build_table(m_distance_table, distance_table_bits, distance_code_lengths, distance_entry_for_symbol));
+    return {};
+}
+
+ErrorOr<void> InMemoryInflater::inflate_stored_block()
+{
+    TRY(return_unread_bytes_to_input());
+
+    if (m_input_end - m_input < 4)
+        return Error::from_string_literal("Unexpected end of DEFLATE data");
+    u16 const length = m_input[0] | (m_input[1] << 8);
+    u16 const negated_length = m_input[2] | (m_input[3] << 8);
+    m_input += 4;
+
+    if ((length ^ 0xffff) != negated_length)
+        return Error::from_string_literal("Calculated negated length does not equal stored negated length");
+    if (static_cast<size_t>(m_input_end - m_input) < length)
+        return Error::from_string_literal("Input data ends in the middle of an uncompressed DEFLATE block");
+
+    TRY(reserve_output(length));
+    __builtin_memcpy(m_output, m_input, length);
+    m_output += length;
+    m_input += length;
+    return {};
+}
+
+ErrorOr<void> InMemoryInflater::inflate_compressed_block(Table const& literal_table, Table const& distance_table)
+{
+    auto const* literals = literal_table.data();
+    auto const* distances = distance_table.data();
+
+    while (true) {
+        // A length code with its extra bits, followed by a distance code with its extra bits, takes at most 48 bits.
+        if (!refill()) [[unlikely]]
+            return Error::from_string_literal("Unexpected end of DEFLATE data");
+
+        auto entry = lookup(literals, literal_table_bits, m_bit_buffer);
+        if (entry.kind() == TableEntry::Literal) {
+            TRY(reserve_output(1));
+            discard_bits(entry.code_length);
+            *m_output++ = entry.value;
+
+            // Literals take at most 15 bits, so two more of them can be decoded without refilling.
+            if (m_output_end - m_output >= 2) {
+                entry = lookup(literals, literal_table_bits, m_bit_buffer);
+                if (entry.kind() != TableEntry::Literal)
+                    continue;
+                discard_bits(entry.code_length);
+                *m_output++ = entry.value;
+
+                entry = lookup(literals, literal_table_bits, m_bit_buffer);
+                if (entry.kind() != TableEntry::Literal)
+                    continue;
+                discard_bits(entry.code_length);
+                *m_output++ = entry.value;
+            }
+            continue;
+        }
+
+        if (entry.kind() == TableEntry::EndOfBlock) {
+            discard_bits(entry.code_length);
+            return {};
+        }
+
+        if (entry.kind() != TableEntry::LengthOrDistance)
+            return Error::from_string_literal("Invalid deflate literal/length symbol");
+
+        discard_bits(entry.code_length);
+        size_t const length = entry.value + read_bits(entry.extra_bits());
+
+        entry = lookup(distances, distance_table_bits, m_bit_buffer);
+        if (entry.kind() != TableEntry::LengthOrDistance) {
+            if (entry.code_length == 0)
+                return Error::from_string_literal("Distance codes have not been initialized");
+            return Error::from_string_literal("Invalid deflate distance symbol");
+        }
+        discard_bits(entry.code_length);
+        size_t const distance = entry.value + read_bits(entry.extra_bits());
+
+        if (distance > static_cast<size_t>(m_output - m_output_start))
+            return Error::from_string_literal("Back-reference distance is beyond the start of the output");
+
+        TRY(reserve_output(length));
+        auto* destination = m_output;
+        auto const* source = m_output - distance;
+        m_output += length;
+
+        if (distance >= 8 && static_cast<size_t>(m_output_end - destination) >= length + 8) {
+            // Copy eight bytes at a time, which may write a few bytes past the end of the match.
+            do {
+                __builtin_memcpy(destination, source, 8);
+                destination += 8;
+                source += 8;
+            } while (destination < m_output);
+        } else if (distance == 1) {
+            __builtin_memset(destination, *source, length);
+        } else {
+            for (size_t i = 0; i < length; ++i)
+                destination[i] = source[i];
+        }
+    }
+}
+
+ErrorOr<void> InMemoryInflater::inflate()
+{
+    if (m_growable_output)
+        TRY(grow_output(min<size_t>(m_input_end - m_input, 1 * MiB) * 4));
+
+    bool is_final_block = false;
+    while (!is_final_block) {
+        if (!refill())
+            return Error::from_string_literal("Unexpected end of DEFLATE data");
+
+        is_final_block = read_bits(1);
+        auto const block_type = read_bits(2);
+
+        if (block_type == 0b00) {
+            TRY(inflate_stored_block());
+        } else if (block_type == 0b01) {
+            TRY(inflate_compressed_block(fixed_literal_table(), fixed_distance_table()));
+        } else if (block_type == 0b10) {
+            TRY(read_dynamic_tables());
+            TRY(inflate_compressed_block(m_literal_table, m_distance_table));
+        } else {
+            return Error::from_string_literal("Unhandled block type for Idle state");
+        }
+
+        if (m_padding_bytes * 8 > m_bit_count)
+            return Error::from_string_literal("Unexpected end of DEFLATE data");
+    }
+
+    TRY(return_unread_bytes_to_input());
+    m_input_size = m_input - m_input_start;
+
+    if (m_growable_output)
+        m_growable_output->resize(m_output - m_growable_output->data());
+    return {};
+}
+
+ErrorOr<ByteBuffer> DeflateDecompressor::decompress_all(ReadonlyBytes bytes)
+{
+    ByteBuffer output;
+    TRY(decompress_all_into(bytes, output));
+    return output;
+}
+
+ErrorOr<size_t> DeflateDecompressor::decompress_all_into(ReadonlyBytes bytes, ByteBuffer& output)
+{
+    InMemoryInflater inflater { bytes, output };
+    TRY(inflater.inflate());
+    return inflater.input_size();
+}
+
+ErrorOr<size_t> DeflateDecompressor::decompress_into(ReadonlyBytes bytes, Bytes output)
+{
+    InMemoryInflater inflater { bytes, output };
+    TRY(inflater.inflate());
+    return inflater.output_size();
 }
 
 ErrorOr<u32> DeflateDecompressor::decode_length(u32 symbol)
@@ -505,7 +1026,7 @@ DeflateCompressor::DeflateCompressor(NonnullOwnPtr<LittleEndianOutputBitStream>
 
 DeflateCompressor::~DeflateCompressor()
 {
-    VERIFY(m_finished);
+    VERIFY(m_finished || m_synced);
 }
 
 ErrorOr<Bytes> DeflateCompressor::read_some(Bytes)
@@ -517,6 +1038,9 @@ ErrorOr<size_t> DeflateCompressor::write_some(ReadonlyBytes bytes)
 {
     VERIFY(!m_finished);
 
+    if (!bytes.is_empty())
+        m_synced = false;
+
     size_t total_written = 0;
     while (!bytes.is_empty()) {
         auto n_written = bytes.copy_trimmed_to(pending_block().slice(m_pending_block_size));
@@ -592,7 +1116,7 @@ size_t DeflateCompressor::find_back_match(size_t start, u16 hash, size_t previou
             break; // no remaining candidates
 
         VERIFY(candidate < start);
-        if (start - candidate > window_size)
+        if (start - candidate > max_distance)
             break; // outside the window
 
         auto match_length = compare_match_candidate(start, candidate, previous_match_length, maximum_match_length);
@@ -702,6 +1226,10 @@ void DeflateCompressor::lz77_compress_block()
         m_hash_head[hash] = window_pos;
     };
 
+    // make the end of the previous block (or the dictionary) available to back references
+    for (auto position = block_size - m_history_size; position < block_size; position++)
+        insert_hash(position, hash_sequence(&m_rolling_window[position]));
+
     auto emit_literal = [&](auto literal) {
         VERIFY(m_pending_symbol_size <= block_size + 1);
         auto index = m_pending_symbol_size++;
@@ -1037,13 +1565,16 @@ ErrorOr<void> DeflateCompressor::flush()
     if (m_finished)
         TRY(m_output_stream->align_to_byte_boundary());
 
+    // move the end of this block in front of the next one, so it can be referenced from there
+    auto new_history_size = min(m_history_size + m_pending_block_size, block_size);
+    memmove(m_rolling_window + block_size - new_history_size, m_rolling_window + block_size + m_pending_block_size - new_history_size, new_history_size);
+    m_history_size = new_history_size;
+
     // reset all block specific members
     m_pending_block_size = 0;
     m_pending_symbol_size = 0;
     m_symbol_frequencies.fill(0);
     m_distance_frequencies.fill(0);
-    // On the final block this copy will potentially produce an invalid search window, but since its the final block we dont care
-    pending_block().copy_trimmed_to({ m_rolling_window, block_size });
 
     return {};
 }
@@ -1057,6 +1588,32 @@ ErrorOr<void> DeflateCompressor::final_flush()
     return {};
 }
 
+void DeflateCompressor::set_dictionary(ReadonlyBytes dictionary)
+{
+    VERIFY(m_pending_block_size == 0 && m_history_size == 0);
+
+    m_history_size = min(dictionary.size(), block_size);
+    dictionary.slice(dictionary.size() - m_history_size).copy_to({ m_rolling_window + block_size - m_history_size, m_history_size });
+}
+
+ErrorOr<void> DeflateCompressor::sync_flush()
+{
+    VERIFY(!m_finished);
+
+    if (m_pending_block_size != 0)
+        TRY(flush());
+
+    // an empty uncompressed block takes us to the next byte boundary
+    TRY(m_output_stream->write_bits(0b000u, 3)); // not final, no compression
+    TRY(m_output_stream->align_to_byte_boundary());
+    TRY(m_output_stream->write_value<LittleEndian<u16>>(0));
+    TRY(m_output_stream->write_value<LittleEndian<u16>>(0xFFFF));
+    TRY(m_output_stream->flush_buffer_to_stream());
+
+    m_synced = true;
+    return {};
+}
+
 ErrorOr<ByteBuffer> DeflateCompressor::compress_all(ReadonlyBytes bytes, CompressionLevel compression_level)
 {
     auto output_stream = TRY(try_make<AllocatingMemoryStream>());
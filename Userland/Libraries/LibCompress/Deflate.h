@@ -97,8 +97,17 @@ public:
     virtual bool is_open() const override;
     virtual void close() override;
 
+    // Decompressing a stream that is completely held in memory is much faster than reading it through the Stream
+    // interface, as the output can be written directly to its destination.
     static ErrorOr<ByteBuffer> decompress_all(ReadonlyBytes);
 
+    // Appends the decompressed data to the buffer, and returns how many bytes of input the DEFLATE stream took up.
+    static ErrorOr<size_t> decompress_all_into(ReadonlyBytes, ByteBuffer& output);
+
+    // Decompresses into a buffer whose size is known beforehand, and returns the number of bytes written to it.
+    // Fails if the decompressed data does not fit.
+    static ErrorOr<size_t> decompress_into(ReadonlyBytes, Bytes output);
+
 private:
     DeflateDecompressor(MaybeOwned<LittleEndianInputBitStream> stream, CircularBuffer buffer);
 
@@ -129,6 +138,7 @@ public:
     static constexpr size_t max_huffman_distances = 32;
     static constexpr size_t min_match_length = 4;   // matches smaller than these are not worth the size of the back reference
     static constexpr size_t max_match_length = 258; // matches longer than these cannot be encoded using huffman codes
+    static constexpr size_t max_distance = 32 * KiB; // back references cannot reach any further than this
     static constexpr u16 empty_slot = UINT16_MAX;
 
     struct CompressionConstants {
@@ -165,6 +175,14 @@ public:
     virtual void close() override;
     ErrorOr<void> final_flush();
 
+    // Primes the compressor with data that precedes its input, so that back-references can point into it.
+    // The decompressor has to have the same data in its window, so this must be called before writing anything.
+    void set_dictionary(ReadonlyBytes);
+
+    // Writes out all pending input and ends the output on a byte boundary, without marking the stream as finished.
+    // More DEFLATE data can be appended to the output afterwards, just like with zlib's Z_SYNC_FLUSH.
+    ErrorOr<void> sync_flush();
+
     static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, CompressionLevel = CompressionLevel::GOOD);
 
 private:
@@ -198,11 +216,13 @@ private:
     ErrorOr<void> flush();
 
     bool m_finished { false };
+    bool m_synced { false };
     CompressionLevel m_compression_level;
     CompressionConstants m_compression_constants;
     NonnullOwnPtr<LittleEndianOutputBitStream> m_output_stream;
 
     u8 m_rolling_window[window_size];
+    size_t m_history_size { 0 }; // the number of bytes right before the pending block that can be referenced
     size_t m_pending_block_size { 0 };
 
     struct [[gnu::packed]] {
@@ -6,6 +6,7 @@
  */
 
 #include <LibCompress/Gzip.h>
+#include <LibCompress/ParallelDeflate.h>
 
 #include <AK/BitStream.h>
 #include <AK/MemoryStream.h>
@@ -54,6 +55,39 @@ GzipDecompressor::Member::Member(BlockHeader header, NonnullOwnPtr<DeflateDecomp
 {
 }
 
+static ErrorOr<void> skip_optional_header_fields(BlockHeader const& header, Stream& stream)
+{
+    if (header.flags & Flags::FEXTRA) {
+        u16 subfield_id = TRY(stream.read_value<LittleEndian<u16>>());
+        u16 length = TRY(stream.read_value<LittleEndian<u16>>());
+        TRY(stream.discard(length));
+        (void)subfield_id;
+    }
+
+    auto discard_string = [&]() -> ErrorOr<void> {
+        char next_char;
+        do {
+            next_char = TRY(stream.read_value<char>());
+        } while (next_char);
+
+        return {};
+    };
+
+    if (header.flags & Flags::FNAME)
+        TRY(discard_string());
+
+    if (header.flags & Flags::FCOMMENT)
+        TRY(discard_string());
+
+    if (header.flags & Flags::FHCRC) {
+        u16 crc = TRY(stream.read_value<LittleEndian<u16>>());
+        // FIXME: we should probably verify this instead of just assuming it matches
+        (void)crc;
+    }
+
+    return {};
+}
+
 GzipDecompressor::GzipDecompressor(MaybeOwned<Stream> stream)
     : m_input_stream(make<LittleEndianInputBitStream>(move(stream)))
 {
@@ -117,33 +151,7 @@ ErrorOr<Bytes> GzipDecompressor::read_some(Bytes bytes)
             if (!header.supported_by_implementation())
                 return Error::from_string_literal("Header is not supported by implementation");
 
-            if (header.flags & Flags::FEXTRA) {
-                u16 subfield_id = TRY(m_input_stream->read_value<LittleEndian<u16>>());
-                u16 length = TRY(m_input_stream->read_value<LittleEndian<u16>>());
-                TRY(m_input_stream->discard(length));
-                (void)subfield_id;
-            }
-
-            auto discard_string = [&]() -> ErrorOr<void> {
-                char next_char;
-                do {
-                    next_char = TRY(m_input_stream->read_value<char>());
-                } while (next_char);
-
-                return {};
-            };
-
-            if (header.flags & Flags::FNAME)
-                TRY(discard_string());
-
-            if (header.flags & Flags::FCOMMENT)
-                TRY(discard_string());
-
-            if (header.flags & Flags::FHCRC) {
-                u16 crc = TRY(m_input_stream->read_value<LittleEndian<u16>>());
-                // FIXME: we should probably verify this instead of just assuming it matches
-                (void)crc;
-            }
+            TRY(skip_optional_header_fields(header, *m_input_stream));
 
             m_current_member = TRY(Member::construct(header, *m_input_stream));
             continue;
@@ -167,19 +175,42 @@ ErrorOr<Optional<String>> GzipDecompressor::describe_header(ReadonlyBytes bytes)
 
 ErrorOr<ByteBuffer> GzipDecompressor::decompress_all(ReadonlyBytes bytes)
 {
-    auto memory_stream = TRY(try_make<FixedMemoryStream>(bytes));
-    auto gzip_stream = make<GzipDecompressor>(move(memory_stream));
-    AllocatingMemoryStream output_stream;
-
-    auto buffer = TRY(ByteBuffer::create_uninitialized(4096));
-    while (!gzip_stream->is_eof()) {
-        auto const data = TRY(gzip_stream->read_some(buffer));
-        TRY(output_stream.write_until_depleted(data));
+    // Unlike read_some(), this inflates each member directly into the output buffer.
+    ByteBuffer output;
+    ReadonlyBytes remaining = bytes;
+
+    // Like read_some(), ignore trailing data that is too short to be followed by a member.
+    while (remaining.size() > sizeof(BlockHeader)) {
+        FixedMemoryStream header_stream { remaining };
+        BlockHeader header;
+        TRY(header_stream.read_until_filled({ &header, sizeof(header) }));
+
+        if (!header.valid_magic_number())
+            return Error::from_string_literal("Header does not have a valid magic number");
+
+        if (!header.supported_by_implementation())
+            return Error::from_string_literal("Header is not supported by implementation");
+
+        TRY(skip_optional_header_fields(header, header_stream));
+        remaining = remaining.slice(TRY(header_stream.tell()));
+
+        auto member_start = output.size();
+        remaining = remaining.slice(TRY(DeflateDecompressor::decompress_all_into(remaining, output)));
+        auto member_data = output.span().slice(member_start);
+
+        FixedMemoryStream trailer_stream { remaining };
+        u32 crc32 = TRY(trailer_stream.read_value<LittleEndian<u32>>());
+        u32 input_size = TRY(trailer_stream.read_value<LittleEndian<u32>>());
+        remaining = remaining.slice(2 * sizeof(u32));
+
+        if (crc32 != Crypto::Checksum::CRC32 { member_data }.digest())
+            return Error::from_string_literal("Stored CRC32 does not match the calculated CRC32 of the current member");
+
+        if (input_size != static_cast<u32>(member_data.size()))
+            return Error::from_string_literal("Input size does not match the number of read bytes");
     }
 
-    auto output_buffer = TRY(ByteBuffer::create_uninitialized(output_stream.used_buffer_size()));
-    TRY(output_stream.read_until_filled(output_buffer));
-    return output_buffer;
+    return output;
 }
 
 ErrorOr<void> GzipDecompressor::decompress_file(StringView input_filename, NonnullOwnPtr<Stream> output_stream)
@@ -205,8 +236,9 @@ ErrorOr<size_t> GzipDecompressor::write_some(ReadonlyBytes)
     return Error::from_errno(EBADF);
 }
 
-GzipCompressor::GzipCompressor(MaybeOwned<Stream> stream)
+GzipCompressor::GzipCompressor(MaybeOwned<Stream> stream, size_t thread_count)
     : m_output_stream(move(stream))
+    , m_thread_count(thread_count)
 {
 }
 
@@ -226,12 +258,21 @@ ErrorOr<size_t> GzipCompressor::write_some(ReadonlyBytes bytes)
     header.extra_flags = 3;      // DEFLATE sets 2 for maximum compression and 4 for minimum compression
     header.operating_system = 3; // unix
     TRY(m_output_stream->write_until_depleted({ &header, sizeof(header) }));
-    auto compressed_stream = TRY(DeflateCompressor::construct(MaybeOwned(*m_output_stream)));
-    TRY(compressed_stream->write_until_depleted(bytes));
-    TRY(compressed_stream->final_flush());
-    Crypto::Checksum::CRC32 crc32;
-    crc32.update(bytes);
-    TRY(m_output_stream->write_value<LittleEndian<u32>>(crc32.digest()));
+
+    u32 crc32;
+    if (m_thread_count > 1) {
+        auto compressed_stream = TRY(ParallelDeflateCompressor::construct(MaybeOwned(*m_output_stream), m_thread_count));
+        TRY(compressed_stream->write_until_depleted(bytes));
+        TRY(compressed_stream->final_flush());
+        crc32 = compressed_stream->crc32();
+    } else {
+        auto compressed_stream = TRY(DeflateCompressor::construct(MaybeOwned(*m_output_stream)));
+        TRY(compressed_stream->write_until_depleted(bytes));
+        TRY(compressed_stream->final_flush());
+        crc32 = Crypto::Checksum::CRC32 { bytes }.digest();
+    }
+
+    TRY(m_output_stream->write_value<LittleEndian<u32>>(crc32));
     TRY(m_output_stream->write_value<LittleEndian<u32>>(bytes.size()));
     return bytes.size();
 }
@@ -250,10 +291,10 @@ void GzipCompressor::close()
 {
 }
 
-ErrorOr<ByteBuffer> GzipCompressor::compress_all(ReadonlyBytes bytes)
+ErrorOr<ByteBuffer> GzipCompressor::compress_all(ReadonlyBytes bytes, size_t thread_count)
 {
     auto output_stream = TRY(try_make<AllocatingMemoryStream>());
-    GzipCompressor gzip_stream { MaybeOwned<Stream>(*output_stream) };
+    GzipCompressor gzip_stream { MaybeOwned<Stream>(*output_stream), thread_count };
 
     TRY(gzip_stream.write_until_depleted(bytes));
 
@@ -262,7 +303,7 @@ ErrorOr<ByteBuffer> GzipCompressor::compress_all(ReadonlyBytes bytes)
     return buffer;
 }
 
-ErrorOr<void> GzipCompressor::compress_file(StringView input_filename, NonnullOwnPtr<Stream> output_stream)
+ErrorOr<void> GzipCompressor::compress_file(StringView input_filename, NonnullOwnPtr<Stream> output_stream, size_t thread_count)
 {
     // We map the whole file instead of streaming to reduce size overhead (gzip header) and increase the deflate block size (better compression)
     // TODO: automatically fallback to buffered streaming for very large files
@@ -274,7 +315,7 @@ ErrorOr<void> GzipCompressor::compress_file(StringView input_filename, NonnullOw
         input_bytes = file->bytes();
     }
 
-    auto output_bytes = TRY(Compress::GzipCompressor::compress_all(input_bytes));
+    auto output_bytes = TRY(Compress::GzipCompressor::compress_all(input_bytes, thread_count));
     TRY(output_stream->write_until_depleted(output_bytes));
 
     return {};
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/MemoryStream.h>
+#include <LibCompress/ParallelDeflate.h>
+#include <LibCrypto/Checksum/CRC32.h>
+
+namespace Compress {
+
+ErrorOr<NonnullOwnPtr<ParallelDeflateCompressor>> ParallelDeflateCompressor::construct(MaybeOwned<Stream> stream, size_t thread_count, DeflateCompressor::CompressionLevel compression_level)
+{
+    VERIFY(thread_count > 0 && thread_count <= max_thread_count);
+
+    Vector<NonnullOwnPtr<Threading::WorkerThread<Error>>> workers;
+    TRY(workers.try_ensure_capacity(thread_count));
+    for (size_t i = 0; i < thread_count; ++i)
+        workers.unchecked_append(TRY(Threading::WorkerThread<Error>::create("Deflate compressor"sv)));
+
+    auto compressor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) ParallelDeflateCompressor(move(stream), compression_level, move(workers))));
+    TRY(compressor->m_chunks.try_resize(thread_count));
+    TRY(compressor->m_pending_input.try_ensure_capacity(chunk_size));
+    return compressor;
+}
+
+ParallelDeflateCompressor::ParallelDeflateCompressor(MaybeOwned<Stream> stream, DeflateCompressor::CompressionLevel compression_level, Vector<NonnullOwnPtr<Threading::WorkerThread<Error>>> workers)
+    : m_output_stream(move(stream))
+    , m_compression_level(compression_level)
+    , m_workers(move(workers))
+{
+}
+
+ParallelDeflateCompressor::~ParallelDeflateCompressor()
+{
+    // If writing failed or final_flush() was never called, some chunks may still be in progress. Their output is
+    // discarded, but the workers have to be done with them before they can be stopped, and before the chunks go away.
+    for (size_t i = 0; i < m_chunks.size(); ++i) {
+        if (m_chunks[i].in_progress)
+            (void)m_workers[i]->wait_until_task_is_finished();
+    }
+    m_workers.clear();
+}
+
+ErrorOr<Bytes> ParallelDeflateCompressor::read_some(Bytes)
+{
+    return Error::from_errno(EBADF);
+}
+
+ErrorOr<size_t> ParallelDeflateCompressor::write_some(ReadonlyBytes bytes)
+{
+    VERIFY(!m_finished);
+
+    size_t total_written = 0;
+    while (!bytes.is_empty()) {
+        auto n_written = min(bytes.size(), chunk_size - m_pending_input.size());
+        TRY(m_pending_input.try_append(bytes.trim(n_written)));
+
+        if (m_pending_input.size() == chunk_size)
+            TRY(start_chunk(false));
+
+        bytes = bytes.slice(n_written);
+        total_written += n_written;
+    }
+    return total_written;
+}
+
+bool ParallelDeflateCompressor::is_eof() const
+{
+    return true;
+}
+
+bool ParallelDeflateCompressor::is_open() const
+{
+    return m_output_stream->is_open();
+}
+
+void ParallelDeflateCompressor::close()
+{
+}
+
+ErrorOr<void> ParallelDeflateCompressor::start_chunk(bool is_last)
+{
+    auto index = m_next_chunk_index;
+    m_next_chunk_index = (m_next_chunk_index + 1) % m_workers.size();
+
+    auto& chunk = m_chunks[index];
+    if (chunk.in_progress)
+        TRY(finish_chunk(index));
+
+    // The next chunk is primed with the end of this one, which keeps the compression ratio close to that of a single
+    // compressor.
+    auto dictionary_size = min(m_pending_input.size(), DeflateCompressor::max_distance);
+    chunk.dictionary = move(m_dictionary);
+    m_dictionary = TRY(ByteBuffer::copy(m_pending_input.bytes().slice(m_pending_input.size() - dictionary_size)));
+
+    chunk.input = move(m_pending_input);
+    m_pending_input = {};
+    TRY(m_pending_input.try_ensure_capacity(chunk_size));
+
+    chunk.in_progress = true;
+    auto started = m_workers[index]->start_task([&chunk, compression_level = m_compression_level, is_last]() -> ErrorOr<void> {
+        AllocatingMemoryStream output_stream;
+        auto compressor = TRY(DeflateCompressor::construct(MaybeOwned<Stream>(output_stream), compression_level));
+        compressor->set_dictionary(chunk.dictionary);
+        TRY(compressor->write_until_depleted(chunk.input));
+        if (is_last)
+            TRY(compressor->final_flush());
+        else
+            TRY(compressor->sync_flush());
+
+        chunk.output = TRY(ByteBuffer::create_uninitialized(output_stream.used_buffer_size()));
+        TRY(output_stream.read_until_filled(chunk.output));
+        chunk.crc32 = Crypto::Checksum::CRC32 { chunk.input }.digest();
+        return {};
+    });
+    VERIFY(started);
+
+    return {};
+}
+
+ErrorOr<void> ParallelDeflateCompressor::finish_chunk(size_t index)
+{
+    auto& chunk = m_chunks[index];
+    chunk.in_progress = false;
+    TRY(m_workers[index]->wait_until_task_is_finished());
+
+    TRY(m_output_stream->write_until_depleted(chunk.output));
+    m_crc32 = Crypto::Checksum::CRC32::combine(m_crc32, chunk.crc32, chunk.input.size());
+    m_uncompressed_size += chunk.input.size();
+    return {};
+}
+
+ErrorOr<void> ParallelDeflateCompressor::final_flush()
+{
+    VERIFY(!m_finished);
+    m_finished = true;
+
+    TRY(start_chunk(true));
+
+    // Collect the remaining chunks, starting with the oldest one.
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+        auto index = (m_next_chunk_index + i) % m_workers.size();
+        if (m_chunks[index].in_progress)
+            TRY(finish_chunk(index));
+    }
+
+    return {};
+}
+
+ErrorOr<ByteBuffer> ParallelDeflateCompressor::compress_all(ReadonlyBytes bytes, size_t thread_count, DeflateCompressor::CompressionLevel compression_level)
+{
+    auto output_stream = TRY(try_make<AllocatingMemoryStream>());
+    auto deflate_stream = TRY(ParallelDeflateCompressor::construct(MaybeOwned<Stream>(*output_stream), thread_count, compression_level));
+
+    TRY(deflate_stream->write_until_depleted(bytes));
+    TRY(deflate_stream->final_flush());
+
+    auto buffer = TRY(ByteBuffer::create_uninitialized(output_stream->used_buffer_size()));
+    TRY(output_stream->read_until_filled(buffer));
+
+    return buffer;
+}
+
+}
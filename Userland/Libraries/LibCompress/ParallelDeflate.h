@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/MaybeOwned.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Stream.h>
+#include <AK/Vector.h>
+#include <LibCompress/Deflate.h>
+#include <LibThreading/WorkerThread.h>
+
+namespace Compress {
+
+// Compresses DEFLATE data on several threads at once, in the same way as pigz: the input is split into chunks that
+// are compressed independently, each one primed with the end of the chunk before it. All but the last chunk end
+// on a byte boundary, which allows simply concatenating the compressed chunks in order.
+class ParallelDeflateCompressor final : public Stream {
+public:
+    static constexpr size_t chunk_size = 128 * KiB;
+    // Every thread holds on to a few chunks worth of memory, and more threads than this don't speed anything up.
+    static constexpr size_t max_thread_count = 64;
+
+    static ErrorOr<NonnullOwnPtr<ParallelDeflateCompressor>> construct(MaybeOwned<Stream>, size_t thread_count, DeflateCompressor::CompressionLevel = DeflateCompressor::CompressionLevel::GOOD);
+    ~ParallelDeflateCompressor();
+
+    virtual ErrorOr<Bytes> read_some(Bytes) override;
+    virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
+    virtual bool is_eof() const override;
+    virtual bool is_open() const override;
+    virtual void close() override;
+    ErrorOr<void> final_flush();
+
+    // The CRC32 and size of all uncompressed data, available after final_flush().
+    u32 crc32() const { return m_crc32; }
+    u64 uncompressed_size() const { return m_uncompressed_size; }
+
+    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, size_t thread_count, DeflateCompressor::CompressionLevel = DeflateCompressor::CompressionLevel::GOOD);
+
+private:
+    struct Chunk {
+        ByteBuffer dictionary;
+        ByteBuffer input;
+        ByteBuffer output;
+        u32 crc32 { 0 };
+        bool in_progress { false };
+    };
+
+    ParallelDeflateCompressor(MaybeOwned<Stream>, DeflateCompressor::CompressionLevel, Vector<NonnullOwnPtr<Threading::WorkerThread<Error>>>);
+
+    ErrorOr<void> start_chunk(bool is_last);
+    ErrorOr<void> finish_chunk(size_t index);
+
+    MaybeOwned<Stream> m_output_stream;
+    DeflateCompressor::CompressionLevel m_compression_level;
+    bool m_finished { false };
+
+    // Chunks are handed out to the workers in turn, so the oldest chunk in progress is always the next one to start.
+    Vector<NonnullOwnPtr<Threading::WorkerThread<Error>>> m_workers;
+    Vector<Chunk> m_chunks;
+    size_t m_next_chunk_index { 0 };
+
+    ByteBuffer m_pending_input;
+    ByteBuffer m_dictionary;
+
+    u32 m_crc32 { 0 };
+    u64 m_uncompressed_size { 0 };
+};
+
+}
@@ -15,10 +15,8 @@
 
 namespace Compress {
 
-ErrorOr<NonnullOwnPtr<ZlibDecompressor>> ZlibDecompressor::create(MaybeOwned<Stream> stream)
+static ErrorOr<void> validate_header(ZlibHeader header)
 {
-    auto header = TRY(stream->read_value<ZlibHeader>());
-
     if (header.compression_method != ZlibCompressionMethod::Deflate || header.compression_info > 7)
         return Error::from_string_literal("Non-DEFLATE compression inside Zlib is not supported");
 
@@ -28,12 +26,40 @@ ErrorOr<NonnullOwnPtr<ZlibDecompressor>> ZlibDecompressor::create(MaybeOwned<Str
     if (header.as_u16 % 31 != 0)
         return Error::from_string_literal("Zlib error correction code does not match");
 
+    return {};
+}
+
+ErrorOr<NonnullOwnPtr<ZlibDecompressor>> ZlibDecompressor::create(MaybeOwned<Stream> stream)
+{
+    auto header = TRY(stream->read_value<ZlibHeader>());
+    TRY(validate_header(header));
+
     auto bit_stream = make<LittleEndianInputBitStream>(move(stream));
     auto deflate_stream = TRY(Compress::DeflateDecompressor::construct(move(bit_stream)));
 
     return adopt_nonnull_own_or_enomem(new (nothrow) ZlibDecompressor(header, move(deflate_stream)));
 }
 
+static ErrorOr<ReadonlyBytes> deflate_data_from_zlib_data(ReadonlyBytes data)
+{
+    FixedMemoryStream stream { data };
+    auto header = TRY(stream.read_value<ZlibHeader>());
+    TRY(validate_header(header));
+
+    return data.slice(sizeof(header));
+}
+
+// FIXME: Like the streaming decompressor, these don't verify the Adler-32 checksum following the DEFLATE data.
+ErrorOr<ByteBuffer> ZlibDecompressor::decompress_all(ReadonlyBytes data)
+{
+    return DeflateDecompressor::decompress_all(TRY(deflate_data_from_zlib_data(data)));
+}
+
+ErrorOr<size_t> ZlibDecompressor::decompress_into(ReadonlyBytes data, Bytes output)
+{
+    return DeflateDecompressor::decompress_into(TRY(deflate_data_from_zlib_data(data)), output);
+}
+
 ZlibDecompressor::ZlibDecompressor(ZlibHeader header, NonnullOwnPtr<Stream> stream)
     : m_header(header)
     , m_stream(move(stream))
@@ -54,6 +54,10 @@ public:
     virtual bool is_open() const override;
     virtual void close() override;
 
+    static ErrorOr<ByteBuffer> decompress_all(ReadonlyBytes);
+    // Returns the number of bytes written to the output, which has to be large enough to hold all decompressed data.
+    static ErrorOr<size_t> decompress_into(ReadonlyBytes, Bytes output);
+
 private:
     ZlibDecompressor(ZlibHeader, NonnullOwnPtr<Stream>);
 
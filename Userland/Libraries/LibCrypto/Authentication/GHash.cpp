@@ -9,6 +9,10 @@
 #include <AK/Types.h>
 #include <LibCrypto/Authentication/GHash.h>
 
+#if ARCH(X86_64)
+#    include <cpuid.h>
+#endif
+
 namespace {
 
 static u32 to_u32(u8 const* b)
@@ -23,42 +27,177 @@ static void to_u8s(u8* b, u32 const* w)
     }
 }
 
+#if ARCH(X86_64)
+
+// Bit 1 of ecx in cpuid[eax = 1] indicates support for the PCLMULQDQ instruction.
+constexpr u32 cpuid_1_ecx_bit_pclmulqdq = 1 << 1;
+
+static bool has_pclmulqdq()
+{
+    static bool const has_pclmulqdq = [] {
+        u32 eax, ebx, ecx, edx;
+        __cpuid(1, eax, ebx, ecx, edx);
+        return (ecx & cpuid_1_ecx_bit_pclmulqdq) != 0;
+    }();
+    return has_pclmulqdq;
+}
+
+// The carry-less multiplication builtin works on vectors of long long, which is not what AK's i64 is.
+using CarrylessVector = long long __attribute__((vector_size(16)));
+
+// Field elements are kept as 128-bit integers made up of the big-endian words of the block, which puts the
+// coefficient of x^0 into the most significant bit.
+static CarrylessVector to_vector(u32 const (&words)[4])
+{
+    return CarrylessVector {
+        static_cast<long long>((static_cast<u64>(words[2]) << 32) | words[3]),
+        static_cast<long long>((static_cast<u64>(words[0]) << 32) | words[1]),
+    };
+}
+
+static void from_vector(u32 (&words)[4], CarrylessVector vector)
+{
+    words[0] = static_cast<u64>(vector[1]) >> 32;
+    words[1] = static_cast<u32>(vector[1]);
+    words[2] = static_cast<u64>(vector[0]) >> 32;
+    words[3] = static_cast<u32>(vector[0]);
+}
+
+static CarrylessVector load_block(u8 const* data)
+{
+    return CarrylessVector {
+        static_cast<long long>(AK::convert_between_host_and_big_endian(ByteReader::load64(data + 8))),
+        static_cast<long long>(AK::convert_between_host_and_big_endian(ByteReader::load64(data))),
+    };
+}
+
+// The 256-bit carry-less product of two field elements, with the two middle partial products not yet added in.
+struct CarrylessProduct {
+    CarrylessVector low {};
+    CarrylessVector middle {};
+    CarrylessVector high {};
+};
+
+[[gnu::target("pclmul")]] static void multiply_and_accumulate(CarrylessProduct& product, CarrylessVector a, CarrylessVector b)
+{
+    product.low ^= __builtin_ia32_pclmulqdq128(a, b, 0x00);
+    product.middle ^= __builtin_ia32_pclmulqdq128(a, b, 0x01) ^ __builtin_ia32_pclmulqdq128(a, b, 0x10);
+    product.high ^= __builtin_ia32_pclmulqdq128(a, b, 0x11);
+}
+
+// Reduces a product modulo <x^128 + x^7 + x^2 + x + 1>, as described in Intel's white paper "Intel Carry-Less
+// Multiplication Instruction and its Usage for Computing the GCM Mode".
+static CarrylessVector reduce(CarrylessProduct const& product)
+{
+    u64 x0 = product.low[0];
+    u64 x1 = product.low[1] ^ product.middle[0];
+    u64 x2 = product.high[0] ^ product.middle[1];
+    u64 x3 = product.high[1];
+
+    // The bits of the field elements are reflected, which leaves their product off by one bit.
+    x3 = (x3 << 1) | (x2 >> 63);
+    x2 = (x2 << 1) | (x1 >> 63);
+    x1 = (x1 << 1) | (x0 >> 63);
+    x0 <<= 1;
+
+    u64 d = x1 ^ (x0 << 63) ^ (x0 << 62) ^ (x0 << 57);
+    u64 h0 = x0 ^ ((x0 >> 1) | (d << 63)) ^ ((x0 >> 2) | (d << 62)) ^ ((x0 >> 7) | (d << 57));
+    u64 h1 = d ^ (d >> 1) ^ (d >> 2) ^ (d >> 7);
+
+    return CarrylessVector { static_cast<long long>(x2 ^ h0), static_cast<long long>(x3 ^ h1) };
+}
+
+[[gnu::target("pclmul")]] static void multiply_with_pclmulqdq(u32 (&tag)[4], u32 const (&key)[4])
+{
+    CarrylessProduct product;
+    multiply_and_accumulate(product, to_vector(tag), to_vector(key));
+    from_vector(tag, reduce(product));
+}
+
+// Consumes the data in multiples of 16 bytes, the rest of it has to be handled by the caller.
+[[gnu::target("pclmul")]] static void update_with_pclmulqdq(u32 (&tag)[4], u32 const (&key_powers)[4][4], ReadonlyBytes& data)
+{
+    static constexpr size_t block_size = 16;
+
+    auto state = to_vector(tag);
+    CarrylessVector const powers[4] { to_vector(key_powers[0]), to_vector(key_powers[1]), to_vector(key_powers[2]), to_vector(key_powers[3]) };
+
+    // Multiplying four blocks by decreasing powers of the key gives the same result as multiplying them in one
+    // after another, but allows summing up the products and reducing them only once.
+    while (data.size() >= 4 * block_size) {
+        CarrylessProduct product;
+        multiply_and_accumulate(product, state ^ load_block(data.offset_pointer(0)), powers[3]);
+        multiply_and_accumulate(product, load_block(data.offset_pointer(block_size)), powers[2]);
+        multiply_and_accumulate(product, load_block(data.offset_pointer(2 * block_size)), powers[1]);
+        multiply_and_accumulate(product, load_block(data.offset_pointer(3 * block_size)), powers[0]);
+        state = reduce(product);
+        data = data.slice(4 * block_size);
+    }
+
+    while (data.size() >= block_size) {
+        CarrylessProduct product;
+        multiply_and_accumulate(product, state ^ load_block(data.data()), powers[0]);
+        state = reduce(product);
+        data = data.slice(block_size);
+    }
+
+    from_vector(tag, state);
+}
+
+#endif
+
 }
 
 namespace Crypto::Authentication {
 
+GHash::GHash(ReadonlyBytes key)
+{
+    VERIFY(key.size() >= 16);
+    for (size_t i = 0; i < 16; i += 4) {
+        m_key[i / 4] = to_u32(key.offset(i));
+        m_key_powers[0][i / 4] = m_key[i / 4];
+    }
+
+    for (size_t i = 1; i < 4; ++i)
+        galois_multiply(m_key_powers[i], m_key_powers[i - 1], m_key);
+}
+
 GHash::TagType GHash::process(ReadonlyBytes aad, ReadonlyBytes cipher)
 {
     u32 tag[4] { 0, 0, 0, 0 };
+    update(tag, aad);
+    update(tag, cipher);
+    return finish(tag, aad.size(), cipher.size());
+}
 
-    auto transform_one = [&](auto& buf) {
-        size_t i = 0;
-        for (; i < buf.size(); i += 16) {
-            if (i + 16 <= buf.size()) {
-                for (auto j = 0; j < 4; ++j) {
-                    tag[j] ^= to_u32(buf.offset(i + j * 4));
-                }
-                galois_multiply(tag, m_key, tag);
-            }
-        }
+void GHash::update(u32 (&tag)[4], ReadonlyBytes data) const
+{
+#if ARCH(X86_64)
+    if (data.size() >= 16 && has_pclmulqdq())
+        update_with_pclmulqdq(tag, m_key_powers, data);
+#endif
 
-        if (i > buf.size()) {
-            u8 buffer[16] = {};
-            Bytes buffer_bytes { buffer, 16 };
-            buf.slice(i - 16).copy_to(buffer_bytes);
+    for (; data.size() >= 16; data = data.slice(16)) {
+        for (auto j = 0; j < 4; ++j)
+            tag[j] ^= to_u32(data.offset(j * 4));
+        multiply_by_key(tag);
+    }
 
-            for (auto j = 0; j < 4; ++j) {
-                tag[j] ^= to_u32(buffer_bytes.offset(j * 4));
-            }
-            galois_multiply(tag, m_key, tag);
-        }
-    };
+    if (!data.is_empty()) {
+        u8 buffer[16] = {};
+        Bytes buffer_bytes { buffer, 16 };
+        data.copy_to(buffer_bytes);
 
-    transform_one(aad);
-    transform_one(cipher);
+        for (auto j = 0; j < 4; ++j)
+            tag[j] ^= to_u32(buffer_bytes.offset(j * 4));
+        multiply_by_key(tag);
+    }
+}
 
-    auto aad_bits = 8 * (u64)aad.size();
-    auto cipher_bits = 8 * (u64)cipher.size();
+GHash::TagType GHash::finish(u32 (&tag)[4], u64 aad_size, u64 cipher_size) const
+{
+    auto aad_bits = 8 * aad_size;
+    auto cipher_bits = 8 * cipher_size;
 
     auto high = [](u64 value) -> u32 { return value >> 32; };
     auto low = [](u64 value) -> u32 { return value & 0xffffffff; };
@@ -76,7 +215,7 @@ GHash::TagType GHash::process(ReadonlyBytes aad, ReadonlyBytes cipher)
 
     dbgln_if(GHASH_PROCESS_DEBUG, "Tag bits: {} : {} : {} : {}", tag[0], tag[1], tag[2], tag[3]);
 
-    galois_multiply(tag, m_key, tag);
+    multiply_by_key(tag);
 
     TagType digest;
     to_u8s(digest.data, tag);
@@ -84,6 +223,18 @@ GHash::TagType GHash::process(ReadonlyBytes aad, ReadonlyBytes cipher)
     return digest;
 }
 
+void GHash::multiply_by_key(u32 (&tag)[4]) const
+{
+#if ARCH(X86_64)
+    if (has_pclmulqdq()) {
+        multiply_with_pclmulqdq(tag, m_key);
+        return;
+    }
+#endif
+
+    galois_multiply(tag, m_key, tag);
+}
+
 /// Galois Field multiplication using <x^127 + x^7 + x^2 + x + 1>.
 /// Note that x, y, and z are strictly BE.
 void galois_multiply(u32 (&z)[4], const u32 (&_x)[4], const u32 (&_y)[4])
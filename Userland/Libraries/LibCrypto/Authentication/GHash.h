@@ -37,13 +37,7 @@ public:
     {
     }
 
-    explicit GHash(ReadonlyBytes key)
-    {
-        VERIFY(key.size() >= 16);
-        for (size_t i = 0; i < 16; i += 4) {
-            m_key[i / 4] = AK::convert_between_host_and_big_endian(ByteReader::load32(key.offset(i)));
-        }
-    }
+    explicit GHash(ReadonlyBytes key);
 
     constexpr static size_t digest_size() { return TagType::Size; }
 
@@ -56,8 +50,18 @@ public:
 
     TagType process(ReadonlyBytes aad, ReadonlyBytes cipher);
 
+    // The steps of process(), for authenticating data while it is being encrypted or decrypted. The AAD and then the
+    // ciphertext are passed to update(), each in pieces that are a multiple of 16 bytes long except for the last one.
+    void update(u32 (&tag)[4], ReadonlyBytes) const;
+    TagType finish(u32 (&tag)[4], u64 aad_size, u64 cipher_size) const;
+
 private:
+    void multiply_by_key(u32 (&tag)[4]) const;
+
     u32 m_key[4];
+
+    // The key raised to the powers 1 to 4, which allows processing several blocks before having to reduce the result.
+    u32 m_key_powers[4][4];
 };
 
 }
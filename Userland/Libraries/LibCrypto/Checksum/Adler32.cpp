@@ -4,17 +4,108 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/SIMD.h>
 #include <AK/Span.h>
 #include <AK/Types.h>
 #include <LibCrypto/Checksum/Adler32.h>
 
+#if ARCH(X86_64)
+#    include <cpuid.h>
+#endif
+
 namespace Crypto::Checksum {
 
+static constexpr u32 modulus = 65521;
+
+// The largest number of bytes that can be summed up before the sums have to be reduced modulo 65521 to not overflow
+// 32 bits, assuming every byte is 255 and both sums start out just below the modulus.
+static constexpr size_t max_bytes_between_reductions = 5552;
+
+#if ARCH(X86_64)
+
+// Bit 9 of ecx in cpuid[eax = 1] indicates support for SSSE3.
+constexpr u32 cpuid_1_ecx_bit_ssse3 = 1 << 9;
+
+static bool has_ssse3()
+{
+    static bool const has_ssse3 = [] {
+        u32 eax, ebx, ecx, edx;
+        __cpuid(1, eax, ebx, ecx, edx);
+        return (ecx & cpuid_1_ecx_bit_ssse3) != 0;
+    }();
+    return has_ssse3;
+}
+
+// The sum of absolute differences builtin works on vectors of long long, which is not what AK's i64 is.
+using SumVector = long long __attribute__((vector_size(16)));
+
+// Processes the data 32 bytes at a time: the plain sum of each block is added to a, while b gets the sum of the
+// bytes weighted by their distance from the end of the block, plus 32 times the value a had before the block.
+// The data is consumed in multiples of 32 bytes, and the rest of it has to be handled by the caller.
+[[gnu::target("ssse3")]] static void update_with_ssse3(u32& a, u32& b, ReadonlyBytes& data)
+{
+    using namespace AK::SIMD;
+
+    static constexpr size_t block_size = 32;
+
+    c8x16 const first_weights { 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17 };
+    c8x16 const second_weights { 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 };
+    i16x8 const ones { 1, 1, 1, 1, 1, 1, 1, 1 };
+    c8x16 const zero {};
+
+    auto load = [&](size_t offset) {
+        c8x16 value;
+        __builtin_memcpy(&value, data.offset_pointer(offset), sizeof(value));
+        return value;
+    };
+
+    while (data.size() >= block_size) {
+        auto blocks = min(data.size(), max_bytes_between_reductions) / block_size;
+
+        // The sums only fit into 32 bits as a whole, so they are kept unsigned and allowed to wrap around in between.
+        u32x4 previous_a_sum { static_cast<u32>(a * blocks), 0, 0, 0 };
+        u32x4 a_sum {};
+        u32x4 b_sum { b, 0, 0, 0 };
+
+        for (size_t i = 0; i < blocks; ++i) {
+            auto first = load(0);
+            auto second = load(16);
+
+            previous_a_sum += a_sum;
+            a_sum += bit_cast<u32x4>(__builtin_ia32_psadbw128(first, zero) + __builtin_ia32_psadbw128(second, zero));
+            b_sum += bit_cast<u32x4>(__builtin_ia32_pmaddwd128(__builtin_ia32_pmaddubsw128(first, first_weights), ones));
+            b_sum += bit_cast<u32x4>(__builtin_ia32_pmaddwd128(__builtin_ia32_pmaddubsw128(second, second_weights), ones));
+
+            data = data.slice(block_size);
+        }
+
+        b_sum += previous_a_sum * static_cast<u32>(block_size);
+
+        a += a_sum[0] + a_sum[1] + a_sum[2] + a_sum[3];
+        b = b_sum[0] + b_sum[1] + b_sum[2] + b_sum[3];
+        a %= modulus;
+        b %= modulus;
+    }
+}
+
+#endif
+
 void Adler32::update(ReadonlyBytes data)
 {
-    for (size_t i = 0; i < data.size(); i++) {
-        m_state_a = (m_state_a + data.at(i)) % 65521;
-        m_state_b = (m_state_b + m_state_a) % 65521;
+#if ARCH(X86_64)
+    if (data.size() >= 32 && has_ssse3())
+        update_with_ssse3(m_state_a, m_state_b, data);
+#endif
+
+    while (!data.is_empty()) {
+        auto chunk = data.trim(max_bytes_between_reductions);
+        for (auto byte : chunk) {
+            m_state_a += byte;
+            m_state_b += m_state_a;
+        }
+        m_state_a %= modulus;
+        m_state_b %= modulus;
+        data = data.slice(chunk.size());
     }
 }
 
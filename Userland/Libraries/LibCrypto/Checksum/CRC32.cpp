@@ -10,6 +10,10 @@
 #include <AK/Types.h>
 #include <LibCrypto/Checksum/CRC32.h>
 
+#if ARCH(X86_64)
+#    include <cpuid.h>
+#endif
+
 namespace Crypto::Checksum {
 
 #if defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
@@ -43,8 +47,6 @@ void CRC32::update(ReadonlyBytes span)
     }
 }
 
-// FIXME: On Intel, use _mm_crc32_u8 / _mm_crc32_u64 if available (SSE 4.2).
-
 #else
 
 static constexpr size_t ethernet_polynomial = 0xEDB88320;
@@ -101,8 +103,86 @@ static constexpr u32 single_byte_crc(u32 crc, u8 byte)
     return (crc >> 8) ^ table[0][(crc & 0xff) ^ byte];
 }
 
+#        if ARCH(X86_64)
+
+// Bit 1 of ecx in cpuid[eax = 1] indicates support for PCLMULQDQ.
+constexpr u32 cpuid_1_ecx_bit_pclmulqdq = 1 << 1;
+
+static bool has_pclmulqdq()
+{
+    static bool const has_pclmulqdq = [] {
+        u32 eax, ebx, ecx, edx;
+        __cpuid(1, eax, ebx, ecx, edx);
+        return (ecx & cpuid_1_ecx_bit_pclmulqdq) != 0;
+    }();
+    return has_pclmulqdq;
+}
+
+// The carry-less multiplication builtin works on vectors of long long, which is not what AK's i64 is.
+using CarrylessVector = long long __attribute__((vector_size(16)));
+
+[[gnu::target("pclmul")]] static CarrylessVector fold_16_bytes(CarrylessVector value, CarrylessVector constants)
+{
+    return __builtin_ia32_pclmulqdq128(value, constants, 0x00) ^ __builtin_ia32_pclmulqdq128(value, constants, 0x11);
+}
+
+// This is the folding approach from Intel's "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction".
+// The data is consumed in multiples of 16 bytes, and the state returned has to be updated with the rest of it.
+[[gnu::target("pclmul")]] static u32 update_with_pclmulqdq(u32 state, ReadonlyBytes& data)
+{
+    VERIFY(data.size() >= 64);
+
+    auto load = [&](size_t offset) {
+        CarrylessVector value;
+        __builtin_memcpy(&value, data.offset_pointer(offset), sizeof(value));
+        return value;
+    };
+
+    // Powers of x modulo the polynomial (bit-reflected) that move 16 bytes of state forward by 64 or 16 bytes.
+    CarrylessVector const fold_by_64_bytes { 0x1'5444'2bd4, 0x1'c6e4'1596 };
+    CarrylessVector const fold_by_16_bytes { 0x1'7519'97d0, 0x0'ccaa'009e };
+
+    auto x0 = load(0) ^ CarrylessVector { state, 0 };
+    auto x1 = load(16);
+    auto x2 = load(32);
+    auto x3 = load(48);
+    data = data.slice(64);
+
+    while (data.size() >= 64) {
+        x0 = fold_16_bytes(x0, fold_by_64_bytes) ^ load(0);
+        x1 = fold_16_bytes(x1, fold_by_64_bytes) ^ load(16);
+        x2 = fold_16_bytes(x2, fold_by_64_bytes) ^ load(32);
+        x3 = fold_16_bytes(x3, fold_by_64_bytes) ^ load(48);
+        data = data.slice(64);
+    }
+
+    auto x = fold_16_bytes(x0, fold_by_16_bytes) ^ x1;
+    x = fold_16_bytes(x, fold_by_16_bytes) ^ x2;
+    x = fold_16_bytes(x, fold_by_16_bytes) ^ x3;
+
+    while (data.size() >= 16) {
+        x = fold_16_bytes(x, fold_by_16_bytes) ^ load(0);
+        data = data.slice(16);
+    }
+
+    // What is left is congruent to the data so far, so its CRC (without an initial state) is the CRC of the data.
+    u8 remainder[16];
+    __builtin_memcpy(remainder, &x, sizeof(remainder));
+    state = 0;
+    for (auto byte : remainder)
+        state = single_byte_crc(state, byte);
+    return state;
+}
+
+#        endif
+
 void CRC32::update(ReadonlyBytes data)
 {
+#        if ARCH(X86_64)
+    if (data.size() >= 64 && has_pclmulqdq())
+        m_state = update_with_pclmulqdq(m_state, data);
+#        endif
+
     // The provided data may not be aligned to a 4-byte boundary, required to reinterpret its address
     // into a u32 in the loop below. So we split the bytes into two segments: the misaligned bytes
     // (which undergo the standard 1-byte-at-a-time algorithm) and remaining aligned bytes.
@@ -171,4 +251,37 @@ u32 CRC32::digest()
     return ~m_state;
 }
 
+// Multiplies two polynomials modulo the CRC32 polynomial, both in the reflected bit order used by CRC32.
+static constexpr u32 multiply_modulo_polynomial(u32 a, u32 b)
+{
+    u32 product = 0;
+    for (u32 mask = 1u << 31; mask != 0; mask >>= 1) {
+        if (a & mask)
+            product ^= b;
+        b = (b >> 1) ^ ((b & 1) * 0xEDB88320u);
+    }
+    return product;
+}
+
+// Entry n is x^(2^n) modulo the CRC32 polynomial. As x^(2^32) == x modulo it, the powers repeat after 32 entries.
+static constexpr auto powers_of_x = [] {
+    Array<u32, 32> powers {};
+    powers[0] = 1u << 30;
+    for (size_t i = 1; i < powers.size(); ++i)
+        powers[i] = multiply_modulo_polynomial(powers[i - 1], powers[i - 1]);
+    return powers;
+}();
+
+u32 CRC32::combine(u32 first_crc, u32 second_crc, u64 second_size)
+{
+    // Appending n bytes multiplies the first CRC by x^(8n), after which the CRC of the second piece is simply added.
+    // The pre- and post-conditioning of both CRCs cancels out, so this works on digests directly.
+    u32 shift = 1u << 31;
+    for (size_t bit = 3; second_size != 0; second_size >>= 1, ++bit) {
+        if (second_size & 1)
+            shift = multiply_modulo_polynomial(powers_of_x[bit % powers_of_x.size()], shift);
+    }
+    return multiply_modulo_polynomial(shift, first_crc) ^ second_crc;
+}
+
 }
@@ -29,6 +29,10 @@ public:
     virtual void update(ReadonlyBytes data) override;
     virtual u32 digest() override;
 
+    // Returns the CRC32 of the concatenation of two pieces of data, given their separate CRC32s and the size of the
+    // second piece. This allows computing checksums of parts of a buffer in parallel.
+    static u32 combine(u32 first_crc, u32 second_crc, u64 second_size);
+
 private:
     u32 m_state { ~0u };
 };
@@ -4,10 +4,16 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ByteReader.h>
+#include <AK/Endian.h>
 #include <AK/StringBuilder.h>
 #include <LibCrypto/Cipher/AES.h>
 #include <LibCrypto/Cipher/AESTables.h>
 
+#if ARCH(X86_64) && !defined(KERNEL)
+#    include <cpuid.h>
+#endif
+
 namespace Crypto::Cipher {
 
 template<typename T>
@@ -83,6 +89,7 @@ void AESCipherKey::expand_encrypt_key(ReadonlyBytes user_key, size_t bits)
                 break;
             round_key += 4;
         }
+        update_round_key_bytes();
         return;
     }
 
@@ -111,6 +118,7 @@ void AESCipherKey::expand_encrypt_key(ReadonlyBytes user_key, size_t bits)
 
             round_key += 6;
         }
+        update_round_key_bytes();
         return;
     }
 
@@ -148,10 +156,17 @@ void AESCipherKey::expand_encrypt_key(ReadonlyBytes user_key, size_t bits)
 
             round_key += 8;
         }
+        update_round_key_bytes();
         return;
     }
 }
 
+void AESCipherKey::update_round_key_bytes()
+{
+    for (size_t i = 0; i < (rounds() + 1) * 4; ++i)
+        ByteReader::store(m_round_key_bytes + i * 4, AK::convert_between_host_and_big_endian(m_rd_keys[i]));
+}
+
 void AESCipherKey::expand_decrypt_key(ReadonlyBytes user_key, size_t bits)
 {
     u32* round_key;
@@ -194,10 +209,126 @@ void AESCipherKey::expand_decrypt_key(ReadonlyBytes user_key, size_t bits)
                 AESTables::Decode3[AESTables::Encode1[(round_key[3]      ) & 0xff] & 0xff] ;
         // clang-format on
     }
+
+    update_round_key_bytes();
+}
+
+#if ARCH(X86_64) && !defined(KERNEL)
+
+// Bit 25 of ecx in cpuid[eax = 1] indicates support for the AES-NI instructions.
+constexpr u32 cpuid_1_ecx_bit_aes = 1 << 25;
+
+static bool has_aes_ni()
+{
+    static bool const has_aes_ni = [] {
+        u32 eax, ebx, ecx, edx;
+        __cpuid(1, eax, ebx, ecx, edx);
+        return (ecx & cpuid_1_ecx_bit_aes) != 0;
+    }();
+    return has_aes_ni;
+}
+
+// The AES builtins work on vectors of long long, which is not what AK's i64 is.
+using AESVector = long long __attribute__((vector_size(16)));
+
+static AESVector load_vector(u8 const* data)
+{
+    AESVector vector;
+    __builtin_memcpy(&vector, data, sizeof(vector));
+    return vector;
 }
 
+static void store_vector(u8* data, AESVector vector)
+{
+    __builtin_memcpy(data, &vector, sizeof(vector));
+}
+
+[[gnu::target("aes")]] static AESVector encrypt_with_aes_ni(AESCipherKey const& key, AESVector block)
+{
+    auto const* round_keys = key.round_key_bytes();
+    block ^= load_vector(round_keys);
+    for (size_t round = 1; round < key.rounds(); ++round)
+        block = __builtin_ia32_aesenc128(block, load_vector(round_keys + round * 16));
+    return __builtin_ia32_aesenclast128(block, load_vector(round_keys + key.rounds() * 16));
+}
+
+// The decryption key schedule is already in the form the "equivalent inverse cipher" needs, which is also what
+// the AES-NI decryption instructions implement.
+[[gnu::target("aes")]] static AESVector decrypt_with_aes_ni(AESCipherKey const& key, AESVector block)
+{
+    auto const* round_keys = key.round_key_bytes();
+    block ^= load_vector(round_keys);
+    for (size_t round = 1; round < key.rounds(); ++round)
+        block = __builtin_ia32_aesdec128(block, load_vector(round_keys + round * 16));
+    return __builtin_ia32_aesdeclast128(block, load_vector(round_keys + key.rounds() * 16));
+}
+
+[[gnu::target("aes")]] static size_t encrypt_in_counter_mode_with_aes_ni(AESCipherKey const& key, ReadonlyBytes in, Bytes out, Bytes counter)
+{
+    static constexpr size_t block_size = 16;
+
+    // Each round takes several cycles to complete, but a new one can be started every cycle, so several independent
+    // blocks are kept in flight at once.
+    static constexpr size_t blocks_per_iteration = 8;
+
+    auto const* round_keys = key.round_key_bytes();
+    auto rounds = key.rounds();
+
+    u64 counter_high = AK::convert_between_host_and_big_endian(ByteReader::load64(counter.offset_pointer(0)));
+    u64 counter_low = AK::convert_between_host_and_big_endian(ByteReader::load64(counter.offset_pointer(8)));
+
+    auto next_counter_block = [&] {
+        AESVector block {
+            static_cast<long long>(AK::convert_between_host_and_big_endian(counter_high)),
+            static_cast<long long>(AK::convert_between_host_and_big_endian(counter_low)),
+        };
+        if (++counter_low == 0)
+            ++counter_high;
+        return block;
+    };
+
+    size_t offset = 0;
+    while (offset + blocks_per_iteration * block_size <= in.size()) {
+        AESVector blocks[blocks_per_iteration];
+        for (auto& block : blocks)
+            block = next_counter_block() ^ load_vector(round_keys);
+
+        for (size_t round = 1; round < rounds; ++round) {
+            auto round_key = load_vector(round_keys + round * block_size);
+            for (auto& block : blocks)
+                block = __builtin_ia32_aesenc128(block, round_key);
+        }
+
+        auto last_round_key = load_vector(round_keys + rounds * block_size);
+        for (auto& block : blocks) {
+            block = __builtin_ia32_aesenclast128(block, last_round_key);
+            store_vector(out.offset_pointer(offset), block ^ load_vector(in.offset_pointer(offset)));
+            offset += block_size;
+        }
+    }
+
+    while (offset + block_size <= in.size()) {
+        auto block = encrypt_with_aes_ni(key, next_counter_block());
+        store_vector(out.offset_pointer(offset), block ^ load_vector(in.offset_pointer(offset)));
+        offset += block_size;
+    }
+
+    ByteReader::store(counter.offset_pointer(0), AK::convert_between_host_and_big_endian(counter_high));
+    ByteReader::store(counter.offset_pointer(8), AK::convert_between_host_and_big_endian(counter_low));
+    return offset;
+}
+
+#endif
+
 void AESCipher::encrypt_block(AESCipherBlock const& in, AESCipherBlock& out)
 {
+#if ARCH(X86_64) && !defined(KERNEL)
+    if (has_aes_ni()) {
+        store_vector(out.bytes().data(), encrypt_with_aes_ni(key(), load_vector(in.bytes().data())));
+        return;
+    }
+#endif
+
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
     size_t r { 0 };
 
@@ -287,6 +418,13 @@ void AESCipher::encrypt_block(AESCipherBlock const& in, AESCipherBlock& out)
 
 void AESCipher::decrypt_block(AESCipherBlock const& in, AESCipherBlock& out)
 {
+#if ARCH(X86_64) && !defined(KERNEL)
+    if (has_aes_ni()) {
+        store_vector(out.bytes().data(), decrypt_with_aes_ni(key(), load_vector(in.bytes().data())));
+        return;
+    }
+#endif
+
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
     size_t r { 0 };
 
@@ -374,6 +512,19 @@ void AESCipher::decrypt_block(AESCipherBlock const& in, AESCipherBlock& out)
     // clang-format on
 }
 
+size_t AESCipher::encrypt_blocks_in_counter_mode(ReadonlyBytes in, Bytes out, Bytes counter) const
+{
+    VERIFY(in.size() <= out.size());
+    VERIFY(counter.size() == AESCipherBlock::block_size());
+
+#if ARCH(X86_64) && !defined(KERNEL)
+    if (has_aes_ni())
+        return encrypt_in_counter_mode_with_aes_ni(m_key, in, out, counter);
+#endif
+
+    return 0;
+}
+
 void AESCipherBlock::overwrite(ReadonlyBytes bytes)
 {
     auto data = bytes.data();
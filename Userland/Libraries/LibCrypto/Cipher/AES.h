@@ -72,6 +72,9 @@ struct AESCipherKey : public CipherKey {
         return (u32 const*)m_rd_keys;
     }
 
+    // The same round keys as round_keys(), laid out as the bytes of each round key in order.
+    u8 const* round_key_bytes() const { return m_round_key_bytes; }
+
     AESCipherKey(ReadonlyBytes user_key, size_t key_bits, Intent intent)
         : m_bits(key_bits)
     {
@@ -93,8 +96,11 @@ protected:
     }
 
 private:
+    void update_round_key_bytes();
+
     static constexpr size_t MAX_ROUND_COUNT = 14;
     u32 m_rd_keys[(MAX_ROUND_COUNT + 1) * 4] { 0 };
+    u8 m_round_key_bytes[(MAX_ROUND_COUNT + 1) * 16] { 0 };
     size_t m_rounds;
     size_t m_bits;
 };
@@ -119,6 +125,11 @@ public:
     virtual void encrypt_block(BlockType const& in, BlockType& out) override;
     virtual void decrypt_block(BlockType const& in, BlockType& out) override;
 
+    // Encrypts the complete blocks of |in| in counter mode, incrementing |counter| as a big-endian integer after each
+    // block. Returns the number of bytes that were processed, which is zero if there is no faster way of doing this
+    // than going through encrypt_block() one block at a time.
+    size_t encrypt_blocks_in_counter_mode(ReadonlyBytes in, Bytes out, Bytes counter) const;
+
 #ifndef KERNEL
     virtual ByteString class_name() const override
     {
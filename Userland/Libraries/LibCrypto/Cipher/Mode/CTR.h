@@ -170,6 +170,14 @@ protected:
         size_t offset { 0 };
         auto block_size = cipher.block_size();
 
+        // Ciphers may provide a faster way of encrypting many blocks at once.
+        if constexpr (IsSame<IncrementFunctionType, IncrementInplace> && requires(T const& c, ReadonlyBytes bytes, Bytes buffer) { c.encrypt_blocks_in_counter_mode(bytes, buffer, buffer); }) {
+            if (in) {
+                offset = cipher.encrypt_blocks_in_counter_mode(*in, out, iv);
+                length -= offset;
+            }
+        }
+
         while (length > 0) {
             m_cipher_block.overwrite(iv.slice(0, block_size));
 
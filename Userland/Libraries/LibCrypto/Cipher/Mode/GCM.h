@@ -92,12 +92,22 @@ public:
         // Skip past block 0
         CTR<T>::increment(iv);
 
-        if (in.is_empty())
+        u32 ghash_state[4] { 0, 0, 0, 0 };
+        m_ghash->update(ghash_state, aad);
+
+        if (in.is_empty()) {
             CTR<T>::key_stream(out, iv);
-        else
-            CTR<T>::encrypt(in, out, iv);
+        } else {
+            VERIFY(in.size() <= out.size());
+            for (size_t offset = 0; offset < in.size(); offset += interleave_size) {
+                auto in_chunk = in.slice(offset, min(interleave_size, in.size() - offset));
+                auto out_chunk = out.slice(offset, in_chunk.size());
+                CTR<T>::encrypt(in_chunk, out_chunk, iv, &iv);
+                m_ghash->update(ghash_state, out_chunk);
+            }
+        }
 
-        auto auth_tag = m_ghash->process(aad, out);
+        auto auth_tag = m_ghash->finish(ghash_state, aad.size(), in.size());
         block0.apply_initialization_vector({ auth_tag.data, array_size(auth_tag.data) });
         block0.bytes().copy_to(tag);
     }
@@ -120,27 +130,35 @@ public:
         // Skip past block 0
         CTR<T>::increment(iv);
 
-        auto auth_tag = m_ghash->process(aad, in);
-        block0.apply_initialization_vector({ auth_tag.data, array_size(auth_tag.data) });
+        u32 ghash_state[4] { 0, 0, 0, 0 };
+        m_ghash->update(ghash_state, aad);
 
-        auto test_consistency = [&] {
-            if (block0.block_size() != tag.size() || !timing_safe_compare(block0.bytes().data(), tag.data(), tag.size()))
-                return VerificationConsistency::Inconsistent;
+        VERIFY(in.size() <= out.size());
+        for (size_t offset = 0; offset < in.size(); offset += interleave_size) {
+            auto in_chunk = in.slice(offset, min(interleave_size, in.size() - offset));
+            auto out_chunk = out.slice(offset, in_chunk.size());
+            m_ghash->update(ghash_state, in_chunk);
+            CTR<T>::encrypt(in_chunk, out_chunk, iv, &iv);
+        }
 
-            return VerificationConsistency::Consistent;
-        };
+        auto auth_tag = m_ghash->finish(ghash_state, aad.size(), in.size());
+        block0.apply_initialization_vector({ auth_tag.data, array_size(auth_tag.data) });
 
-        if (in.is_empty()) {
+        if (in.is_empty())
             out = {};
-            return test_consistency();
-        }
 
-        CTR<T>::encrypt(in, out, iv);
-        return test_consistency();
+        if (block0.block_size() != tag.size() || !timing_safe_compare(block0.bytes().data(), tag.data(), tag.size()))
+            return VerificationConsistency::Inconsistent;
+
+        return VerificationConsistency::Consistent;
     }
 
 private:
     static constexpr auto block_size = T::BlockType::BlockSizeInBits / 8;
+
+    // The data is encrypted and authenticated in chunks that are small enough to still be in the cache for the
+    // second of the two steps.
+    static constexpr size_t interleave_size = 4 * KiB;
     u8 m_auth_key_storage[block_size];
     Bytes m_auth_key { m_auth_key_storage, block_size };
     Optional<Authentication::GHash> m_ghash;
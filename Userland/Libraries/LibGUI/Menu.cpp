@@ -14,6 +14,7 @@
 #include <LibGUI/Menu.h>
 #include <LibGUI/MenuItem.h>
 #include <LibGfx/Bitmap.h>
+#include <LibIPC/Connection.h>
 
 namespace GUI {
 
@@ -58,6 +59,7 @@ void Menu::add_action(NonnullRefPtr<Action> action)
 
 void Menu::remove_all_actions()
 {
+    IPC::MessageBatch batch { ConnectionToWindowServer::the() };
     for (auto& item : m_items) {
         ConnectionToWindowServer::the().async_remove_menu_item(m_menu_id, item->identifier());
     }
@@ -138,6 +140,9 @@ void Menu::dismiss()
 
 int Menu::realize_menu(RefPtr<Action> default_action)
 {
+    // Let WindowServer build the whole menu (including its submenus) in one go.
+    IPC::MessageBatch batch { ConnectionToWindowServer::the() };
+
     unrealize_menu();
     m_menu_id = s_menu_id_allocator.allocate();
 
@@ -7,9 +7,9 @@
 
 #pragma once
 
+#include <AK/AtomicRefCounted.h>
 #include <AK/Forward.h>
 #include <AK/Function.h>
-#include <AK/RefCounted.h>
 #include <LibCore/AnonymousBuffer.h>
 #include <LibCore/Forward.h>
 #include <LibGfx/Color.h>
@@ -88,7 +88,9 @@ enum RotationDirection {
     Clockwise
 };
 
-class Bitmap : public RefCounted<Bitmap> {
+// NOTE: Bitmaps are reference counted atomically, since the same bitmap (like a cached glyph) may be painted by
+//       several threads at once.
+class Bitmap : public AtomicRefCounted<Bitmap> {
 public:
     [[nodiscard]] static ErrorOr<NonnullRefPtr<Bitmap>> create(BitmapFormat, IntSize, int intrinsic_scale = 1);
     [[nodiscard]] static ErrorOr<NonnullRefPtr<Bitmap>> create_shareable(BitmapFormat, IntSize, int intrinsic_scale = 1);
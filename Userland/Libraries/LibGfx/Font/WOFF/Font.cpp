@@ -131,12 +131,10 @@ ErrorOr<NonnullRefPtr<Font>> Font::try_load_from_externally_owned_memory(Readonl
         if (font_buffer_offset + entry.orig_length > font_buffer.size())
             return Error::from_string_literal("Uncompressed WOFF table too big");
         if (entry.comp_length < entry.orig_length) {
-            auto compressed_data_stream = make<FixedMemoryStream>(buffer.slice(entry.offset, entry.comp_length));
-            auto decompressor = TRY(Compress::ZlibDecompressor::create(move(compressed_data_stream)));
-            auto decompressed = TRY(decompressor->read_until_eof());
-            if (entry.orig_length != decompressed.size())
+            auto table_buffer = font_buffer.bytes().slice(font_buffer_offset, entry.orig_length);
+            auto decompressed_size = TRY(Compress::ZlibDecompressor::decompress_into(buffer.slice(entry.offset, entry.comp_length), table_buffer));
+            if (entry.orig_length != decompressed_size)
                 return Error::from_string_literal("Invalid decompressed WOFF table length");
-            font_buffer.overwrite(font_buffer_offset, decompressed.data(), entry.orig_length);
         } else {
             if (entry.comp_length != entry.orig_length)
                 return Error::from_string_literal("Invalid uncompressed WOFF table length");
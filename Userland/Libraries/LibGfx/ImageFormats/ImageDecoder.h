@@ -28,6 +28,14 @@ struct VectorImageFrameDescriptor {
     int duration { 0 };
 };
 
+// The largest factor by which an image can be shrunk in both dimensions while staying at least as large as ideal_size.
+inline int downscale_factor_for_ideal_size(IntSize size, Optional<IntSize> ideal_size)
+{
+    if (!ideal_size.has_value() || ideal_size->is_empty())
+        return 1;
+    return max(1, min(size.width() / ideal_size->width(), size.height() / ideal_size->height()));
+}
+
 class ImageDecoderPlugin {
 public:
     virtual ~ImageDecoderPlugin() = default;
@@ -50,9 +58,15 @@ public:
     virtual size_t frame_count() { return 1; }
     virtual size_t first_animated_frame_index() { return 0; }
 
+    // Vector formats render the frame at ideal_size. Raster formats that can decode a smaller image for less than the
+    // full-size one may return a bitmap that's smaller than size(), but never smaller than ideal_size.
     virtual ErrorOr<ImageFrameDescriptor> frame(size_t index, Optional<IntSize> ideal_size = {}) = 0;
     virtual ErrorOr<Optional<ReadonlyBytes>> icc_data() { return OptionalNone {}; }
 
+    // Decodes as much of a frame as the data passed to create() allows, so that images can be shown while they're still
+    // being downloaded. Override this if the format can show something useful before all of its data has arrived.
+    virtual ErrorOr<ImageFrameDescriptor> partial_frame(size_t index) { return frame(index); }
+
     virtual bool is_vector() { return false; }
     virtual ErrorOr<VectorImageFrameDescriptor> vector_frame(size_t) { VERIFY_NOT_REACHED(); }
 
@@ -73,6 +87,7 @@ public:
     size_t frame_count() const { return m_plugin->frame_count(); }
     size_t first_animated_frame_index() const { return m_plugin->first_animated_frame_index(); }
     ErrorOr<ImageFrameDescriptor> frame(size_t index, Optional<IntSize> ideal_size = {}) const { return m_plugin->frame(index, ideal_size); }
+    ErrorOr<ImageFrameDescriptor> partial_frame(size_t index) const { return m_plugin->partial_frame(index); }
     ErrorOr<Optional<ReadonlyBytes>> icc_data() const { return m_plugin->icc_data(); }
 
     bool is_vector() { return m_plugin->is_vector(); }
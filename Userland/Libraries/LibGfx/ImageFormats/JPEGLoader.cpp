@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
 #include <AK/Debug.h>
 #include <AK/Endian.h>
 #include <AK/Error.h>
@@ -13,11 +14,14 @@
 #include <AK/Math.h>
 #include <AK/MemoryStream.h>
 #include <AK/NumericLimits.h>
+#include <AK/SIMDExtras.h>
+#include <AK/SIMDMath.h>
 #include <AK/String.h>
 #include <AK/Try.h>
 #include <AK/Vector.h>
 #include <LibGfx/ImageFormats/JPEGLoader.h>
 #include <LibGfx/ImageFormats/JPEGShared.h>
+#include <LibThreading/Thread.h>
 
 namespace Gfx {
 
@@ -224,6 +228,51 @@ public:
         return m_byte_offset;
     }
 
+    struct EntropyCodedSegment {
+        Vector<u8> data;
+        // Where each restart interval but the first begins in the data, right after its RST marker.
+        Vector<size_t> restart_interval_offsets;
+        bool is_complete { false };
+    };
+
+    // Reads the entropy-coded data verbatim, up to and including the marker that ends it. That marker is saved, just
+    // like HuffmanStream does when it runs into it. If the data ends before that marker, the segment is incomplete.
+    ErrorOr<EntropyCodedSegment> read_entropy_coded_segment()
+    {
+        EntropyCodedSegment segment;
+        bool last_byte_was_ff = false;
+        while (true) {
+            if (m_byte_offset == m_current_size && refill_buffer().is_error())
+                return segment;
+
+            u8 const byte = m_buffer[m_byte_offset++];
+            TRY(segment.data.try_append(byte));
+
+            if (!last_byte_was_ff) {
+                last_byte_was_ff = byte == 0xFF;
+                continue;
+            }
+
+            // Any number of 0xFF bytes can precede a marker.
+            if (byte == 0xFF)
+                continue;
+
+            last_byte_was_ff = false;
+            if (byte == 0x00)
+                continue;
+
+            Marker const marker = 0xFF00 | byte;
+            if (marker >= JPEG_RST0 && marker <= JPEG_RST7) {
+                TRY(segment.restart_interval_offsets.try_append(segment.data.size()));
+                continue;
+            }
+
+            m_saved_marker = marker;
+            segment.is_complete = true;
+            return segment;
+        }
+    }
+
 private:
     JPEGStream(NonnullOwnPtr<Stream> stream, Vector<u8> buffer)
         : m_stream(move(stream))
@@ -388,6 +437,17 @@ struct Scan {
     {
     }
 
+    // Restart intervals can be decoded independently of each other, each from its own stream.
+    Scan(Scan const& other, HuffmanStream stream)
+        : components(other.components)
+        , spectral_selection_start(other.spectral_selection_start)
+        , spectral_selection_end(other.spectral_selection_end)
+        , successive_approximation_high(other.successive_approximation_high)
+        , successive_approximation_low(other.successive_approximation_low)
+        , huffman_stream(stream)
+    {
+    }
+
     // B.2.3 - Scan header syntax
     Vector<ScanComponent, 4> components;
 
@@ -399,6 +459,10 @@ struct Scan {
     HuffmanStream huffman_stream;
 
     u64 end_of_bands_run_count { 0 };
+    Array<i16, 4> previous_dc_values {};
+
+    // The number of MCUs decoded since the start of the stream, which tells where restart intervals end.
+    u32 decoded_mcu_count { 0 };
 
     // See the note on Figure B.4 - Scan header syntax
     bool are_components_interleaved() const
@@ -444,6 +508,11 @@ struct JPEGLoadingContext {
     u8 hsample_factor { 0 };
     u8 vsample_factor { 0 };
 
+    // Images can be decoded at 1/2, 1/4 or 1/8 of their size, in which case each block only yields 4x4, 2x2 or 1x1
+    // pixels. They are stored in the top-left corner of the block.
+    u8 scale_denominator { 1 };
+    u8 scaled_block_size() const { return 8 / scale_denominator; }
+
     Optional<Scan> current_scan {};
 
     Vector<Component, 4> components;
@@ -451,7 +520,6 @@ struct JPEGLoadingContext {
     u16 dc_restart_interval { 0 };
     HashMap<u8, HuffmanTable> dc_tables;
     HashMap<u8, HuffmanTable> ac_tables;
-    Array<i16, 4> previous_dc_values {};
     MacroblockMeta mblock_meta;
     JPEGStream stream;
     JPEGDecoderOptions options;
@@ -495,7 +563,7 @@ enum class JPEGDecodingMode {
 };
 
 template<JPEGDecodingMode DecodingMode>
-static ErrorOr<void> add_dc(JPEGLoadingContext& context, Macroblock& macroblock, ScanComponent const& scan_component)
+static ErrorOr<void> add_dc(JPEGLoadingContext const& context, Scan& scan, Macroblock& macroblock, ScanComponent const& scan_component)
 {
     auto maybe_table = context.dc_tables.get(scan_component.dc_destination_id);
     if (!maybe_table.has_value()) {
@@ -504,7 +572,6 @@ static ErrorOr<void> add_dc(JPEGLoadingContext& context, Macroblock& macroblock,
     }
 
     auto& dc_table = maybe_table.value();
-    auto& scan = *context.current_scan;
 
     auto* select_component = get_component(macroblock, scan_component.component.index);
     auto& coefficient = select_component[0];
@@ -532,7 +599,7 @@ static ErrorOr<void> add_dc(JPEGLoadingContext& context, Macroblock& macroblock,
     if (dc_length != 0 && dc_diff < (1 << (dc_length - 1)))
         dc_diff -= (1 << dc_length) - 1;
 
-    auto& previous_dc = context.previous_dc_values[scan_component.component.index];
+    auto& previous_dc = scan.previous_dc_values[scan_component.component.index];
     previous_dc += dc_diff;
     coefficient = previous_dc << scan.successive_approximation_low;
 
@@ -576,7 +643,7 @@ static bool is_progressive(StartOfFrame::FrameType frame_type)
 }
 
 template<JPEGDecodingMode DecodingMode>
-static ErrorOr<void> add_ac(JPEGLoadingContext& context, Macroblock& macroblock, ScanComponent const& scan_component)
+static ErrorOr<void> add_ac(JPEGLoadingContext const& context, Scan& scan, Macroblock& macroblock, ScanComponent const& scan_component)
 {
     auto maybe_table = context.ac_tables.get(scan_component.ac_destination_id);
     if (!maybe_table.has_value()) {
@@ -587,8 +654,6 @@ static ErrorOr<void> add_ac(JPEGLoadingContext& context, Macroblock& macroblock,
     auto& ac_table = maybe_table.value();
     auto* select_component = get_component(macroblock, scan_component.component.index);
 
-    auto& scan = *context.current_scan;
-
     // Compute the AC coefficients.
 
     // 0th coefficient is the dc, which is already handled
@@ -694,6 +759,50 @@ static ErrorOr<void> add_ac(JPEGLoadingContext& context, Macroblock& macroblock,
     return {};
 }
 
+static bool is_dct_based(StartOfFrame::FrameType frame_type)
+{
+    return frame_type == StartOfFrame::FrameType::Baseline_DCT
+        || frame_type == StartOfFrame::FrameType::Extended_Sequential_DCT
+        || frame_type == StartOfFrame::FrameType::Progressive_DCT
+        || frame_type == StartOfFrame::FrameType::Differential_Sequential_DCT
+        || frame_type == StartOfFrame::FrameType::Differential_Progressive_DCT
+        || frame_type == StartOfFrame::FrameType::Progressive_DCT_Arithmetic
+        || frame_type == StartOfFrame::FrameType::Differential_Sequential_DCT_Arithmetic
+        || frame_type == StartOfFrame::FrameType::Differential_Progressive_DCT_Arithmetic;
+}
+
+static void reset_decoder(JPEGLoadingContext const& context, Scan& scan)
+{
+    // G.1.2.2 - Progressive encoding of AC coefficients with Huffman coding
+    scan.end_of_bands_run_count = 0;
+
+    // E.2.4 Control procedure for decoding a restart interval
+    if (is_dct_based(context.frame.type)) {
+        scan.previous_dc_values = {};
+        return;
+    }
+
+    VERIFY_NOT_REACHED();
+}
+
+static ErrorOr<void> start_next_mcu(JPEGLoadingContext const& context, Scan& scan)
+{
+    // E.2.4 Control procedure for decoding a restart interval
+    // Restart intervals are counted in MCUs, which are single blocks in scans that aren't interleaved.
+    if (context.dc_restart_interval > 0 && scan.decoded_mcu_count > 0 && scan.decoded_mcu_count % context.dc_restart_interval == 0) {
+        reset_decoder(context, scan);
+
+        // Restart markers are stored in byte boundaries. Advance the huffman stream cursor to
+        //  the 0th bit of the next byte.
+        TRY(scan.huffman_stream.advance_to_byte_boundary());
+
+        // Skip the restart marker (RSTn).
+        TRY(scan.huffman_stream.discard_bits(8));
+    }
+    ++scan.decoded_mcu_count;
+    return {};
+}
+
 /**
  * Build the macroblocks possible by reading single (MCU) subsampled pair of CbCr.
  * Depending on the sampling factors, we may not see triples of y, cb, cr in that
@@ -710,14 +819,17 @@ static ErrorOr<void> add_ac(JPEGLoadingContext& context, Macroblock& macroblock,
  * we are dealing with three components) will fill up the blocks with chroma data.
  */
 template<JPEGDecodingMode DecodingMode>
-static ErrorOr<void> build_macroblocks(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks, u32 hcursor, u32 vcursor)
+static ErrorOr<void> build_macroblocks(JPEGLoadingContext const& context, Scan& scan, Vector<Macroblock>& macroblocks, u32 hcursor, u32 vcursor)
 {
-    for (auto const& scan_component : context.current_scan->components) {
+    if (scan.are_components_interleaved())
+        TRY(start_next_mcu(context, scan));
+
+    for (auto const& scan_component : scan.components) {
         for (u8 vfactor_i = 0; vfactor_i < scan_component.component.vsample_factor; vfactor_i++) {
             for (u8 hfactor_i = 0; hfactor_i < scan_component.component.hsample_factor; hfactor_i++) {
                 // A.2.3 - Interleaved order
                 u32 macroblock_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
-                if (!context.current_scan->are_components_interleaved()) {
+                if (!scan.are_components_interleaved()) {
                     macroblock_index = vcursor * context.mblock_meta.hpadded_count + (hfactor_i + (hcursor * scan_component.component.vsample_factor) + (vfactor_i * scan_component.component.hsample_factor));
 
                     // A.2.4 Completion of partial MCU
@@ -730,22 +842,24 @@ static ErrorOr<void> build_macroblocks(JPEGLoadingContext& context, Vector<Macro
                     // Vertically
                     if (macroblock_index >= context.mblock_meta.hpadded_count * context.mblock_meta.vcount)
                         continue;
+
+                    TRY(start_next_mcu(context, scan));
                 }
 
                 Macroblock& block = macroblocks[macroblock_index];
 
                 if constexpr (DecodingMode == JPEGDecodingMode::Sequential) {
-                    TRY(add_dc<DecodingMode>(context, block, scan_component));
-                    TRY(add_ac<DecodingMode>(context, block, scan_component));
+                    TRY(add_dc<DecodingMode>(context, scan, block, scan_component));
+                    TRY(add_ac<DecodingMode>(context, scan, block, scan_component));
                 } else {
-                    if (context.current_scan->spectral_selection_start == 0)
-                        TRY(add_dc<DecodingMode>(context, block, scan_component));
-                    if (context.current_scan->spectral_selection_end != 0)
-                        TRY(add_ac<DecodingMode>(context, block, scan_component));
+                    if (scan.spectral_selection_start == 0)
+                        TRY(add_dc<DecodingMode>(context, scan, block, scan_component));
+                    if (scan.spectral_selection_end != 0)
+                        TRY(add_ac<DecodingMode>(context, scan, block, scan_component));
 
                     // G.1.2.2 - Progressive encoding of AC coefficients with Huffman coding
-                    if (context.current_scan->end_of_bands_run_count > 0) {
-                        --context.current_scan->end_of_bands_run_count;
+                    if (scan.end_of_bands_run_count > 0) {
+                        --scan.end_of_bands_run_count;
                         continue;
                     }
                 }
@@ -756,71 +870,131 @@ static ErrorOr<void> build_macroblocks(JPEGLoadingContext& context, Vector<Macro
     return {};
 }
 
-static bool is_dct_based(StartOfFrame::FrameType frame_type)
+// The MCU positions of a scan, in the order they are coded. In scans that aren't interleaved, a position is the group of
+// blocks of the component that an MCU of an interleaved scan would contain.
+static u32 mcu_positions_per_row(JPEGLoadingContext const& context)
 {
-    return frame_type == StartOfFrame::FrameType::Baseline_DCT
-        || frame_type == StartOfFrame::FrameType::Extended_Sequential_DCT
-        || frame_type == StartOfFrame::FrameType::Progressive_DCT
-        || frame_type == StartOfFrame::FrameType::Differential_Sequential_DCT
-        || frame_type == StartOfFrame::FrameType::Differential_Progressive_DCT
-        || frame_type == StartOfFrame::FrameType::Progressive_DCT_Arithmetic
-        || frame_type == StartOfFrame::FrameType::Differential_Sequential_DCT_Arithmetic
-        || frame_type == StartOfFrame::FrameType::Differential_Progressive_DCT_Arithmetic;
+    return ceil_div(context.mblock_meta.hcount, static_cast<u32>(context.hsample_factor));
 }
 
-static void reset_decoder(JPEGLoadingContext& context)
+static u32 mcu_position_count(JPEGLoadingContext const& context)
 {
-    // G.1.2.2 - Progressive encoding of AC coefficients with Huffman coding
-    context.current_scan->end_of_bands_run_count = 0;
-
-    // E.2.4 Control procedure for decoding a restart interval
-    if (is_dct_based(context.frame.type)) {
-        context.previous_dc_values = {};
-        return;
-    }
-
-    VERIFY_NOT_REACHED();
+    return mcu_positions_per_row(context) * ceil_div(context.mblock_meta.vcount, static_cast<u32>(context.vsample_factor));
 }
 
-static ErrorOr<void> decode_huffman_stream(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks)
+static ErrorOr<void> decode_mcus(JPEGLoadingContext const& context, Scan& scan, Vector<Macroblock>& macroblocks, u32 first_position, u32 end_position)
 {
-    for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.vsample_factor) {
-        for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.hsample_factor) {
-            u32 i = vcursor * context.mblock_meta.hpadded_count + hcursor;
+    auto const positions_per_row = mcu_positions_per_row(context);
+    for (u32 position = first_position; position < end_position; ++position) {
+        u32 const vcursor = position / positions_per_row * context.vsample_factor;
+        u32 const hcursor = position % positions_per_row * context.hsample_factor;
+
+        auto result = [&]() {
+            if (is_progressive(context.frame.type))
+                return build_macroblocks<JPEGDecodingMode::Progressive>(context, scan, macroblocks, hcursor, vcursor);
+            return build_macroblocks<JPEGDecodingMode::Sequential>(context, scan, macroblocks, hcursor, vcursor);
+        }();
+
+        if (result.is_error()) {
+            if constexpr (JPEG_DEBUG) {
+                dbgln("Failed to build Macroblock {}: {}", vcursor * context.mblock_meta.hpadded_count + hcursor, result.error());
+                dbgln("Huffman stream byte offset {}", context.stream.byte_offset());
+            }
+            return result.release_error();
+        }
+    }
+    return {};
+}
 
-            auto& huffman_stream = context.current_scan->huffman_stream;
+// Decoding restart intervals on other threads only pays off if each thread gets enough of them.
+static constexpr u32 minimum_mcus_per_task = 256;
 
-            if (context.dc_restart_interval > 0) {
-                if (i != 0 && i % (context.dc_restart_interval * context.vsample_factor * context.hsample_factor) == 0) {
-                    reset_decoder(context);
+static size_t thread_count_for_current_scan(JPEGLoadingContext const& context)
+{
+    // Only interleaved scans are split, as that's what sequential images consist of, and their MCUs map directly to
+    // positions.
+    if (context.options.thread_count <= 1 || context.dc_restart_interval == 0 || !context.current_scan->are_components_interleaved())
+        return 1;
+    auto const intervals_per_task = ceil_div(minimum_mcus_per_task, static_cast<u32>(context.dc_restart_interval));
+    auto const task_count = ceil_div(mcu_position_count(context), intervals_per_task * context.dc_restart_interval);
+    return min(context.options.thread_count, static_cast<size_t>(task_count));
+}
 
-                    // Restart markers are stored in byte boundaries. Advance the huffman stream cursor to
-                    //  the 0th bit of the next byte.
-                    TRY(huffman_stream.advance_to_byte_boundary());
+static ErrorOr<void> decode_restart_intervals_on_threads(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks, size_t thread_count)
+{
+    // The data of every restart interval has to be found before any of them can be decoded, so the whole scan is read
+    // up front. Data that ends early or has restart markers missing is decoded in one go instead, so that it stops at
+    // the same point as it otherwise would.
+    auto segment = TRY(context.stream.read_entropy_coded_segment());
+    auto const interval_size = static_cast<u32>(context.dc_restart_interval);
+    auto const position_count = mcu_position_count(context);
+    auto const interval_count = ceil_div(position_count, interval_size);
+    if (!segment.is_complete || segment.restart_interval_offsets.size() != interval_count - 1) {
+        auto stream = TRY(JPEGStream::create(TRY(try_make<FixedMemoryStream>(segment.data.span()))));
+        Scan scan(*context.current_scan, HuffmanStream { stream });
+        return decode_mcus(context, scan, macroblocks, 0, position_count);
+    }
+
+    // Consecutive intervals are grouped into tasks that each read from their own stream.
+    auto const intervals_per_task = ceil_div(minimum_mcus_per_task, interval_size);
+    auto const task_count = ceil_div(interval_count, intervals_per_task);
+    auto decode_task = [&](u32 task) -> ErrorOr<void> {
+        auto const first_interval = task * intervals_per_task;
+        auto const data_offset = first_interval == 0 ? 0 : segment.restart_interval_offsets[first_interval - 1];
+        auto stream = TRY(JPEGStream::create(TRY(try_make<FixedMemoryStream>(segment.data.span().slice(data_offset)))));
+        Scan scan(*context.current_scan, HuffmanStream { stream });
+        auto const first_position = first_interval * interval_size;
+        auto const end_position = min(first_position + intervals_per_task * interval_size, position_count);
+        return decode_mcus(context, scan, macroblocks, first_position, end_position);
+    };
 
-                    // Skip the restart marker (RSTn).
-                    TRY(huffman_stream.discard_bits(8));
-                }
+    Atomic<u32> next_task { 0 };
+    Atomic<bool> has_failed { false };
+    Vector<Optional<Error>> errors;
+    TRY(errors.try_resize(task_count));
+    auto decode_tasks = [&] {
+        while (!has_failed) {
+            auto const task = next_task.fetch_add(1);
+            if (task >= task_count)
+                return;
+            if (auto result = decode_task(task); result.is_error()) {
+                errors[task] = result.release_error();
+                has_failed = true;
             }
+        }
+    };
 
-            auto result = [&]() {
-                if (is_progressive(context.frame.type))
-                    return build_macroblocks<JPEGDecodingMode::Progressive>(context, macroblocks, hcursor, vcursor);
-                return build_macroblocks<JPEGDecodingMode::Sequential>(context, macroblocks, hcursor, vcursor);
-            }();
+    Vector<NonnullRefPtr<Threading::Thread>> threads;
+    for (size_t i = 1; i < thread_count; ++i) {
+        auto thread_or_error = Threading::Thread::try_create([&] {
+            decode_tasks();
+            return 0;
+        },
+            "JPEG decoder"sv);
+        // Whatever isn't picked up by other threads is decoded on this one.
+        if (thread_or_error.is_error() || threads.try_append(thread_or_error.value()).is_error())
+            break;
+        threads.last()->start();
+    }
 
-            if (result.is_error()) {
-                if constexpr (JPEG_DEBUG) {
-                    dbgln("Failed to build Macroblock {}: {}", i, result.error());
-                    dbgln("Huffman stream byte offset {}", context.stream.byte_offset());
-                }
-                return result.release_error();
-            }
-        }
+    decode_tasks();
+    for (auto& thread : threads)
+        (void)thread->join();
+
+    for (auto& error : errors) {
+        if (error.has_value())
+            return error.release_value();
     }
     return {};
 }
 
+static ErrorOr<void> decode_huffman_stream(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks)
+{
+    if (auto thread_count = thread_count_for_current_scan(context); thread_count > 1)
+        return decode_restart_intervals_on_threads(context, macroblocks, thread_count);
+    return decode_mcus(context, *context.current_scan, macroblocks, 0, mcu_position_count(context));
+}
+
 static bool is_frame_marker(Marker const marker)
 {
     // B.1.1.3 - Marker assignments
@@ -1354,37 +1528,14 @@ static ErrorOr<void> skip_segment(JPEGStream& stream)
     return {};
 }
 
-static ErrorOr<void> dequantize(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks)
+static void dequantize(Array<u16, 64> const& table, i16* block_component)
 {
-    for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.vsample_factor) {
-        for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.hsample_factor) {
-            for (u32 i = 0; i < context.components.size(); i++) {
-                auto const& component = context.components[i];
-
-                if (!context.quantization_tables[component.quantization_table_id].has_value()) {
-                    dbgln_if(JPEG_DEBUG, "Unknown quantization table id: {}!", component.quantization_table_id);
-                    return Error::from_string_literal("Unknown quantization table id");
-                }
-
-                auto const& table = context.quantization_tables[component.quantization_table_id].value();
-
-                for (u32 vfactor_i = 0; vfactor_i < component.vsample_factor; vfactor_i++) {
-                    for (u32 hfactor_i = 0; hfactor_i < component.hsample_factor; hfactor_i++) {
-                        u32 macroblock_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
-                        Macroblock& block = macroblocks[macroblock_index];
-                        auto* block_component = get_component(block, i);
-                        for (u32 k = 0; k < 64; k++)
-                            block_component[k] *= table[k];
-                    }
-                }
-            }
-        }
-    }
-
-    return {};
+    for (u32 k = 0; k < 64; k++)
+        block_component[k] *= table[k];
 }
 
-static void inverse_dct(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks)
+// One dimension of the inverse DCT, done for eight columns at once: each vector holds one row of the block.
+static ALWAYS_INLINE void inverse_dct_columns(Array<AK::SIMD::f32x8, 8>& rows)
 {
     static float const m0 = 2.0f * AK::cos(1.0f / 16.0f * 2.0f * AK::Pi<float>);
     static float const m1 = 2.0f * AK::cos(2.0f / 16.0f * 2.0f * AK::Pi<float>);
@@ -1401,184 +1552,229 @@ static void inverse_dct(JPEGLoadingContext const& context, Vector<Macroblock>& m
     static float const s6 = AK::cos(6.0f / 16.0f * AK::Pi<float>) / 2.0f;
     static float const s7 = AK::cos(7.0f / 16.0f * AK::Pi<float>) / 2.0f;
 
-    for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.vsample_factor) {
-        for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.hsample_factor) {
-            for (u32 component_i = 0; component_i < context.components.size(); component_i++) {
-                auto& component = context.components[component_i];
-                for (u8 vfactor_i = 0; vfactor_i < component.vsample_factor; vfactor_i++) {
-                    for (u8 hfactor_i = 0; hfactor_i < component.hsample_factor; hfactor_i++) {
-                        u32 macroblock_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
-                        Macroblock& block = macroblocks[macroblock_index];
-                        auto* block_component = get_component(block, component_i);
-                        for (u32 k = 0; k < 8; ++k) {
-                            float const g0 = block_component[0 * 8 + k] * s0;
-                            float const g1 = block_component[4 * 8 + k] * s4;
-                            float const g2 = block_component[2 * 8 + k] * s2;
-                            float const g3 = block_component[6 * 8 + k] * s6;
-                            float const g4 = block_component[5 * 8 + k] * s5;
-                            float const g5 = block_component[1 * 8 + k] * s1;
-                            float const g6 = block_component[7 * 8 + k] * s7;
-                            float const g7 = block_component[3 * 8 + k] * s3;
-
-                            float const f0 = g0;
-                            float const f1 = g1;
-                            float const f2 = g2;
-                            float const f3 = g3;
-                            float const f4 = g4 - g7;
-                            float const f5 = g5 + g6;
-                            float const f6 = g5 - g6;
-                            float const f7 = g4 + g7;
-
-                            float const e0 = f0;
-                            float const e1 = f1;
-                            float const e2 = f2 - f3;
-                            float const e3 = f2 + f3;
-                            float const e4 = f4;
-                            float const e5 = f5 - f7;
-                            float const e6 = f6;
-                            float const e7 = f5 + f7;
-                            float const e8 = f4 + f6;
-
-                            float const d0 = e0;
-                            float const d1 = e1;
-                            float const d2 = e2 * m1;
-                            float const d3 = e3;
-                            float const d4 = e4 * m2;
-                            float const d5 = e5 * m3;
-                            float const d6 = e6 * m4;
-                            float const d7 = e7;
-                            float const d8 = e8 * m5;
-
-                            float const c0 = d0 + d1;
-                            float const c1 = d0 - d1;
-                            float const c2 = d2 - d3;
-                            float const c3 = d3;
-                            float const c4 = d4 + d8;
-                            float const c5 = d5 + d7;
-                            float const c6 = d6 - d8;
-                            float const c7 = d7;
-                            float const c8 = c5 - c6;
-
-                            float const b0 = c0 + c3;
-                            float const b1 = c1 + c2;
-                            float const b2 = c1 - c2;
-                            float const b3 = c0 - c3;
-                            float const b4 = c4 - c8;
-                            float const b5 = c8;
-                            float const b6 = c6 - c7;
-                            float const b7 = c7;
-
-                            block_component[0 * 8 + k] = b0 + b7;
-                            block_component[1 * 8 + k] = b1 + b6;
-                            block_component[2 * 8 + k] = b2 + b5;
-                            block_component[3 * 8 + k] = b3 + b4;
-                            block_component[4 * 8 + k] = b3 - b4;
-                            block_component[5 * 8 + k] = b2 - b5;
-                            block_component[6 * 8 + k] = b1 - b6;
-                            block_component[7 * 8 + k] = b0 - b7;
-                        }
-                        for (u32 l = 0; l < 8; ++l) {
-                            float const g0 = block_component[l * 8 + 0] * s0;
-                            float const g1 = block_component[l * 8 + 4] * s4;
-                            float const g2 = block_component[l * 8 + 2] * s2;
-                            float const g3 = block_component[l * 8 + 6] * s6;
-                            float const g4 = block_component[l * 8 + 5] * s5;
-                            float const g5 = block_component[l * 8 + 1] * s1;
-                            float const g6 = block_component[l * 8 + 7] * s7;
-                            float const g7 = block_component[l * 8 + 3] * s3;
-
-                            float const f0 = g0;
-                            float const f1 = g1;
-                            float const f2 = g2;
-                            float const f3 = g3;
-                            float const f4 = g4 - g7;
-                            float const f5 = g5 + g6;
-                            float const f6 = g5 - g6;
-                            float const f7 = g4 + g7;
-
-                            float const e0 = f0;
-                            float const e1 = f1;
-                            float const e2 = f2 - f3;
-                            float const e3 = f2 + f3;
-                            float const e4 = f4;
-                            float const e5 = f5 - f7;
-                            float const e6 = f6;
-                            float const e7 = f5 + f7;
-                            float const e8 = f4 + f6;
-
-                            float const d0 = e0;
-                            float const d1 = e1;
-                            float const d2 = e2 * m1;
-                            float const d3 = e3;
-                            float const d4 = e4 * m2;
-                            float const d5 = e5 * m3;
-                            float const d6 = e6 * m4;
-                            float const d7 = e7;
-                            float const d8 = e8 * m5;
-
-                            float const c0 = d0 + d1;
-                            float const c1 = d0 - d1;
-                            float const c2 = d2 - d3;
-                            float const c3 = d3;
-                            float const c4 = d4 + d8;
-                            float const c5 = d5 + d7;
-                            float const c6 = d6 - d8;
-                            float const c7 = d7;
-                            float const c8 = c5 - c6;
-
-                            float const b0 = c0 + c3;
-                            float const b1 = c1 + c2;
-                            float const b2 = c1 - c2;
-                            float const b3 = c0 - c3;
-                            float const b4 = c4 - c8;
-                            float const b5 = c8;
-                            float const b6 = c6 - c7;
-                            float const b7 = c7;
-
-                            block_component[l * 8 + 0] = b0 + b7;
-                            block_component[l * 8 + 1] = b1 + b6;
-                            block_component[l * 8 + 2] = b2 + b5;
-                            block_component[l * 8 + 3] = b3 + b4;
-                            block_component[l * 8 + 4] = b3 - b4;
-                            block_component[l * 8 + 5] = b2 - b5;
-                            block_component[l * 8 + 6] = b1 - b6;
-                            block_component[l * 8 + 7] = b0 - b7;
-                        }
-                    }
-                }
-            }
+    auto const g0 = rows[0] * s0;
+    auto const g1 = rows[4] * s4;
+    auto const g2 = rows[2] * s2;
+    auto const g3 = rows[6] * s6;
+    auto const g4 = rows[5] * s5;
+    auto const g5 = rows[1] * s1;
+    auto const g6 = rows[7] * s7;
+    auto const g7 = rows[3] * s3;
+
+    auto const f0 = g0;
+    auto const f1 = g1;
+    auto const f2 = g2;
+    auto const f3 = g3;
+    auto const f4 = g4 - g7;
+    auto const f5 = g5 + g6;
+    auto const f6 = g5 - g6;
+    auto const f7 = g4 + g7;
+
+    auto const e0 = f0;
+    auto const e1 = f1;
+    auto const e2 = f2 - f3;
+    auto const e3 = f2 + f3;
+    auto const e4 = f4;
+    auto const e5 = f5 - f7;
+    auto const e6 = f6;
+    auto const e7 = f5 + f7;
+    auto const e8 = f4 + f6;
+
+    auto const d0 = e0;
+    auto const d1 = e1;
+    auto const d2 = e2 * m1;
+    auto const d3 = e3;
+    auto const d4 = e4 * m2;
+    auto const d5 = e5 * m3;
+    auto const d6 = e6 * m4;
+    auto const d7 = e7;
+    auto const d8 = e8 * m5;
+
+    auto const c0 = d0 + d1;
+    auto const c1 = d0 - d1;
+    auto const c2 = d2 - d3;
+    auto const c3 = d3;
+    auto const c4 = d4 + d8;
+    auto const c5 = d5 + d7;
+    auto const c6 = d6 - d8;
+    auto const c7 = d7;
+    auto const c8 = c5 - c6;
+
+    auto const b0 = c0 + c3;
+    auto const b1 = c1 + c2;
+    auto const b2 = c1 - c2;
+    auto const b3 = c0 - c3;
+    auto const b4 = c4 - c8;
+    auto const b5 = c8;
+    auto const b6 = c6 - c7;
+    auto const b7 = c7;
+
+    rows[0] = b0 + b7;
+    rows[1] = b1 + b6;
+    rows[2] = b2 + b5;
+    rows[3] = b3 + b4;
+    rows[4] = b3 - b4;
+    rows[5] = b2 - b5;
+    rows[6] = b1 - b6;
+    rows[7] = b0 - b7;
+}
+
+static ALWAYS_INLINE void transpose(Array<AK::SIMD::f32x8, 8>& rows)
+{
+    Array<AK::SIMD::f32x8, 8> columns;
+    for (u8 column = 0; column < 8; ++column)
+        columns[column] = AK::SIMD::f32x8 { rows[0][column], rows[1][column], rows[2][column], rows[3][column], rows[4][column], rows[5][column], rows[6][column], rows[7][column] };
+    rows = columns;
+}
+
+// Vectors of eight floats are only ever passed by reference, as passing them by value without AVX changes the ABI.
+static ALWAYS_INLINE AK::SIMD::i16x8 to_i16x8(AK::SIMD::f32x8 const& value)
+{
+    return __builtin_convertvector(__builtin_convertvector(value, AK::SIMD::i32x8), AK::SIMD::i16x8);
+}
+
+static void inverse_dct(i16* block_component)
+{
+    Array<AK::SIMD::f32x8, 8> rows;
+    for (u8 row = 0; row < 8; ++row) {
+        AK::SIMD::i16x8 samples;
+        __builtin_memcpy(&samples, block_component + row * 8, sizeof(samples));
+        rows[row] = __builtin_convertvector(samples, AK::SIMD::f32x8);
+    }
+
+    // The samples are stored as integers between the two passes, so they are truncated in between them as well.
+    inverse_dct_columns(rows);
+    for (auto& row : rows)
+        row = __builtin_convertvector(to_i16x8(row), AK::SIMD::f32x8);
+
+    // The rows are transformed the same way after transposing the block.
+    transpose(rows);
+    inverse_dct_columns(rows);
+    transpose(rows);
+
+    for (u8 row = 0; row < 8; ++row) {
+        auto const samples = to_i16x8(rows[row]);
+        __builtin_memcpy(block_component + row * 8, &samples, sizeof(samples));
+    }
+}
+
+// The basis functions used by inverse_dct_scaled().
+using ScaledInverseDCTBasis = Array<Array<float, 4>, 4>;
+
+static ScaledInverseDCTBasis scaled_inverse_dct_basis(u8 block_size)
+{
+    // The same basis functions as the full inverse DCT, sampled at the center of each group of 8 / block_size pixels.
+    ScaledInverseDCTBasis basis {};
+    for (u8 x = 0; x < block_size; ++x) {
+        for (u8 u = 0; u < block_size; ++u) {
+            auto const scale = u == 0 ? AK::rsqrt(8.0f) : 0.5f;
+            basis[x][u] = scale * AK::cos((2 * x + 1) * u * AK::Pi<float> / (2 * block_size));
+        }
+    }
+    return basis;
+}
+
+// Computes the inverse DCT of only the lowest frequencies of the block, which directly yields the block at a reduced
+// size. This is much cheaper than doing the full inverse DCT and scaling the result down afterwards.
+static void inverse_dct_scaled(ScaledInverseDCTBasis const& basis, u8 block_size, i16* block_component)
+{
+    VERIFY(block_size < 8);
+
+    Array<Array<float, 4>, 4> columns {};
+    for (u8 u = 0; u < block_size; ++u) {
+        for (u8 y = 0; y < block_size; ++y) {
+            for (u8 v = 0; v < block_size; ++v)
+                columns[y][u] += basis[y][v] * block_component[v * 8 + u];
         }
     }
 
+    for (u8 y = 0; y < block_size; ++y) {
+        for (u8 x = 0; x < block_size; ++x) {
+            float value = 0;
+            for (u8 u = 0; u < block_size; ++u)
+                value += basis[x][u] * columns[y][u];
+            block_component[y * 8 + x] = value;
+        }
+    }
+}
+
+static void level_shift_and_clamp(JPEGLoadingContext const& context, i16* block_component)
+{
     // F.2.1.5 - Inverse DCT (IDCT)
     auto const level_shift = 1 << (context.frame.precision - 1);
     auto const max_value = (1 << context.frame.precision) - 1;
+
+    // FIXME: This just truncate all coefficients, it's an easy way to support (read hack)
+    //        12 bits JPEGs without rewriting all color transformations.
+    auto const shift_to_8_bits = context.frame.precision == 8 ? 0 : 4;
+
+    for (u32 k = 0; k < 64; k++)
+        block_component[k] = clamp(block_component[k] + level_shift, 0, max_value) >> shift_to_8_bits;
+}
+
+// Turns the quantized coefficients of every block into samples. All the steps are done one block at a time, so that
+// each block only has to be brought into the cache once.
+static ErrorOr<void> reconstruct_samples(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks)
+{
+    for (auto const& component : context.components) {
+        if (!context.quantization_tables[component.quantization_table_id].has_value()) {
+            dbgln_if(JPEG_DEBUG, "Unknown quantization table id: {}!", component.quantization_table_id);
+            return Error::from_string_literal("Unknown quantization table id");
+        }
+    }
+
+    auto const block_size = context.scaled_block_size();
+    Optional<ScaledInverseDCTBasis> basis;
+    if (block_size < 8)
+        basis = scaled_inverse_dct_basis(block_size);
+
+    // The K channel is only ever read by the CMYK and YCCK conversions.
+    bool const has_k_channel = context.components.size() == 4 || context.color_transform == ColorTransform::YCCK;
+    u32 const channel_count = has_k_channel ? 4 : 3;
+
     for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.vsample_factor) {
         for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.hsample_factor) {
             for (u8 vfactor_i = 0; vfactor_i < context.vsample_factor; ++vfactor_i) {
                 for (u8 hfactor_i = 0; hfactor_i < context.hsample_factor; ++hfactor_i) {
                     u32 mb_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hcursor + hfactor_i);
-                    for (u8 i = 0; i < 8; ++i) {
-                        for (u8 j = 0; j < 8; ++j) {
-
-                            // FIXME: This just truncate all coefficients, it's an easy way to support (read hack)
-                            //        12 bits JPEGs without rewriting all color transformations.
-                            auto const clamp_to_8_bits = [&](u16 color) -> u8 {
-                                if (context.frame.precision == 8)
-                                    return static_cast<u8>(color);
-                                return static_cast<u8>(color >> 4);
-                            };
+                    Macroblock& block = macroblocks[mb_index];
+                    for (u32 component_i = 0; component_i < channel_count; ++component_i) {
+                        auto* block_component = get_component(block, component_i);
 
-                            macroblocks[mb_index].r[i * 8 + j] = clamp_to_8_bits(clamp(macroblocks[mb_index].r[i * 8 + j] + level_shift, 0, max_value));
-                            macroblocks[mb_index].g[i * 8 + j] = clamp_to_8_bits(clamp(macroblocks[mb_index].g[i * 8 + j] + level_shift, 0, max_value));
-                            macroblocks[mb_index].b[i * 8 + j] = clamp_to_8_bits(clamp(macroblocks[mb_index].b[i * 8 + j] + level_shift, 0, max_value));
-                            macroblocks[mb_index].k[i * 8 + j] = clamp_to_8_bits(clamp(macroblocks[mb_index].k[i * 8 + j] + level_shift, 0, max_value));
+                        // Components that are subsampled only have coefficients in the first blocks of each MCU.
+                        bool const has_coefficients = component_i < context.components.size()
+                            && vfactor_i < context.components[component_i].vsample_factor
+                            && hfactor_i < context.components[component_i].hsample_factor;
+                        if (has_coefficients) {
+                            dequantize(context.quantization_tables[context.components[component_i].quantization_table_id].value(), block_component);
+                            if (basis.has_value())
+                                inverse_dct_scaled(*basis, block_size, block_component);
+                            else
+                                inverse_dct(block_component);
                         }
+
+                        level_shift_and_clamp(context, block_component);
                     }
                 }
             }
         }
     }
+
+    return {};
+}
+
+// Returns the chroma of four neighbouring pixels, which share each sample in pairs if the chroma is subsampled horizontally.
+static ALWAYS_INLINE AK::SIMD::f32x4 upsample_chroma(i16 const* samples, u8 hsample_factor)
+{
+    if (hsample_factor == 2) {
+        AK::SIMD::i16x2 shared_samples;
+        __builtin_memcpy(&shared_samples, samples, sizeof(shared_samples));
+        return __builtin_convertvector(__builtin_shufflevector(shared_samples, shared_samples, 0, 0, 1, 1), AK::SIMD::f32x4);
+    }
+
+    AK::SIMD::i16x4 contiguous_samples;
+    __builtin_memcpy(&contiguous_samples, samples, sizeof(contiguous_samples));
+    return __builtin_convertvector(contiguous_samples, AK::SIMD::f32x4);
 }
 
 static void ycbcr_to_rgb(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks)
@@ -1586,29 +1782,64 @@ static void ycbcr_to_rgb(JPEGLoadingContext const& context, Vector<Macroblock>&
     // Conversion from YCbCr to RGB isn't specified in the first JPEG specification but in the JFIF extension:
     // See: https://www.itu.int/rec/dologin_pub.asp?lang=f&id=T-REC-T.871-201105-I!!PDF-E&type=items
     // 7 - Conversion to and from RGB
+    u8 const block_size = context.scaled_block_size();
+    u8 const lane_count = min<u8>(block_size, 4);
     for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.vsample_factor) {
         for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.hsample_factor) {
+            // The chroma samples of the whole MCU live in its first block, which gets overwritten by the conversion.
             u32 const chroma_block_index = vcursor * context.mblock_meta.hpadded_count + hcursor;
-            Macroblock const& chroma = macroblocks[chroma_block_index];
-            // Overflows are intentional.
-            for (u8 vfactor_i = context.vsample_factor - 1; vfactor_i < context.vsample_factor; --vfactor_i) {
-                for (u8 hfactor_i = context.hsample_factor - 1; hfactor_i < context.hsample_factor; --hfactor_i) {
+            Array<i16, 64> chroma_cb;
+            Array<i16, 64> chroma_cr;
+            __builtin_memcpy(chroma_cb.data(), macroblocks[chroma_block_index].cb, sizeof(chroma_cb));
+            __builtin_memcpy(chroma_cr.data(), macroblocks[chroma_block_index].cr, sizeof(chroma_cr));
+
+            for (u8 vfactor_i = 0; vfactor_i < context.vsample_factor; ++vfactor_i) {
+                for (u8 hfactor_i = 0; hfactor_i < context.hsample_factor; ++hfactor_i) {
                     u32 macroblock_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hcursor + hfactor_i);
                     auto* y = macroblocks[macroblock_index].y;
                     auto* cb = macroblocks[macroblock_index].cb;
                     auto* cr = macroblocks[macroblock_index].cr;
-                    for (u8 i = 7; i < 8; --i) {
-                        for (u8 j = 7; j < 8; --j) {
-                            u8 const pixel = i * 8 + j;
-                            u32 const chroma_pxrow = (i / context.vsample_factor) + 4 * vfactor_i;
-                            u32 const chroma_pxcol = (j / context.hsample_factor) + 4 * hfactor_i;
-                            u32 const chroma_pixel = chroma_pxrow * 8 + chroma_pxcol;
-                            int r = y[pixel] + 1.402f * (chroma.cr[chroma_pixel] - 128);
-                            int g = y[pixel] - 0.3441f * (chroma.cb[chroma_pixel] - 128) - 0.7141f * (chroma.cr[chroma_pixel] - 128);
-                            int b = y[pixel] + 1.772f * (chroma.cb[chroma_pixel] - 128);
-                            y[pixel] = clamp(r, 0, 255);
-                            cb[pixel] = clamp(g, 0, 255);
-                            cr[pixel] = clamp(b, 0, 255);
+
+                    Array<u8, 8> chroma_pxcols;
+                    for (u8 j = 0; j < block_size; ++j)
+                        chroma_pxcols[j] = (j / context.hsample_factor) + (block_size / 2) * hfactor_i;
+
+                    for (u8 i = 0; i < block_size; ++i) {
+                        u32 const chroma_pxrow = (i / context.vsample_factor) + (block_size / 2) * vfactor_i;
+
+                        // Four pixels are converted at once, or fewer if the blocks have been scaled down further.
+                        for (u8 j = 0; j < block_size; j += 4) {
+                            u32 const chroma_pixel = chroma_pxrow * 8 + chroma_pxcols[j];
+                            AK::SIMD::f32x4 luma {};
+                            AK::SIMD::f32x4 blue_difference {};
+                            AK::SIMD::f32x4 red_difference {};
+                            if (lane_count == 4 && context.hsample_factor <= 2) {
+                                AK::SIMD::i16x4 samples;
+                                __builtin_memcpy(&samples, y + i * 8 + j, sizeof(samples));
+                                luma = __builtin_convertvector(samples, AK::SIMD::f32x4);
+                                blue_difference = upsample_chroma(chroma_cb.data() + chroma_pixel, context.hsample_factor) - 128.0f;
+                                red_difference = upsample_chroma(chroma_cr.data() + chroma_pixel, context.hsample_factor) - 128.0f;
+                            } else {
+                                for (u8 lane = 0; lane < lane_count; ++lane) {
+                                    u32 const lane_chroma_pixel = chroma_pxrow * 8 + chroma_pxcols[j + lane];
+                                    luma[lane] = y[i * 8 + j + lane];
+                                    blue_difference[lane] = chroma_cb[lane_chroma_pixel] - 128;
+                                    red_difference[lane] = chroma_cr[lane_chroma_pixel] - 128;
+                                }
+                            }
+
+                            auto const clamp_to_u8 = [](AK::SIMD::f32x4 value) {
+                                return AK::SIMD::to_i32x4(AK::SIMD::clamp(value, 0.0f, 255.0f));
+                            };
+                            auto const r = clamp_to_u8(luma + 1.402f * red_difference);
+                            auto const g = clamp_to_u8(luma - 0.3441f * blue_difference - 0.7141f * red_difference);
+                            auto const b = clamp_to_u8(luma + 1.772f * blue_difference);
+
+                            for (u8 lane = 0; lane < lane_count; ++lane) {
+                                y[i * 8 + j + lane] = r[lane];
+                                cb[i * 8 + j + lane] = g[lane];
+                                cr[i * 8 + j + lane] = b[lane];
+                            }
                         }
                     }
                 }
@@ -1762,18 +1993,23 @@ static ErrorOr<void> handle_color_transform(JPEGLoadingContext const& context, V
 
 static ErrorOr<void> compose_bitmap(JPEGLoadingContext& context, Vector<Macroblock> const& macroblocks)
 {
-    context.bitmap = TRY(Bitmap::create(BitmapFormat::BGRx8888, { context.frame.width, context.frame.height }));
-
-    for (u32 y = context.frame.height - 1; y < context.frame.height; y--) {
-        u32 const block_row = y / 8;
-        u32 const pixel_row = y % 8;
-        for (u32 x = 0; x < context.frame.width; x++) {
-            u32 const block_column = x / 8;
-            auto& block = macroblocks[block_row * context.mblock_meta.hpadded_count + block_column];
-            u32 const pixel_column = x % 8;
-            u32 const pixel_index = pixel_row * 8 + pixel_column;
-            Color const color { (u8)block.y[pixel_index], (u8)block.cb[pixel_index], (u8)block.cr[pixel_index] };
-            context.bitmap->set_pixel(x, y, color);
+    context.bitmap = TRY(Bitmap::create(BitmapFormat::BGRx8888, { ceil_div<u16, u16>(context.frame.width, context.scale_denominator), ceil_div<u16, u16>(context.frame.height, context.scale_denominator) }));
+
+    u32 const block_size = context.scaled_block_size();
+    u32 const width = context.bitmap->width();
+    u32 const height = context.bitmap->height();
+
+    for (u32 y = 0; y < height; y++) {
+        u32 const block_row = y / block_size;
+        u32 const pixel_row = y % block_size;
+        auto* scanline = context.bitmap->scanline(y);
+        auto const* block = &macroblocks[block_row * context.mblock_meta.hpadded_count];
+        for (u32 x = 0; x < width; x += block_size, ++block) {
+            u32 const pixel_count = min(block_size, width - x);
+            for (u32 pixel_column = 0; pixel_column < pixel_count; pixel_column++) {
+                u32 const pixel_index = pixel_row * 8 + pixel_column;
+                scanline[x + pixel_column] = Color { (u8)block->y[pixel_index], (u8)block->cb[pixel_index], (u8)block->cr[pixel_index] }.value();
+            }
         }
     }
 
@@ -1896,13 +2132,12 @@ static ErrorOr<void> decode_header(JPEGLoadingContext& context)
     return {};
 }
 
-static ErrorOr<Vector<Macroblock>> construct_macroblocks(JPEGLoadingContext& context)
+static ErrorOr<void> construct_macroblocks(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks)
 {
     // B.6 - Summary
     // See: Figure B.16 – Flow of compressed data syntax
     // This function handles the "Multi-scan" loop.
 
-    Vector<Macroblock> macroblocks;
     TRY(macroblocks.try_resize(context.mblock_meta.padded_total));
 
     Marker marker = TRY(read_marker_at_cursor(context.stream));
@@ -1913,7 +2148,7 @@ static ErrorOr<Vector<Macroblock>> construct_macroblocks(JPEGLoadingContext& con
             TRY(read_start_of_scan(context.stream, context));
             TRY(decode_huffman_stream(context, macroblocks));
         } else if (marker == JPEG_EOI) {
-            return macroblocks;
+            return {};
         } else {
             dbgln_if(JPEG_DEBUG, "Unexpected marker {:x}!", marker);
             return Error::from_string_literal("Unexpected marker");
@@ -1923,18 +2158,50 @@ static ErrorOr<Vector<Macroblock>> construct_macroblocks(JPEGLoadingContext& con
     }
 }
 
-static ErrorOr<void> decode_jpeg(JPEGLoadingContext& context)
+static ErrorOr<void> decode_macroblocks_to_bitmap(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks)
 {
-    auto macroblocks = TRY(construct_macroblocks(context));
-    TRY(dequantize(context, macroblocks));
-    inverse_dct(context, macroblocks);
+    TRY(reconstruct_samples(context, macroblocks));
     TRY(handle_color_transform(context, macroblocks));
     TRY(compose_bitmap(context, macroblocks));
     return {};
 }
 
-JPEGImageDecoderPlugin::JPEGImageDecoderPlugin(NonnullOwnPtr<JPEGLoadingContext> context)
+static ErrorOr<void> decode_jpeg(JPEGLoadingContext& context)
+{
+    Vector<Macroblock> macroblocks;
+    TRY(construct_macroblocks(context, macroblocks));
+    TRY(decode_macroblocks_to_bitmap(context, macroblocks));
+    return {};
+}
+
+static ErrorOr<void> decode_partial_jpeg(JPEGLoadingContext& context)
+{
+    // Whatever the scans that made it into the data left in the macroblocks is shown: progressive images get sharper
+    // with every scan, while sequential ones fill in from the top, leaving the rest of the image gray.
+    Vector<Macroblock> macroblocks;
+    if (auto result = construct_macroblocks(context, macroblocks); result.is_error()) {
+        if (!context.current_scan.has_value())
+            return result.release_error();
+        dbgln_if(JPEG_DEBUG, "Showing partially decoded image: {}", result.error());
+    }
+    TRY(decode_macroblocks_to_bitmap(context, macroblocks));
+    return {};
+}
+
+static ErrorOr<NonnullRefPtr<Bitmap>> decode_jpeg_at_reduced_size(ReadonlyBytes data, JPEGDecoderOptions options, u8 scale_denominator)
+{
+    // Decoding consumes the stream, so this happens in a separate context to keep the full-size image decodable.
+    auto stream = TRY(try_make<FixedMemoryStream>(data));
+    auto context = TRY(JPEGLoadingContext::create(move(stream), options));
+    TRY(decode_header(*context));
+    context->scale_denominator = scale_denominator;
+    TRY(decode_jpeg(*context));
+    return context->bitmap.release_nonnull();
+}
+
+JPEGImageDecoderPlugin::JPEGImageDecoderPlugin(NonnullOwnPtr<JPEGLoadingContext> context, ReadonlyBytes data)
     : m_context(move(context))
+    , m_data(data)
 {
 }
 
@@ -1953,21 +2220,29 @@ bool JPEGImageDecoderPlugin::sniff(ReadonlyBytes data)
         && data.data()[2] == 0xFF;
 }
 
+static size_t s_default_thread_count { 1 };
+
+void JPEGImageDecoderPlugin::set_default_thread_count(size_t thread_count)
+{
+    VERIFY(thread_count > 0);
+    s_default_thread_count = thread_count;
+}
+
 ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> JPEGImageDecoderPlugin::create(ReadonlyBytes data)
 {
-    return create_with_options(data, {});
+    return create_with_options(data, { .thread_count = s_default_thread_count });
 }
 
 ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> JPEGImageDecoderPlugin::create_with_options(ReadonlyBytes data, JPEGDecoderOptions options)
 {
     auto stream = TRY(try_make<FixedMemoryStream>(data));
     auto context = TRY(JPEGLoadingContext::create(move(stream), options));
-    auto plugin = TRY(adopt_nonnull_own_or_enomem(new (nothrow) JPEGImageDecoderPlugin(move(context))));
+    auto plugin = TRY(adopt_nonnull_own_or_enomem(new (nothrow) JPEGImageDecoderPlugin(move(context), data)));
     TRY(decode_header(*plugin->m_context));
     return plugin;
 }
 
-ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Optional<IntSize>)
+ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Optional<IntSize> ideal_size)
 {
     if (index > 0)
         return Error::from_string_literal("JPEGImageDecoderPlugin: Invalid frame index");
@@ -1975,6 +2250,16 @@ ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Option
     if (m_context->state == JPEGLoadingContext::State::Error)
         return Error::from_string_literal("JPEGImageDecoderPlugin: Decoding failed");
 
+    // A scaled inverse DCT yields the image at 1/2, 1/4 or 1/8 of its size, which is only worth it if the full-size
+    // image hasn't been decoded already.
+    if (m_context->state < JPEGLoadingContext::State::BitmapDecoded) {
+        u8 scale_denominator = 1;
+        for (auto factor = min(downscale_factor_for_ideal_size(size(), ideal_size), 8); scale_denominator * 2 <= factor;)
+            scale_denominator *= 2;
+        if (scale_denominator > 1)
+            return ImageFrameDescriptor { TRY(decode_jpeg_at_reduced_size(m_data, m_context->options, scale_denominator)), 0 };
+    }
+
     if (m_context->state < JPEGLoadingContext::State::BitmapDecoded) {
         if (auto result = decode_jpeg(*m_context); result.is_error()) {
             m_context->state = JPEGLoadingContext::State::Error;
@@ -1986,6 +2271,25 @@ ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Option
     return ImageFrameDescriptor { m_context->bitmap, 0 };
 }
 
+ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::partial_frame(size_t index)
+{
+    if (index > 0)
+        return Error::from_string_literal("JPEGImageDecoderPlugin: Invalid frame index");
+
+    if (m_context->state == JPEGLoadingContext::State::Error)
+        return Error::from_string_literal("JPEGImageDecoderPlugin: Decoding failed");
+
+    if (m_context->state < JPEGLoadingContext::State::BitmapDecoded) {
+        if (auto result = decode_partial_jpeg(*m_context); result.is_error()) {
+            m_context->state = JPEGLoadingContext::State::Error;
+            return result.release_error();
+        }
+        m_context->state = JPEGLoadingContext::State::BitmapDecoded;
+    }
+
+    return ImageFrameDescriptor { m_context->bitmap, 0 };
+}
+
 ErrorOr<Optional<ReadonlyBytes>> JPEGImageDecoderPlugin::icc_data()
 {
     if (m_context->icc_data.has_value())
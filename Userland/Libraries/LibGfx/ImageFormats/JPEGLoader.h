@@ -25,6 +25,9 @@ struct JPEGDecoderOptions {
         PDF,
     };
     CMYK cmyk { CMYK::Normal };
+
+    // Scans with restart intervals are decoded on up to this many threads.
+    size_t thread_count { 1 };
 };
 
 class JPEGImageDecoderPlugin : public ImageDecoderPlugin {
@@ -33,16 +36,22 @@ public:
     static ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> create(ReadonlyBytes);
     static ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> create_with_options(ReadonlyBytes, JPEGDecoderOptions = {});
 
+    // The number of threads used by the decoders that create() makes. Using more than one requires the "thread"
+    // pledge, so processes have to opt in.
+    static void set_default_thread_count(size_t);
+
     virtual ~JPEGImageDecoderPlugin() override;
     virtual IntSize size() override;
 
     virtual ErrorOr<ImageFrameDescriptor> frame(size_t index, Optional<IntSize> ideal_size = {}) override;
+    virtual ErrorOr<ImageFrameDescriptor> partial_frame(size_t index) override;
     virtual ErrorOr<Optional<ReadonlyBytes>> icc_data() override;
 
 private:
-    JPEGImageDecoderPlugin(NonnullOwnPtr<JPEGLoadingContext>);
+    JPEGImageDecoderPlugin(NonnullOwnPtr<JPEGLoadingContext>, ReadonlyBytes);
 
     NonnullOwnPtr<JPEGLoadingContext> m_context;
+    ReadonlyBytes m_data;
 };
 
 }
@@ -182,6 +182,9 @@ struct PNGLoadingContext {
     bool has_seen_iend { false };
     bool has_seen_idat_chunk { false };
     bool has_seen_actl_chunk_before_idat { false };
+    bool allow_truncated_image_data { false };
+    // When greater than 1, each square of this many pixels on a side is averaged into one pixel of the bitmap.
+    int downscale_factor { 1 };
     bool has_alpha() const { return to_underlying(color_type) & 4 || palette_transparency_data.size() > 0; }
     Vector<Scanline> scanlines;
     ByteBuffer unfiltered_data;
@@ -268,6 +271,7 @@ public:
     }
 
     u8 const* current_data_ptr() const { return m_data_ptr; }
+    size_t size_remaining() const { return m_size_remaining; }
     bool at_end() const { return !m_size_remaining; }
 
 private:
@@ -393,9 +397,8 @@ ALWAYS_INLINE static void unpack_triplets_with_transparency_value(PNGLoadingCont
     }
 }
 
-NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
+static ErrorOr<void> unfilter_scanlines(PNGLoadingContext& context)
 {
-    // First unfilter the scanlines:
 
     // FIXME: Instead of creating a separate buffer for the scanlines that need to be
     //        mutated, the mutation could be done in place (if the data was non-const).
@@ -435,7 +438,11 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
         previous_scanlines_data = context.scanlines[y].data;
     }
 
-    // Now unpack the scanlines to RGBA:
+    return {};
+}
+
+NEVER_INLINE FLATTEN static ErrorOr<void> unpack_scanlines(PNGLoadingContext& context)
+{
     switch (context.color_type) {
     case PNG::ColorType::Greyscale:
         if (context.bit_depth == 8) {
@@ -572,6 +579,61 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
     return {};
 }
 
+static ErrorOr<void> unfilter(PNGLoadingContext& context)
+{
+    TRY(unfilter_scanlines(context));
+    return unpack_scanlines(context);
+}
+
+// Unpacks the scanlines one strip of rows at a time, averaging each square of pixels in it into one pixel of the bitmap,
+// so that the image never has to be unpacked at its full size.
+static ErrorOr<void> unfilter_and_downscale(PNGLoadingContext& context)
+{
+    TRY(unfilter_scanlines(context));
+
+    auto const factor = context.downscale_factor;
+    auto const format = context.has_alpha() ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888;
+    context.bitmap = TRY(Bitmap::create(format, { ceil_div(context.width, factor), ceil_div(context.height, factor) }));
+
+    auto strip_context = context.create_subimage_context(context.width, factor);
+    strip_context.bitmap = TRY(Bitmap::create(format, { context.width, factor }));
+    TRY(strip_context.scanlines.try_ensure_capacity(factor));
+
+    for (int strip_y = 0; strip_y < context.height; strip_y += factor) {
+        strip_context.height = min(factor, context.height - strip_y);
+        strip_context.scanlines.clear_with_capacity();
+        for (int y = 0; y < strip_context.height; ++y)
+            strip_context.scanlines.unchecked_append(context.scanlines[strip_y + y]);
+        TRY(unpack_scanlines(strip_context));
+
+        auto* destination = context.bitmap->scanline(strip_y / factor);
+        for (int x = 0; x < context.bitmap->width(); ++x) {
+            auto const first_column = x * factor;
+            auto const last_column = min(first_column + factor, context.width);
+
+            // Colors are weighted by their alpha, so that fully transparent pixels don't bleed into their neighbors.
+            u64 red = 0, green = 0, blue = 0, alpha = 0;
+            for (int y = 0; y < strip_context.height; ++y) {
+                for (int column = first_column; column < last_column; ++column) {
+                    auto color = Color::from_argb(strip_context.bitmap->scanline(y)[column]);
+                    red += color.red() * color.alpha();
+                    green += color.green() * color.alpha();
+                    blue += color.blue() * color.alpha();
+                    alpha += color.alpha();
+                }
+            }
+
+            auto const pixel_count = strip_context.height * (last_column - first_column);
+            if (alpha == 0)
+                destination[x] = Color(Color::Transparent).value();
+            else
+                destination[x] = Color(red / alpha, green / alpha, blue / alpha, alpha / pixel_count).value();
+        }
+    }
+
+    return {};
+}
+
 static bool decode_png_header(PNGLoadingContext& context)
 {
     if (!context.data || context.data_size < sizeof(PNG::header)) {
@@ -718,6 +780,9 @@ static ErrorOr<void> decode_png_bitmap_simple(PNGLoadingContext& context, ByteBu
         }
     }
 
+    if (context.downscale_factor > 1)
+        return unfilter_and_downscale(context);
+
     context.bitmap = TRY(Bitmap::create(context.has_alpha() ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888, { context.width, context.height }));
     return unfilter(context);
 }
@@ -772,7 +837,16 @@ static int adam7_startx[8] = { 0, 0, 4, 0, 2, 0, 1, 0 };
 static int adam7_stepy[8] = { 1, 8, 8, 8, 4, 4, 2, 2 };
 static int adam7_stepx[8] = { 1, 8, 8, 4, 4, 2, 2, 1 };
 
-static ErrorOr<void> decode_adam7_pass(PNGLoadingContext& context, Streamer& streamer, int pass)
+// The area each pixel of a pass stands for until the later passes have been decoded.
+static int adam7_blockw[8] = { 1, 8, 4, 4, 2, 2, 1, 1 };
+static int adam7_blockh[8] = { 1, 8, 8, 4, 4, 2, 2, 1 };
+
+enum class FillAdam7Blocks {
+    No,
+    Yes,
+};
+
+static ErrorOr<void> decode_adam7_pass(PNGLoadingContext& context, Streamer& streamer, int pass, FillAdam7Blocks fill_blocks = FillAdam7Blocks::No)
 {
     auto subimage_context = context.create_subimage_context(adam7_width(context, pass), adam7_height(context, pass));
 
@@ -810,7 +884,15 @@ static ErrorOr<void> decode_adam7_pass(PNGLoadingContext& context, Streamer& str
     // Copy the subimage data into the main image according to the pass pattern
     for (int y = 0, dy = adam7_starty[pass]; y < subimage_context.height && dy < context.height; ++y, dy += adam7_stepy[pass]) {
         for (int x = 0, dx = adam7_startx[pass]; x < subimage_context.width && dx < context.width; ++x, dx += adam7_stepx[pass]) {
-            context.bitmap->set_pixel(dx, dy, subimage_context.bitmap->get_pixel(x, y));
+            auto color = subimage_context.bitmap->get_pixel(x, y);
+            if (fill_blocks == FillAdam7Blocks::No) {
+                context.bitmap->set_pixel(dx, dy, color);
+                continue;
+            }
+            for (int by = dy; by < min(dy + adam7_blockh[pass], context.height); ++by) {
+                for (int bx = dx; bx < min(dx + adam7_blockw[pass], context.width); ++bx)
+                    context.bitmap->set_pixel(bx, by, color);
+            }
         }
     }
     return {};
@@ -838,14 +920,7 @@ static ErrorOr<void> decode_png_bitmap(PNGLoadingContext& context)
     if (context.color_type == PNG::ColorType::IndexedColor && context.palette_data.is_empty())
         return Error::from_string_literal("PNGImageDecoderPlugin: Didn't see a PLTE chunk for a palletized image, or it was empty.");
 
-    auto compressed_data_stream = make<FixedMemoryStream>(context.compressed_data.span());
-    auto decompressor_or_error = Compress::ZlibDecompressor::create(move(compressed_data_stream));
-    if (decompressor_or_error.is_error()) {
-        context.state = PNGLoadingContext::State::Error;
-        return decompressor_or_error.release_error();
-    }
-    auto decompressor = decompressor_or_error.release_value();
-    auto result_or_error = decompressor->read_until_eof();
+    auto result_or_error = Compress::ZlibDecompressor::decompress_all(context.compressed_data);
     if (result_or_error.is_error()) {
         context.state = PNGLoadingContext::State::Error;
         return result_or_error.release_error();
@@ -870,6 +945,72 @@ static ErrorOr<void> decode_png_bitmap(PNGLoadingContext& context)
     return {};
 }
 
+// Decompresses as much of the image data as there is, which may end in the middle of the zlib stream.
+static ErrorOr<ByteBuffer> decompress_available_image_data(ReadonlyBytes compressed_data)
+{
+    auto decompressor = TRY(Compress::ZlibDecompressor::create(make<FixedMemoryStream>(compressed_data)));
+    AllocatingMemoryStream decompressed_data;
+
+    // NOTE: Anything decompressed by a read that runs out of data is lost, so small reads are used.
+    Array<u8, 1 * KiB> buffer;
+    while (true) {
+        auto bytes_or_error = decompressor->read_some(buffer);
+        if (bytes_or_error.is_error() || bytes_or_error.value().is_empty())
+            break;
+        TRY(decompressed_data.write_until_depleted(bytes_or_error.value()));
+    }
+    return decompressed_data.read_until_eof();
+}
+
+static ErrorOr<void> decode_partial_png_bitmap(PNGLoadingContext& context)
+{
+    context.allow_truncated_image_data = true;
+    if (!decode_png_chunks(context))
+        return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
+    if (context.has_seen_iend)
+        return decode_png_bitmap(context);
+
+    if (context.compressed_data.is_empty())
+        return Error::from_string_literal("PNGImageDecoderPlugin: No image data yet");
+    if (context.color_type == PNG::ColorType::IndexedColor && context.palette_data.is_empty())
+        return Error::from_string_literal("PNGImageDecoderPlugin: Didn't see a PLTE chunk for a palletized image, or it was empty.");
+
+    auto decompression_buffer = TRY(decompress_available_image_data(context.compressed_data));
+    context.compressed_data.clear();
+
+    auto format = context.has_alpha() ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888;
+    context.bitmap = TRY(Bitmap::create(format, { context.width, context.height }));
+    context.bitmap->fill(Color::Transparent);
+
+    auto row_size = context.compute_row_size_for_width(context.width);
+    if (row_size.has_overflow())
+        return Error::from_string_literal("PNGImageDecoderPlugin: Row size overflow");
+
+    if (context.interlace_method == PngInterlaceMethod::Adam7) {
+        // Every complete pass makes the image sharper. Its pixels are blown up to cover the ones still missing.
+        Streamer streamer(decompression_buffer.data(), decompression_buffer.size());
+        for (int pass = 1; pass <= 7; ++pass) {
+            if (decode_adam7_pass(context, streamer, pass, FillAdam7Blocks::Yes).is_error()) {
+                if (pass == 1)
+                    return Error::from_string_literal("PNGImageDecoderPlugin: Not enough image data yet");
+                break;
+            }
+        }
+    } else {
+        // The rows that are complete are shown, the rest of the image stays transparent.
+        auto available_rows = min<size_t>(context.height, decompression_buffer.size() / (row_size.value() + 1));
+        if (available_rows == 0)
+            return Error::from_string_literal("PNGImageDecoderPlugin: Not enough image data yet");
+        auto rows_context = context.create_subimage_context(context.width, available_rows);
+        TRY(decode_png_bitmap_simple(rows_context, decompression_buffer));
+        for (size_t y = 0; y < available_rows; ++y)
+            memcpy(context.bitmap->scanline(y), rows_context.bitmap->scanline(y), rows_context.bitmap->pitch());
+    }
+
+    context.state = PNGLoadingContext::State::BitmapDecoded;
+    return {};
+}
+
 static ErrorOr<RefPtr<Bitmap>> decode_png_animation_frame_bitmap(PNGLoadingContext& context, AnimationFrame& animation_frame)
 {
     if (context.color_type == PNG::ColorType::IndexedColor && context.palette_data.is_empty())
@@ -880,9 +1021,7 @@ static ErrorOr<RefPtr<Bitmap>> decode_png_animation_frame_bitmap(PNGLoadingConte
     auto frame_rect = animation_frame.rect();
     auto frame_context = context.create_subimage_context(frame_rect.width(), frame_rect.height());
 
-    auto compressed_data_stream = make<FixedMemoryStream>(animation_frame.compressed_data.span());
-    auto decompressor = TRY(Compress::ZlibDecompressor::create(move(compressed_data_stream)));
-    auto decompression_buffer = TRY(decompressor->read_until_eof());
+    auto decompression_buffer = TRY(Compress::ZlibDecompressor::decompress_all(animation_frame.compressed_data));
     frame_context.compressed_data.clear();
 
     frame_context.scanlines.ensure_capacity(frame_context.height);
@@ -1191,6 +1330,11 @@ static ErrorOr<void> process_chunk(Streamer& streamer, PNGLoadingContext& contex
     }
     ReadonlyBytes chunk_data;
     if (!streamer.wrap_bytes(chunk_data, chunk_size)) {
+        // The beginning of the image data of a file that is still being downloaded can already be shown.
+        if (context.allow_truncated_image_data && chunk_type == "IDAT"sv && context.state >= PNGLoadingContext::IHDRDecoded) {
+            if (streamer.wrap_bytes(chunk_data, streamer.size_remaining()))
+                TRY(process_IDAT(chunk_data, context));
+        }
         dbgln_if(PNG_DEBUG, "Bail at chunk_data");
         return Error::from_string_literal("Error while reading from Streamer");
     }
@@ -1366,7 +1510,21 @@ static ErrorOr<RefPtr<Bitmap>> render_animation_frame(AnimationFrame const& prev
     return rendered_bitmap;
 }
 
-ErrorOr<ImageFrameDescriptor> PNGImageDecoderPlugin::frame(size_t index, Optional<IntSize>)
+static ErrorOr<NonnullRefPtr<Bitmap>> decode_png_bitmap_at_reduced_size(PNGLoadingContext const& context, int downscale_factor)
+{
+    // Decoding drops the compressed data, so this happens in a separate context to keep the full-size image decodable.
+    PNGLoadingContext downscaled_context;
+    downscaled_context.data = downscaled_context.data_current_ptr = context.data;
+    downscaled_context.data_size = context.data_size;
+    downscaled_context.downscale_factor = downscale_factor;
+    if (!decode_png_header(downscaled_context))
+        return Error::from_string_literal("PNGImageDecoderPlugin: Invalid header for a PNG file");
+    TRY(decode_png_ihdr(downscaled_context));
+    TRY(decode_png_bitmap(downscaled_context));
+    return downscaled_context.bitmap.release_nonnull();
+}
+
+ErrorOr<ImageFrameDescriptor> PNGImageDecoderPlugin::frame(size_t index, Optional<IntSize> ideal_size)
 {
     if (m_context->state == PNGLoadingContext::State::Error)
         return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
@@ -1374,6 +1532,14 @@ ErrorOr<ImageFrameDescriptor> PNGImageDecoderPlugin::frame(size_t index, Optiona
     if (!ensure_image_data_chunk_was_decoded())
         return Error::from_string_literal("PNGImageDecoderPlugin: Decoding image data chunk");
 
+    // Every row has to be inflated and unfiltered anyway, but a non-interlaced still image can be unpacked straight into
+    // a smaller bitmap. Animation frames are composited onto each other at full size, so they don't get this treatment.
+    if (index == 0 && m_context->state < PNGLoadingContext::State::BitmapDecoded && !m_context->has_seen_actl_chunk_before_idat
+        && m_context->interlace_method == PngInterlaceMethod::Null) {
+        if (auto downscale_factor = downscale_factor_for_ideal_size(size(), ideal_size); downscale_factor > 1)
+            return ImageFrameDescriptor { TRY(decode_png_bitmap_at_reduced_size(*m_context, downscale_factor)) };
+    }
+
     auto set_descriptor_duration = [](ImageFrameDescriptor& descriptor, AnimationFrame const& animation_frame) {
         descriptor.duration = static_cast<int>(animation_frame.duration_ms());
         if (descriptor.duration < 0)
@@ -1436,6 +1602,25 @@ ErrorOr<ImageFrameDescriptor> PNGImageDecoderPlugin::frame(size_t index, Optiona
     return descriptor;
 }
 
+ErrorOr<ImageFrameDescriptor> PNGImageDecoderPlugin::partial_frame(size_t index)
+{
+    // Animation frames are only shown once they're complete.
+    if (index > 0)
+        return frame(index);
+
+    if (m_context->state == PNGLoadingContext::State::Error)
+        return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
+
+    if (m_context->state < PNGLoadingContext::State::BitmapDecoded) {
+        if (auto result = decode_partial_png_bitmap(*m_context); result.is_error()) {
+            m_context->state = PNGLoadingContext::State::Error;
+            return result.release_error();
+        }
+    }
+
+    return ImageFrameDescriptor { m_context->bitmap };
+}
+
 ErrorOr<Optional<ReadonlyBytes>> PNGImageDecoderPlugin::icc_data()
 {
     if (!decode_png_chunks(*m_context))
@@ -1443,14 +1628,7 @@ ErrorOr<Optional<ReadonlyBytes>> PNGImageDecoderPlugin::icc_data()
 
     if (m_context->embedded_icc_profile.has_value()) {
         if (!m_context->decompressed_icc_profile.has_value()) {
-            auto compressed_data_stream = make<FixedMemoryStream>(m_context->embedded_icc_profile->compressed_data);
-            auto decompressor_or_error = Compress::ZlibDecompressor::create(move(compressed_data_stream));
-            if (decompressor_or_error.is_error()) {
-                m_context->embedded_icc_profile.clear();
-                return decompressor_or_error.release_error();
-            }
-            auto decompressor = decompressor_or_error.release_value();
-            auto result_or_error = decompressor->read_until_eof();
+            auto result_or_error = Compress::ZlibDecompressor::decompress_all(m_context->embedded_icc_profile->compressed_data);
             if (result_or_error.is_error()) {
                 m_context->embedded_icc_profile.clear();
                 return result_or_error.release_error();
@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/CharacterTypes.h>
+#include <AK/GenericLexer.h>
+#include <LibHTTP/CachePolicy.h>
+
+namespace HTTP {
+
+// Heuristic freshness is capped, so that resources which haven't changed in years aren't trusted for months.
+static constexpr auto max_heuristic_freshness_lifetime = Duration::from_seconds(7 * 24 * 60 * 60);
+
+CacheControl CacheControl::parse(StringView value)
+{
+    CacheControl cache_control;
+    value.for_each_split_view(',', SplitBehavior::Nothing, [&](StringView directive) {
+        directive = directive.trim_whitespace();
+        auto name = directive;
+        Optional<StringView> argument;
+        if (auto equals_index = directive.find('='); equals_index.has_value()) {
+            name = directive.substring_view(0, *equals_index).trim_whitespace();
+            argument = directive.substring_view(*equals_index + 1).trim_whitespace().trim("\""sv);
+        }
+
+        if (name.equals_ignoring_ascii_case("max-age"sv)) {
+            // "a cache ought to consider a response with an invalid max-age directive as stale"
+            auto seconds = argument.has_value() ? argument->to_number<i64>() : Optional<i64> {};
+            cache_control.max_age = seconds.has_value() && *seconds >= 0 ? *seconds : 0;
+        } else if (name.equals_ignoring_ascii_case("no-cache"sv)) {
+            cache_control.no_cache = true;
+        } else if (name.equals_ignoring_ascii_case("no-store"sv)) {
+            cache_control.no_store = true;
+        } else if (name.equals_ignoring_ascii_case("must-revalidate"sv)) {
+            cache_control.must_revalidate = true;
+        } else if (name.equals_ignoring_ascii_case("immutable"sv)) {
+            cache_control.immutable = true;
+        }
+    });
+    return cache_control;
+}
+
+static Optional<u8> parse_month(StringView name)
+{
+    static constexpr Array month_names { "Jan"sv, "Feb"sv, "Mar"sv, "Apr"sv, "May"sv, "Jun"sv, "Jul"sv, "Aug"sv, "Sep"sv, "Oct"sv, "Nov"sv, "Dec"sv };
+    for (size_t i = 0; i < month_names.size(); ++i) {
+        if (name.equals_ignoring_ascii_case(month_names[i]))
+            return i + 1;
+    }
+    return {};
+}
+
+static Optional<u32> parse_digits(GenericLexer& lexer, size_t min_length, size_t max_length)
+{
+    auto digits = lexer.consume_while(is_ascii_digit);
+    if (digits.length() < min_length || digits.length() > max_length)
+        return {};
+    return digits.to_number<u32>();
+}
+
+static Optional<UnixDateTime> parse_time_of_day_and_make_date(GenericLexer& lexer, i32 year, u8 month, u8 day)
+{
+    auto hour = parse_digits(lexer, 2, 2);
+    if (!hour.has_value() || !lexer.consume_specific(':'))
+        return {};
+    auto minute = parse_digits(lexer, 2, 2);
+    if (!minute.has_value() || !lexer.consume_specific(':'))
+        return {};
+    auto second = parse_digits(lexer, 2, 2);
+    if (!second.has_value())
+        return {};
+    if (day < 1 || day > days_in_month(year, month) || *hour > 23 || *minute > 59 || *second > 60)
+        return {};
+    return UnixDateTime::from_unix_time_parts(year, month, day, *hour, *minute, min(*second, 59u), 0);
+}
+
+Optional<UnixDateTime> parse_http_date(StringView value)
+{
+    GenericLexer lexer { value.trim_whitespace() };
+
+    // All three formats start with the name of the day, which is only a comma away in the first two.
+    auto day_name = lexer.consume_while(is_ascii_alpha);
+    if (day_name.is_empty())
+        return {};
+
+    if (lexer.consume_specific(',')) {
+        lexer.ignore_while(is_ascii_space);
+
+        auto day = parse_digits(lexer, 2, 2);
+        if (!day.has_value())
+            return {};
+
+        // IMF-fixdate: "Sun, 06 Nov 1994 08:49:37 GMT"
+        if (lexer.consume_specific(' ')) {
+            auto month = parse_month(lexer.consume(3));
+            if (!month.has_value() || !lexer.consume_specific(' '))
+                return {};
+            auto year = parse_digits(lexer, 4, 4);
+            if (!year.has_value() || !lexer.consume_specific(' '))
+                return {};
+            auto date = parse_time_of_day_and_make_date(lexer, *year, *month, *day);
+            if (!date.has_value() || !lexer.consume_specific(" GMT"sv) || !lexer.is_eof())
+                return {};
+            return date;
+        }
+
+        // Obsolete RFC 850 format: "Sunday, 06-Nov-94 08:49:37 GMT"
+        if (!lexer.consume_specific('-'))
+            return {};
+        auto month = parse_month(lexer.consume(3));
+        if (!month.has_value() || !lexer.consume_specific('-'))
+            return {};
+        auto two_digit_year = parse_digits(lexer, 2, 2);
+        if (!two_digit_year.has_value() || !lexer.consume_specific(' '))
+            return {};
+        // "Recipients of a timestamp value in rfc850-date format [...] MUST interpret a timestamp that appears to be more
+        //  than 50 years in the future as representing the most recent year in the past that had the same last two digits."
+        auto year = static_cast<i32>(*two_digit_year) + 2000;
+        if (year > seconds_since_epoch_to_year(UnixDateTime::now().seconds_since_epoch()) + 50)
+            year -= 100;
+        auto date = parse_time_of_day_and_make_date(lexer, year, *month, *day);
+        if (!date.has_value() || !lexer.consume_specific(" GMT"sv) || !lexer.is_eof())
+            return {};
+        return date;
+    }
+
+    // Obsolete asctime() format: "Sun Nov  6 08:49:37 1994"
+    if (!lexer.consume_specific(' '))
+        return {};
+    auto month = parse_month(lexer.consume(3));
+    if (!month.has_value() || !lexer.consume_specific(' '))
+        return {};
+    lexer.consume_specific(' ');
+    auto day = parse_digits(lexer, 1, 2);
+    if (!day.has_value() || !lexer.consume_specific(' '))
+        return {};
+    GenericLexer time_lexer { lexer.consume_until(' ') };
+    if (!lexer.consume_specific(' '))
+        return {};
+    auto year = parse_digits(lexer, 4, 4);
+    if (!year.has_value() || !lexer.is_eof())
+        return {};
+    auto date = parse_time_of_day_and_make_date(time_lexer, *year, *month, *day);
+    if (!time_lexer.is_eof())
+        return {};
+    return date;
+}
+
+Optional<ByteString> find_request_header(RequestHeaders const& headers, StringView name)
+{
+    for (auto const& header : headers) {
+        if (header.key.equals_ignoring_ascii_case(name))
+            return header.value;
+    }
+    return {};
+}
+
+bool can_use_cache_for_request(StringView method, RequestHeaders const& headers)
+{
+    if (!method.equals_ignoring_ascii_case("GET"sv))
+        return false;
+
+    // Responses to requests with credentials or ranges, and the results of conditional requests made by the client
+    // itself, are passed through untouched.
+    static constexpr Array bypassing_headers { "Authorization"sv, "Range"sv, "If-None-Match"sv, "If-Modified-Since"sv, "If-Match"sv, "If-Unmodified-Since"sv, "If-Range"sv };
+    for (auto name : bypassing_headers) {
+        if (find_request_header(headers, name).has_value())
+            return false;
+    }
+
+    if (auto cache_control = find_request_header(headers, "Cache-Control"sv); cache_control.has_value())
+        return !CacheControl::parse(*cache_control).no_store;
+    return true;
+}
+
+bool is_response_storable(u32 status_code, ResponseHeaders const& headers)
+{
+    // https://httpwg.org/specs/rfc9110.html#overview.of.status.codes
+    // "Responses with status codes that are defined as heuristically cacheable [...]"
+    static constexpr Array heuristically_cacheable_status_codes { 200u, 203u, 204u, 300u, 301u, 308u, 404u, 405u, 410u, 414u, 501u };
+    if (!heuristically_cacheable_status_codes.contains_slow(status_code))
+        return false;
+
+    auto cache_control = CacheControl::parse(headers.get("Cache-Control"sv).value_or({}));
+    if (cache_control.no_store)
+        return false;
+
+    // A response that is stale right away and can't be validated would never be used.
+    if (freshness_lifetime(headers) == Duration::zero() && !headers.contains("ETag"sv) && !headers.contains("Last-Modified"sv))
+        return false;
+
+    return true;
+}
+
+Duration freshness_lifetime(ResponseHeaders const& headers)
+{
+    auto cache_control = CacheControl::parse(headers.get("Cache-Control"sv).value_or({}));
+    if (cache_control.max_age.has_value())
+        return Duration::from_seconds(*cache_control.max_age);
+
+    auto date = parse_http_date(headers.get("Date"sv).value_or({}));
+    if (!date.has_value())
+        return Duration::zero();
+
+    if (auto expires_value = headers.get("Expires"sv); expires_value.has_value()) {
+        // "A cache recipient MUST interpret invalid date formats, especially the value "0", as representing a time in the past"
+        auto expires = parse_http_date(*expires_value);
+        if (!expires.has_value() || *expires <= *date)
+            return Duration::zero();
+        return *expires - *date;
+    }
+
+    // https://httpwg.org/specs/rfc9111.html#heuristic.freshness
+    if (auto last_modified = parse_http_date(headers.get("Last-Modified"sv).value_or({})); last_modified.has_value() && *last_modified < *date)
+        return min(Duration::from_seconds((*date - *last_modified).to_seconds() / 10), max_heuristic_freshness_lifetime);
+
+    return Duration::zero();
+}
+
+Duration current_age(ResponseHeaders const& headers, UnixDateTime request_time, UnixDateTime response_time, UnixDateTime now)
+{
+    auto age_value = Duration::zero();
+    if (auto age = headers.get("Age"sv).value_or({}).to_number<i64>(); age.has_value() && *age >= 0)
+        age_value = Duration::from_seconds(*age);
+
+    auto apparent_age = Duration::zero();
+    if (auto date = parse_http_date(headers.get("Date"sv).value_or({})); date.has_value() && *date < response_time)
+        apparent_age = response_time - *date;
+
+    auto response_delay = max(response_time - request_time, Duration::zero());
+    auto corrected_initial_age = max(apparent_age, age_value + response_delay);
+    auto resident_time = max(now - response_time, Duration::zero());
+    return corrected_initial_age + resident_time;
+}
+
+bool needs_revalidation(RequestHeaders const& request_headers, ResponseHeaders const& response_headers, UnixDateTime request_time, UnixDateTime response_time, UnixDateTime now)
+{
+    auto response_cache_control = CacheControl::parse(response_headers.get("Cache-Control"sv).value_or({}));
+    if (response_cache_control.no_cache)
+        return true;
+
+    auto age = current_age(response_headers, request_time, response_time, now);
+    auto is_fresh = age < freshness_lifetime(response_headers);
+
+    // Reloading asks for every stored response to be validated, except for the ones promising to never change while fresh.
+    auto request_cache_control = CacheControl::parse(find_request_header(request_headers, "Cache-Control"sv).value_or({}));
+    auto pragma = find_request_header(request_headers, "Pragma"sv);
+    if (request_cache_control.no_cache || (pragma.has_value() && pragma->contains("no-cache"sv, CaseSensitivity::CaseInsensitive)))
+        return !(is_fresh && response_cache_control.immutable);
+    if (request_cache_control.max_age.has_value() && age > Duration::from_seconds(*request_cache_control.max_age))
+        return !(is_fresh && response_cache_control.immutable);
+
+    return !is_fresh;
+}
+
+bool add_validators_to_request(RequestHeaders& request_headers, ResponseHeaders const& stored_response_headers)
+{
+    bool has_validators = false;
+    if (auto etag = stored_response_headers.get("ETag"sv); etag.has_value()) {
+        request_headers.set("If-None-Match", *etag);
+        has_validators = true;
+    }
+    if (auto last_modified = stored_response_headers.get("Last-Modified"sv); last_modified.has_value()) {
+        request_headers.set("If-Modified-Since", *last_modified);
+        has_validators = true;
+    }
+    return has_validators;
+}
+
+void update_stored_headers(ResponseHeaders& stored_response_headers, ResponseHeaders const& not_modified_response_headers)
+{
+    // "the cache MUST add each header field in the provided response to the stored response, replacing field values
+    //  that are already present, with the following exceptions: Header fields excepted from storage in Section 3.1,
+    //  [...] the Content-Length header field."
+    static constexpr Array excluded_headers { "Content-Length"sv, "Connection"sv, "Keep-Alive"sv, "Transfer-Encoding"sv, "Content-Encoding"sv };
+    for (auto const& header : not_modified_response_headers) {
+        if (any_of(excluded_headers, [&](auto name) { return header.key.equals_ignoring_ascii_case(name); }))
+            continue;
+        stored_response_headers.set(header.key, header.value);
+    }
+}
+
+Optional<RequestHeaders> varying_request_headers(RequestHeaders const& request_headers, ResponseHeaders const& response_headers)
+{
+    RequestHeaders varying_headers;
+    auto vary = response_headers.get("Vary"sv);
+    if (!vary.has_value())
+        return varying_headers;
+
+    bool varies_on_everything = false;
+    vary->view().for_each_split_view(',', SplitBehavior::Nothing, [&](StringView name) {
+        name = name.trim_whitespace();
+        if (name == "*"sv) {
+            varies_on_everything = true;
+            return;
+        }
+        if (auto value = find_request_header(request_headers, name); value.has_value())
+            varying_headers.set(name.to_lowercase_string(), *value);
+    });
+    if (varies_on_everything)
+        return {};
+    return varying_headers;
+}
+
+}
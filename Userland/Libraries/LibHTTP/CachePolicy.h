@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/Optional.h>
+#include <AK/StringView.h>
+#include <AK/Time.h>
+
+// The rules for storing, reusing and validating responses in a private HTTP cache.
+// https://httpwg.org/specs/rfc9111.html
+
+namespace HTTP {
+
+using ResponseHeaders = HashMap<ByteString, ByteString, CaseInsensitiveStringTraits>;
+using RequestHeaders = HashMap<ByteString, ByteString>;
+
+// https://httpwg.org/specs/rfc9111.html#field.cache-control
+struct CacheControl {
+    static CacheControl parse(StringView);
+
+    Optional<i64> max_age;
+    bool no_cache { false };
+    bool no_store { false };
+    bool must_revalidate { false };
+    bool immutable { false };
+};
+
+// https://httpwg.org/specs/rfc9110.html#http.date
+Optional<UnixDateTime> parse_http_date(StringView);
+
+// Looks up a header in a map that isn't case-insensitive, like the request headers passed to RequestServer.
+Optional<ByteString> find_request_header(RequestHeaders const&, StringView name);
+
+// Whether a request may be answered from the cache at all, and whether its response may be stored.
+bool can_use_cache_for_request(StringView method, RequestHeaders const&);
+
+// https://httpwg.org/specs/rfc9111.html#response.cacheability
+bool is_response_storable(u32 status_code, ResponseHeaders const&);
+
+// https://httpwg.org/specs/rfc9111.html#calculating.freshness.lifetime
+Duration freshness_lifetime(ResponseHeaders const&);
+
+// https://httpwg.org/specs/rfc9111.html#age.calculations
+Duration current_age(ResponseHeaders const&, UnixDateTime request_time, UnixDateTime response_time, UnixDateTime now);
+
+// Whether a stored response has to be validated with the origin server before it can be used for the given request.
+bool needs_revalidation(RequestHeaders const&, ResponseHeaders const&, UnixDateTime request_time, UnixDateTime response_time, UnixDateTime now);
+
+// Adds the validators of a stored response to a request, so that the origin server answers with 304 (Not Modified) if
+// the stored response is still valid. Returns false if the stored response has no validators.
+// https://httpwg.org/specs/rfc9111.html#validation.sent
+bool add_validators_to_request(RequestHeaders&, ResponseHeaders const& stored_response_headers);
+
+// Updates the headers of a stored response with the ones received in a 304 (Not Modified) response.
+// https://httpwg.org/specs/rfc9111.html#freshening.responses
+void update_stored_headers(ResponseHeaders& stored_response_headers, ResponseHeaders const& not_modified_response_headers);
+
+// The request headers named by the Vary header of a response, which a later request has to match to reuse it.
+// Returns an empty optional if the response varies on something that can't be matched.
+// https://httpwg.org/specs/rfc9111.html#caching.negotiated.responses
+Optional<RequestHeaders> varying_request_headers(RequestHeaders const&, ResponseHeaders const&);
+
+}
@@ -51,17 +51,16 @@ static ErrorOr<ByteBuffer> handle_content_encoding(ByteBuffer const& buf, ByteSt
 
         // Even though the content encoding is "deflate", it's actually deflate with the zlib wrapper.
         // https://tools.ietf.org/html/rfc7230#section-4.2.2
-        auto memory_stream = make<FixedMemoryStream>(buf);
-        auto zlib_decompressor = Compress::ZlibDecompressor::create(move(memory_stream));
+        auto zlib_uncompressed = Compress::ZlibDecompressor::decompress_all(buf);
         Optional<ByteBuffer> uncompressed;
-        if (zlib_decompressor.is_error()) {
+        if (zlib_uncompressed.is_error()) {
             // From the RFC:
             // "Note: Some non-conformant implementations send the "deflate"
             //        compressed data without the zlib wrapper."
             dbgln_if(JOB_DEBUG, "Job::handle_content_encoding: ZlibDecompressor::decompress_all() failed. Trying DeflateDecompressor::decompress_all()");
             uncompressed = TRY(Compress::DeflateDecompressor::decompress_all(buf));
         } else {
-            uncompressed = TRY(zlib_decompressor.value()->read_until_eof());
+            uncompressed = zlib_uncompressed.release_value();
         }
 
         if constexpr (JOB_DEBUG) {
@@ -8,11 +8,29 @@
 #include <LibCore/System.h>
 #include <LibIPC/Connection.h>
 #include <LibIPC/Stub.h>
+#include <fcntl.h>
 #include <sched.h>
 #include <sys/select.h>
 
 namespace IPC {
 
+// Frames that manage the shared memory ring are sent through the socket in place of a message size, using sizes that
+// no message can have.
+enum class ConnectionBase::TransportFrame : u32 {
+    // Sent by the receiving side when it has made room in a ring that the sending side found full.
+    RingHasRoom = NumericLimits<u32>::max() - 3,
+    // Sent by the receiving side after passing the file descriptor of the ring.
+    RingOffer = NumericLimits<u32>::max() - 2,
+    // Sent by the sending side before it puts the first message into the ring.
+    RingAccepted = NumericLimits<u32>::max() - 1,
+    // Sent by the sending side when the receiving side might not know that there is something in the ring.
+    RingWakeup = NumericLimits<u32>::max(),
+};
+
+// How much may wait for room in the ring before we assume that the peer has stopped reading, just like we would if
+// its socket stayed full.
+static constexpr size_t max_size_of_messages_waiting_for_ring = 4 * MiB;
+
 struct CoreEventLoopDeferredInvoker final : public DeferredInvoker {
     virtual ~CoreEventLoopDeferredInvoker() = default;
 
@@ -22,9 +40,10 @@ struct CoreEventLoopDeferredInvoker final : public DeferredInvoker {
     }
 };
 
-ConnectionBase::ConnectionBase(IPC::Stub& local_stub, NonnullOwnPtr<Core::LocalSocket> socket, u32 local_endpoint_magic)
+ConnectionBase::ConnectionBase(IPC::Stub& local_stub, NonnullOwnPtr<Core::LocalSocket> socket, u32 local_endpoint_magic, bool receives_through_shared_memory_ring)
     : m_local_stub(local_stub)
     , m_socket(move(socket))
+    , m_receives_through_shared_memory_ring(receives_through_shared_memory_ring)
     , m_local_endpoint_magic(local_endpoint_magic)
     , m_deferred_invoker(make<CoreEventLoopDeferredInvoker>())
 {
@@ -60,10 +79,6 @@ ErrorOr<void> ConnectionBase::post_message(MessageBuffer buffer)
     if (!m_socket->is_open())
         return Error::from_string_literal("Trying to post_message during IPC shutdown");
 
-    // Prepend the message size.
-    uint32_t message_size = buffer.data.size();
-    TRY(buffer.data.try_prepend(reinterpret_cast<u8 const*>(&message_size), sizeof(message_size)));
-
     for (auto& fd : buffer.fds) {
         if (auto result = fd_passing_socket().send_fd(fd->value()); result.is_error()) {
             shutdown_with_error(result.error());
@@ -71,7 +86,115 @@ ErrorOr<void> ConnectionBase::post_message(MessageBuffer buffer)
         }
     }
 
-    ReadonlyBytes bytes_to_write { buffer.data.span() };
+    if (m_ring_to_peer.has_value())
+        return post_message_through_ring(buffer);
+
+    uint32_t message_size = buffer.data.size();
+
+    if (m_message_batch_depth > 0) {
+        TRY(m_pending_messages.try_append(&message_size, sizeof(message_size)));
+        TRY(m_pending_messages.try_append(buffer.data.data(), buffer.data.size()));
+        if (m_pending_messages.size() >= MessageBatch::max_size)
+            return flush_pending_messages();
+        return {};
+    }
+
+    // Prepend the message size.
+    TRY(buffer.data.try_prepend(reinterpret_cast<u8 const*>(&message_size), sizeof(message_size)));
+    return write_to_socket(buffer.data.span());
+}
+
+ErrorOr<void> ConnectionBase::post_message_through_ring(MessageBuffer& buffer)
+{
+    if (buffer.fds.is_empty() && buffer.data.size() <= SharedMemoryRing::max_message_size) {
+        TRY(enqueue_into_ring(buffer.data.span()));
+    } else {
+        // Messages that come with file descriptors, or that are too large for the ring, still go through the socket.
+        // The marker only goes into the ring once the whole message has been written, so the peer never has to wait
+        // long for it.
+        uint32_t message_size = buffer.data.size();
+        TRY(buffer.data.try_prepend(reinterpret_cast<u8 const*>(&message_size), sizeof(message_size)));
+        TRY(write_to_socket(buffer.data.span()));
+        TRY(enqueue_into_ring({}));
+    }
+
+    if (m_message_batch_depth > 0)
+        return {};
+    return flush_pending_messages();
+}
+
+ErrorOr<void> ConnectionBase::enqueue_into_ring(ReadonlyBytes message)
+{
+    // Nothing may overtake the messages that are already waiting for room.
+    if (m_messages_waiting_for_ring.is_empty() && TRY(try_enqueue_into_ring(message)))
+        return {};
+
+    if (m_size_of_messages_waiting_for_ring + message.size() > max_size_of_messages_waiting_for_ring) {
+        shutdown();
+        return Error::from_string_literal("IPC::Connection::post_message: Peer ring overflowed");
+    }
+
+    m_messages_waiting_for_ring.enqueue(TRY(ByteBuffer::copy(message)));
+    m_size_of_messages_waiting_for_ring += message.size();
+    return {};
+}
+
+ErrorOr<bool> ConnectionBase::try_enqueue_into_ring(ReadonlyBytes message)
+{
+    for (auto attempt = 0; attempt < 2; ++attempt) {
+        auto result = message.is_empty() ? m_ring_to_peer->try_enqueue_marker() : m_ring_to_peer->try_enqueue(message);
+        if (result.is_error()) {
+            shutdown_with_error(result.error());
+            return result.release_error();
+        }
+
+        if (result.value() == SharedMemoryRing::EnqueueResult::EnqueuedIntoEmptyRing)
+            m_peer_needs_wakeup = true;
+        if (result.value() != SharedMemoryRing::EnqueueResult::Full)
+            return true;
+
+        if (attempt == 0)
+            m_ring_to_peer->request_room();
+    }
+    return false;
+}
+
+ErrorOr<void> ConnectionBase::enqueue_messages_waiting_for_ring()
+{
+    while (!m_messages_waiting_for_ring.is_empty()) {
+        if (!TRY(try_enqueue_into_ring(m_messages_waiting_for_ring.head())))
+            break;
+        m_size_of_messages_waiting_for_ring -= m_messages_waiting_for_ring.dequeue().size();
+    }
+
+    if (m_message_batch_depth > 0)
+        return {};
+    return flush_pending_messages();
+}
+
+ErrorOr<void> ConnectionBase::flush_pending_messages()
+{
+    if (!m_pending_messages.is_empty()) {
+        auto pending_messages = move(m_pending_messages);
+        TRY(write_to_socket(pending_messages));
+    }
+
+    if (m_peer_needs_wakeup) {
+        m_peer_needs_wakeup = false;
+        TRY(send_transport_frame(TransportFrame::RingWakeup));
+    }
+
+    return {};
+}
+
+ErrorOr<void> ConnectionBase::send_transport_frame(TransportFrame frame)
+{
+    auto value = to_underlying(frame);
+    return write_to_socket({ &value, sizeof(value) });
+}
+
+ErrorOr<void> ConnectionBase::write_to_socket(ReadonlyBytes bytes_to_write)
+{
     int writes_done = 0;
     size_t initial_size = bytes_to_write.size();
     while (!bytes_to_write.is_empty()) {
@@ -134,7 +257,11 @@ void ConnectionBase::handle_messages()
             }
 
             if (auto response = handler_result.release_value()) {
-                if (auto post_result = post_message(*response); post_result.is_error()) {
+                // The peer is blocked waiting for the response, so it must not be held back by a batch.
+                auto post_result = post_message(*response);
+                if (!post_result.is_error())
+                    post_result = flush_pending_messages();
+                if (post_result.is_error()) {
                     dbgln("IPC::ConnectionBase::handle_messages: {}", post_result.error());
                 }
             }
@@ -154,14 +281,10 @@ void ConnectionBase::wait_for_socket_to_become_readable()
     VERIFY(maybe_did_become_readable.value());
 }
 
-ErrorOr<Vector<u8>> ConnectionBase::read_as_much_as_possible_from_socket_without_blocking()
+ErrorOr<void> ConnectionBase::read_as_much_as_possible_from_socket_without_blocking()
 {
-    Vector<u8> bytes;
-
-    if (!m_unprocessed_bytes.is_empty()) {
-        bytes.append(m_unprocessed_bytes.data(), m_unprocessed_bytes.size());
-        m_unprocessed_bytes.clear();
-    }
+    // New bytes are appended right after any partial message left over from last time.
+    auto initial_size = m_unprocessed_bytes.size();
 
     u8 buffer[4096];
 
@@ -197,36 +320,165 @@ ErrorOr<Vector<u8>> ConnectionBase::read_as_much_as_possible_from_socket_without
             break;
         }
 
-        bytes.append(bytes_read.data(), bytes_read.size());
+        TRY(m_unprocessed_bytes.try_append(bytes_read));
     }
 
-    if (!bytes.is_empty()) {
+    if (m_unprocessed_bytes.size() > initial_size) {
         m_responsiveness_timer->stop();
         did_become_responsive();
     } else if (should_shut_down) {
         return Error::from_string_literal("IPC connection EOF");
     }
 
-    return bytes;
+    return {};
+}
+
+ErrorOr<void> ConnectionBase::parse_messages_from_socket()
+{
+    size_t index = 0;
+    u32 message_size = 0;
+    while (index + sizeof(message_size) <= m_unprocessed_bytes.size()) {
+        memcpy(&message_size, m_unprocessed_bytes.data() + index, sizeof(message_size));
+
+        if (auto frame = static_cast<TransportFrame>(message_size); frame == TransportFrame::RingHasRoom || frame == TransportFrame::RingOffer || frame == TransportFrame::RingAccepted || frame == TransportFrame::RingWakeup) {
+            index += sizeof(message_size);
+            TRY(handle_transport_frame(frame));
+            continue;
+        }
+
+        if (message_size == 0 || m_unprocessed_bytes.size() - index - sizeof(message_size) < message_size)
+            break;
+        index += sizeof(message_size);
+
+        auto message = decode_message(m_unprocessed_bytes.bytes().slice(index, message_size));
+        if (message.is_error())
+            break;
+        index += message_size;
+
+        // Once the peer uses the ring, the messages that it sends through the socket have to wait for their markers.
+        if (m_peer_accepted_ring)
+            m_messages_from_socket.append(message.release_value());
+        else
+            m_unprocessed_messages.append(message.release_value());
+    }
+
+    if (index > 0) {
+        // Sometimes we might receive a partial message. That's okay, just move the unprocessed bytes
+        // to the front, and the rest of the message will be appended to them next time.
+        auto remaining_size = m_unprocessed_bytes.size() - index;
+        if (remaining_size > 0)
+            memmove(m_unprocessed_bytes.data(), m_unprocessed_bytes.data() + index, remaining_size);
+        m_unprocessed_bytes.trim(remaining_size, false);
+    }
+
+    return {};
+}
+
+ErrorOr<void> ConnectionBase::handle_transport_frame(TransportFrame frame)
+{
+    switch (frame) {
+    case TransportFrame::RingHasRoom:
+        if (!m_ring_to_peer.has_value())
+            return Error::from_string_literal("Peer made room in a shared memory ring that we don't use");
+        return enqueue_messages_waiting_for_ring();
+    case TransportFrame::RingOffer: {
+        auto fd = TRY(fd_passing_socket().receive_fd(O_CLOEXEC));
+        auto ring = SharedMemoryRing::create_from_fd(fd);
+        if (ring.is_error()) {
+            // The peer keeps reading from the socket until we accept, so we can just not do that.
+            dbgln("IPC::ConnectionBase: Could not map the shared memory ring offered by the peer, staying with the socket: {}", ring.error());
+            return {};
+        }
+
+        // Everything sent so far has to arrive before the peer starts reading from the ring.
+        TRY(flush_pending_messages());
+        TRY(send_transport_frame(TransportFrame::RingAccepted));
+        m_ring_to_peer = ring.release_value();
+        return {};
+    }
+    case TransportFrame::RingAccepted:
+        if (!m_ring_from_peer.has_value())
+            return Error::from_string_literal("Peer accepted a shared memory ring that was never offered");
+        m_peer_accepted_ring = true;
+        return {};
+    case TransportFrame::RingWakeup:
+        // The ring is read after the socket anyway.
+        return {};
+    }
+    VERIFY_NOT_REACHED();
+}
+
+ErrorOr<void> ConnectionBase::offer_shared_memory_ring()
+{
+    // The peer takes the file descriptors in the order in which it finds their messages, so the messages that were
+    // posted before have to go out first.
+    TRY(flush_pending_messages());
+
+    auto ring = TRY(SharedMemoryRing::create());
+    TRY(fd_passing_socket().send_fd(ring.fd()));
+    m_ring_from_peer = move(ring);
+    return send_transport_frame(TransportFrame::RingOffer);
+}
+
+ErrorOr<void> ConnectionBase::drain_ring_from_peer()
+{
+    if (!m_peer_accepted_ring)
+        return {};
+
+    bool did_receive_messages = false;
+    SharedMemoryRing::MessageStorage message;
+    for (;;) {
+        auto result = TRY(m_ring_from_peer->try_dequeue(message));
+        if (result == SharedMemoryRing::DequeueResult::Empty)
+            break;
+
+        if (result == SharedMemoryRing::DequeueResult::Marker)
+            m_unprocessed_messages.append(TRY(take_message_from_socket()));
+        else
+            m_unprocessed_messages.append(TRY(decode_message(message)));
+        did_receive_messages = true;
+    }
+
+    if (did_receive_messages) {
+        m_responsiveness_timer->stop();
+        did_become_responsive();
+
+        if (m_ring_from_peer->take_room_request())
+            TRY(send_transport_frame(TransportFrame::RingHasRoom));
+    }
+    return {};
+}
+
+ErrorOr<NonnullOwnPtr<Message>> ConnectionBase::take_message_from_socket()
+{
+    // The peer writes the whole message to the socket before it puts the marker for it into the ring.
+    while (m_messages_from_socket.is_empty()) {
+        if (!m_socket->is_open())
+            return Error::from_string_literal("IPC connection EOF");
+        wait_for_socket_to_become_readable();
+        TRY(read_as_much_as_possible_from_socket_without_blocking());
+        TRY(parse_messages_from_socket());
+    }
+    return m_messages_from_socket.take_first();
 }
 
 ErrorOr<void> ConnectionBase::drain_messages_from_peer()
 {
-    auto bytes = TRY(read_as_much_as_possible_from_socket_without_blocking());
+    if (m_receives_through_shared_memory_ring && !m_did_offer_shared_memory_ring) {
+        // The connection is fully set up by the time the first messages come in, including its fd passing socket.
+        m_did_offer_shared_memory_ring = true;
+        if (auto result = offer_shared_memory_ring(); result.is_error())
+            dbgln("IPC::ConnectionBase: Could not offer a shared memory ring, staying with the socket: {}", result.error());
+    }
 
-    size_t index = 0;
-    try_parse_messages(bytes, index);
-
-    if (index < bytes.size()) {
-        // Sometimes we might receive a partial message. That's okay, just stash away
-        // the unprocessed bytes and we'll prepend them to the next incoming message
-        // in the next run of this function.
-        auto remaining_bytes = TRY(ByteBuffer::copy(bytes.span().slice(index)));
-        if (!m_unprocessed_bytes.is_empty()) {
-            shutdown();
-            return Error::from_string_literal("drain_messages_from_peer: Already have unprocessed bytes");
-        }
-        m_unprocessed_bytes = move(remaining_bytes);
+    TRY(read_as_much_as_possible_from_socket_without_blocking());
+
+    auto result = parse_messages_from_socket();
+    if (!result.is_error())
+        result = drain_ring_from_peer();
+    if (result.is_error()) {
+        shutdown_with_error(result.error());
+        return result.release_error();
     }
 
     if (!m_unprocessed_messages.is_empty()) {
@@ -239,6 +491,10 @@ ErrorOr<void> ConnectionBase::drain_messages_from_peer()
 
 OwnPtr<IPC::Message> ConnectionBase::wait_for_specific_endpoint_message_impl(u32 endpoint_magic, int message_id)
 {
+    // The message we are waiting for might be the response to one that is still held back by a batch.
+    if (flush_pending_messages().is_error())
+        return {};
+
     for (;;) {
         // Double check we don't already have the event waiting for us.
         // Otherwise we might end up blocked for a while for no reason.
@@ -260,4 +516,19 @@ OwnPtr<IPC::Message> ConnectionBase::wait_for_specific_endpoint_message_impl(u32
     return {};
 }
 
+MessageBatch::MessageBatch(ConnectionBase& connection)
+    : m_connection(connection)
+{
+    ++m_connection->m_message_batch_depth;
+}
+
+MessageBatch::~MessageBatch()
+{
+    if (--m_connection->m_message_batch_depth > 0)
+        return;
+
+    if (auto result = m_connection->flush_pending_messages(); result.is_error())
+        dbgln("IPC::MessageBatch: {}", result.error());
+}
+
 }
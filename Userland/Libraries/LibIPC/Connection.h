@@ -8,6 +8,7 @@
 #pragma once
 
 #include <AK/ByteBuffer.h>
+#include <AK/Queue.h>
 #include <AK/Try.h>
 #include <LibCore/Event.h>
 #include <LibCore/EventLoop.h>
@@ -16,6 +17,7 @@
 #include <LibCore/Timer.h>
 #include <LibIPC/Forward.h>
 #include <LibIPC/Message.h>
+#include <LibIPC/SharedMemoryRing.h>
 #include <errno.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -51,22 +53,39 @@ public:
     Core::LocalSocket& socket() { return *m_socket; }
     Core::LocalSocket& fd_passing_socket();
 
+    bool is_sending_through_shared_memory_ring() const { return m_ring_to_peer.has_value(); }
+
 protected:
-    explicit ConnectionBase(IPC::Stub&, NonnullOwnPtr<Core::LocalSocket>, u32 local_endpoint_magic);
+    explicit ConnectionBase(IPC::Stub&, NonnullOwnPtr<Core::LocalSocket>, u32 local_endpoint_magic, bool receives_through_shared_memory_ring);
 
     virtual void may_have_become_unresponsive() { }
     virtual void did_become_responsive() { }
-    virtual void try_parse_messages(Vector<u8> const& bytes, size_t& index) = 0;
+    virtual ErrorOr<NonnullOwnPtr<Message>> decode_message(ReadonlyBytes) = 0;
     virtual void shutdown_with_error(Error const&);
 
     OwnPtr<IPC::Message> wait_for_specific_endpoint_message_impl(u32 endpoint_magic, int message_id);
     void wait_for_socket_to_become_readable();
-    ErrorOr<Vector<u8>> read_as_much_as_possible_from_socket_without_blocking();
+    ErrorOr<void> read_as_much_as_possible_from_socket_without_blocking();
+    ErrorOr<void> parse_messages_from_socket();
     ErrorOr<void> drain_messages_from_peer();
 
     ErrorOr<void> post_message(MessageBuffer);
+    ErrorOr<void> flush_pending_messages();
+    ErrorOr<void> write_to_socket(ReadonlyBytes);
     void handle_messages();
 
+    enum class TransportFrame : u32;
+    ErrorOr<void> handle_transport_frame(TransportFrame);
+    ErrorOr<void> send_transport_frame(TransportFrame);
+
+    ErrorOr<void> offer_shared_memory_ring();
+    ErrorOr<void> post_message_through_ring(MessageBuffer&);
+    ErrorOr<void> enqueue_into_ring(ReadonlyBytes message);
+    ErrorOr<bool> try_enqueue_into_ring(ReadonlyBytes message);
+    ErrorOr<void> enqueue_messages_waiting_for_ring();
+    ErrorOr<void> drain_ring_from_peer();
+    ErrorOr<NonnullOwnPtr<Message>> take_message_from_socket();
+
     IPC::Stub& m_local_stub;
 
     NonnullOwnPtr<Core::LocalSocket> m_socket;
@@ -77,16 +96,57 @@ protected:
     Vector<NonnullOwnPtr<Message>> m_unprocessed_messages;
     ByteBuffer m_unprocessed_bytes;
 
+    // Messages posted while a MessageBatch is alive, each preceded by its size.
+    ByteBuffer m_pending_messages;
+    size_t m_message_batch_depth { 0 };
+
+    // Endpoints can ask for the messages sent to them to go through shared memory instead of the socket. The
+    // receiving side offers a ring to the sending side, and uses it once the sender has accepted it. Messages that
+    // still have to go through the socket are then kept in order by markers in the ring.
+    bool m_receives_through_shared_memory_ring { false };
+    bool m_did_offer_shared_memory_ring { false };
+    Optional<SharedMemoryRing> m_ring_from_peer;
+    bool m_peer_accepted_ring { false };
+    Vector<NonnullOwnPtr<Message>> m_messages_from_socket;
+    Optional<SharedMemoryRing> m_ring_to_peer;
+    bool m_peer_needs_wakeup { false };
+
+    // Messages that found the ring to the peer full wait here until it tells us that it has made room, as does
+    // everything posted after them. An empty buffer stands for a marker.
+    Queue<ByteBuffer, 64> m_messages_waiting_for_ring;
+    size_t m_size_of_messages_waiting_for_ring { 0 };
+
     u32 m_local_endpoint_magic { 0 };
 
     NonnullOwnPtr<DeferredInvoker> m_deferred_invoker;
+
+private:
+    friend class MessageBatch;
+};
+
+// Holds back the messages posted to a connection while it is alive and then sends all of them at once, so the peer
+// can handle them after a single wakeup instead of one per message. Batches can be nested, and waiting for a response
+// on the connection sends everything that was held back so far.
+class MessageBatch {
+    AK_MAKE_NONCOPYABLE(MessageBatch);
+    AK_MAKE_NONMOVABLE(MessageBatch);
+
+public:
+    // A batch never holds back more than this, as the peer could not receive much more without reading in between.
+    static constexpr size_t max_size = 32 * KiB;
+
+    explicit MessageBatch(ConnectionBase&);
+    ~MessageBatch();
+
+private:
+    NonnullRefPtr<ConnectionBase> m_connection;
 };
 
 template<typename LocalEndpoint, typename PeerEndpoint>
 class Connection : public ConnectionBase {
 public:
     Connection(IPC::Stub& local_stub, NonnullOwnPtr<Core::LocalSocket> socket)
-        : ConnectionBase(local_stub, move(socket), LocalEndpoint::static_magic())
+        : ConnectionBase(local_stub, move(socket), LocalEndpoint::static_magic(), LocalEndpoint::uses_shared_memory_ring())
     {
         m_socket->on_ready_to_read = [this] {
             NonnullRefPtr protect = *this;
@@ -128,33 +188,20 @@ protected:
         return {};
     }
 
-    virtual void try_parse_messages(Vector<u8> const& bytes, size_t& index) override
+    virtual ErrorOr<NonnullOwnPtr<Message>> decode_message(ReadonlyBytes bytes) override
     {
-        u32 message_size = 0;
-        for (; index + sizeof(message_size) < bytes.size(); index += message_size) {
-            memcpy(&message_size, bytes.data() + index, sizeof(message_size));
-            if (message_size == 0 || bytes.size() - index - sizeof(uint32_t) < message_size)
-                break;
-            index += sizeof(message_size);
-            auto remaining_bytes = ReadonlyBytes { bytes.data() + index, message_size };
-
-            auto local_message = LocalEndpoint::decode_message(remaining_bytes, fd_passing_socket());
-            if (!local_message.is_error()) {
-                m_unprocessed_messages.append(local_message.release_value());
-                continue;
-            }
-
-            auto peer_message = PeerEndpoint::decode_message(remaining_bytes, fd_passing_socket());
-            if (!peer_message.is_error()) {
-                m_unprocessed_messages.append(peer_message.release_value());
-                continue;
-            }
-
-            dbgln("Failed to parse a message");
-            dbgln("Local endpoint error: {}", local_message.error());
-            dbgln("Peer endpoint error: {}", peer_message.error());
-            break;
-        }
+        auto local_message = LocalEndpoint::decode_message(bytes, fd_passing_socket());
+        if (!local_message.is_error())
+            return local_message.release_value();
+
+        auto peer_message = PeerEndpoint::decode_message(bytes, fd_passing_socket());
+        if (!peer_message.is_error())
+            return peer_message.release_value();
+
+        dbgln("Failed to parse a message");
+        dbgln("Local endpoint error: {}", local_message.error());
+        dbgln("Peer endpoint error: {}", peer_message.error());
+        return peer_message.release_error();
     }
 };
 
@@ -12,6 +12,7 @@
 #include <LibCore/DateTime.h>
 #include <LibCore/Proxy.h>
 #include <LibCore/Socket.h>
+#include <LibCore/System.h>
 #include <LibIPC/Decoder.h>
 #include <LibIPC/File.h>
 #include <fcntl.h>
@@ -23,10 +24,26 @@ ErrorOr<size_t> Decoder::decode_size()
     return static_cast<size_t>(TRY(decode<u32>()));
 }
 
+ErrorOr<Core::AnonymousBuffer> Decoder::decode_large_payload(size_t size)
+{
+    auto file = TRY(decode<IPC::File>());
+
+    // Mapping more than the peer actually gave us would crash us as soon as we touch the missing part.
+    auto stat = TRY(Core::System::fstat(file.fd()));
+    if (stat.st_size < 0 || static_cast<u64>(stat.st_size) < size)
+        return Error::from_string_literal("Large payload is smaller than its encoded size");
+
+    return Core::AnonymousBuffer::create_from_anon_fd(file.take_fd(), size);
+}
+
 template<>
 ErrorOr<String> decode(Decoder& decoder)
 {
     auto length = TRY(decoder.decode_size());
+    if (decoder.is_large_payload(length)) {
+        auto payload = TRY(decoder.decode_large_payload(length));
+        return String::from_utf8(StringView { payload.data<char>(), length });
+    }
     return String::from_stream(decoder.stream(), length);
 }
 
@@ -38,6 +55,10 @@ ErrorOr<ByteString> decode(Decoder& decoder)
         return ByteString {};
     if (length == 0)
         return ByteString::empty();
+    if (decoder.is_large_payload(length)) {
+        auto payload = TRY(decoder.decode_large_payload(length));
+        return ByteString { StringView { payload.data<char>(), length } };
+    }
 
     char* text_buffer = nullptr;
     auto text_impl = StringImpl::create_uninitialized(length, text_buffer);
@@ -54,6 +75,10 @@ ErrorOr<ByteBuffer> decode(Decoder& decoder)
     auto length = TRY(decoder.decode_size());
     if (length == 0)
         return ByteBuffer {};
+    if (decoder.is_large_payload(length)) {
+        auto payload = TRY(decoder.decode_large_payload(length));
+        return ByteBuffer::copy(payload.data<u8>(), length);
+    }
 
     auto buffer = TRY(ByteBuffer::create_uninitialized(length));
     auto bytes = buffer.bytes();
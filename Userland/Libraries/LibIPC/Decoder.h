@@ -34,9 +34,10 @@ inline ErrorOr<T> decode(Decoder&)
 
 class Decoder {
 public:
-    Decoder(Stream& stream, Core::LocalSocket& socket)
+    Decoder(Stream& stream, Core::LocalSocket& socket, LargePayloads large_payloads = LargePayloads::Inline)
         : m_stream(stream)
         , m_socket(socket)
+        , m_large_payloads(large_payloads)
     {
     }
 
@@ -58,12 +59,19 @@ public:
 
     ErrorOr<size_t> decode_size();
 
+    // Whether a payload of the given size was sent in shared memory, see Encoder::append_payload().
+    bool is_large_payload(size_t size) const { return m_large_payloads == LargePayloads::InSharedMemory && size >= large_payload_threshold; }
+
+    // Maps the shared memory of a payload that was too large to be sent inline.
+    ErrorOr<Core::AnonymousBuffer> decode_large_payload(size_t size);
+
     Stream& stream() { return m_stream; }
     Core::LocalSocket& socket() { return m_socket; }
 
 private:
     Stream& m_stream;
     Core::LocalSocket& m_socket;
+    LargePayloads m_large_payloads { LargePayloads::Inline };
 };
 
 template<Arithmetic T>
@@ -31,6 +31,16 @@ ErrorOr<void> Encoder::encode_size(size_t size)
     return encode(static_cast<u32>(size));
 }
 
+ErrorOr<void> Encoder::append_payload(ReadonlyBytes bytes)
+{
+    if (m_large_payloads == LargePayloads::Inline || bytes.size() < large_payload_threshold)
+        return append(bytes.data(), bytes.size());
+
+    auto buffer = TRY(Core::AnonymousBuffer::create_with_size(bytes.size()));
+    bytes.copy_to({ buffer.data<u8>(), buffer.size() });
+    return encode(IPC::File { buffer.fd() });
+}
+
 template<>
 ErrorOr<void> encode(Encoder& encoder, float const& value)
 {
@@ -48,7 +58,7 @@ ErrorOr<void> encode(Encoder& encoder, String const& value)
 {
     auto bytes = value.bytes();
     TRY(encoder.encode_size(bytes.size()));
-    TRY(encoder.append(bytes.data(), bytes.size()));
+    TRY(encoder.append_payload(bytes));
     return {};
 }
 
@@ -60,7 +70,7 @@ ErrorOr<void> encode(Encoder& encoder, StringView const& value)
         return encoder.encode(NumericLimits<u32>::max());
 
     TRY(encoder.encode_size(value.length()));
-    TRY(encoder.append(reinterpret_cast<u8 const*>(value.characters_without_null_termination()), value.length()));
+    TRY(encoder.append_payload(value.bytes()));
     return {};
 }
 
@@ -74,7 +84,7 @@ template<>
 ErrorOr<void> encode(Encoder& encoder, ByteBuffer const& value)
 {
     TRY(encoder.encode_size(value.size()));
-    TRY(encoder.append(value.data(), value.size()));
+    TRY(encoder.append_payload(value.bytes()));
     return {};
 }
 
@@ -27,8 +27,9 @@ ErrorOr<void> encode(Encoder&, T const&)
 
 class Encoder {
 public:
-    explicit Encoder(MessageBuffer& buffer)
+    explicit Encoder(MessageBuffer& buffer, LargePayloads large_payloads = LargePayloads::Inline)
         : m_buffer(buffer)
+        , m_large_payloads(large_payloads)
     {
     }
 
@@ -52,6 +53,10 @@ public:
         return {};
     }
 
+    // Appends the bytes of a string or buffer whose size has already been encoded. If the endpoint allows it, large
+    // payloads are copied into shared memory, and only the file descriptor for that is sent along with the message.
+    ErrorOr<void> append_payload(ReadonlyBytes);
+
     ErrorOr<void> append_file_descriptor(int fd)
     {
         auto auto_fd = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) AutoCloseFileDescriptor(fd)));
@@ -60,8 +65,11 @@ public:
 
     ErrorOr<void> encode_size(size_t size);
 
+    LargePayloads large_payloads() const { return m_large_payloads; }
+
 private:
     MessageBuffer& m_buffer;
+    LargePayloads m_large_payloads { LargePayloads::Inline };
 };
 
 template<Arithmetic T>
@@ -33,6 +33,19 @@ private:
     int m_fd;
 };
 
+// Strings and byte buffers of at least this size are passed in shared memory instead of being copied through the
+// socket, see Encoder::append_payload(). Setting up the shared memory costs more than copying smaller payloads, but
+// anything larger would have to squeeze through the socket buffer in several writes.
+constexpr size_t large_payload_threshold = 256 * KiB;
+
+// Passing a payload in shared memory sends a file descriptor along with the message, which kills processes that
+// haven't pledged "sendfd" or "recvfd". Endpoints opt in with the [LargePayloadsInSharedMemory] attribute once both
+// sides may pass file descriptors.
+enum class LargePayloads {
+    Inline,
+    InSharedMemory,
+};
+
 struct MessageBuffer {
     Vector<u8, 1024> data;
     Vector<NonnullRefPtr<AutoCloseFileDescriptor>, 1> fds;
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <AK/NumericLimits.h>
+#include <AK/ScopeGuard.h>
+#include <LibCore/System.h>
+#include <LibIPC/SharedMemoryRing.h>
+
+namespace IPC {
+
+// Every record starts with the size of its message. Records are padded to keep these sizes aligned, which also keeps
+// them from wrapping around the end of the ring. Only the messages themselves might have to.
+static constexpr u32 marker_header = NumericLimits<u32>::max();
+static constexpr size_t record_alignment = sizeof(u32);
+
+static constexpr size_t record_size(size_t message_size)
+{
+    return sizeof(u32) + align_up_to(message_size, record_alignment);
+}
+
+struct SharedMemoryRing::SharedState {
+    // Both positions only ever grow, and are taken modulo the capacity to find a record.
+    AK_CACHE_ALIGNED Atomic<u64> tail { 0 };
+    AK_CACHE_ALIGNED Atomic<u64> head { 0 };
+    // Set by the writer when it finds the ring full, and cleared by the reader when it tells the writer about room.
+    AK_CACHE_ALIGNED Atomic<bool> writer_needs_room { false };
+    AK_CACHE_ALIGNED u8 data[capacity];
+};
+
+static_assert(SharedMemoryRing::capacity % record_alignment == 0);
+static_assert(record_size(SharedMemoryRing::max_message_size) <= SharedMemoryRing::capacity);
+
+SharedMemoryRing::SharedMemoryRing(Core::AnonymousBuffer buffer)
+    : m_buffer(move(buffer))
+{
+}
+
+ErrorOr<SharedMemoryRing> SharedMemoryRing::create()
+{
+    auto buffer = TRY(Core::AnonymousBuffer::create_with_size(sizeof(SharedState)));
+    new (buffer.data<void>()) SharedState;
+    return SharedMemoryRing { move(buffer) };
+}
+
+ErrorOr<SharedMemoryRing> SharedMemoryRing::create_from_fd(int fd)
+{
+    ArmedScopeGuard close_fd { [&] { (void)Core::System::close(fd); } };
+
+    // Mapping more than the other process actually allocated would crash us as soon as we touch the missing part.
+    auto stat = TRY(Core::System::fstat(fd));
+    if (stat.st_size < 0 || static_cast<u64>(stat.st_size) < sizeof(SharedState))
+        return Error::from_string_literal("Shared memory ring is too small");
+
+    auto buffer = TRY(Core::AnonymousBuffer::create_from_anon_fd(fd, sizeof(SharedState)));
+    close_fd.disarm();
+    return SharedMemoryRing { move(buffer) };
+}
+
+SharedMemoryRing::SharedState& SharedMemoryRing::shared_state()
+{
+    return *static_cast<SharedState*>(m_buffer.data<void>());
+}
+
+ErrorOr<SharedMemoryRing::EnqueueResult> SharedMemoryRing::try_enqueue(ReadonlyBytes message)
+{
+    VERIFY(message.size() <= max_message_size);
+    return try_enqueue_record(message.size(), message);
+}
+
+ErrorOr<SharedMemoryRing::EnqueueResult> SharedMemoryRing::try_enqueue_marker()
+{
+    return try_enqueue_record(marker_header, {});
+}
+
+ErrorOr<SharedMemoryRing::EnqueueResult> SharedMemoryRing::try_enqueue_record(u32 header, ReadonlyBytes payload)
+{
+    auto& shared = shared_state();
+
+    auto head = shared.head.load();
+    if (head > m_tail || m_tail - head > capacity)
+        return Error::from_string_literal("Shared memory ring has an invalid head");
+
+    auto size = record_size(payload.size());
+    if (capacity - (m_tail - head) < size)
+        return EnqueueResult::Full;
+
+    auto offset = m_tail % capacity;
+    __builtin_memcpy(shared.data + offset, &header, sizeof(header));
+
+    if (!payload.is_empty()) {
+        offset = (offset + sizeof(header)) % capacity;
+        auto size_until_end = min(payload.size(), capacity - offset);
+        __builtin_memcpy(shared.data + offset, payload.data(), size_until_end);
+        __builtin_memcpy(shared.data, payload.offset_pointer(size_until_end), payload.size() - size_until_end);
+    }
+
+    auto old_tail = m_tail;
+    m_tail += size;
+    shared.tail.store(m_tail);
+
+    // The reader stores its head before looking at the tail again, and we store the tail before looking at the head.
+    // So if it has not read up to this record yet, it will find it, and otherwise it might have gone to sleep.
+    if (shared.head.load() == old_tail)
+        return EnqueueResult::EnqueuedIntoEmptyRing;
+    return EnqueueResult::Enqueued;
+}
+
+void SharedMemoryRing::request_room()
+{
+    // We store the request before looking at the head again, and the reader stores its head before looking at the
+    // request. So either our next attempt finds the room, or the reader finds the request.
+    shared_state().writer_needs_room.store(true);
+}
+
+bool SharedMemoryRing::take_room_request()
+{
+    return shared_state().writer_needs_room.exchange(false);
+}
+
+ErrorOr<SharedMemoryRing::DequeueResult> SharedMemoryRing::try_dequeue(MessageStorage& message)
+{
+    auto& shared = shared_state();
+
+    auto tail = shared.tail.load();
+    if (tail < m_head || tail - m_head > capacity)
+        return Error::from_string_literal("Shared memory ring has an invalid tail");
+    if (tail == m_head)
+        return DequeueResult::Empty;
+    if (tail - m_head < record_size(0))
+        return Error::from_string_literal("Shared memory ring has an invalid record");
+
+    auto offset = m_head % capacity;
+    u32 header;
+    __builtin_memcpy(&header, shared.data + offset, sizeof(header));
+
+    message.clear_with_capacity();
+    if (header == marker_header) {
+        m_head += record_size(0);
+        shared.head.store(m_head);
+        return DequeueResult::Marker;
+    }
+
+    if (header > max_message_size || record_size(header) > tail - m_head)
+        return Error::from_string_literal("Shared memory ring has an invalid record");
+
+    offset = (offset + sizeof(header)) % capacity;
+    auto size_until_end = min<size_t>(header, capacity - offset);
+    message.unchecked_append(shared.data + offset, size_until_end);
+    message.unchecked_append(shared.data, header - size_until_end);
+
+    m_head += record_size(header);
+    shared.head.store(m_head);
+    return DequeueResult::Message;
+}
+
+}
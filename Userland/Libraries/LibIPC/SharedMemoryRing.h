@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/Span.h>
+#include <AK/Types.h>
+#include <AK/Vector.h>
+#include <LibCore/AnonymousBuffer.h>
+
+namespace IPC {
+
+// A ring of messages in shared memory, written by one process and read by another. Unlike
+// Core::SharedSingleProducerCircularQueue, it holds messages of varying size, and neither side trusts anything that
+// the other side writes into the shared memory: each side keeps its own position and only checks the other's.
+class SharedMemoryRing {
+public:
+    static constexpr size_t capacity = 64 * KiB;
+    static constexpr size_t max_message_size = 4 * KiB;
+
+    // Allocates a new, empty ring. The process that allocates it is the one reading from it.
+    static ErrorOr<SharedMemoryRing> create();
+    // Maps a ring that another process allocated, in order to write to it.
+    static ErrorOr<SharedMemoryRing> create_from_fd(int fd);
+
+    int fd() const { return m_buffer.fd(); }
+
+    enum class EnqueueResult {
+        Full,
+        Enqueued,
+        // The reader might have seen the ring empty just before, so it has to be woken up to read the message.
+        EnqueuedIntoEmptyRing,
+    };
+
+    ErrorOr<EnqueueResult> try_enqueue(ReadonlyBytes message);
+    // Tells the reader that the next message was sent some other way, in order to keep it in its place.
+    ErrorOr<EnqueueResult> try_enqueue_marker();
+
+    // Asks the reader to tell us once it has made room, after finding the ring full. The reader might have emptied the
+    // ring just before seeing the request, so the writer has to try again once after making it.
+    void request_room();
+    // Returns whether the writer has asked for room since the last call, for the reader to call after dequeuing.
+    bool take_room_request();
+
+    enum class DequeueResult {
+        Empty,
+        Message,
+        Marker,
+    };
+
+    using MessageStorage = Vector<u8, max_message_size>;
+    ErrorOr<DequeueResult> try_dequeue(MessageStorage& message);
+
+private:
+    struct SharedState;
+
+    explicit SharedMemoryRing(Core::AnonymousBuffer);
+
+    SharedState& shared_state();
+    ErrorOr<EnqueueResult> try_enqueue_record(u32 header, ReadonlyBytes payload);
+
+    Core::AnonymousBuffer m_buffer;
+
+    // The writer only ever looks at its own tail, and the reader only at its own head.
+    u64 m_tail { 0 };
+    u64 m_head { 0 };
+};
+
+}
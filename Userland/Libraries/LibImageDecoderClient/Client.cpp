@@ -20,7 +20,7 @@ void Client::die()
         on_death();
 }
 
-Optional<DecodedImage> Client::decode_image(ReadonlyBytes encoded_data, Optional<ByteString> mime_type)
+Optional<DecodedImage> Client::decode_image(ReadonlyBytes encoded_data, Optional<ByteString> mime_type, Optional<Gfx::IntSize> ideal_size)
 {
     if (encoded_data.is_empty())
         return {};
@@ -33,7 +33,7 @@ Optional<DecodedImage> Client::decode_image(ReadonlyBytes encoded_data, Optional
     auto encoded_buffer = encoded_buffer_or_error.release_value();
 
     memcpy(encoded_buffer.data<void>(), encoded_data.data(), encoded_data.size());
-    auto response_or_error = try_decode_image(move(encoded_buffer), mime_type);
+    auto response_or_error = try_decode_image(move(encoded_buffer), mime_type, ideal_size);
 
     if (response_or_error.is_error()) {
         dbgln("ImageDecoder died heroically");
@@ -59,4 +59,82 @@ Optional<DecodedImage> Client::decode_image(ReadonlyBytes encoded_data, Optional
     return image;
 }
 
+Optional<i32> Client::begin_decode_session(DecodeSessionCallbacks callbacks, Optional<ByteString> mime_type)
+{
+    if (!is_open()) {
+        dbgln("ImageDecoder died heroically");
+        return {};
+    }
+
+    auto session_id = IPC::ConnectionToServer<ImageDecoderClientEndpoint, ImageDecoderServerEndpoint>::begin_decode_session(mime_type);
+    m_decode_sessions.set(session_id, move(callbacks));
+    return session_id;
+}
+
+void Client::append_encoded_data(i32 session_id, ReadonlyBytes encoded_data)
+{
+    if (encoded_data.is_empty())
+        return;
+
+    auto buffer_or_error = ByteBuffer::copy(encoded_data);
+    if (buffer_or_error.is_error()) {
+        dbgln("Could not allocate encoded buffer");
+        return;
+    }
+    async_append_encoded_data(session_id, buffer_or_error.release_value());
+}
+
+void Client::finish_encoded_data(i32 session_id)
+{
+    async_finish_encoded_data(session_id);
+}
+
+void Client::decode_frame(i32 session_id, u32 frame_index)
+{
+    async_decode_frame(session_id, frame_index);
+}
+
+void Client::end_decode_session(i32 session_id)
+{
+    m_decode_sessions.remove(session_id);
+    async_end_decode_session(session_id);
+}
+
+void Client::did_decode_image_size(i32 session_id, Gfx::IntSize size)
+{
+    auto callbacks = m_decode_sessions.get(session_id);
+    if (callbacks.has_value() && callbacks->on_size)
+        callbacks->on_size(size);
+}
+
+void Client::did_decode_image_metadata(i32 session_id, bool is_animated, u32 loop_count, u32 frame_count)
+{
+    auto callbacks = m_decode_sessions.get(session_id);
+    if (callbacks.has_value() && callbacks->on_metadata)
+        callbacks->on_metadata(is_animated, loop_count, frame_count);
+}
+
+void Client::did_decode_frame(i32 session_id, u32 frame_index, Gfx::ShareableBitmap const& bitmap, u32 duration, bool is_complete)
+{
+    auto callbacks = m_decode_sessions.get(session_id);
+    if (!callbacks.has_value())
+        return;
+
+    if (!bitmap.is_valid()) {
+        if (callbacks->on_failure)
+            callbacks->on_failure();
+        return;
+    }
+
+    if (callbacks->on_frame)
+        callbacks->on_frame(frame_index, Frame { *bitmap.bitmap(), duration }, is_complete);
+}
+
+void Client::did_fail_to_decode(i32 session_id)
+{
+    auto callbacks = m_decode_sessions.get(session_id);
+    if (callbacks.has_value() && callbacks->on_failure)
+        callbacks->on_failure();
+}
+
 }
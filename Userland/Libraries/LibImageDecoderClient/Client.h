@@ -24,6 +24,16 @@ struct DecodedImage {
     Vector<Frame> frames;
 };
 
+// Receives the results of a decode session, as they become available.
+struct DecodeSessionCallbacks {
+    Function<void(Gfx::IntSize)> on_size;
+    Function<void(bool is_animated, u32 loop_count, u32 frame_count)> on_metadata;
+    // Called with is_complete set to false for the partially decoded first frame of an image whose data hasn't all
+    // been received yet, and with it set to true for every frame once it's fully decoded.
+    Function<void(u32 frame_index, Frame, bool is_complete)> on_frame;
+    Function<void()> on_failure;
+};
+
 class Client final
     : public IPC::ConnectionToServer<ImageDecoderClientEndpoint, ImageDecoderServerEndpoint>
     , public ImageDecoderClientEndpoint {
@@ -32,12 +42,28 @@ class Client final
 public:
     Client(NonnullOwnPtr<Core::LocalSocket>);
 
-    Optional<DecodedImage> decode_image(ReadonlyBytes, Optional<ByteString> mime_type = {});
+    // If an ideal size is given, the frames may be decoded at a smaller size that is still at least as large as it.
+    Optional<DecodedImage> decode_image(ReadonlyBytes, Optional<ByteString> mime_type = {}, Optional<Gfx::IntSize> ideal_size = {});
+
+    // Decodes an image while its data is still arriving: partial frames are sent as the data comes in, and the frames
+    // of animations are only decoded when asked for with decode_frame(), once finish_encoded_data() has been called.
+    Optional<i32> begin_decode_session(DecodeSessionCallbacks, Optional<ByteString> mime_type = {});
+    void append_encoded_data(i32 session_id, ReadonlyBytes);
+    void finish_encoded_data(i32 session_id);
+    void decode_frame(i32 session_id, u32 frame_index);
+    void end_decode_session(i32 session_id);
 
     Function<void()> on_death;
 
 private:
     virtual void die() override;
+
+    virtual void did_decode_image_size(i32 session_id, Gfx::IntSize) override;
+    virtual void did_decode_image_metadata(i32 session_id, bool is_animated, u32 loop_count, u32 frame_count) override;
+    virtual void did_decode_frame(i32 session_id, u32 frame_index, Gfx::ShareableBitmap const&, u32 duration, bool is_complete) override;
+    virtual void did_fail_to_decode(i32 session_id) override;
+
+    HashMap<i32, DecodeSessionCallbacks> m_decode_sessions;
 };
 
 }
@@ -303,15 +303,21 @@ struct X86_64Assembler {
         emit8(rex.raw);
     }
 
-    void shift_right(Operand dst, Operand count)
+    void shift_right(Operand dst, Optional<Operand> count)
     {
         VERIFY(dst.type == Operand::Type::Reg);
-        VERIFY(count.type == Operand::Type::Imm);
-        VERIFY(count.fits_in_u8());
-        emit_rex_for_slash(dst, REX_W::Yes);
-        emit8(0xc1);
-        emit_modrm_slash(5, dst);
-        emit8(count.offset_or_immediate);
+        if (count.has_value()) {
+            VERIFY(count->type == Operand::Type::Imm);
+            VERIFY(count->fits_in_u8());
+            emit_rex_for_slash(dst, REX_W::Yes);
+            emit8(0xc1);
+            emit_modrm_slash(5, dst);
+            emit8(count->offset_or_immediate);
+        } else {
+            emit_rex_for_slash(dst, REX_W::Yes);
+            emit8(0xd3);
+            emit_modrm_slash(5, dst);
+        }
     }
 
     void mov(Operand dst, Operand src, Patchable patchable = Patchable::No)
@@ -385,6 +391,21 @@ struct X86_64Assembler {
 
     void mov8(Operand dst, Operand src, Extension extension = Extension::ZeroExtend)
     {
+        if (dst.type == Operand::Type::Mem64BaseAndOffset && src.type == Operand::Type::Reg) {
+            // mov r/m8, r8
+            // Note: Without a REX prefix, registers 4-7 would encode AH, CH, DH and BH instead of SPL, BPL, SIL and DIL.
+            REX rex {
+                .B = to_underlying(dst.reg) >= 8,
+                .X = 0,
+                .R = to_underlying(src.reg) >= 8,
+                .W = 0
+            };
+            if (rex.B || rex.R || to_underlying(src.reg) >= 4)
+                emit8(rex.raw);
+            emit8(0x88);
+            emit_modrm_mr(dst, src);
+            return;
+        }
         VERIFY(dst.type == Operand::Type::Reg && src.type == Operand::Type::Mem64BaseAndOffset);
         // mov[sz]x r32, r/m8
         emit_rex_for_rm(dst, src, REX_W::No);
@@ -395,6 +416,14 @@ struct X86_64Assembler {
 
     void mov16(Operand dst, Operand src, Extension extension = Extension::ZeroExtend)
     {
+        if (dst.type == Operand::Type::Mem64BaseAndOffset && src.type == Operand::Type::Reg) {
+            // mov r/m16, r16
+            emit8(0x66);
+            emit_rex_for_mr(dst, src, REX_W::No);
+            emit8(0x89);
+            emit_modrm_mr(dst, src);
+            return;
+        }
         VERIFY(dst.type == Operand::Type::Reg && src.is_register_or_memory());
         // mov[sz]x r32, r/m16
         emit_rex_for_rm(dst, src, REX_W::No);
@@ -405,6 +434,13 @@ struct X86_64Assembler {
 
     void mov32(Operand dst, Operand src, Extension extension = Extension::ZeroExtend)
     {
+        if (dst.type == Operand::Type::Mem64BaseAndOffset && src.type == Operand::Type::Reg) {
+            // mov r/m32, r32
+            emit_rex_for_mr(dst, src, REX_W::No);
+            emit8(0x89);
+            emit_modrm_mr(dst, src);
+            return;
+        }
         VERIFY(dst.type == Operand::Type::Reg && src.is_register_or_memory());
         if (extension == Extension::ZeroExtend) {
             // mov r32, r/m32
@@ -640,6 +676,28 @@ struct X86_64Assembler {
         }
     }
 
+    void bitwise_xor(Operand dst, Operand src)
+    {
+        // xor dst,src
+        if (dst.is_register_or_memory() && src.type == Operand::Type::Reg) {
+            emit_rex_for_mr(dst, src, REX_W::Yes);
+            emit8(0x31);
+            emit_modrm_mr(dst, src);
+        } else if (dst.type == Operand::Type::Reg && src.type == Operand::Type::Imm && src.fits_in_i8()) {
+            emit_rex_for_slash(dst, REX_W::Yes);
+            emit8(0x83);
+            emit_modrm_slash(6, dst);
+            emit8(src.offset_or_immediate);
+        } else if (dst.type == Operand::Type::Reg && src.type == Operand::Type::Imm && src.fits_in_i32()) {
+            emit_rex_for_slash(dst, REX_W::Yes);
+            emit8(0x81);
+            emit_modrm_slash(6, dst);
+            emit32(src.offset_or_immediate);
+        } else {
+            VERIFY_NOT_REACHED();
+        }
+    }
+
     void bitwise_xor32(Operand dst, Operand src)
     {
         if (dst.is_register_or_memory() && src.type == Operand::Type::Reg) {
@@ -668,11 +726,63 @@ struct X86_64Assembler {
             emit8(0x0f);
             emit8(0x59);
             emit_modrm_rm(dest, src);
+        } else if (dest.type == Operand::Type::Reg && src.is_register_or_memory()) {
+            // imul dest, src (64-bit signed)
+            emit_rex_for_rm(dest, src, REX_W::Yes);
+            emit8(0x0f);
+            emit8(0xaf);
+            emit_modrm_rm(dest, src);
         } else {
             VERIFY_NOT_REACHED();
         }
     }
 
+    // Divides RDX:RAX by the divisor, leaving the quotient in RAX and the remainder in RDX.
+    // RDX is set up from RAX first, so only the dividend has to be in RAX.
+    void signed_divide(Operand divisor)
+    {
+        VERIFY(divisor.is_register_or_memory());
+        // cqo
+        emit8(0x48);
+        emit8(0x99);
+        // idiv divisor
+        emit_rex_for_slash(divisor, REX_W::Yes);
+        emit8(0xf7);
+        emit_modrm_slash(7, divisor);
+    }
+
+    void unsigned_divide(Operand divisor)
+    {
+        VERIFY(divisor.is_register_or_memory());
+        mov(Operand::Register(Reg::RDX), Operand::Imm(0));
+        // div divisor
+        emit_rex_for_slash(divisor, REX_W::Yes);
+        emit8(0xf7);
+        emit_modrm_slash(6, divisor);
+    }
+
+    // Same as above, but dividing EDX:EAX and leaving the results in EAX and EDX.
+    void signed_divide32(Operand divisor)
+    {
+        VERIFY(divisor.is_register_or_memory());
+        // cdq
+        emit8(0x99);
+        // idiv divisor
+        emit_rex_for_slash(divisor, REX_W::No);
+        emit8(0xf7);
+        emit_modrm_slash(7, divisor);
+    }
+
+    void unsigned_divide32(Operand divisor)
+    {
+        VERIFY(divisor.is_register_or_memory());
+        mov(Operand::Register(Reg::RDX), Operand::Imm(0));
+        // div divisor
+        emit_rex_for_slash(divisor, REX_W::No);
+        emit8(0xf7);
+        emit_modrm_slash(6, divisor);
+    }
+
     void mul32(Operand dest, Operand src, Optional<Label&> overflow_label)
     {
         // imul32 dest, src (32-bit signed)
@@ -794,6 +904,74 @@ struct X86_64Assembler {
         }
     }
 
+    void rotate_left(Operand dest, Optional<Operand> count)
+    {
+        VERIFY(dest.type == Operand::Type::Reg);
+        if (count.has_value()) {
+            VERIFY(count->type == Operand::Type::Imm);
+            VERIFY(count->fits_in_u8());
+            emit_rex_for_slash(dest, REX_W::Yes);
+            emit8(0xc1);
+            emit_modrm_slash(0, dest);
+            emit8(count->offset_or_immediate);
+        } else {
+            emit_rex_for_slash(dest, REX_W::Yes);
+            emit8(0xd3);
+            emit_modrm_slash(0, dest);
+        }
+    }
+
+    void rotate_left32(Operand dest, Optional<Operand> count)
+    {
+        VERIFY(dest.type == Operand::Type::Reg);
+        if (count.has_value()) {
+            VERIFY(count->type == Operand::Type::Imm);
+            VERIFY(count->fits_in_u8());
+            emit_rex_for_slash(dest, REX_W::No);
+            emit8(0xc1);
+            emit_modrm_slash(0, dest);
+            emit8(count->offset_or_immediate);
+        } else {
+            emit_rex_for_slash(dest, REX_W::No);
+            emit8(0xd3);
+            emit_modrm_slash(0, dest);
+        }
+    }
+
+    void rotate_right(Operand dest, Optional<Operand> count)
+    {
+        VERIFY(dest.type == Operand::Type::Reg);
+        if (count.has_value()) {
+            VERIFY(count->type == Operand::Type::Imm);
+            VERIFY(count->fits_in_u8());
+            emit_rex_for_slash(dest, REX_W::Yes);
+            emit8(0xc1);
+            emit_modrm_slash(1, dest);
+            emit8(count->offset_or_immediate);
+        } else {
+            emit_rex_for_slash(dest, REX_W::Yes);
+            emit8(0xd3);
+            emit_modrm_slash(1, dest);
+        }
+    }
+
+    void rotate_right32(Operand dest, Optional<Operand> count)
+    {
+        VERIFY(dest.type == Operand::Type::Reg);
+        if (count.has_value()) {
+            VERIFY(count->type == Operand::Type::Imm);
+            VERIFY(count->fits_in_u8());
+            emit_rex_for_slash(dest, REX_W::No);
+            emit8(0xc1);
+            emit_modrm_slash(1, dest);
+            emit8(count->offset_or_immediate);
+        } else {
+            emit_rex_for_slash(dest, REX_W::No);
+            emit8(0xd3);
+            emit_modrm_slash(1, dest);
+        }
+    }
+
     void enter()
     {
         push(Operand::Register(Reg::RBP));
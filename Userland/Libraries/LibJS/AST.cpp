@@ -72,6 +72,28 @@ static void update_function_name(Value value, DeprecatedFlyString const& name)
         static_cast<ECMAScriptFunctionObject&>(function).set_name(name);
 }
 
+static ByteString source_text_for_range(UnrealizedSourceRange const& range)
+{
+    // NOTE: Synthesized nodes (such as default class constructors) don't have any source text.
+    if (!range.source_code)
+        return ByteString::empty();
+    return range.source_code->code().bytes_as_string_view().substring_view(range.start_offset, range.end_offset - range.start_offset);
+}
+
+ByteString const& FunctionNode::source_text() const
+{
+    if (!m_source_text.has_value())
+        m_source_text = source_text_for_range(m_source_text_range);
+    return *m_source_text;
+}
+
+ByteString const& ClassExpression::source_text() const
+{
+    if (!m_source_text.has_value())
+        m_source_text = source_text_for_range(m_source_text_range);
+    return *m_source_text;
+}
+
 void LabelledStatement::dump(int indent) const
 {
     ASTNode::dump(indent);
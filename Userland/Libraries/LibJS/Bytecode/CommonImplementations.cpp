@@ -135,6 +135,10 @@ ThrowCompletionOr<Value> get_by_value(VM& vm, Value base_value, Value property_k
                     return fast_typed_array_get_element<i32>(typed_array, index);
                 case TypedArrayBase::Kind::Uint8ClampedArray:
                     return fast_typed_array_get_element<u8>(typed_array, index);
+                case TypedArrayBase::Kind::Float32Array:
+                    return fast_typed_array_get_element<float>(typed_array, index);
+                case TypedArrayBase::Kind::Float64Array:
+                    return fast_typed_array_get_element<double>(typed_array, index);
                 default:
                     // FIXME: Support more TypedArray kinds.
                     break;
@@ -427,6 +431,19 @@ ThrowCompletionOr<void> put_by_value(VM& vm, Value base, Value property_key_valu
                 }
             }
 
+            if (value.is_number() && is_valid_integer_index(typed_array, canonical_index)) {
+                switch (typed_array.kind()) {
+                case TypedArrayBase::Kind::Float32Array:
+                    fast_typed_array_set_element<float>(typed_array, index, static_cast<float>(value.as_double()));
+                    return {};
+                case TypedArrayBase::Kind::Float64Array:
+                    fast_typed_array_set_element<double>(typed_array, index, value.as_double());
+                    return {};
+                default:
+                    break;
+                }
+            }
+
             switch (typed_array.kind()) {
 #define __JS_ENUMERATE(ClassName, snake_name, PrototypeName, ConstructorName, Type) \
     case TypedArrayBase::Kind::ClassName:                                           \
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashFunctions.h>
+#include <AK/StringHash.h>
+#include <LibJS/ProgramCache.h>
+#include <LibJS/SourceCode.h>
+
+namespace JS {
+
+void ProgramCache::set_enabled(bool enabled)
+{
+    m_enabled = enabled;
+    if (!m_enabled)
+        clear();
+}
+
+u32 ProgramCache::compute_hash(StringView source_text, StringView filename, Program::Type type, size_t line_number_offset)
+{
+    auto hash = string_hash(source_text.characters_without_null_termination(), source_text.length());
+    hash = pair_int_hash(hash, string_hash(filename.characters_without_null_termination(), filename.length()));
+    hash = pair_int_hash(hash, to_underlying(type));
+    return pair_int_hash(hash, static_cast<u32>(line_number_offset));
+}
+
+RefPtr<Program> ProgramCache::find(StringView source_text, StringView filename, Program::Type type, size_t line_number_offset)
+{
+    if (!m_enabled || source_text.length() < minimum_cached_source_length)
+        return nullptr;
+
+    auto hash = compute_hash(source_text, filename, type, line_number_offset);
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        auto const& entry = m_entries[i];
+        if (entry.hash != hash || entry.type != type || entry.line_number_offset != line_number_offset)
+            continue;
+
+        // The hash is only a filter, make sure that the program was really parsed from the same source.
+        auto const& source_code = entry.program->source_code();
+        if (source_code.code().bytes_as_string_view() != source_text || source_code.filename().bytes_as_string_view() != filename)
+            continue;
+
+        ++m_hit_count;
+        if (i != 0) {
+            auto hit = m_entries.take(i);
+            m_entries.prepend(move(hit));
+        }
+        return m_entries.first().program;
+    }
+
+    ++m_miss_count;
+    return nullptr;
+}
+
+void ProgramCache::insert(StringView source_text, StringView filename, Program::Type type, size_t line_number_offset, NonnullRefPtr<Program> program)
+{
+    if (!m_enabled || source_text.length() < minimum_cached_source_length)
+        return;
+
+    if (m_entries.size() >= maximum_cached_program_count)
+        m_entries.take_last();
+
+    m_entries.prepend({ compute_hash(source_text, filename, type, line_number_offset), type, line_number_offset, move(program) });
+}
+
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Noncopyable.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/RefPtr.h>
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+#include <LibJS/AST.h>
+
+namespace JS {
+
+// A per-VM cache of successfully parsed programs, keyed by their source text, filename and type.
+// Once parsed, a Program can back any number of Script and SourceTextModule records in any realm of the VM.
+// This avoids re-lexing and re-parsing identical sources, such as a script shared between several documents.
+// NOTE: This is per-VM rather than process-wide, as function bodies in the AST hold on to their bytecode
+//       executables, which live in the VM's heap.
+class ProgramCache {
+    AK_MAKE_NONCOPYABLE(ProgramCache);
+    AK_MAKE_NONMOVABLE(ProgramCache);
+
+public:
+    // Sources shorter than this are cheap enough to parse that caching them isn't worth the bookkeeping.
+    static constexpr size_t minimum_cached_source_length = 256;
+    static constexpr size_t maximum_cached_program_count = 64;
+
+    ProgramCache() = default;
+
+    RefPtr<Program> find(StringView source_text, StringView filename, Program::Type, size_t line_number_offset);
+    void insert(StringView source_text, StringView filename, Program::Type, size_t line_number_offset, NonnullRefPtr<Program>);
+
+    void clear() { m_entries.clear(); }
+
+    bool is_enabled() const { return m_enabled; }
+    void set_enabled(bool enabled);
+
+    size_t hit_count() const { return m_hit_count; }
+    size_t miss_count() const { return m_miss_count; }
+
+private:
+    struct Entry {
+        u32 hash { 0 };
+        Program::Type type { Program::Type::Script };
+        size_t line_number_offset { 0 };
+        NonnullRefPtr<Program> program;
+    };
+
+    static u32 compute_hash(StringView source_text, StringView filename, Program::Type, size_t line_number_offset);
+
+    // Most recently used entries are kept at the front.
+    Vector<Entry> m_entries;
+    size_t m_hit_count { 0 };
+    size_t m_miss_count { 0 };
+    bool m_enabled { true };
+};
+
+}
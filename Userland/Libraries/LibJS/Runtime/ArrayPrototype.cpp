@@ -31,6 +31,25 @@ JS_DEFINE_ALLOCATOR(ArrayPrototype);
 
 static HashTable<NonnullGCPtr<Object>> s_array_join_seen_objects;
 
+// OPTIMIZATION: If an element is stored in simple indexed property storage of an object that can't interfere with
+//               indexed property access, it is an own data property with default attributes. HasProperty() is then
+//               trivially true and Get() returns the stored value, without any observable side effects, so searching
+//               builtins can read it straight out of the storage instead of going through the generic property lookup.
+static Optional<Value> fast_get_own_element(Object const& object, u64 index)
+{
+    if (object.may_interfere_with_indexed_property_access())
+        return {};
+
+    auto const* storage = object.indexed_properties().storage();
+    if (!storage || !storage->is_simple_storage() || index >= storage->array_like_size())
+        return {};
+
+    auto value = static_cast<SimpleIndexedPropertyStorage const&>(*storage).elements()[index];
+    if (value.is_empty() || value.is_accessor())
+        return {};
+    return value;
+}
+
 ArrayPrototype::ArrayPrototype(Realm& realm)
     : Array(realm.intrinsics().object_prototype())
 {
@@ -743,6 +762,11 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::includes)
     }
     auto value_to_find = vm.argument(0);
     for (u64 i = from_index; i < length; ++i) {
+        if (auto element = fast_get_own_element(this_object, i); element.has_value()) {
+            if (same_value_zero(*element, value_to_find))
+                return Value(true);
+            continue;
+        }
         auto element = TRY(this_object->get(i));
         if (same_value_zero(element, value_to_find))
             return Value(true);
@@ -797,6 +821,12 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::index_of)
 
     // 10. Repeat, while k < len,
     for (; k < length; ++k) {
+        if (auto element_k = fast_get_own_element(object, k); element_k.has_value()) {
+            if (is_strictly_equal(search_element, *element_k))
+                return Value(k);
+            continue;
+        }
+
         auto property_key = PropertyKey { k };
 
         // a. Let kPresent be ? HasProperty(O, ! ToString(𝔽(k))).
@@ -908,6 +938,12 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::last_index_of)
 
     // 8. Repeat, while k ≥ 0,
     for (; k >= 0; --k) {
+        if (auto element_k = fast_get_own_element(object, k); element_k.has_value()) {
+            if (is_strictly_equal(search_element, *element_k))
+                return Value((size_t)k);
+            continue;
+        }
+
         auto property_key = PropertyKey { k };
 
         // a. Let kPresent be ? HasProperty(O, ! ToString(𝔽(k))).
@@ -53,6 +53,8 @@ public:
 
     Bytecode::Interpreter& bytecode_interpreter();
 
+    ProgramCache& program_cache() { return *m_program_cache; }
+
     void dump_backtrace() const;
 
     void gather_roots(HashMap<Cell*, HeapRoot>&);
@@ -292,6 +294,9 @@ private:
 
     Heap m_heap;
 
+    // NOTE: This must be destroyed before the heap, as cached programs hold handles to bytecode executables.
+    OwnPtr<ProgramCache> m_program_cache;
+
     Vector<ExecutionContext*> m_execution_context_stack;
 
     Vector<Vector<ExecutionContext*>> m_saved_execution_context_stacks;
@@ -7,6 +7,7 @@
 #include <LibJS/AST.h>
 #include <LibJS/Lexer.h>
 #include <LibJS/Parser.h>
+#include <LibJS/ProgramCache.h>
 #include <LibJS/Runtime/VM.h>
 #include <LibJS/Script.h>
 
@@ -18,15 +19,23 @@ JS_DEFINE_ALLOCATOR(Script);
 Result<NonnullGCPtr<Script>, Vector<ParserError>> Script::parse(StringView source_text, Realm& realm, StringView filename, HostDefined* host_defined, size_t line_number_offset)
 {
     // 1. Let script be ParseText(sourceText, Script).
-    auto parser = Parser(Lexer(source_text, filename, line_number_offset));
-    auto script = parser.parse_program();
+    // NOTE: Identical sources are only parsed once per VM, the resulting AST is shared through its ProgramCache.
+    auto& program_cache = realm.vm().program_cache();
+    RefPtr<Program> script = program_cache.find(source_text, filename, Program::Type::Script, line_number_offset);
+    if (!script) {
+        auto parser = Parser(Lexer(source_text, filename, line_number_offset));
+        auto parsed_script = parser.parse_program();
 
-    // 2. If script is a List of errors, return body.
-    if (parser.has_errors())
-        return parser.errors();
+        // 2. If script is a List of errors, return body.
+        if (parser.has_errors())
+            return parser.errors();
+
+        program_cache.insert(source_text, filename, Program::Type::Script, line_number_offset, parsed_script);
+        script = move(parsed_script);
+    }
 
     // 3. Return Script Record { [[Realm]]: realm, [[ECMAScriptCode]]: script, [[HostDefined]]: hostDefined }.
-    return realm.heap().allocate_without_realm<Script>(realm, filename, move(script), host_defined);
+    return realm.heap().allocate_without_realm<Script>(realm, filename, script.release_nonnull(), host_defined);
 }
 
 Script::Script(Realm& realm, StringView filename, NonnullRefPtr<Program> parse_node, HostDefined* host_defined)
@@ -26,3 +26,11 @@ test("is unscopable", () => {
         }).toThrowWithMessage(ReferenceError, "'includes' is not defined");
     }
 });
+
+test("holes are looked up on the prototype chain", () => {
+    var array = [1, , 3];
+    Object.setPrototypeOf(array, { 1: "from prototype" });
+
+    expect(Array.prototype.includes.call(array, "from prototype")).toBeTrue();
+    expect([1, , 3].includes(undefined)).toBeTrue();
+});
@@ -23,3 +23,27 @@ test("basic functionality", () => {
     expect([].indexOf()).toBe(-1);
     expect([undefined].indexOf()).toBe(0);
 });
+
+test("holes are looked up on the prototype chain", () => {
+    var array = [1, , 3];
+    Object.setPrototypeOf(array, { 1: "from prototype" });
+
+    expect(Array.prototype.indexOf.call(array, "from prototype")).toBe(1);
+    expect([1, , 3].indexOf(undefined)).toBe(-1);
+});
+
+test("getters are invoked while searching", () => {
+    var array = [1, 2, 3];
+    var calls = 0;
+    Object.defineProperty(array, 1, {
+        get() {
+            ++calls;
+            return "getter";
+        },
+    });
+
+    expect(array.indexOf("getter")).toBe(1);
+    expect(calls).toBe(1);
+    expect(array.indexOf(3)).toBe(2);
+    expect(calls).toBe(2);
+});
@@ -20,3 +20,11 @@ test("basic functionality", () => {
     expect([undefined].lastIndexOf()).toBe(0);
     expect([undefined, undefined, undefined].lastIndexOf()).toBe(2);
 });
+
+test("holes are looked up on the prototype chain", () => {
+    var array = [1, , 3];
+    Object.setPrototypeOf(array, { 1: "from prototype" });
+
+    expect(Array.prototype.lastIndexOf.call(array, "from prototype")).toBe(1);
+    expect([1, , 3].lastIndexOf(undefined)).toBe(-1);
+});
@@ -0,0 +1,533 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashFunctions.h>
+#include <AK/HashTable.h>
+#include <LibRegex/RegexLinearMatcher.h>
+
+namespace regex {
+
+static size_t jump_target(ByteCode const& bytecode, size_t instruction_position, OpCode const& opcode)
+{
+    // All jumping opcodes store their offset (relative to the next instruction) as the first argument.
+    return instruction_position + opcode.size() + static_cast<ssize_t>(bytecode.at(instruction_position + 1));
+}
+
+static bool compare_consumes_one_character(ByteCode const& bytecode, size_t instruction_position)
+{
+    auto argument_count = bytecode.at(instruction_position + 1);
+    if (argument_count == 0)
+        return false;
+
+    size_t offset = instruction_position + 3;
+    for (size_t i = 0; i < argument_count; ++i) {
+        switch (static_cast<CharacterCompareType>(bytecode.at(offset++))) {
+        case CharacterCompareType::Inverse:
+        case CharacterCompareType::TemporaryInverse:
+        case CharacterCompareType::AnyChar:
+            break;
+        case CharacterCompareType::Char:
+        case CharacterCompareType::CharClass:
+        case CharacterCompareType::CharRange:
+        case CharacterCompareType::Property:
+        case CharacterCompareType::GeneralCategory:
+        case CharacterCompareType::Script:
+        case CharacterCompareType::ScriptExtension:
+            ++offset;
+            break;
+        case CharacterCompareType::LookupTable:
+            offset += bytecode.at(offset) + 1;
+            break;
+        default:
+            // Strings, back-references and set operations can match more or fewer than one character.
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool can_reach_without_consuming(ByteCode const& bytecode, size_t from, size_t to)
+{
+    HashTable<size_t> visited;
+    Vector<size_t> stack { from };
+    MatchState state;
+
+    while (!stack.is_empty()) {
+        auto position = stack.take_last();
+        if (position == to)
+            return true;
+        if (visited.set(position) != HashSetResult::InsertedNewEntry)
+            continue;
+
+        state.instruction_position = position;
+        auto& opcode = bytecode.get_opcode(state);
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare:
+        case OpCodeId::Exit:
+            break;
+        case OpCodeId::Jump:
+            stack.append(jump_target(bytecode, position, opcode));
+            break;
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceJump:
+        case OpCodeId::ForkReplaceStay:
+        case OpCodeId::JumpNonEmpty:
+            stack.append(position + opcode.size());
+            stack.append(jump_target(bytecode, position, opcode));
+            break;
+        default:
+            stack.append(position + opcode.size());
+            break;
+        }
+    }
+
+    return false;
+}
+
+bool LinearMatcher::supports(ByteCode const& bytecode)
+{
+    HashMap<size_t, size_t> checkpoint_positions;
+    Vector<size_t> jump_non_empty_positions;
+
+    MatchState state;
+    while (state.instruction_position < bytecode.size()) {
+        auto& opcode = bytecode.get_opcode(state);
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare:
+            if (!compare_consumes_one_character(bytecode, state.instruction_position))
+                return false;
+            break;
+        case OpCodeId::Checkpoint:
+            checkpoint_positions.set(static_cast<OpCode_Checkpoint const&>(opcode).id(), state.instruction_position);
+            break;
+        case OpCodeId::JumpNonEmpty:
+            jump_non_empty_positions.append(state.instruction_position);
+            break;
+        case OpCodeId::Jump:
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceJump:
+        case OpCodeId::ForkReplaceStay:
+        case OpCodeId::CheckBegin:
+        case OpCodeId::CheckEnd:
+        case OpCodeId::CheckBoundary:
+        case OpCodeId::Exit:
+            break;
+        default:
+            // Captures, lookarounds and counted repetitions would need per-thread state.
+            return false;
+        }
+        state.instruction_position += opcode.size();
+    }
+
+    // Checkpoints only exist to stop loops from iterating forever without consuming anything.
+    // If no loop body can match the empty string, every JumpNonEmpty always takes its jump.
+    for (auto position : jump_non_empty_positions) {
+        state.instruction_position = position;
+        auto checkpoint = static_cast<OpCode_JumpNonEmpty const&>(bytecode.get_opcode(state)).checkpoint();
+        auto checkpoint_position = checkpoint_positions.get(checkpoint);
+        if (!checkpoint_position.has_value())
+            return false;
+        if (can_reach_without_consuming(bytecode, *checkpoint_position, position))
+            return false;
+    }
+
+    return true;
+}
+
+LinearMatcher::LinearMatcher(ByteCode const& bytecode)
+{
+    m_visited.resize(bytecode.size() + 1);
+
+    MatchState state;
+    while (state.instruction_position < bytecode.size()) {
+        auto& opcode = bytecode.get_opcode(state);
+        switch (opcode.opcode_id()) {
+        case OpCodeId::CheckBegin:
+        case OpCodeId::CheckEnd:
+        case OpCodeId::CheckBoundary:
+            m_has_assertions = true;
+            break;
+        default:
+            break;
+        }
+        state.instruction_position += opcode.size();
+    }
+}
+
+void LinearMatcher::begin_generation()
+{
+    if (++m_generation == 0) {
+        for (auto& visited : m_visited)
+            visited = 0;
+        m_generation = 1;
+    }
+}
+
+bool LinearMatcher::add_thread(ByteCode const& bytecode, MatchInput const& input, size_t instruction_position, size_t start_position, ThreadList& threads)
+{
+    // Follow every path that doesn't consume anything, in the order the backtracking matcher would try them,
+    // and collect the compares they end up at. Reaching the end means we found a match, and since all the
+    // paths that are still left have a lower priority than that match, we don't need to look at them.
+    m_stack.clear_with_capacity();
+    m_stack.append(instruction_position);
+
+    auto push_fork = [&](size_t next, size_t target, bool jump_first) {
+        // The top of the stack is tried first.
+        if (jump_first) {
+            m_stack.append(next);
+            m_stack.append(target);
+        } else {
+            m_stack.append(target);
+            m_stack.append(next);
+        }
+    };
+
+    while (!m_stack.is_empty()) {
+        auto position = min(m_stack.take_last(), bytecode.size());
+        if (m_visited[position] == m_generation)
+            continue;
+        m_visited[position] = m_generation;
+
+        m_state.string_position = m_position;
+        m_state.string_position_in_code_units = m_position_in_code_units;
+        m_state.instruction_position = position;
+
+        auto& opcode = bytecode.get_opcode(m_state);
+        auto next = position + opcode.size();
+
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare:
+            threads.instruction_positions.append(position);
+            threads.start_positions.append(start_position);
+            break;
+        case OpCodeId::Jump:
+            m_stack.append(jump_target(bytecode, position, opcode));
+            break;
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkReplaceJump:
+            push_fork(next, jump_target(bytecode, position, opcode), true);
+            break;
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceStay:
+            push_fork(next, jump_target(bytecode, position, opcode), false);
+            break;
+        case OpCodeId::JumpNonEmpty: {
+            // supports() made sure that the loop body always consumes something, so this always jumps.
+            auto target = jump_target(bytecode, position, opcode);
+            switch (static_cast<OpCode_JumpNonEmpty const&>(opcode).form()) {
+            case OpCodeId::Jump:
+                m_stack.append(target);
+                break;
+            case OpCodeId::ForkJump:
+            case OpCodeId::ForkReplaceJump:
+                push_fork(next, target, true);
+                break;
+            default:
+                push_fork(next, target, false);
+                break;
+            }
+            break;
+        }
+        case OpCodeId::Checkpoint:
+            m_stack.append(next);
+            break;
+        case OpCodeId::CheckBegin:
+        case OpCodeId::CheckEnd:
+        case OpCodeId::CheckBoundary:
+            if (opcode.execute(input, m_state) == ExecutionResult::Continue)
+                m_stack.append(next);
+            break;
+        case OpCodeId::Exit:
+            if (opcode.execute(input, m_state) == ExecutionResult::Succeeded) {
+                threads.match_start = start_position;
+                return true;
+            }
+            break;
+        default:
+            VERIFY_NOT_REACHED();
+        }
+    }
+
+    return false;
+}
+
+void LinearMatcher::start(ByteCode const& bytecode, MatchInput const& input, ThreadList& threads)
+{
+    begin_generation();
+    threads.instruction_positions.clear_with_capacity();
+    threads.start_positions.clear_with_capacity();
+    threads.matched = add_thread(bytecode, input, 0, m_position, threads);
+}
+
+void LinearMatcher::step(ByteCode const& bytecode, MatchInput const& input, ThreadList const& current, ThreadList& next)
+{
+    begin_generation();
+    next.instruction_positions.clear_with_capacity();
+    next.start_positions.clear_with_capacity();
+    next.matched = false;
+
+    auto position = m_position;
+    auto position_in_code_units = m_position_in_code_units;
+    bool did_advance = false;
+
+    for (size_t i = 0; i < current.instruction_positions.size(); ++i) {
+        m_state.string_position = position;
+        m_state.string_position_in_code_units = position_in_code_units;
+        m_state.instruction_position = current.instruction_positions[i];
+
+        auto& opcode = bytecode.get_opcode(m_state);
+        auto next_instruction_position = m_state.instruction_position + opcode.size();
+        if (opcode.execute(input, m_state) != ExecutionResult::Continue)
+            continue;
+
+        // Every compare consumes exactly one character, so all threads end up at the same position.
+        m_position = m_state.string_position;
+        m_position_in_code_units = m_state.string_position_in_code_units;
+        did_advance = true;
+
+        if (add_thread(bytecode, input, next_instruction_position, current.start_positions[i], next)) {
+            next.matched = true;
+            break;
+        }
+    }
+
+    // Searching continues past positions where all threads died.
+    if (!did_advance)
+        advance_by_one_character(input);
+}
+
+void LinearMatcher::advance_by_one_character(MatchInput const& input)
+{
+    if (input.view.unicode() && m_position_in_code_units < input.view.length_in_code_units())
+        m_position_in_code_units += input.view.length_of_code_point(input.view[m_position_in_code_units]);
+    else
+        ++m_position_in_code_units;
+    ++m_position;
+}
+
+bool LinearMatcher::can_use_dfa(MatchInput const& input) const
+{
+    // Assertions depend on more than the current character, and unicode views may advance by more than
+    // one code unit, so the transitions between thread lists can only be cached without either of those.
+    return !m_has_assertions && !input.view.unicode();
+}
+
+bool LinearMatcher::execute(ByteCode const& bytecode, MatchInput const& input, MatchState& state, size_t& operations)
+{
+    if (can_use_dfa(input))
+        return execute_dfa(bytecode, input, state, Mode::Anchored, operations);
+    return execute_nfa(bytecode, input, state, operations);
+}
+
+bool LinearMatcher::search(ByteCode const& bytecode, MatchInput const& input, MatchState& state, size_t last_start_position, size_t& match_start, size_t& operations)
+{
+    auto use_dfa = can_use_dfa(input);
+    if (use_dfa) {
+        // Most searches fail or find a match soon, so first make sure that there is one at all without keeping track
+        // of where threads started. This only ever looks at each character once.
+        auto start_position = state.string_position;
+        if (!execute_dfa(bytecode, input, state, Mode::Unanchored, operations))
+            return false;
+        state.string_position = start_position;
+        state.string_position_in_code_units = start_position;
+    }
+
+    m_position = state.string_position;
+    m_position_in_code_units = state.string_position_in_code_units;
+
+    Optional<size_t> found_match_start;
+    size_t match_end = 0;
+    size_t match_end_in_code_units = 0;
+
+    ThreadList current;
+    ThreadList next;
+    start(bytecode, input, current);
+
+    for (;;) {
+        if (current.matched) {
+            found_match_start = current.match_start;
+            match_end = m_position;
+            match_end_in_code_units = m_position_in_code_units;
+        }
+
+        if (found_match_start.has_value()) {
+            // Threads that started after the match was found were dropped with the ones that had a lower priority,
+            // so once the first thread started where the match did, nothing can start further to the left.
+            if (current.instruction_positions.is_empty() || (use_dfa && current.start_positions.first() == *found_match_start))
+                break;
+        } else if (current.instruction_positions.is_empty() && m_position >= last_start_position) {
+            break;
+        }
+        if (m_position >= input.view.length())
+            break;
+
+        ++operations;
+        step(bytecode, input, current, next);
+
+        // A thread that starts here has a lower priority than all the others, and could only be used without a match.
+        if (!found_match_start.has_value() && !next.matched && m_position <= last_start_position)
+            next.matched = add_thread(bytecode, input, 0, m_position, next);
+
+        swap(current, next);
+    }
+
+    if (!found_match_start.has_value())
+        return false;
+
+    match_start = *found_match_start;
+    if (use_dfa) {
+        // Only the start of the match is settled so far, but the DFA finds its end a lot faster than the threads would.
+        state.string_position = match_start;
+        state.string_position_in_code_units = match_start;
+        auto matched = execute_dfa(bytecode, input, state, Mode::Anchored, operations);
+        VERIFY(matched);
+        return true;
+    }
+
+    state.string_position = match_end;
+    state.string_position_in_code_units = match_end_in_code_units;
+    return true;
+}
+
+bool LinearMatcher::execute_nfa(ByteCode const& bytecode, MatchInput const& input, MatchState& state, size_t& operations)
+{
+    m_position = state.string_position;
+    m_position_in_code_units = state.string_position_in_code_units;
+
+    Optional<size_t> match_end;
+    size_t match_end_in_code_units = 0;
+
+    ThreadList current;
+    ThreadList next;
+    start(bytecode, input, current);
+
+    for (;;) {
+        if (current.matched) {
+            match_end = m_position;
+            match_end_in_code_units = m_position_in_code_units;
+        }
+        if (current.instruction_positions.is_empty() || m_position >= input.view.length())
+            break;
+
+        ++operations;
+        step(bytecode, input, current, next);
+        swap(current, next);
+    }
+
+    if (!match_end.has_value())
+        return false;
+
+    state.string_position = *match_end;
+    state.string_position_in_code_units = match_end_in_code_units;
+    return true;
+}
+
+bool LinearMatcher::execute_dfa(ByteCode const& bytecode, MatchInput const& input, MatchState& state, Mode mode, size_t& operations)
+{
+    if (m_dfa_flags != input.regex_options.value()) {
+        clear_dfa_states();
+        m_dfa_flags = input.regex_options.value();
+    }
+
+    auto& dfa = mode == Mode::Anchored ? m_anchored_dfa : m_unanchored_dfa;
+
+    m_position = state.string_position;
+    m_position_in_code_units = state.string_position_in_code_units;
+
+    if (!dfa.start_state.has_value()) {
+        ThreadList threads;
+        start(bytecode, input, threads);
+        dfa.start_state = intern_dfa_state(dfa, move(threads));
+    }
+
+    Optional<size_t> match_end;
+    auto length = input.view.length();
+    auto current = *dfa.start_state;
+
+    for (;;) {
+        auto& dfa_state = *dfa.states[current];
+        if (dfa_state.threads.matched) {
+            match_end = m_position;
+            // When searching, all that matters is whether there is a match at all.
+            if (mode == Mode::Unanchored)
+                break;
+        }
+        if ((mode == Mode::Anchored && dfa_state.threads.instruction_positions.is_empty()) || m_position >= length)
+            break;
+
+        ++operations;
+        auto position = m_position;
+        auto ch = input.view.code_unit_at(position);
+        if (ch < dfa_state.transitions.size() && dfa_state.transitions[ch] != unknown_transition) {
+            current = dfa_state.transitions[ch];
+            m_position = m_position_in_code_units = position + 1;
+            continue;
+        }
+
+        ThreadList next;
+        step(bytecode, input, dfa_state.threads, next);
+        m_position = m_position_in_code_units = position + 1;
+        if (mode == Mode::Unanchored && !next.matched)
+            next.matched = add_thread(bytecode, input, 0, m_position, next);
+
+        if (dfa.states.size() >= max_dfa_state_count) {
+            // Rather than growing without bounds, start over with a fresh set of states.
+            clear_dfa_states();
+            current = intern_dfa_state(dfa, move(next));
+            continue;
+        }
+
+        auto next_state = intern_dfa_state(dfa, move(next));
+        // Only ASCII is cached, as all view types agree on what an ASCII code unit means.
+        if (ch < dfa_state.transitions.size())
+            dfa_state.transitions[ch] = next_state;
+        current = next_state;
+    }
+
+    if (!match_end.has_value())
+        return false;
+
+    // Without unicode, every character is a single code unit.
+    state.string_position = *match_end;
+    state.string_position_in_code_units = *match_end;
+    return true;
+}
+
+u32 LinearMatcher::intern_dfa_state(DFA& dfa, ThreadList&& threads)
+{
+    u32 hash = threads.matched ? 1 : 0;
+    for (auto instruction_position : threads.instruction_positions)
+        hash = pair_int_hash(hash, static_cast<u32>(instruction_position));
+
+    auto& indices = dfa.states_by_hash.ensure(hash);
+    for (auto index : indices) {
+        auto& existing_threads = dfa.states[index]->threads;
+        if (existing_threads.matched == threads.matched && existing_threads.instruction_positions == threads.instruction_positions)
+            return index;
+    }
+
+    auto dfa_state = make<DFAState>();
+    dfa_state->threads = move(threads);
+    dfa_state->transitions.fill(unknown_transition);
+
+    auto index = static_cast<u32>(dfa.states.size());
+    dfa.states.append(move(dfa_state));
+    indices.append(index);
+    return index;
+}
+
+void LinearMatcher::clear_dfa_states()
+{
+    for (auto* dfa : { &m_anchored_dfa, &m_unanchored_dfa }) {
+        dfa->states.clear();
+        dfa->states_by_hash.clear();
+        dfa->start_state.clear();
+    }
+}
+
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include "RegexByteCode.h"
+#include "RegexMatch.h"
+
+#include <AK/Array.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+
+namespace regex {
+
+// Matches bytecode that only consists of single-character compares, jumps, forks and simple assertions
+// by following all the paths the backtracking matcher would try at once (a Thompson NFA simulation).
+// This keeps matching linear in the length of the input, while still producing the same match as
+// the backtracking matcher, as threads are kept in the order the backtracking matcher would try them.
+// The sets of threads are cached as the states of a lazily-built DFA whenever that's possible.
+class LinearMatcher {
+public:
+    static bool supports(ByteCode const&);
+
+    explicit LinearMatcher(ByteCode const&);
+
+    // Tries to match the pattern anchored at state.string_position, and moves the state to the end of the match on success.
+    bool execute(ByteCode const&, MatchInput const&, MatchState&, size_t& operations);
+
+    // Looks for the leftmost match that starts between state.string_position and last_start_position in a single pass
+    // over the input, as if the pattern was prefixed with a lazy `.*?`. On success, match_start is set to where the
+    // match starts, and the state is moved to its end.
+    bool search(ByteCode const&, MatchInput const&, MatchState&, size_t last_start_position, size_t& match_start, size_t& operations);
+
+private:
+    struct ThreadList {
+        Vector<size_t> instruction_positions;
+        // Where the thread at the same index started to match. Threads that started earlier always come first.
+        Vector<size_t> start_positions;
+        bool matched { false };
+        size_t match_start { 0 };
+    };
+
+    struct DFAState {
+        ThreadList threads;
+        Array<u32, 128> transitions;
+    };
+
+    // Searching adds a new thread at every position, so its states have different transitions than those of anchored matching.
+    struct DFA {
+        Vector<NonnullOwnPtr<DFAState>> states;
+        HashMap<u32, Vector<u32>> states_by_hash;
+        Optional<u32> start_state;
+    };
+
+    static constexpr u32 unknown_transition = NumericLimits<u32>::max();
+    static constexpr size_t max_dfa_state_count = 512;
+
+    enum class Mode {
+        Anchored,
+        Unanchored,
+    };
+
+    bool can_use_dfa(MatchInput const&) const;
+
+    void begin_generation();
+    bool add_thread(ByteCode const&, MatchInput const&, size_t instruction_position, size_t start_position, ThreadList&);
+    void start(ByteCode const&, MatchInput const&, ThreadList&);
+    void step(ByteCode const&, MatchInput const&, ThreadList const&, ThreadList&);
+    void advance_by_one_character(MatchInput const&);
+
+    bool execute_nfa(ByteCode const&, MatchInput const&, MatchState&, size_t& operations);
+    bool execute_dfa(ByteCode const&, MatchInput const&, MatchState&, Mode, size_t& operations);
+
+    u32 intern_dfa_state(DFA&, ThreadList&&);
+    void clear_dfa_states();
+
+    bool m_has_assertions { false };
+
+    // Scratch state used to evaluate opcodes, and the current position of the simulation.
+    MatchState m_state;
+    size_t m_position { 0 };
+    size_t m_position_in_code_units { 0 };
+
+    Vector<size_t> m_stack;
+    Vector<u32> m_visited;
+    u32 m_generation { 0 };
+
+    DFA m_anchored_dfa;
+    DFA m_unanchored_dfa;
+    Optional<AllFlags> m_dfa_flags;
+};
+
+}
@@ -4,9 +4,11 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/BumpAllocator.h>
 #include <AK/ByteString.h>
 #include <AK/Debug.h>
+#include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
 #include <LibRegex/RegexMatcher.h>
 #include <LibRegex/RegexParser.h>
@@ -121,6 +123,14 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
     if (!((AllFlags)m_regex_options.value() & AllFlags::Internal_Stateful))
         m_pattern->start_offset = 0;
 
+    bool const may_use_linear_matcher = m_pattern->parser_result.optimization_data.supports_linear_matching;
+    if (may_use_linear_matcher)
+        VERIFY(!m_linear_matcher_in_use.exchange(true));
+    ScopeGuard release_linear_matcher = [&] {
+        if (may_use_linear_matcher)
+            m_linear_matcher_in_use.store(false);
+    };
+
     size_t match_count { 0 };
 
     MatchInput input;
@@ -245,6 +255,12 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             if (match_length_minimum && match_length_minimum > view_length - view_index)
                 break;
 
+            if (view_index < view_length && !can_start_match_at(input, view_index)) {
+                if (!continue_search)
+                    break;
+                continue;
+            }
+
             input.column = match_count;
             input.match_index = match_count;
 
@@ -253,7 +269,19 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             state.instruction_position = 0;
             state.repetition_marks.clear();
 
-            auto success = execute(input, state, operations);
+            bool success;
+            if (can_search_with_linear_matcher(input)) {
+                // Rather than being started over at every position, the linear matcher finds the next match in one pass.
+                auto last_start_position = input.regex_options.has_flag_set(AllFlags::Multiline) ? view_length - 1 : view_length;
+                size_t match_start = 0;
+                success = linear_matcher().search(m_pattern->parser_result.bytecode, input, state, last_start_position, match_start, operations);
+                if (!success)
+                    break;
+                view_index = match_start;
+            } else {
+                success = execute(input, state, operations);
+            }
+
             if (success) {
                 succeeded = true;
 
@@ -416,6 +444,44 @@ private:
     Node* m_last { nullptr };
 };
 
+template<class Parser>
+bool Matcher<Parser>::can_start_match_at(MatchInput const& input, size_t index) const
+{
+    auto& starting_ranges = m_pattern->parser_result.optimization_data.starting_ranges;
+    if (starting_ranges.is_empty() || input.view.unicode() || input.regex_options.has_flag_set(AllFlags::Insensitive))
+        return true;
+
+    // Only ASCII is looked at, as that's the only range where all view types agree on what a code unit is.
+    auto ch = input.view.code_unit_at(index);
+    if (ch > 0x7f)
+        return true;
+
+    return any_of(starting_ranges, [ch](auto const& range) { return range.from <= ch && ch <= range.to; });
+}
+
+template<class Parser>
+bool Matcher<Parser>::can_search_with_linear_matcher(MatchInput const& input) const
+{
+    if (!m_pattern->parser_result.optimization_data.supports_linear_matching)
+        return false;
+    if (m_pattern->parser_result.optimization_data.pure_substring_search.has_value() && input.view.is_string_view())
+        return false;
+
+    // Searching only makes sense if a failed match continues at the next position, and it can't skip over matches.
+    bool continue_search = input.regex_options.has_flag_set(AllFlags::Global) || input.regex_options.has_flag_set(AllFlags::Multiline);
+    if (!continue_search || input.regex_options.has_flag_set(AllFlags::Sticky))
+        return false;
+    return !input.regex_options.has_flag_set(AllFlags::MatchNotBeginOfLine) && !input.regex_options.has_flag_set(AllFlags::MatchNotEndOfLine);
+}
+
+template<class Parser>
+LinearMatcher& Matcher<Parser>::linear_matcher() const
+{
+    if (!m_linear_matcher)
+        m_linear_matcher = make<LinearMatcher>(m_pattern->parser_result.bytecode);
+    return *m_linear_matcher;
+}
+
 template<class Parser>
 bool Matcher<Parser>::execute(MatchInput const& input, MatchState& state, size_t& operations) const
 {
@@ -439,6 +505,9 @@ bool Matcher<Parser>::execute(MatchInput const& input, MatchState& state, size_t
         return true;
     }
 
+    if (m_pattern->parser_result.optimization_data.supports_linear_matching)
+        return linear_matcher().execute(m_pattern->parser_result.bytecode, input, state, operations);
+
     BumpAllocatedLinkedList<MatchState> states_to_try_next;
 #if REGEX_DEBUG
     size_t recursion_level = 0;
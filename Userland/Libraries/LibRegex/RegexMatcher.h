@@ -7,10 +7,12 @@
 #pragma once
 
 #include "RegexByteCode.h"
+#include "RegexLinearMatcher.h"
 #include "RegexMatch.h"
 #include "RegexOptions.h"
 #include "RegexParser.h"
 
+#include <AK/Atomic.h>
 #include <AK/Forward.h>
 #include <AK/GenericLexer.h>
 #include <AK/HashMap.h>
@@ -74,9 +76,16 @@ public:
 
 private:
     bool execute(MatchInput const& input, MatchState& state, size_t& operations) const;
+    bool can_start_match_at(MatchInput const& input, size_t index) const;
+    bool can_search_with_linear_matcher(MatchInput const& input) const;
+    LinearMatcher& linear_matcher() const;
 
     Regex<Parser> const* m_pattern;
     typename ParserTraits<Parser>::OptionsType const m_regex_options;
+    // The linear matcher keeps its scratch state and the DFA it builds from one match to the next, so patterns that use
+    // it must not be matched on several threads at once. Matching never calls out of LibRegex, so it can't be reentered.
+    mutable OwnPtr<LinearMatcher> m_linear_matcher;
+    mutable Atomic<bool> m_linear_matcher_in_use { false };
 };
 
 template<class Parser>
@@ -232,6 +241,7 @@ private:
     void run_optimization_passes();
     void attempt_rewrite_loops_as_atomic_groups(BasicBlockList const&);
     bool attempt_rewrite_entire_match_as_substring_search(BasicBlockList const&);
+    void fill_optimization_data();
 };
 
 // free standing functions for match, search and has_match
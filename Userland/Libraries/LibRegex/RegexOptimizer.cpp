@@ -13,6 +13,7 @@
 #include <AK/Trie.h>
 #include <LibRegex/Regex.h>
 #include <LibRegex/RegexBytecodeStreamOptimizer.h>
+#include <LibRegex/RegexLinearMatcher.h>
 #include <LibUnicode/CharacterTypes.h>
 #if REGEX_DEBUG
 #    include <AK/ScopeGuard.h>
@@ -37,6 +38,64 @@ void Regex<Parser>::run_optimization_passes()
     attempt_rewrite_loops_as_atomic_groups(blocks);
 
     parser_result.bytecode.flatten();
+
+    fill_optimization_data();
+}
+
+template<typename Parser>
+void Regex<Parser>::fill_optimization_data()
+{
+    // Find the set of characters any match has to start with, so the matcher can skip
+    // over starting positions that can't possibly match without running the bytecode.
+    auto& bytecode = parser_result.bytecode;
+
+    parser_result.optimization_data.supports_linear_matching = parser_result.capture_groups_count == 0
+        && parser_result.named_capture_groups_count == 0
+        && LinearMatcher::supports(bytecode);
+
+    MatchState state;
+    while (state.instruction_position < bytecode.size()) {
+        auto& opcode = bytecode.get_opcode(state);
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare: {
+            auto& compare = static_cast<OpCode_Compare const&>(opcode);
+            auto flat_compares = compare.flat_compares();
+
+            // A single string or lookup table expands into several entries, but with more than one
+            // argument we can't tell an empty (always matching) string apart from a missing one.
+            if (compare.arguments_count() != 1 && compare.arguments_count() != flat_compares.size())
+                return;
+
+            Vector<CharRange> ranges;
+            for (auto& flat_compare : flat_compares) {
+                switch (flat_compare.type) {
+                case CharacterCompareType::Char:
+                    ranges.empend(static_cast<u32>(flat_compare.value), static_cast<u32>(flat_compare.value));
+                    break;
+                case CharacterCompareType::CharRange:
+                    ranges.empend(flat_compare.value);
+                    break;
+                default:
+                    return;
+                }
+            }
+
+            parser_result.optimization_data.starting_ranges = move(ranges);
+            return;
+        }
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::CheckBegin:
+        case OpCodeId::CheckBoundary:
+        case OpCodeId::Checkpoint:
+            // These don't consume anything, so the next compare still has to match the first character.
+            break;
+        default:
+            return;
+        }
+        state.instruction_position += opcode.size();
+    }
 }
 
 template<typename Parser>
@@ -58,6 +58,10 @@ public:
 
         struct {
             Optional<ByteString> pure_substring_search;
+            // If non-empty, every match must start with a code point inside one of these ranges.
+            Vector<CharRange> starting_ranges;
+            // Whether the bytecode can be run by the LinearMatcher instead of backtracking.
+            bool supports_linear_matching { false };
         } optimization_data {};
     };
 
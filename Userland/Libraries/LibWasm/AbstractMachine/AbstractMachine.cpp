@@ -9,6 +9,7 @@
 #include <LibWasm/AbstractMachine/Configuration.h>
 #include <LibWasm/AbstractMachine/Interpreter.h>
 #include <LibWasm/AbstractMachine/Validator.h>
+#include <LibWasm/JIT/Compiler.h>
 #include <LibWasm/Types.h>
 
 namespace Wasm {
@@ -24,6 +25,15 @@ Optional<FunctionAddress> Store::allocate(ModuleInstance& module, Module::Functi
     return address;
 }
 
+JIT::NativeFunction* WasmFunction::native_function(Store& store) const
+{
+    if (!m_attempted_compilation) {
+        m_attempted_compilation = true;
+        m_native_function = JIT::Compiler::compile(store, *this);
+    }
+    return m_native_function.ptr();
+}
+
 Optional<FunctionAddress> Store::allocate(HostFunction&& function)
 {
     FunctionAddress address { m_functions.size() };
@@ -507,6 +517,8 @@ Result AbstractMachine::invoke(Interpreter& interpreter, FunctionAddress address
     Configuration configuration { m_store };
     if (m_should_limit_instruction_count)
         configuration.enable_instruction_count_limit();
+    else if (m_should_use_jit)
+        configuration.enable_jit(m_stack_info);
     return configuration.call(interpreter, address, move(arguments));
 }
 
@@ -13,6 +13,7 @@
 #include <AK/Result.h>
 #include <AK/StackInfo.h>
 #include <AK/UFixedBigInt.h>
+#include <LibWasm/JIT/NativeFunction.h>
 #include <LibWasm/Types.h>
 
 // NOTE: Special case for Wasm::Result.
@@ -22,6 +23,7 @@ namespace Wasm {
 
 class Configuration;
 struct Interpreter;
+class Store;
 
 struct InstantiationError {
     ByteString error { "Unknown error" };
@@ -344,10 +346,15 @@ public:
     auto& module() const { return m_module; }
     auto& code() const { return m_code; }
 
+    // Compiled the first time it's asked for, null if the function can't be compiled.
+    JIT::NativeFunction* native_function(Store&) const;
+
 private:
     FunctionType m_type;
     ModuleInstance const& m_module;
     Module::Function const& m_code;
+    mutable OwnPtr<JIT::NativeFunction> m_native_function;
+    mutable bool m_attempted_compilation { false };
 };
 
 class HostFunction {
@@ -548,18 +555,22 @@ private:
 
 class Label {
 public:
-    explicit Label(size_t arity, InstructionPointer continuation)
+    explicit Label(size_t arity, InstructionPointer continuation, size_t stack_height)
         : m_arity(arity)
         , m_continuation(continuation)
+        , m_stack_height(stack_height)
     {
     }
 
     auto continuation() const { return m_continuation; }
     auto arity() const { return m_arity; }
+    // The size of the value stack when this label was entered, which is where its results end up when branching to it.
+    auto stack_height() const { return m_stack_height; }
 
 private:
     size_t m_arity { 0 };
     InstructionPointer m_continuation { 0 };
+    size_t m_stack_height { 0 };
 };
 
 class Frame {
@@ -578,20 +589,24 @@ public:
     auto& expression() const { return m_expression; }
     auto arity() const { return m_arity; }
 
+    // The index of this frame's outermost label on the label stack, set when the frame is entered.
+    auto label_index() const { return m_label_index; }
+    void set_label_index(size_t index) { m_label_index = index; }
+
 private:
     ModuleInstance const& m_module;
     Vector<Value> m_locals;
     Expression const& m_expression;
     size_t m_arity { 0 };
+    size_t m_label_index { 0 };
 };
 
 class Stack {
 public:
-    using EntryType = Variant<Value, Label, Frame>;
     Stack() = default;
 
     [[nodiscard]] ALWAYS_INLINE bool is_empty() const { return m_data.is_empty(); }
-    ALWAYS_INLINE void push(EntryType entry) { m_data.append(move(entry)); }
+    ALWAYS_INLINE void push(Value value) { m_data.append(move(value)); }
     ALWAYS_INLINE auto pop() { return m_data.take_last(); }
     ALWAYS_INLINE auto& peek() const { return m_data.last(); }
     ALWAYS_INLINE auto& peek() { return m_data.last(); }
@@ -601,7 +616,7 @@ public:
     ALWAYS_INLINE auto& entries() { return m_data; }
 
 private:
-    Vector<EntryType, 1024> m_data;
+    Vector<Value, 1024> m_data;
 };
 
 using InstantiationResult = AK::Result<NonnullOwnPtr<ModuleInstance>, InstantiationError>;
@@ -621,6 +636,8 @@ public:
     auto& store() { return m_store; }
 
     void enable_instruction_count_limit() { m_should_limit_instruction_count = true; }
+    // Functions are compiled to native code when they are first called, unless the instruction count is limited.
+    void enable_jit() { m_should_use_jit = true; }
 
 private:
     Optional<InstantiationError> allocate_all_initial_phase(Module const&, ModuleInstance&, Vector<ExternValue>&, Vector<Value>& global_values, Vector<FunctionAddress>& own_functions);
@@ -628,6 +645,7 @@ private:
     Store m_store;
     StackInfo m_stack_info;
     bool m_should_limit_instruction_count { false };
+    bool m_should_use_jit { false };
 };
 
 class Linker {
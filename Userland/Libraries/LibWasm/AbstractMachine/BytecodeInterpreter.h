@@ -62,7 +62,15 @@ protected:
     Optional<VectorType> pop_vector(Configuration&);
     template<typename M, template<typename> typename SetSign, typename VectorType = Native128ByteVectorOf<M, SetSign>>
     Optional<VectorType> peek_vector(Configuration&);
-    void store_to_memory(Configuration&, Instruction const&, ReadonlyBytes data, i32 base);
+    template<typename VectorType, typename PushType>
+    void pop_and_push_lane(Configuration&, Instruction const&);
+    template<typename VectorType, typename PopType>
+    void pop_and_replace_lane(Configuration&, Instruction const&);
+    template<size_t N>
+    void load_and_replace_lane_n(Configuration&, Instruction const&);
+    template<size_t N>
+    void pop_and_store_lane_n(Configuration&, Instruction const&);
+    void store_to_memory(Configuration&, Instruction::MemoryArgument const&, ReadonlyBytes data, i32 base);
     void call_address(Configuration&, FunctionAddress);
 
     template<typename PopTypeLHS, typename PushType, typename Operator, typename PopTypeRHS = PopTypeLHS>
@@ -78,9 +86,8 @@ protected:
     MakeSigned<T> checked_signed_truncate(V);
 
     template<typename T>
-    T read_value(ReadonlyBytes data);
+    static T read_value(u8 const* data);
 
-    Vector<Value> pop_values(Configuration& configuration, size_t count);
     ALWAYS_INLINE bool trap_if_not(bool value, StringView reason)
     {
         if (!value)
@@ -11,30 +11,18 @@
 
 namespace Wasm {
 
-Optional<size_t> Configuration::nth_label_index(size_t i)
-{
-    for (size_t index = m_stack.size(); index > 0; --index) {
-        auto& entry = m_stack.entries()[index - 1];
-        if (entry.has<Label>()) {
-            if (i == 0)
-                return index - 1;
-            --i;
-        }
-    }
-    return {};
-}
-
 void Configuration::unwind(Badge<CallFrameHandle>, CallFrameHandle const& frame_handle)
 {
-    if (m_stack.size() == frame_handle.stack_size && frame_handle.frame_index == m_current_frame_index)
-        return;
-
-    VERIFY(m_stack.size() > frame_handle.stack_size);
-    m_stack.entries().remove(frame_handle.stack_size, m_stack.size() - frame_handle.stack_size);
-    m_current_frame_index = frame_handle.frame_index;
     m_depth--;
     m_ip = frame_handle.ip;
-    VERIFY(m_stack.size() == frame_handle.stack_size);
+
+    // A trap can leave anything behind on any of the stacks, so just drop everything the call pushed.
+    VERIFY(m_value_stack.size() >= frame_handle.value_stack_size);
+    VERIFY(m_label_stack.size() >= frame_handle.label_stack_size);
+    VERIFY(m_frame_stack.size() >= frame_handle.frame_stack_size);
+    m_value_stack.entries().shrink(frame_handle.value_stack_size, true);
+    m_label_stack.shrink(frame_handle.label_stack_size, true);
+    m_frame_stack.shrink(frame_handle.frame_stack_size, true);
 }
 
 Result Configuration::call(Interpreter& interpreter, FunctionAddress address, Vector<Value> arguments)
@@ -43,6 +31,11 @@ Result Configuration::call(Interpreter& interpreter, FunctionAddress address, Ve
     if (!function)
         return Trap {};
     if (auto* wasm_function = function->get_pointer<WasmFunction>()) {
+        if (m_jit_stack_info) {
+            if (auto* native_function = wasm_function->native_function(m_store))
+                return native_function->call(*this, interpreter, *wasm_function, arguments);
+        }
+
         Vector<Value> locals = move(arguments);
         locals.ensure_capacity(locals.size() + wasm_function->code().locals().size());
         for (auto& type : wasm_function->code().locals())
@@ -69,17 +62,17 @@ Result Configuration::execute(Interpreter& interpreter)
     if (interpreter.did_trap())
         return Trap { interpreter.trap_reason() };
 
-    if (stack().size() <= frame().arity() + 1)
+    // The frame's own label should be the only one left at this point.
+    if (m_label_stack.size() != frame().label_index() + 1)
+        return Trap { "Invalid stack configuration" };
+    auto label = m_label_stack.take_last();
+    if (m_value_stack.size() < label.stack_height() + frame().arity())
         return Trap { "Not enough values to return from call" };
 
     Vector<Value> results;
     results.ensure_capacity(frame().arity());
     for (size_t i = 0; i < frame().arity(); ++i)
-        results.append(move(stack().pop().get<Value>()));
-    auto label = stack().pop();
-    // ASSERT: label == current frame
-    if (!label.has<Label>())
-        return Trap { "Invalid stack configuration" };
+        results.append(m_value_stack.pop());
     return Result { move(results) };
 }
 
@@ -92,21 +85,19 @@ void Configuration::dump_stack()
         memory_stream.read_until_filled(buffer).release_value_but_fixme_should_propagate_errors();
         dbgln(format.view(), StringView(buffer).trim_whitespace());
     };
-    for (auto const& entry : stack().entries()) {
-        entry.visit(
-            [&](Value const& v) {
-                print_value("    {}", v);
-            },
-            [&](Frame const& f) {
-                dbgln("    frame({})", f.arity());
-                for (auto& local : f.locals()) {
-                    print_value("        {}", local);
-                }
-            },
-            [](Label const& l) {
-                dbgln("    label({}) -> {}", l.arity(), l.continuation());
-            });
+    dbgln("  frames:");
+    for (auto const& frame : m_frame_stack) {
+        dbgln("    frame({})", frame.arity());
+        for (auto& local : frame.locals()) {
+            print_value("        {}", local);
+        }
     }
+    dbgln("  labels:");
+    for (auto const& label : m_label_stack)
+        dbgln("    label({}) -> {} @ {}", label.arity(), label.continuation(), label.stack_height());
+    dbgln("  values:");
+    for (auto const& value : m_value_stack.entries())
+        print_value("    {}", value);
 }
 
 }
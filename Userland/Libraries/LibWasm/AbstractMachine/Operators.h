@@ -10,6 +10,7 @@
 #include <AK/BuiltinWrappers.h>
 #include <AK/Result.h>
 #include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/StringView.h>
 #include <AK/Types.h>
 #include <limits.h>
@@ -522,4 +523,475 @@ struct SaturatingTruncate {
     static StringView name() { return "truncate.saturating"sv; }
 };
 
+// Vector
+//
+// These work on whole vectors at once through the compiler's vector extensions, which lower them to the native
+// SIMD instructions where the target has them (SSE2 on x86_64, NEON on aarch64) and to scalar code everywhere else.
+// Most of them only have to reinterpret the u128 a v128 value is stored as, with the lane type given by the opcode.
+
+// Functions passing around vectors wider than the native registers change the calling convention, see AK/SIMDExtras.h.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+template<size_t VectorSize, template<typename> typename SetSign = MakeSigned>
+using VectorOfIntegers = NativeVectorType<128 / VectorSize, VectorSize, SetSign>;
+
+template<size_t VectorSize>
+using VectorOfFloats = NativeVectorType<128 / VectorSize, VectorSize, MakeSigned, NativeFloatingType<128 / VectorSize>>;
+
+enum class VectorHalf {
+    Low,
+    High,
+};
+
+template<typename VectorType, typename T>
+ALWAYS_INLINE static VectorType splat_vector(T value)
+{
+    VectorType vector {};
+    for (size_t i = 0; i < sizeof(VectorType) / sizeof(vector[0]); ++i)
+        vector[i] = value;
+    return vector;
+}
+
+template<size_t VectorSize, typename Op, template<typename> typename SetSign = MakeSigned>
+struct VectorIntegerBinaryOp {
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        using VectorType = VectorOfIntegers<VectorSize, SetSign>;
+        return bit_cast<u128>(Op {}(bit_cast<VectorType>(lhs), bit_cast<VectorType>(rhs)));
+    }
+
+    static StringView name() { return Op::name(); }
+};
+
+template<size_t VectorSize, typename Op, template<typename> typename SetSign = MakeSigned>
+struct VectorIntegerUnaryOp {
+    u128 operator()(u128 value) const
+    {
+        using VectorType = VectorOfIntegers<VectorSize, SetSign>;
+        return bit_cast<u128>(Op {}(bit_cast<VectorType>(value)));
+    }
+
+    static StringView name() { return Op::name(); }
+};
+
+template<size_t VectorSize, typename Op>
+struct VectorFloatBinaryOp {
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        using VectorType = VectorOfFloats<VectorSize>;
+        return bit_cast<u128>(Op {}(bit_cast<VectorType>(lhs), bit_cast<VectorType>(rhs)));
+    }
+
+    static StringView name() { return Op::name(); }
+};
+
+// Applies a scalar operator to each lane, for the operations that have no portable vector equivalent.
+template<size_t VectorSize, typename Op>
+struct VectorFloatLanewiseOp {
+    u128 operator()(u128 value) const
+    {
+        auto vector = bit_cast<VectorOfFloats<VectorSize>>(value);
+        for (size_t i = 0; i < VectorSize; ++i) {
+            auto result = Op {}(vector[i]);
+            if constexpr (IsSpecializationOf<decltype(result), AK::Result>)
+                vector[i] = result.release_value();
+            else
+                vector[i] = result;
+        }
+        return bit_cast<u128>(vector);
+    }
+
+    static StringView name() { return Op::name(); }
+};
+
+struct VectorDivide {
+    template<typename Lhs, typename Rhs>
+    auto operator()(Lhs lhs, Rhs rhs) const { return lhs / rhs; }
+
+    static StringView name() { return "/"sv; }
+};
+
+struct VectorNot {
+    template<typename Lhs>
+    auto operator()(Lhs lhs) const { return ~lhs; }
+
+    static StringView name() { return "~"sv; }
+};
+
+struct VectorAndNot {
+    template<typename Lhs, typename Rhs>
+    auto operator()(Lhs lhs, Rhs rhs) const { return lhs & ~rhs; }
+
+    static StringView name() { return "andnot"sv; }
+};
+
+struct VectorMinimum {
+    template<typename Lhs, typename Rhs>
+    auto operator()(Lhs lhs, Rhs rhs) const { return lhs < rhs ? lhs : rhs; }
+
+    static StringView name() { return "minimum"sv; }
+};
+
+struct VectorMaximum {
+    template<typename Lhs, typename Rhs>
+    auto operator()(Lhs lhs, Rhs rhs) const { return lhs > rhs ? lhs : rhs; }
+
+    static StringView name() { return "maximum"sv; }
+};
+
+struct VectorAverageRounded {
+    template<typename Lhs, typename Rhs>
+    auto operator()(Lhs lhs, Rhs rhs) const
+    {
+        // (lhs + rhs + 1) / 2, without overflowing the lanes.
+        return (lhs | rhs) - ((lhs ^ rhs) >> 1);
+    }
+
+    static StringView name() { return "avgr"sv; }
+};
+
+template<size_t VectorSize>
+struct VectorAbsolute {
+    u128 operator()(u128 value) const
+    {
+        auto vector = bit_cast<VectorOfIntegers<VectorSize, MakeSigned>>(value);
+        auto unsigned_vector = bit_cast<VectorOfIntegers<VectorSize, MakeUnsigned>>(value);
+        // Negating the unsigned lanes wraps around, so the most negative value stays as it is.
+        return bit_cast<u128>(vector < 0 ? -unsigned_vector : unsigned_vector);
+    }
+
+    static StringView name() { return "abs"sv; }
+};
+
+struct VectorPopCount {
+    u128 operator()(u128 value) const
+    {
+        auto vector = bit_cast<u8x16>(value);
+        vector = vector - ((vector >> 1) & 0x55);
+        vector = (vector & 0x33) + ((vector >> 2) & 0x33);
+        return bit_cast<u128>((vector + (vector >> 4)) & 0x0f);
+    }
+
+    static StringView name() { return "popcnt"sv; }
+};
+
+template<size_t VectorSize, typename Op, template<typename> typename SetSign>
+struct VectorSaturatingOp {
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        using Element = SetSign<NativeIntegralType<128 / VectorSize>>;
+        // The exact result always fits into lanes twice as wide, from where it's clamped back into range.
+        // Going through one half at a time keeps the wide vectors in a single register.
+        using HalfVectorType = NativeVectorType<128 / VectorSize, VectorSize / 2, SetSign>;
+        using WideVectorType = NativeVectorType<256 / VectorSize, VectorSize / 2, MakeSigned>;
+        auto const min = splat_vector<WideVectorType>(NumericLimits<Element>::min());
+        auto const max = splat_vector<WideVectorType>(NumericLimits<Element>::max());
+        auto apply = [&](u64 lhs_half, u64 rhs_half) {
+            auto result = Op {}(__builtin_convertvector(bit_cast<HalfVectorType>(lhs_half), WideVectorType), __builtin_convertvector(bit_cast<HalfVectorType>(rhs_half), WideVectorType));
+            result = result < min ? min : result;
+            result = result > max ? max : result;
+            return bit_cast<u64>(__builtin_convertvector(result, HalfVectorType));
+        };
+        auto lhs_halves = bit_cast<u64x2>(lhs);
+        auto rhs_halves = bit_cast<u64x2>(rhs);
+        return bit_cast<u128>(u64x2 { apply(lhs_halves[0], rhs_halves[0]), apply(lhs_halves[1], rhs_halves[1]) });
+    }
+
+    static StringView name() { return Op::name(); }
+};
+
+struct VectorQ15MultiplyRoundSaturate {
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        auto const max = splat_vector<i32x4>(NumericLimits<i16>::max());
+        auto apply = [&](u64 lhs_half, u64 rhs_half) {
+            auto product = __builtin_convertvector(bit_cast<i16x4>(lhs_half), i32x4) * __builtin_convertvector(bit_cast<i16x4>(rhs_half), i32x4);
+            auto result = (product + 0x4000) >> 15;
+            // Only -32768 * -32768 goes out of range.
+            result = result > max ? max : result;
+            return bit_cast<u64>(__builtin_convertvector(result, i16x4));
+        };
+        auto lhs_halves = bit_cast<u64x2>(lhs);
+        auto rhs_halves = bit_cast<u64x2>(rhs);
+        return bit_cast<u128>(u64x2 { apply(lhs_halves[0], rhs_halves[0]), apply(lhs_halves[1], rhs_halves[1]) });
+    }
+
+    static StringView name() { return "q15mulr_sat"sv; }
+};
+
+// Narrows the signed lanes of two vectors into one with lanes half as wide, saturating them to the range of SetSign.
+template<size_t VectorSize, template<typename> typename SetSign>
+struct VectorNarrow {
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        using Element = SetSign<NativeIntegralType<128 / VectorSize>>;
+        using WideVectorType = VectorOfIntegers<VectorSize / 2, MakeSigned>;
+        using HalfVectorType = NativeVectorType<128 / VectorSize, VectorSize / 2, SetSign>;
+        auto const min = splat_vector<WideVectorType>(NumericLimits<Element>::min());
+        auto const max = splat_vector<WideVectorType>(NumericLimits<Element>::max());
+        auto narrow = [&](u128 value) {
+            auto vector = bit_cast<WideVectorType>(value);
+            vector = vector < min ? min : vector;
+            vector = vector > max ? max : vector;
+            return bit_cast<u64>(__builtin_convertvector(vector, HalfVectorType));
+        };
+        return bit_cast<u128>(u64x2 { narrow(lhs), narrow(rhs) });
+    }
+
+    static StringView name() { return "narrow"sv; }
+};
+
+// Extends half of the lanes to twice their width, VectorSize being the number of resulting lanes.
+template<size_t VectorSize, VectorHalf Half, template<typename> typename SetSign>
+struct VectorExtend {
+    u128 operator()(u128 value) const
+    {
+        using HalfVectorType = NativeVectorType<64 / VectorSize, VectorSize, SetSign>;
+        auto half = bit_cast<HalfVectorType>(bit_cast<u64x2>(value)[Half == VectorHalf::Low ? 0 : 1]);
+        return bit_cast<u128>(__builtin_convertvector(half, VectorOfIntegers<VectorSize, SetSign>));
+    }
+
+    static StringView name() { return "extend"sv; }
+};
+
+template<size_t VectorSize, VectorHalf Half, template<typename> typename SetSign>
+struct VectorExtendedMultiply {
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        using VectorType = VectorOfIntegers<VectorSize, SetSign>;
+        VectorExtend<VectorSize, Half, SetSign> extend;
+        // The product of two narrow lanes always fits into a wide one.
+        return bit_cast<u128>(bit_cast<VectorType>(extend(lhs)) * bit_cast<VectorType>(extend(rhs)));
+    }
+
+    static StringView name() { return "extmul"sv; }
+};
+
+template<size_t VectorSize, template<typename> typename SetSign>
+struct VectorExtendedAddPairwise {
+    u128 operator()(u128 value) const
+    {
+        // Each wide lane holds a pair of narrow ones, shifting them down (arithmetically if signed) extends them in place.
+        constexpr auto half_lane_bits = 64 / VectorSize;
+        auto vector = bit_cast<VectorOfIntegers<VectorSize, SetSign>>(value);
+        auto low = (vector << half_lane_bits) >> half_lane_bits;
+        auto high = vector >> half_lane_bits;
+        return bit_cast<u128>(low + high);
+    }
+
+    static StringView name() { return "extadd_pairwise"sv; }
+};
+
+struct VectorDotProduct {
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        auto lhs_vector = bit_cast<i32x4>(lhs);
+        auto rhs_vector = bit_cast<i32x4>(rhs);
+        auto low = ((lhs_vector << 16) >> 16) * ((rhs_vector << 16) >> 16);
+        auto high = (lhs_vector >> 16) * (rhs_vector >> 16);
+        // Adding two -32768 * -32768 products overflows, and has to wrap around.
+        return bit_cast<u128>(bit_cast<u32x4>(low) + bit_cast<u32x4>(high));
+    }
+
+    static StringView name() { return "dot"sv; }
+};
+
+struct VectorSwizzle {
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        auto indices = bit_cast<u8x16>(rhs);
+        auto result = shuffle(bit_cast<u8x16>(lhs), indices);
+        // AK::SIMD::shuffle() wraps the indices around, but out of range ones have to select zero here.
+        return bit_cast<u128>(result & bit_cast<u8x16>(indices < 16));
+    }
+
+    static StringView name() { return "swizzle"sv; }
+};
+
+struct VectorAnyTrue {
+    i32 operator()(u128 value) const
+    {
+        auto halves = bit_cast<u64x2>(value);
+        return (halves[0] | halves[1]) != 0;
+    }
+
+    static StringView name() { return "any_true"sv; }
+};
+
+template<size_t VectorSize>
+struct VectorAllTrue {
+    i32 operator()(u128 value) const
+    {
+        auto zero_lanes = bit_cast<u64x2>(bit_cast<VectorOfIntegers<VectorSize>>(value) == 0);
+        return (zero_lanes[0] | zero_lanes[1]) == 0;
+    }
+
+    static StringView name() { return "all_true"sv; }
+};
+
+template<size_t VectorSize>
+struct VectorBitMask {
+    i32 operator()(u128 value) const
+    {
+        auto vector = bit_cast<VectorOfIntegers<VectorSize, MakeSigned>>(value);
+#if ARCH(X86_64)
+        if constexpr (VectorSize == 16)
+            return __builtin_ia32_pmovmskb128(bit_cast<c8x16>(vector));
+        if constexpr (VectorSize == 4)
+            return __builtin_ia32_movmskps(bit_cast<f32x4>(vector));
+        if constexpr (VectorSize == 2)
+            return __builtin_ia32_movmskpd(bit_cast<f64x2>(vector));
+#endif
+        i32 result = 0;
+        for (size_t i = 0; i < VectorSize; ++i)
+            result |= static_cast<i32>(vector[i] < 0) << i;
+        return result;
+    }
+
+    static StringView name() { return "bitmask"sv; }
+};
+
+template<size_t VectorSize>
+struct VectorFloatAbsolute {
+    u128 operator()(u128 value) const
+    {
+        constexpr auto sign_bit = static_cast<NativeIntegralType<128 / VectorSize>>(1) << (128 / VectorSize - 1);
+        return bit_cast<u128>(bit_cast<VectorOfIntegers<VectorSize, MakeUnsigned>>(value) & ~sign_bit);
+    }
+
+    static StringView name() { return "abs"sv; }
+};
+
+template<size_t VectorSize>
+struct VectorFloatNegate {
+    u128 operator()(u128 value) const
+    {
+        constexpr auto sign_bit = static_cast<NativeIntegralType<128 / VectorSize>>(1) << (128 / VectorSize - 1);
+        return bit_cast<u128>(bit_cast<VectorOfIntegers<VectorSize, MakeUnsigned>>(value) ^ sign_bit);
+    }
+
+    static StringView name() { return "neg"sv; }
+};
+
+template<size_t VectorSize>
+struct VectorFloatSquareRoot {
+    u128 operator()(u128 value) const
+    {
+#if ARCH(X86_64)
+        auto vector = bit_cast<VectorOfFloats<VectorSize>>(value);
+        if constexpr (VectorSize == 4)
+            return bit_cast<u128>(__builtin_ia32_sqrtps(vector));
+        else
+            return bit_cast<u128>(__builtin_ia32_sqrtpd(vector));
+#else
+        return VectorFloatLanewiseOp<VectorSize, SquareRoot> {}(value);
+#endif
+    }
+
+    static StringView name() { return "sqrt"sv; }
+};
+
+// The special cases of the scalar operators are blended in with lane masks, so there are no branches per lane.
+template<size_t VectorSize>
+struct VectorFloatMinimum {
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        using MaskType = VectorOfIntegers<VectorSize, MakeSigned>;
+        auto lhs_vector = bit_cast<VectorOfFloats<VectorSize>>(lhs);
+        auto rhs_vector = bit_cast<VectorOfFloats<VectorSize>>(rhs);
+        auto lhs_bits = bit_cast<MaskType>(lhs);
+        auto rhs_bits = bit_cast<MaskType>(rhs);
+        // -0 and +0 compare equal, OR-ing them together makes the negative one win.
+        auto result = lhs_vector < rhs_vector ? lhs_bits : (lhs_vector == rhs_vector ? (lhs_bits | rhs_bits) : rhs_bits);
+        auto is_nan = (lhs_vector != lhs_vector) | (rhs_vector != rhs_vector);
+        result = is_nan ? bit_cast<MaskType>(lhs_vector + rhs_vector) : result;
+        return bit_cast<u128>(result);
+    }
+
+    static StringView name() { return "minimum"sv; }
+};
+
+template<size_t VectorSize>
+struct VectorFloatMaximum {
+    u128 operator()(u128 lhs, u128 rhs) const
+    {
+        using MaskType = VectorOfIntegers<VectorSize, MakeSigned>;
+        auto lhs_vector = bit_cast<VectorOfFloats<VectorSize>>(lhs);
+        auto rhs_vector = bit_cast<VectorOfFloats<VectorSize>>(rhs);
+        auto lhs_bits = bit_cast<MaskType>(lhs);
+        auto rhs_bits = bit_cast<MaskType>(rhs);
+        // -0 and +0 compare equal, AND-ing them together makes the positive one win.
+        auto result = lhs_vector > rhs_vector ? lhs_bits : (lhs_vector == rhs_vector ? (lhs_bits & rhs_bits) : rhs_bits);
+        auto is_nan = (lhs_vector != lhs_vector) | (rhs_vector != rhs_vector);
+        result = is_nan ? bit_cast<MaskType>(lhs_vector + rhs_vector) : result;
+        return bit_cast<u128>(result);
+    }
+
+    static StringView name() { return "maximum"sv; }
+};
+
+struct VectorPseudoMinimum {
+    template<typename Lhs, typename Rhs>
+    auto operator()(Lhs lhs, Rhs rhs) const { return rhs < lhs ? rhs : lhs; }
+
+    static StringView name() { return "pmin"sv; }
+};
+
+struct VectorPseudoMaximum {
+    template<typename Lhs, typename Rhs>
+    auto operator()(Lhs lhs, Rhs rhs) const { return lhs < rhs ? rhs : lhs; }
+
+    static StringView name() { return "pmax"sv; }
+};
+
+template<typename ResultType, typename SourceType>
+struct VectorConvert {
+    u128 operator()(u128 value) const
+    {
+        return bit_cast<u128>(__builtin_convertvector(bit_cast<SourceType>(value), ResultType));
+    }
+
+    static StringView name() { return "convert"sv; }
+};
+
+// Converts the two lanes in the low half of the source, for the conversions into 64-bit lanes.
+template<typename ResultType, typename SourceType>
+struct VectorConvertLow {
+    u128 operator()(u128 value) const
+    {
+        auto low = bit_cast<SourceType>(bit_cast<u64x2>(value)[0]);
+        return bit_cast<u128>(__builtin_convertvector(low, ResultType));
+    }
+
+    static StringView name() { return "convert_low"sv; }
+};
+
+struct VectorDemoteZero {
+    u128 operator()(u128 value) const
+    {
+        auto low = __builtin_convertvector(bit_cast<f64x2>(value), f32x2);
+        return bit_cast<u128>(u64x2 { bit_cast<u64>(low), 0 });
+    }
+
+    static StringView name() { return "demote_zero"sv; }
+};
+
+template<typename ResultT, size_t VectorSize>
+struct VectorSaturatingTruncate {
+    u128 operator()(u128 value) const
+    {
+        auto vector = bit_cast<VectorOfFloats<VectorSize>>(value);
+        // The result always has 32-bit lanes, those without a source lane are zeroed.
+        i32x4 result {};
+        for (size_t i = 0; i < VectorSize; ++i)
+            result[i] = static_cast<i32>(SaturatingTruncate<ResultT> {}(vector[i]));
+        return bit_cast<u128>(result);
+    }
+
+    static StringView name() { return "truncate.saturating"sv; }
+};
+
+#pragma GCC diagnostic pop
+
 }
@@ -2886,7 +2886,7 @@ VALIDATE_INSTRUCTION(v128_load8_lane)
     constexpr auto max_lane = 128 / N;
     constexpr auto max_alignment = N / 8;
 
-    if (arg.lane > max_lane)
+    if (arg.lane >= max_lane)
         return Errors::out_of_bounds("lane index"sv, arg.lane, 0u, max_lane);
 
     TRY(validate(arg.memory.memory_index));
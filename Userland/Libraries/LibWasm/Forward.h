@@ -13,6 +13,11 @@ class Validator;
 struct ValidationError;
 struct Interpreter;
 
+namespace JIT {
+struct NativeContext;
+class NativeFunction;
+}
+
 namespace Wasi {
 struct Implementation;
 }
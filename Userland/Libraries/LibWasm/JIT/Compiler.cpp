@@ -0,0 +1,905 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/OwnPtr.h>
+#include <AK/Platform.h>
+#include <LibJIT/GDB.h>
+#include <LibWasm/AbstractMachine/Configuration.h>
+#include <LibWasm/Constants.h>
+#include <LibWasm/JIT/Compiler.h>
+#include <LibWasm/JIT/NativeContext.h>
+#include <LibWasm/Printer/Printer.h>
+#include <sys/mman.h>
+
+#ifdef JIT_ARCH_SUPPORTED
+
+#    define LOG_JIT_SUCCESS 0
+#    define LOG_JIT_FAILURE 0
+
+namespace Wasm::JIT {
+
+using Reg = Assembler::Reg;
+using Operand = Assembler::Operand;
+
+// The frame pointer is followed by the callee-saved registers pushed by Assembler::enter().
+static constexpr size_t callee_saved_registers_size = 6 * sizeof(u64);
+
+static NativeStatus cxx_call(NativeContext* context, u64 address, u64* slots)
+{
+    auto& configuration = *context->configuration;
+    auto* function = configuration.store().get(FunctionAddress { address });
+
+    // Calls within a module share the caller's context, so native code can call other native code directly.
+    if (auto* wasm_function = function->get_pointer<WasmFunction>(); wasm_function && &wasm_function->module() == context->module) {
+        if (auto* native_function = wasm_function->native_function(configuration.store()))
+            return native_function->entry()(context, slots, slots);
+    }
+
+    FunctionType const* type { nullptr };
+    function->visit([&](auto const& instance) { type = &instance.type(); });
+
+    Vector<Value> arguments;
+    arguments.ensure_capacity(type->parameters().size());
+    for (size_t i = 0; i < type->parameters().size(); ++i)
+        arguments.unchecked_append(Value(type->parameters()[i], slots[i]));
+
+    auto result = [&] {
+        Configuration::CallFrameHandle handle { configuration };
+        return configuration.call(*context->interpreter, FunctionAddress { address }, move(arguments));
+    }();
+
+    // Anything could have happened to the memory in the meantime.
+    context->reload_memory();
+
+    if (result.is_trap() || result.is_completion()) {
+        *context->abrupt_result = move(result);
+        return NativeStatus::Abrupt;
+    }
+
+    auto const& results = result.values();
+    for (size_t i = 0; i < results.size(); ++i)
+        slots[i] = NativeContext::raw_value(results[results.size() - i - 1]);
+    return NativeStatus::Success;
+}
+
+static u64 cxx_memory_grow(NativeContext* context, u64 pages)
+{
+    auto& memory = *context->memory;
+    i32 old_pages = memory.size() / Constants::page_size;
+    // The page count is unsigned, so this can't overflow, and anything that large fails to grow.
+    i32 result = memory.grow(static_cast<u32>(pages) * Constants::page_size) ? old_pages : -1;
+    context->reload_memory();
+    return static_cast<u32>(result);
+}
+
+static u64 cxx_global_get(NativeContext* context, u64 address)
+{
+    auto* global = context->configuration->store().get(GlobalAddress { address });
+    return NativeContext::raw_value(global->value());
+}
+
+static void cxx_global_set(NativeContext* context, u64 address, u64 value)
+{
+    auto* global = context->configuration->store().get(GlobalAddress { address });
+    global->set_value(Value(global->type().type(), value));
+}
+
+bool Compiler::is_supported(ValueType const& type)
+{
+    return type.kind() == ValueType::I32 || type.kind() == ValueType::I64;
+}
+
+bool Compiler::is_supported(FunctionType const& type)
+{
+    return all_of(type.parameters(), [](auto const& type) { return is_supported(type); })
+        && all_of(type.results(), [](auto const& type) { return is_supported(type); });
+}
+
+Optional<FunctionType> Compiler::block_type(BlockType const& type) const
+{
+    switch (type.kind()) {
+    case BlockType::Empty:
+        return FunctionType { {}, {} };
+    case BlockType::Type:
+        if (!is_supported(type.value_type()))
+            return {};
+        return FunctionType { {}, { type.value_type() } };
+    case BlockType::Index: {
+        auto const& function_type = m_function.module().types()[type.type_index().value()];
+        if (!is_supported(function_type))
+            return {};
+        return function_type;
+    }
+    }
+    VERIFY_NOT_REACHED();
+}
+
+Operand Compiler::local(size_t index) const
+{
+    return Operand::Mem64BaseAndOffset(SLOTS, index * sizeof(u64));
+}
+
+Operand Compiler::stack_slot(size_t height) const
+{
+    return Operand::Mem64BaseAndOffset(SLOTS, (m_local_count + height) * sizeof(u64));
+}
+
+void Compiler::push(Reg reg)
+{
+    m_assembler.mov(stack_slot(m_stack_height), Operand::Register(reg));
+    ++m_stack_height;
+    m_max_stack_height = max(m_max_stack_height, m_stack_height);
+}
+
+void Compiler::pop(Reg reg, Assembler::Extension extension)
+{
+    --m_stack_height;
+    // i32 values are always kept zero-extended, so they only need extending for signed operations.
+    if (extension == Assembler::Extension::SignExtend)
+        m_assembler.mov32(Operand::Register(reg), stack_slot(m_stack_height), Assembler::Extension::SignExtend);
+    else
+        m_assembler.mov(Operand::Register(reg), stack_slot(m_stack_height));
+}
+
+void Compiler::copy_slot(Operand destination, Operand source)
+{
+    m_assembler.mov(Operand::Register(GPR0), source);
+    m_assembler.mov(destination, Operand::Register(GPR0));
+}
+
+void Compiler::reload_memory_registers()
+{
+    m_assembler.mov(
+        Operand::Register(MEMORY_BASE),
+        Operand::Mem64BaseAndOffset(CONTEXT, offsetof(NativeContext, memory_base)));
+    m_assembler.mov(
+        Operand::Register(MEMORY_SIZE),
+        Operand::Mem64BaseAndOffset(CONTEXT, offsetof(NativeContext, memory_size)));
+}
+
+bool Compiler::compile_block(Instruction const& instruction, ControlFrame::Kind kind)
+{
+    auto const& arguments = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
+    auto type = block_type(arguments.block_type);
+    if (!type.has_value())
+        return false;
+
+    ControlFrame frame;
+    frame.kind = kind;
+    frame.parameter_count = type->parameters().size();
+    frame.result_count = type->results().size();
+
+    if (kind == ControlFrame::Kind::If) {
+        pop(GPR0);
+        m_assembler.test(Operand::Register(GPR0), Operand::Register(GPR0));
+        m_assembler.jump_if(Assembler::Condition::EqualTo, frame.else_label);
+    }
+
+    frame.stack_height = m_stack_height - frame.parameter_count;
+    if (kind == ControlFrame::Kind::Loop)
+        frame.loop_label.link(m_assembler);
+
+    m_control_stack.append(move(frame));
+    return true;
+}
+
+void Compiler::compile_else()
+{
+    auto& frame = m_control_stack.last();
+    if (!m_is_unreachable)
+        m_assembler.jump(frame.end_label);
+    frame.else_label.link(m_assembler);
+    frame.has_else = true;
+    m_stack_height = frame.stack_height + frame.parameter_count;
+    m_is_unreachable = false;
+}
+
+void Compiler::compile_end()
+{
+    auto frame = m_control_stack.take_last();
+    // Without an else branch, a false condition skips straight to the end.
+    if (frame.kind == ControlFrame::Kind::If && !frame.has_else)
+        frame.else_label.link(m_assembler);
+    frame.end_label.link(m_assembler);
+    m_stack_height = frame.stack_height + frame.result_count;
+    m_is_unreachable = false;
+}
+
+void Compiler::compile_branch(LabelIndex index)
+{
+    auto& target = m_control_stack[m_control_stack.size() - index.value() - 1];
+    auto arity = target.branch_arity();
+    auto source_height = m_stack_height - arity;
+    if (source_height != target.stack_height) {
+        for (size_t i = 0; i < arity; ++i)
+            copy_slot(stack_slot(target.stack_height + i), stack_slot(source_height + i));
+    }
+    m_assembler.jump(target.branch_target());
+}
+
+bool Compiler::compile_call(FunctionIndex index)
+{
+    auto address = m_function.module().functions()[index.value()];
+    auto* function = m_store.get(address);
+    if (!function)
+        return false;
+
+    FunctionType const* type { nullptr };
+    function->visit([&](auto const& instance) { type = &instance.type(); });
+    if (!is_supported(*type))
+        return false;
+
+    // The arguments are already laid out in consecutive slots, and the results replace them.
+    auto base = m_stack_height - type->parameters().size();
+    m_assembler.mov(Operand::Register(ARG0), Operand::Register(CONTEXT));
+    m_assembler.mov(Operand::Register(ARG1), Operand::Imm(address.value()));
+    m_assembler.mov(Operand::Register(ARG2), Operand::Register(SLOTS));
+    m_assembler.add(Operand::Register(ARG2), Operand::Imm(stack_slot(base).offset_or_immediate));
+    m_assembler.native_call(bit_cast<u64>(&cxx_call));
+
+    m_assembler.test(Operand::Register(RET), Operand::Register(RET));
+    m_assembler.jump_if(Assembler::Condition::NotEqualTo, m_exit_label);
+    reload_memory_registers();
+
+    m_stack_height = base + type->results().size();
+    m_max_stack_height = max(m_max_stack_height, m_stack_height);
+    return true;
+}
+
+void Compiler::compute_effective_address(Instruction::MemoryArgument const& argument, size_t size)
+{
+    pop(GPR0);
+    if (argument.offset != 0) {
+        auto offset = Operand::Imm(argument.offset);
+        if (offset.fits_in_i32()) {
+            m_assembler.add(Operand::Register(GPR0), offset);
+        } else {
+            m_assembler.mov(Operand::Register(GPR1), offset);
+            m_assembler.add(Operand::Register(GPR0), Operand::Register(GPR1));
+        }
+    }
+
+    // The address and offset are both 32-bit, so this can't overflow.
+    m_assembler.mov(Operand::Register(GPR1), Operand::Register(GPR0));
+    m_assembler.add(Operand::Register(GPR1), Operand::Imm(size));
+    m_assembler.cmp(Operand::Register(GPR1), Operand::Register(MEMORY_SIZE));
+    m_assembler.jump_if(Assembler::Condition::UnsignedGreaterThan, m_memory_trap_label);
+
+    m_assembler.add(Operand::Register(GPR0), Operand::Register(MEMORY_BASE));
+}
+
+bool Compiler::compile_load(Instruction const& instruction, size_t size, Assembler::Extension extension, bool is_64_bit)
+{
+    auto const& argument = instruction.arguments().get<Instruction::MemoryArgument>();
+    if (argument.memory_index.value() != 0 || m_function.module().memories().is_empty())
+        return false;
+
+    compute_effective_address(argument, size);
+
+    auto destination = Operand::Register(GPR0);
+    auto source = Operand::Mem64BaseAndOffset(GPR0, 0);
+    switch (size) {
+    case 1:
+        m_assembler.mov8(destination, source, extension);
+        break;
+    case 2:
+        m_assembler.mov16(destination, source, extension);
+        break;
+    case 4:
+        m_assembler.mov32(destination, source, extension);
+        break;
+    case 8:
+        m_assembler.mov(destination, source);
+        break;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+    if (is_64_bit && size < 4 && extension == Assembler::Extension::SignExtend)
+        m_assembler.sign_extend_32_to_64_bits(GPR0);
+
+    push(GPR0);
+    return true;
+}
+
+bool Compiler::compile_store(Instruction const& instruction, size_t size)
+{
+    auto const& argument = instruction.arguments().get<Instruction::MemoryArgument>();
+    if (argument.memory_index.value() != 0 || m_function.module().memories().is_empty())
+        return false;
+
+    pop(GPR2);
+    compute_effective_address(argument, size);
+
+    auto destination = Operand::Mem64BaseAndOffset(GPR0, 0);
+    auto source = Operand::Register(GPR2);
+    switch (size) {
+    case 1:
+        m_assembler.mov8(destination, source);
+        break;
+    case 2:
+        m_assembler.mov16(destination, source);
+        break;
+    case 4:
+        m_assembler.mov32(destination, source);
+        break;
+    case 8:
+        m_assembler.mov(destination, source);
+        break;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+    return true;
+}
+
+void Compiler::compile_compare(Assembler::Condition condition, bool sign_extend_i32)
+{
+    auto extension = sign_extend_i32 ? Assembler::Extension::SignExtend : Assembler::Extension::ZeroExtend;
+    pop(GPR2, extension);
+    pop(GPR1, extension);
+    // Note: This has to happen before the comparison, as it's done with a xor that clobbers the flags.
+    m_assembler.mov(Operand::Register(GPR0), Operand::Imm(0));
+    m_assembler.cmp(Operand::Register(GPR1), Operand::Register(GPR2));
+    m_assembler.set_if(condition, Operand::Register(GPR0));
+    push(GPR0);
+}
+
+void Compiler::compile_division(bool is_64_bit, bool is_signed, bool is_remainder)
+{
+    auto extension = is_signed && !is_64_bit ? Assembler::Extension::SignExtend : Assembler::Extension::ZeroExtend;
+    pop(GPR1, extension);
+    pop(GPR0, extension);
+
+    m_assembler.test(Operand::Register(GPR1), Operand::Register(GPR1));
+    m_assembler.jump_if(Assembler::Condition::EqualTo, m_division_trap_label);
+
+    // The hardware faults on the most negative number divided by -1, as the quotient doesn't fit.
+    Assembler::Label done;
+    if (is_signed) {
+        Assembler::Label divide;
+        m_assembler.cmp(Operand::Register(GPR1), Operand::Imm(static_cast<u64>(-1)));
+        m_assembler.jump_if(Assembler::Condition::NotEqualTo, divide);
+        if (is_remainder) {
+            m_assembler.mov(Operand::Register(GPR2), Operand::Imm(0));
+            m_assembler.jump(done);
+        } else {
+            auto minimum = is_64_bit ? static_cast<u64>(NumericLimits<i64>::min()) : static_cast<u64>(static_cast<i64>(NumericLimits<i32>::min()));
+            m_assembler.mov(Operand::Register(GPR2), Operand::Imm(minimum));
+            m_assembler.cmp(Operand::Register(GPR0), Operand::Register(GPR2));
+            m_assembler.jump_if(Assembler::Condition::EqualTo, m_division_trap_label);
+        }
+        divide.link(m_assembler);
+    }
+
+    auto divisor = Operand::Register(GPR1);
+    if (is_64_bit && is_signed)
+        m_assembler.signed_divide(divisor);
+    else if (is_64_bit)
+        m_assembler.unsigned_divide(divisor);
+    else if (is_signed)
+        m_assembler.signed_divide32(divisor);
+    else
+        m_assembler.unsigned_divide32(divisor);
+
+    done.link(m_assembler);
+    push(is_remainder ? GPR2 : GPR0);
+}
+
+bool Compiler::compile_global_get(GlobalIndex index)
+{
+    auto address = m_function.module().globals()[index.value()];
+    auto* global = m_store.get(address);
+    if (!global || !is_supported(global->type().type()))
+        return false;
+
+    m_assembler.mov(Operand::Register(ARG0), Operand::Register(CONTEXT));
+    m_assembler.mov(Operand::Register(ARG1), Operand::Imm(address.value()));
+    m_assembler.native_call(bit_cast<u64>(&cxx_global_get));
+    push(RET);
+    return true;
+}
+
+bool Compiler::compile_global_set(GlobalIndex index)
+{
+    auto address = m_function.module().globals()[index.value()];
+    auto* global = m_store.get(address);
+    if (!global || !is_supported(global->type().type()))
+        return false;
+
+    pop(ARG2);
+    m_assembler.mov(Operand::Register(ARG0), Operand::Register(CONTEXT));
+    m_assembler.mov(Operand::Register(ARG1), Operand::Imm(address.value()));
+    m_assembler.native_call(bit_cast<u64>(&cxx_global_set));
+    return true;
+}
+
+bool Compiler::compile_instruction(Instruction const& instruction)
+{
+    auto opcode = instruction.opcode();
+
+    if (m_is_unreachable) {
+        switch (opcode.value()) {
+        case Instructions::block.value():
+        case Instructions::loop.value():
+        case Instructions::if_.value():
+            ++m_unreachable_depth;
+            return true;
+        case Instructions::structured_else.value():
+            if (m_unreachable_depth == 0)
+                compile_else();
+            return true;
+        case Instructions::structured_end.value():
+            if (m_unreachable_depth == 0)
+                compile_end();
+            else
+                --m_unreachable_depth;
+            return true;
+        default:
+            return true;
+        }
+    }
+
+    auto binary_operation = [&](auto emit) {
+        pop(GPR1);
+        pop(GPR0);
+        emit(Operand::Register(GPR0), Operand::Register(GPR1));
+        push(GPR0);
+    };
+
+    auto unary_operation = [&](auto emit, Assembler::Extension extension = Assembler::Extension::ZeroExtend) {
+        pop(GPR0, extension);
+        emit(Operand::Register(GPR0));
+        push(GPR0);
+    };
+
+    auto eqz = [&] {
+        pop(GPR1);
+        m_assembler.mov(Operand::Register(GPR0), Operand::Imm(0));
+        m_assembler.test(Operand::Register(GPR1), Operand::Register(GPR1));
+        m_assembler.set_if(Assembler::Condition::EqualTo, Operand::Register(GPR0));
+        push(GPR0);
+    };
+
+    using Condition = Assembler::Condition;
+    using Extension = Assembler::Extension;
+
+    switch (opcode.value()) {
+    case Instructions::unreachable.value():
+        m_assembler.jump(m_unreachable_trap_label);
+        m_is_unreachable = true;
+        return true;
+    case Instructions::nop.value():
+        return true;
+    case Instructions::block.value():
+        return compile_block(instruction, ControlFrame::Kind::Block);
+    case Instructions::loop.value():
+        return compile_block(instruction, ControlFrame::Kind::Loop);
+    case Instructions::if_.value():
+        return compile_block(instruction, ControlFrame::Kind::If);
+    case Instructions::structured_else.value():
+        compile_else();
+        return true;
+    case Instructions::structured_end.value():
+        compile_end();
+        return true;
+    case Instructions::br.value():
+        compile_branch(instruction.arguments().get<LabelIndex>());
+        m_is_unreachable = true;
+        return true;
+    case Instructions::br_if.value(): {
+        Assembler::Label not_taken;
+        pop(GPR0);
+        m_assembler.test(Operand::Register(GPR0), Operand::Register(GPR0));
+        m_assembler.jump_if(Condition::EqualTo, not_taken);
+        compile_branch(instruction.arguments().get<LabelIndex>());
+        not_taken.link(m_assembler);
+        return true;
+    }
+    case Instructions::br_table.value(): {
+        auto const& arguments = instruction.arguments().get<Instruction::TableBranchArgs>();
+        if (arguments.labels.size() > NumericLimits<i32>::max())
+            return false;
+        // The index is zero-extended, so negative indices compare as too large and take the default label too.
+        pop(GPR0);
+        for (size_t i = 0; i < arguments.labels.size(); ++i) {
+            Assembler::Label next;
+            m_assembler.cmp(Operand::Register(GPR0), Operand::Imm(i));
+            m_assembler.jump_if(Condition::NotEqualTo, next);
+            compile_branch(arguments.labels[i]);
+            next.link(m_assembler);
+        }
+        compile_branch(arguments.default_);
+        m_is_unreachable = true;
+        return true;
+    }
+    case Instructions::return_.value():
+        compile_branch(LabelIndex { m_control_stack.size() - 1 });
+        m_is_unreachable = true;
+        return true;
+    case Instructions::call.value():
+        return compile_call(instruction.arguments().get<FunctionIndex>());
+    case Instructions::drop.value():
+        --m_stack_height;
+        return true;
+    case Instructions::select_typed.value():
+        if (!all_of(instruction.arguments().get<Vector<ValueType>>(), [](auto const& type) { return is_supported(type); }))
+            return false;
+        [[fallthrough]];
+    case Instructions::select.value():
+        pop(GPR2);
+        pop(GPR1);
+        pop(GPR0);
+        m_assembler.test(Operand::Register(GPR2), Operand::Register(GPR2));
+        m_assembler.mov_if(Condition::EqualTo, Operand::Register(GPR0), Operand::Register(GPR1));
+        push(GPR0);
+        return true;
+    case Instructions::local_get.value():
+        m_assembler.mov(Operand::Register(GPR0), local(instruction.arguments().get<LocalIndex>().value()));
+        push(GPR0);
+        return true;
+    case Instructions::local_set.value():
+        pop(GPR0);
+        m_assembler.mov(local(instruction.arguments().get<LocalIndex>().value()), Operand::Register(GPR0));
+        return true;
+    case Instructions::local_tee.value():
+        copy_slot(local(instruction.arguments().get<LocalIndex>().value()), stack_slot(m_stack_height - 1));
+        return true;
+    case Instructions::global_get.value():
+        return compile_global_get(instruction.arguments().get<GlobalIndex>());
+    case Instructions::global_set.value():
+        return compile_global_set(instruction.arguments().get<GlobalIndex>());
+
+    case Instructions::i32_load.value():
+        return compile_load(instruction, 4, Extension::ZeroExtend, false);
+    case Instructions::i64_load.value():
+        return compile_load(instruction, 8, Extension::ZeroExtend, true);
+    case Instructions::i32_load8_s.value():
+        return compile_load(instruction, 1, Extension::SignExtend, false);
+    case Instructions::i32_load8_u.value():
+        return compile_load(instruction, 1, Extension::ZeroExtend, false);
+    case Instructions::i32_load16_s.value():
+        return compile_load(instruction, 2, Extension::SignExtend, false);
+    case Instructions::i32_load16_u.value():
+        return compile_load(instruction, 2, Extension::ZeroExtend, false);
+    case Instructions::i64_load8_s.value():
+        return compile_load(instruction, 1, Extension::SignExtend, true);
+    case Instructions::i64_load8_u.value():
+        return compile_load(instruction, 1, Extension::ZeroExtend, true);
+    case Instructions::i64_load16_s.value():
+        return compile_load(instruction, 2, Extension::SignExtend, true);
+    case Instructions::i64_load16_u.value():
+        return compile_load(instruction, 2, Extension::ZeroExtend, true);
+    case Instructions::i64_load32_s.value():
+        return compile_load(instruction, 4, Extension::SignExtend, true);
+    case Instructions::i64_load32_u.value():
+        return compile_load(instruction, 4, Extension::ZeroExtend, true);
+    case Instructions::i32_store.value():
+        return compile_store(instruction, 4);
+    case Instructions::i64_store.value():
+        return compile_store(instruction, 8);
+    case Instructions::i32_store8.value():
+    case Instructions::i64_store8.value():
+        return compile_store(instruction, 1);
+    case Instructions::i32_store16.value():
+    case Instructions::i64_store16.value():
+        return compile_store(instruction, 2);
+    case Instructions::i64_store32.value():
+        return compile_store(instruction, 4);
+    case Instructions::memory_size.value(): {
+        static_assert(Constants::page_size == 1 << 16);
+        if (instruction.arguments().get<Instruction::MemoryIndexArgument>().memory_index.value() != 0 || m_function.module().memories().is_empty())
+            return false;
+        m_assembler.mov(Operand::Register(GPR0), Operand::Register(MEMORY_SIZE));
+        m_assembler.shift_right(Operand::Register(GPR0), Operand::Imm(16));
+        push(GPR0);
+        return true;
+    }
+    case Instructions::memory_grow.value():
+        if (instruction.arguments().get<Instruction::MemoryIndexArgument>().memory_index.value() != 0 || m_function.module().memories().is_empty())
+            return false;
+        pop(ARG1);
+        m_assembler.mov(Operand::Register(ARG0), Operand::Register(CONTEXT));
+        m_assembler.native_call(bit_cast<u64>(&cxx_memory_grow));
+        push(RET);
+        reload_memory_registers();
+        return true;
+
+    case Instructions::i32_const.value():
+        m_assembler.mov(Operand::Register(GPR0), Operand::Imm(static_cast<u32>(instruction.arguments().get<i32>())));
+        push(GPR0);
+        return true;
+    case Instructions::i64_const.value():
+        m_assembler.mov(Operand::Register(GPR0), Operand::Imm(static_cast<u64>(instruction.arguments().get<i64>())));
+        push(GPR0);
+        return true;
+
+    case Instructions::i32_eqz.value():
+    case Instructions::i64_eqz.value():
+        eqz();
+        return true;
+    case Instructions::i32_eq.value():
+    case Instructions::i64_eq.value():
+        compile_compare(Condition::EqualTo, false);
+        return true;
+    case Instructions::i32_ne.value():
+    case Instructions::i64_ne.value():
+        compile_compare(Condition::NotEqualTo, false);
+        return true;
+    case Instructions::i32_lts.value():
+        compile_compare(Condition::SignedLessThan, true);
+        return true;
+    case Instructions::i32_gts.value():
+        compile_compare(Condition::SignedGreaterThan, true);
+        return true;
+    case Instructions::i32_les.value():
+        compile_compare(Condition::SignedLessThanOrEqualTo, true);
+        return true;
+    case Instructions::i32_ges.value():
+        compile_compare(Condition::SignedGreaterThanOrEqualTo, true);
+        return true;
+    case Instructions::i64_lts.value():
+        compile_compare(Condition::SignedLessThan, false);
+        return true;
+    case Instructions::i64_gts.value():
+        compile_compare(Condition::SignedGreaterThan, false);
+        return true;
+    case Instructions::i64_les.value():
+        compile_compare(Condition::SignedLessThanOrEqualTo, false);
+        return true;
+    case Instructions::i64_ges.value():
+        compile_compare(Condition::SignedGreaterThanOrEqualTo, false);
+        return true;
+    case Instructions::i32_ltu.value():
+    case Instructions::i64_ltu.value():
+        compile_compare(Condition::UnsignedLessThan, false);
+        return true;
+    case Instructions::i32_gtu.value():
+    case Instructions::i64_gtu.value():
+        compile_compare(Condition::UnsignedGreaterThan, false);
+        return true;
+    case Instructions::i32_leu.value():
+    case Instructions::i64_leu.value():
+        compile_compare(Condition::UnsignedLessThanOrEqualTo, false);
+        return true;
+    case Instructions::i32_geu.value():
+    case Instructions::i64_geu.value():
+        compile_compare(Condition::UnsignedGreaterThanOrEqualTo, false);
+        return true;
+
+    case Instructions::i32_add.value():
+        binary_operation([&](auto lhs, auto rhs) { m_assembler.add32(lhs, rhs, {}); });
+        return true;
+    case Instructions::i32_sub.value():
+        binary_operation([&](auto lhs, auto rhs) { m_assembler.sub32(lhs, rhs, {}); });
+        return true;
+    case Instructions::i32_mul.value():
+        binary_operation([&](auto lhs, auto rhs) { m_assembler.mul32(lhs, rhs, {}); });
+        return true;
+    case Instructions::i32_divs.value():
+        compile_division(false, true, false);
+        return true;
+    case Instructions::i32_divu.value():
+        compile_division(false, false, false);
+        return true;
+    case Instructions::i32_rems.value():
+        compile_division(false, true, true);
+        return true;
+    case Instructions::i32_remu.value():
+        compile_division(false, false, true);
+        return true;
+    // Bitwise operations on zero-extended values keep them zero-extended, so i32 can share the 64-bit versions.
+    case Instructions::i32_and.value():
+    case Instructions::i64_and.value():
+        binary_operation([&](auto lhs, auto rhs) { m_assembler.bitwise_and(lhs, rhs); });
+        return true;
+    case Instructions::i32_or.value():
+    case Instructions::i64_or.value():
+        binary_operation([&](auto lhs, auto rhs) { m_assembler.bitwise_or(lhs, rhs); });
+        return true;
+    case Instructions::i32_xor.value():
+    case Instructions::i64_xor.value():
+        binary_operation([&](auto lhs, auto rhs) { m_assembler.bitwise_xor(lhs, rhs); });
+        return true;
+    // Shifts and rotations take their count from CL (GPR1), and mask it just like Wasm does.
+    case Instructions::i32_shl.value():
+        binary_operation([&](auto lhs, auto) { m_assembler.shift_left32(lhs, {}); });
+        return true;
+    case Instructions::i32_shrs.value():
+        binary_operation([&](auto lhs, auto) { m_assembler.arithmetic_right_shift32(lhs, {}); });
+        return true;
+    case Instructions::i32_shru.value():
+        binary_operation([&](auto lhs, auto) { m_assembler.shift_right32(lhs, {}); });
+        return true;
+    case Instructions::i32_rotl.value():
+        binary_operation([&](auto lhs, auto) { m_assembler.rotate_left32(lhs, {}); });
+        return true;
+    case Instructions::i32_rotr.value():
+        binary_operation([&](auto lhs, auto) { m_assembler.rotate_right32(lhs, {}); });
+        return true;
+
+    case Instructions::i64_add.value():
+        binary_operation([&](auto lhs, auto rhs) { m_assembler.add(lhs, rhs); });
+        return true;
+    case Instructions::i64_sub.value():
+        binary_operation([&](auto lhs, auto rhs) { m_assembler.sub(lhs, rhs); });
+        return true;
+    case Instructions::i64_mul.value():
+        binary_operation([&](auto lhs, auto rhs) { m_assembler.mul(lhs, rhs); });
+        return true;
+    case Instructions::i64_divs.value():
+        compile_division(true, true, false);
+        return true;
+    case Instructions::i64_divu.value():
+        compile_division(true, false, false);
+        return true;
+    case Instructions::i64_rems.value():
+        compile_division(true, true, true);
+        return true;
+    case Instructions::i64_remu.value():
+        compile_division(true, false, true);
+        return true;
+    case Instructions::i64_shl.value():
+        binary_operation([&](auto lhs, auto) { m_assembler.shift_left(lhs, {}); });
+        return true;
+    case Instructions::i64_shrs.value():
+        binary_operation([&](auto lhs, auto) { m_assembler.arithmetic_right_shift(lhs, {}); });
+        return true;
+    case Instructions::i64_shru.value():
+        binary_operation([&](auto lhs, auto) { m_assembler.shift_right(lhs, {}); });
+        return true;
+    case Instructions::i64_rotl.value():
+        binary_operation([&](auto lhs, auto) { m_assembler.rotate_left(lhs, {}); });
+        return true;
+    case Instructions::i64_rotr.value():
+        binary_operation([&](auto lhs, auto) { m_assembler.rotate_right(lhs, {}); });
+        return true;
+
+    case Instructions::i32_wrap_i64.value():
+        unary_operation([&](auto value) { m_assembler.mov32(value, value); });
+        return true;
+    case Instructions::i64_extend_si32.value():
+    case Instructions::i64_extend32_s.value():
+        unary_operation([](auto) {}, Extension::SignExtend);
+        return true;
+    case Instructions::i64_extend_ui32.value():
+        return true;
+    case Instructions::i32_extend8_s.value():
+        unary_operation([&](auto value) {
+            m_assembler.shift_left32(value, Operand::Imm(24));
+            m_assembler.arithmetic_right_shift32(value, Operand::Imm(24));
+        });
+        return true;
+    case Instructions::i32_extend16_s.value():
+        unary_operation([&](auto value) {
+            m_assembler.shift_left32(value, Operand::Imm(16));
+            m_assembler.arithmetic_right_shift32(value, Operand::Imm(16));
+        });
+        return true;
+    case Instructions::i64_extend8_s.value():
+        unary_operation([&](auto value) {
+            m_assembler.shift_left(value, Operand::Imm(56));
+            m_assembler.arithmetic_right_shift(value, Operand::Imm(56));
+        });
+        return true;
+    case Instructions::i64_extend16_s.value():
+        unary_operation([&](auto value) {
+            m_assembler.shift_left(value, Operand::Imm(48));
+            m_assembler.arithmetic_right_shift(value, Operand::Imm(48));
+        });
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+OwnPtr<NativeFunction> Compiler::compile(Store& store, WasmFunction const& function)
+{
+    auto const& type = function.type();
+    if (!is_supported(type) || !all_of(function.code().locals(), [](auto const& type) { return is_supported(type); })) {
+        if constexpr (LOG_JIT_FAILURE)
+            dbgln("\033[31;1mJIT compilation failed\033[0m: Unsupported value types");
+        return nullptr;
+    }
+
+    Compiler compiler { store, function };
+    auto& assembler = compiler.m_assembler;
+    compiler.m_local_count = type.parameters().size() + function.code().locals().size();
+
+    // Entry: (NativeContext* context, u64 const* arguments, u64* results)
+    assembler.enter();
+    assembler.mov(Operand::Register(CONTEXT), Operand::Register(ARG0));
+    assembler.mov(Operand::Register(RESULTS), Operand::Register(ARG2));
+
+    // The frame size isn't known until the whole function has been compiled, so it's patched in at the end.
+    assembler.mov(Operand::Register(GPR0), Operand::Imm(0), Assembler::Patchable::Yes);
+    auto frame_size_offset = compiler.m_output.size() - sizeof(u64);
+    assembler.sub(Operand::Register(Reg::RSP), Operand::Register(GPR0));
+    assembler.mov(Operand::Register(SLOTS), Operand::Register(Reg::RSP));
+
+    assembler.mov(Operand::Register(GPR0), Operand::Mem64BaseAndOffset(CONTEXT, offsetof(NativeContext, stack_limit)));
+    assembler.cmp(Operand::Register(Reg::RSP), Operand::Register(GPR0));
+    assembler.jump_if(Assembler::Condition::UnsignedLessThan, compiler.m_stack_trap_label);
+
+    for (size_t i = 0; i < type.parameters().size(); ++i)
+        compiler.copy_slot(compiler.local(i), Operand::Mem64BaseAndOffset(ARG1, i * sizeof(u64)));
+    assembler.mov(Operand::Register(GPR0), Operand::Imm(0));
+    for (size_t i = type.parameters().size(); i < compiler.m_local_count; ++i)
+        assembler.mov(compiler.local(i), Operand::Register(GPR0));
+
+    compiler.reload_memory_registers();
+
+    // The function body behaves like a block, branching to it returns from the function.
+    ControlFrame function_frame;
+    function_frame.result_count = type.results().size();
+    compiler.m_control_stack.append(move(function_frame));
+
+    for (auto const& instruction : function.code().body().instructions()) {
+        if (!compiler.compile_instruction(instruction)) {
+            if constexpr (LOG_JIT_FAILURE)
+                dbgln("\033[31;1mJIT compilation failed\033[0m: Unsupported instruction {}", instruction_name(instruction.opcode()));
+            return nullptr;
+        }
+    }
+
+    if (compiler.m_control_stack.size() != 1)
+        return nullptr;
+    compiler.compile_end();
+
+    auto results = Operand::Register(GPR1);
+    assembler.mov(results, Operand::Register(RESULTS));
+    for (size_t i = 0; i < type.results().size(); ++i)
+        compiler.copy_slot(Operand::Mem64BaseAndOffset(GPR1, i * sizeof(u64)), compiler.stack_slot(i));
+    assembler.mov(Operand::Register(RET), Operand::Imm(to_underlying(NativeStatus::Success)));
+
+    compiler.m_exit_label.link(assembler);
+    assembler.mov(Operand::Register(Reg::RSP), Operand::Register(Reg::RBP));
+    assembler.sub(Operand::Register(Reg::RSP), Operand::Imm(callee_saved_registers_size));
+    assembler.exit();
+
+    auto emit_trap = [&](Assembler::Label& label, NativeStatus status) {
+        label.link(assembler);
+        assembler.mov(Operand::Register(RET), Operand::Imm(to_underlying(status)));
+        assembler.jump(compiler.m_exit_label);
+    };
+    emit_trap(compiler.m_unreachable_trap_label, NativeStatus::Unreachable);
+    emit_trap(compiler.m_memory_trap_label, NativeStatus::MemoryAccessOutOfBounds);
+    emit_trap(compiler.m_division_trap_label, NativeStatus::IntegerDivisionOverflow);
+    emit_trap(compiler.m_stack_trap_label, NativeStatus::StackExhausted);
+
+    // Keep the stack pointer 16-byte aligned for calls out of native code.
+    u64 frame_size = align_up_to((compiler.m_local_count + compiler.m_max_stack_height) * sizeof(u64), 16);
+    for (size_t i = 0; i < sizeof(u64); ++i)
+        compiler.m_output[frame_size_offset + i] = (frame_size >> (i * 8)) & 0xff;
+
+    auto* executable_memory = mmap(nullptr, compiler.m_output.size(), PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, 0, 0);
+    if (executable_memory == MAP_FAILED) {
+        dbgln("mmap: {}", strerror(errno));
+        return nullptr;
+    }
+
+    memcpy(executable_memory, compiler.m_output.data(), compiler.m_output.size());
+
+    if (mprotect(executable_memory, compiler.m_output.size(), PROT_READ | PROT_EXEC) < 0) {
+        dbgln("mprotect: {}", strerror(errno));
+        munmap(executable_memory, compiler.m_output.size());
+        return nullptr;
+    }
+
+    if constexpr (LOG_JIT_SUCCESS)
+        dbgln("\033[32;1mJIT compilation succeeded!\033[0m");
+
+    Optional<FixedArray<u8>> gdb_object;
+    if (getenv("LIBWASM_JIT_GDB")) {
+        auto const code = ReadonlyBytes { executable_memory, compiler.m_output.size() };
+        gdb_object = ::JIT::GDB::build_gdb_image(code, "LibWasm JIT"sv, "LibWasm JITted code"sv);
+    }
+
+    return make<NativeFunction>(executable_memory, compiler.m_output.size(), move(gdb_object));
+}
+
+}
+
+#endif
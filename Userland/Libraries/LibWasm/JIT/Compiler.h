@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/OwnPtr.h>
+#include <AK/Platform.h>
+#include <LibJIT/Assembler.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/JIT/NativeFunction.h>
+
+#ifdef JIT_ARCH_SUPPORTED
+
+namespace Wasm::JIT {
+
+using ::JIT::Assembler;
+
+// A single-pass baseline compiler: every local and operand stack slot lives at a fixed offset in the native frame,
+// and the instructions are translated one by one, in order. Functions using anything that isn't supported yet
+// (floating point arithmetic, vectors, references, tables, indirect calls...) are left to the interpreter.
+class Compiler {
+public:
+    static OwnPtr<NativeFunction> compile(Store&, WasmFunction const&);
+
+private:
+#    if ARCH(X86_64)
+    static constexpr auto GPR0 = Assembler::Reg::RAX;
+    static constexpr auto GPR1 = Assembler::Reg::RCX;
+    static constexpr auto GPR2 = Assembler::Reg::RDX;
+    static constexpr auto ARG0 = Assembler::Reg::RDI;
+    static constexpr auto ARG1 = Assembler::Reg::RSI;
+    static constexpr auto ARG2 = Assembler::Reg::RDX;
+    static constexpr auto ARG3 = Assembler::Reg::RCX;
+    static constexpr auto RET = Assembler::Reg::RAX;
+
+    // These are all callee-saved, so they survive calls out of native code.
+    static constexpr auto CONTEXT = Assembler::Reg::R15;
+    static constexpr auto SLOTS = Assembler::Reg::R14;
+    static constexpr auto RESULTS = Assembler::Reg::R13;
+    static constexpr auto MEMORY_SIZE = Assembler::Reg::R12;
+    static constexpr auto MEMORY_BASE = Assembler::Reg::RBX;
+#    endif
+
+    Compiler(Store& store, WasmFunction const& function)
+        : m_store(store)
+        , m_function(function)
+    {
+    }
+
+    struct ControlFrame {
+        enum class Kind {
+            Block,
+            Loop,
+            If,
+        };
+
+        Kind kind { Kind::Block };
+        // The operand stack height below the block's parameters.
+        size_t stack_height { 0 };
+        size_t parameter_count { 0 };
+        size_t result_count { 0 };
+        Assembler::Label loop_label;
+        Assembler::Label else_label;
+        Assembler::Label end_label;
+        bool has_else { false };
+
+        size_t branch_arity() const { return kind == Kind::Loop ? parameter_count : result_count; }
+        Assembler::Label& branch_target() { return kind == Kind::Loop ? loop_label : end_label; }
+    };
+
+    static bool is_supported(ValueType const&);
+    static bool is_supported(FunctionType const&);
+    Optional<FunctionType> block_type(BlockType const&) const;
+
+    bool compile_instruction(Instruction const&);
+    bool compile_block(Instruction const&, ControlFrame::Kind);
+    void compile_else();
+    void compile_end();
+    void compile_branch(LabelIndex);
+    bool compile_call(FunctionIndex);
+    bool compile_load(Instruction const&, size_t size, Assembler::Extension, bool is_64_bit);
+    bool compile_store(Instruction const&, size_t size);
+    void compile_compare(Assembler::Condition, bool sign_extend_i32);
+    void compile_division(bool is_64_bit, bool is_signed, bool is_remainder);
+    bool compile_global_get(GlobalIndex);
+    bool compile_global_set(GlobalIndex);
+
+    void compute_effective_address(Instruction::MemoryArgument const&, size_t size);
+    void reload_memory_registers();
+
+    Assembler::Operand local(size_t index) const;
+    Assembler::Operand stack_slot(size_t height) const;
+    void push(Assembler::Reg);
+    void pop(Assembler::Reg, Assembler::Extension = Assembler::Extension::ZeroExtend);
+    void copy_slot(Assembler::Operand destination, Assembler::Operand source);
+
+    Store& m_store;
+    WasmFunction const& m_function;
+
+    Vector<u8> m_output;
+    Assembler m_assembler { m_output };
+
+    Vector<ControlFrame> m_control_stack;
+    size_t m_local_count { 0 };
+    size_t m_stack_height { 0 };
+    size_t m_max_stack_height { 0 };
+    // Code following an unconditional branch can't run, so it's skipped until the end of the enclosing block.
+    bool m_is_unreachable { false };
+    size_t m_unreachable_depth { 0 };
+
+    Assembler::Label m_exit_label;
+    Assembler::Label m_unreachable_trap_label;
+    Assembler::Label m_memory_trap_label;
+    Assembler::Label m_division_trap_label;
+    Assembler::Label m_stack_trap_label;
+};
+
+}
+
+#else
+
+namespace Wasm::JIT {
+class Compiler {
+public:
+    static OwnPtr<NativeFunction> compile(Store&, WasmFunction const&) { return nullptr; }
+};
+}
+
+#endif
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/Types.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+
+namespace Wasm::JIT {
+
+// The state native code needs from the outside world, shared by all the native calls made for one module.
+// Native code reads the members directly, so this has to stay a standard-layout type.
+struct NativeContext {
+    u8* memory_base { nullptr };
+    u64 memory_size { 0 };
+    // Native code traps when the stack pointer goes below this.
+    FlatPtr stack_limit { 0 };
+
+    Configuration* configuration { nullptr };
+    Interpreter* interpreter { nullptr };
+    ModuleInstance const* module { nullptr };
+    MemoryInstance* memory { nullptr };
+    Optional<Result>* abrupt_result { nullptr };
+
+    // Must be called whenever the memory may have been resized, as that can move it.
+    void reload_memory()
+    {
+        if (!memory)
+            return;
+        memory_base = memory->data().data();
+        memory_size = memory->size();
+    }
+
+    static u64 raw_value(Value const& value)
+    {
+        if (value.type().kind() == ValueType::I32)
+            return static_cast<u32>(value.to<i32>().value());
+        return static_cast<u64>(value.to<i64>().value());
+    }
+};
+
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJIT/GDB.h>
+#include <LibWasm/AbstractMachine/Configuration.h>
+#include <LibWasm/Constants.h>
+#include <LibWasm/JIT/NativeContext.h>
+#include <LibWasm/JIT/NativeFunction.h>
+#include <sys/mman.h>
+
+namespace Wasm::JIT {
+
+NativeFunction::NativeFunction(void* code, size_t size, Optional<FixedArray<u8>> gdb_object)
+    : m_code(code)
+    , m_size(size)
+    , m_gdb_object(move(gdb_object))
+{
+    if (m_gdb_object.has_value())
+        ::JIT::GDB::register_into_gdb(m_gdb_object.value().span());
+}
+
+NativeFunction::~NativeFunction()
+{
+    if (m_gdb_object.has_value())
+        ::JIT::GDB::unregister_from_gdb(m_gdb_object.value().span());
+    munmap(m_code, m_size);
+}
+
+Result NativeFunction::call(Configuration& configuration, Interpreter& interpreter, WasmFunction const& function, Vector<Value>& arguments) const
+{
+    auto const& module = function.module();
+    Optional<Result> abrupt_result;
+    NativeContext context {
+        .stack_limit = configuration.jit_stack_info()->base() + Constants::minimum_stack_space_to_keep_free,
+        .configuration = &configuration,
+        .interpreter = &interpreter,
+        .module = &module,
+        .memory = module.memories().is_empty() ? nullptr : configuration.store().get(module.memories().first()),
+        .abrupt_result = &abrupt_result,
+    };
+    context.reload_memory();
+
+    Vector<u64, 8> raw_arguments;
+    raw_arguments.ensure_capacity(arguments.size());
+    for (auto const& argument : arguments)
+        raw_arguments.unchecked_append(NativeContext::raw_value(argument));
+
+    auto const& result_types = function.type().results();
+    Vector<u64, 4> raw_results;
+    raw_results.resize(result_types.size());
+
+    switch (entry()(&context, raw_arguments.data(), raw_results.data())) {
+    case NativeStatus::Success:
+        break;
+    case NativeStatus::Abrupt:
+        return abrupt_result.release_value();
+    case NativeStatus::Unreachable:
+        return Trap { "Unreachable" };
+    case NativeStatus::MemoryAccessOutOfBounds:
+        return Trap { "Memory access out of bounds" };
+    case NativeStatus::IntegerDivisionOverflow:
+        return Trap { "Integer division overflow" };
+    case NativeStatus::StackExhausted:
+        return Trap { "Call stack exhausted" };
+    }
+
+    // Results are handed out in reverse stack order, same as Configuration::execute() does.
+    Vector<Value> results;
+    results.ensure_capacity(result_types.size());
+    for (size_t i = result_types.size(); i > 0; --i)
+        results.unchecked_append(Value(result_types[i - 1], raw_results[i - 1]));
+    return Result { move(results) };
+}
+
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/FixedArray.h>
+#include <AK/Noncopyable.h>
+#include <AK/Optional.h>
+#include <AK/Types.h>
+#include <AK/Vector.h>
+#include <LibWasm/Forward.h>
+#include <LibWasm/Types.h>
+
+namespace Wasm {
+
+class Configuration;
+class Result;
+class Value;
+class WasmFunction;
+
+namespace JIT {
+
+// What native code returns to its caller; anything other than Success means the call did not complete normally.
+enum class NativeStatus : u64 {
+    Success = 0,
+    // The reason is stored in the context's abrupt result, as it came from outside the native code.
+    Abrupt,
+    Unreachable,
+    MemoryAccessOutOfBounds,
+    IntegerDivisionOverflow,
+    StackExhausted,
+};
+
+class NativeFunction {
+    AK_MAKE_NONCOPYABLE(NativeFunction);
+    AK_MAKE_NONMOVABLE(NativeFunction);
+
+public:
+    // The arguments and results are the raw bits of the values, in stack order.
+    using Entry = NativeStatus (*)(NativeContext*, u64 const* arguments, u64* results);
+
+    NativeFunction(void* code, size_t size, Optional<FixedArray<u8>> gdb_object = {});
+    ~NativeFunction();
+
+    Entry entry() const { return reinterpret_cast<Entry>(m_code); }
+
+    Result call(Configuration&, Interpreter&, WasmFunction const&, Vector<Value>& arguments) const;
+
+    ReadonlyBytes code_bytes() const { return { m_code, m_size }; }
+
+private:
+    void* m_code { nullptr };
+    size_t m_size { 0 };
+    Optional<FixedArray<u8>> m_gdb_object;
+};
+
+}
+
+}
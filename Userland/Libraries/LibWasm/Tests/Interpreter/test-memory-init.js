@@ -0,0 +1,81 @@
+// Builds a module with one page of memory and a passive data segment holding the bytes 1 to 8. "init" runs
+// memory.init on its three operands, and "load" reads back a single byte.
+
+const uleb = value => {
+    const bytes = [];
+    do {
+        let byte = value & 0x7f;
+        value >>>= 7;
+        if (value !== 0) byte |= 0x80;
+        bytes.push(byte);
+    } while (value !== 0);
+    return bytes;
+};
+
+const section = (id, contents) => [id, ...uleb(contents.length), ...contents];
+const vector = items => [...uleb(items.length), ...items.flat()];
+const name = string => vector([...string].map(c => c.charCodeAt(0)));
+
+function compile() {
+    const i32 = 0x7f;
+    const init = [0x20, 0x00, 0x20, 0x01, 0x20, 0x02, 0xfc, 0x08, 0x00, 0x00, 0x0b];
+    const load = [0x20, 0x00, 0x2d, 0x00, 0x00, 0x0b];
+    const bytes = [
+        0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,
+        ...section(1, vector([
+            [0x60, ...vector([i32, i32, i32]), ...vector([])],
+            [0x60, ...vector([i32]), ...vector([i32])],
+        ])),
+        ...section(3, vector([[0x00], [0x01]])),
+        ...section(5, vector([[0x00, 0x01]])),
+        ...section(7, vector([
+            [...name("init"), 0x00, 0x00],
+            [...name("load"), 0x00, 0x01],
+        ])),
+        ...section(12, uleb(1)),
+        ...section(10, vector([
+            [...uleb(init.length + 1), 0x00, ...init],
+            [...uleb(load.length + 1), 0x00, ...load],
+        ])),
+        ...section(11, vector([[0x01, ...vector([1, 2, 3, 4, 5, 6, 7, 8])]])),
+    ];
+
+    const module = parseWebAssemblyModule(new Uint8Array(bytes));
+    const initExport = module.getExport("init");
+    const loadExport = module.getExport("load");
+    return {
+        init: (destination, source, count) => module.invoke(initExport, destination, source, count),
+        load: address => module.invoke(loadExport, address),
+    };
+}
+
+test("copies the data segment into memory", () => {
+    const module = compile();
+    module.init(100, 2, 4);
+    expect([99, 100, 101, 102, 103, 104].map(module.load)).toEqual([0, 3, 4, 5, 6, 0]);
+    module.init(65528, 0, 8);
+    expect(module.load(65535)).toBe(8);
+});
+
+test("zero-length copies at the end of either range do not trap", () => {
+    const module = compile();
+    module.init(0, 8, 0);
+    module.init(65536, 0, 0);
+    expect(module.load(0)).toBe(0);
+});
+
+test("ranges outside the data segment trap", () => {
+    const module = compile();
+    expect(() => module.init(0, -4, 8)).toThrow();
+    expect(() => module.init(0, 4, -4)).toThrow();
+    expect(() => module.init(0, 1, 8)).toThrow();
+    expect(() => module.init(0, 9, 0)).toThrow();
+    expect(module.load(0)).toBe(0);
+});
+
+test("ranges outside memory trap", () => {
+    const module = compile();
+    expect(() => module.init(65529, 0, 8)).toThrow();
+    expect(() => module.init(-1, 0, 1)).toThrow();
+    expect(() => module.init(65537, 0, 0)).toThrow();
+});
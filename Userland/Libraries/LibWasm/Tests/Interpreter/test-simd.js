@@ -0,0 +1,284 @@
+// Builds a module around a single SIMD instruction: "run" takes every v128 operand as two i64 halves, applies the
+// instruction, and either returns its scalar result or stores the vector at address 0, where "load" reads it back.
+
+const valueTypes = { i32: 0x7f, i64: 0x7e, f32: 0x7d, f64: 0x7c };
+
+const uleb = value => {
+    const bytes = [];
+    do {
+        let byte = value & 0x7f;
+        value >>>= 7;
+        if (value !== 0) byte |= 0x80;
+        bytes.push(byte);
+    } while (value !== 0);
+    return bytes;
+};
+
+const section = (id, contents) => [id, ...uleb(contents.length), ...contents];
+const vector = items => [...uleb(items.length), ...items.flat()];
+const simd = (opcode, ...immediates) => [0xfd, ...uleb(opcode), ...immediates];
+
+const i64x2Splat = 0x12;
+const i64x2ReplaceLane = 0x1e;
+const v128Store = 0x0b;
+
+function compile(instruction, operands, { result = "v128", data = [] } = {}) {
+    const parameters = [];
+    const body = [];
+    if (result === "v128") body.push(0x41, 0x00);
+    for (const operand of operands) {
+        const index = parameters.length;
+        if (operand === "v128") {
+            parameters.push(valueTypes.i64, valueTypes.i64);
+            body.push(0x20, index, ...simd(i64x2Splat), 0x20, index + 1, ...simd(i64x2ReplaceLane, 1));
+        } else {
+            parameters.push(valueTypes[operand]);
+            body.push(0x20, index);
+        }
+    }
+    body.push(...instruction);
+    if (result === "v128") body.push(...simd(v128Store, 4, 0));
+    body.push(0x0b);
+
+    const results = result === "v128" || result === "none" ? [] : [valueTypes[result]];
+    const load = [0x20, 0x00, 0x29, 0x03, 0x00, 0x0b];
+    const bytes = [
+        0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,
+        ...section(1, vector([
+            [0x60, ...vector(parameters), ...vector(results)],
+            [0x60, 0x01, valueTypes.i32, 0x01, valueTypes.i64],
+        ])),
+        ...section(3, vector([[0x00], [0x01]])),
+        ...section(5, vector([[0x00, 0x01]])),
+        ...section(7, vector([
+            [...vector([..."run"].map(c => c.charCodeAt(0))), 0x00, 0x00],
+            [...vector([..."load"].map(c => c.charCodeAt(0))), 0x00, 0x01],
+        ])),
+        ...section(10, vector([
+            [...uleb(body.length + 1), 0x00, ...body],
+            [...uleb(load.length + 1), 0x00, ...load],
+        ])),
+        ...(data.length ? section(11, vector([[0x00, 0x41, 0x00, 0x0b, ...vector(data)]])) : []),
+    ];
+
+    const module = parseWebAssemblyModule(new Uint8Array(bytes));
+    const run = module.getExport("run");
+    const loadExport = module.getExport("load");
+    return {
+        run(...args) {
+            const flattened = args.flatMap(arg => (arg instanceof BigInt64Array ? [arg[0], arg[1]] : [arg]));
+            return module.invoke(run, ...flattened);
+        },
+        load(ArrayType, address = 0) {
+            const halves = new BigInt64Array([module.invoke(loadExport, address), module.invoke(loadExport, address + 8)]);
+            return Array.from(new ArrayType(halves.buffer));
+        },
+    };
+}
+
+const v128 = (ArrayType, lanes) => new BigInt64Array(new ArrayType(lanes).buffer);
+
+function binary(opcode, ArrayType, lhs, rhs, ResultType = ArrayType) {
+    const module = compile(simd(opcode), ["v128", "v128"]);
+    module.run(v128(ArrayType, lhs), v128(ArrayType, rhs));
+    return module.load(ResultType);
+}
+
+function unary(opcode, ArrayType, value, ResultType = ArrayType) {
+    const module = compile(simd(opcode), ["v128"]);
+    module.run(v128(ArrayType, value));
+    return module.load(ResultType);
+}
+
+function reduce(opcode, ArrayType, value) {
+    return compile(simd(opcode), ["v128"], { result: "i32" }).run(v128(ArrayType, value));
+}
+
+test("integer arithmetic wraps around", () => {
+    expect(binary(0x6e, Int8Array, [127, -128, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14], [1, -1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1]))
+        .toEqual([-128, 127, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15]);
+    expect(binary(0x91, Int16Array, [0, -32768, 5, 6, 7, 8, 9, 10], [1, 1, 1, 1, 1, 1, 1, 1])).toEqual([-1, 32767, 4, 5, 6, 7, 8, 9]);
+    expect(binary(0x95, Int16Array, [256, -3, 2, 3, 4, 5, 6, 7], [256, 7, 2, 3, 4, 5, 6, 7])).toEqual([0, -21, 4, 9, 16, 25, 36, 49]);
+    expect(binary(0xb5, Int32Array, [65536, -2, 3, 4], [65536, 3, -3, 4])).toEqual([0, -6, -9, 16]);
+    expect(binary(0xd5, BigInt64Array, [1n << 32n, -3n], [1n << 32n, 5n])).toEqual([0n, -15n]);
+    expect(binary(0xce, BigInt64Array, [-1n, 1n << 62n], [1n, 1n << 62n])).toEqual([0n, -(1n << 63n)]);
+});
+
+test("saturating arithmetic", () => {
+    const lhs = [127, -128, 100, -100, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0];
+    const rhs = [1, -1, 100, -100, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0];
+    expect(binary(0x6f, Int8Array, lhs, rhs).slice(0, 4)).toEqual([127, -128, 127, -128]);
+    expect(binary(0x70, Uint8Array, [250, 5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 200], [10, 5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 100]))
+        .toEqual([255, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 255]);
+    expect(binary(0x73, Uint8Array, [5, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0], [10, 5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1]))
+        .toEqual([0, 5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0]);
+    expect(binary(0x92, Int16Array, [-32768, 32767, 0, 0, 0, 0, 0, -5], [1, -1, 0, 0, 0, 0, 0, 5])).toEqual([-32768, 32767, 0, 0, 0, 0, 0, -10]);
+    expect(binary(0x90, Uint16Array, [65535, 1, 0, 0, 0, 0, 0, 0], [1, 1, 0, 0, 0, 0, 0, 0])).toEqual([65535, 2, 0, 0, 0, 0, 0, 0]);
+    expect(binary(0x82, Int16Array, [-32768, 16384, -16384, 0, 0, 0, 0, 0], [-32768, 16384, 16384, 0, 0, 0, 0, 0]))
+        .toEqual([32767, 8192, -8192, 0, 0, 0, 0, 0]);
+});
+
+test("comparisons produce lane masks", () => {
+    const lhs = [-1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0];
+    const rhs = [1, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0];
+    expect(binary(0x25, Int8Array, lhs, rhs).slice(0, 3)).toEqual([-1, 0, 0]);
+    expect(binary(0x26, Int8Array, lhs, rhs).slice(0, 3)).toEqual([0, -1, 0]);
+    expect(binary(0x2b, Int8Array, lhs, rhs).slice(0, 3)).toEqual([0, -1, -1]);
+    expect(binary(0x3e, Int32Array, [-1, 1, 2, 3], [1, -1, 2, 2])).toEqual([0, -1, -1, 0]);
+    expect(binary(0xd8, BigInt64Array, [-1n, 5n], [1n, 5n])).toEqual([-1n, 0n]);
+    expect(binary(0x43, Float32Array, [1, NaN, -0, 2], [2, 1, 0, 1], Int32Array)).toEqual([-1, 0, 0, 0]);
+    expect(binary(0x48, Float64Array, [NaN, 1], [NaN, 1], BigInt64Array)).toEqual([-1n, 0n]);
+});
+
+test("bitwise operations", () => {
+    const lhs = [0x0f0f0f0f, -1, 0, 0x12345678];
+    const rhs = [0x00ff00ff, 0x0000ffff, -1, 0];
+    expect(binary(0x4e, Int32Array, lhs, rhs)).toEqual([0x000f000f, 0x0000ffff, 0, 0]);
+    expect(binary(0x4f, Int32Array, lhs, rhs)).toEqual([0x0f000f00, -65536, 0, 0x12345678]);
+    expect(binary(0x50, Int32Array, lhs, rhs)).toEqual([0x0fff0fff, -1, -1, 0x12345678]);
+    expect(binary(0x51, Int32Array, lhs, rhs)).toEqual([0x0ff00ff0, -65536, -1, 0x12345678]);
+    expect(unary(0x4d, Int32Array, lhs)).toEqual([~0x0f0f0f0f, 0, -1, ~0x12345678]);
+
+    const module = compile(simd(0x52), ["v128", "v128", "v128"]);
+    module.run(v128(Int32Array, [-1, -1, 0, 0]), v128(Int32Array, [0, 0, -1, -1]), v128(Int32Array, [0xff, 0, 0xff, 0]));
+    expect(module.load(Int32Array)).toEqual([0xff, 0, -256, -1]);
+});
+
+test("integer minimum, maximum and average", () => {
+    const lhs = [-1, 1, 127, -128, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0];
+    const rhs = [1, -1, -128, 127, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0];
+    expect(binary(0x76, Int8Array, lhs, rhs).slice(0, 4)).toEqual([-1, -1, -128, -128]);
+    expect(binary(0x77, Int8Array, lhs, rhs).slice(0, 4)).toEqual([1, 1, 127, 127]);
+    expect(binary(0x78, Int8Array, lhs, rhs).slice(0, 4)).toEqual([1, 1, 127, 127]);
+    expect(binary(0x79, Int8Array, lhs, rhs).slice(0, 4)).toEqual([-1, -1, -128, -128]);
+    expect(binary(0xb7, Uint32Array, [1, 0xffffffff, 7, 8], [2, 0, 7, 9])).toEqual([1, 0, 7, 8]);
+    expect(binary(0x7b, Uint8Array, [255, 0, 1, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0], [255, 1, 2, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0]).slice(0, 4))
+        .toEqual([255, 1, 2, 2]);
+    expect(binary(0x9b, Uint16Array, [65535, 0, 0, 0, 0, 0, 0, 3], [65534, 1, 0, 0, 0, 0, 0, 4])).toEqual([65535, 1, 0, 0, 0, 0, 0, 4]);
+});
+
+test("integer unary operations", () => {
+    expect(unary(0x60, Int8Array, [-128, -1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0]).slice(0, 4)).toEqual([-128, 1, 1, 0]);
+    expect(unary(0xa1, Int32Array, [-2147483648, -1, 1, 0])).toEqual([-2147483648, 1, -1, 0]);
+    expect(unary(0xc0, BigInt64Array, [-(1n << 63n), -5n])).toEqual([-(1n << 63n), 5n]);
+    expect(unary(0x62, Uint8Array, [0, 1, 3, 255, 0x80, 0x55, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0]).slice(0, 6)).toEqual([0, 1, 2, 8, 1, 4]);
+});
+
+test("reductions into a scalar", () => {
+    expect(reduce(0x53, Int32Array, [0, 0, 0, 0])).toBe(0);
+    expect(reduce(0x53, Int32Array, [0, 0, 0, 0x100])).toBe(1);
+    expect(reduce(0x63, Int8Array, [1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1])).toBe(1);
+    expect(reduce(0x63, Int8Array, [1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0])).toBe(0);
+    expect(reduce(0xc3, BigInt64Array, [1n << 40n, 1n])).toBe(1);
+    expect(reduce(0x64, Int8Array, [-1, 0, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -128])).toBe(0x8005);
+    expect(reduce(0x84, Int16Array, [0, -1, 0, 0, 0, 0, 0, -1])).toBe(0x82);
+    expect(reduce(0xa4, Int32Array, [-1, 0, -1, 1])).toBe(0x5);
+    expect(reduce(0xc4, BigInt64Array, [1n, -1n])).toBe(0x2);
+});
+
+test("narrowing, widening and pairwise operations", () => {
+    expect(binary(0x65, Int16Array, [300, -300, 5, -5, 127, -128, 128, -129], [1, 2, 3, 4, 5, 6, 7, 8], Int8Array))
+        .toEqual([127, -128, 5, -5, 127, -128, 127, -128, 1, 2, 3, 4, 5, 6, 7, 8]);
+    expect(binary(0x86, Int32Array, [70000, -1, 65535, 3], [0, 1, 2, 3], Uint16Array)).toEqual([65535, 0, 65535, 3, 0, 1, 2, 3]);
+
+    const bytes = [-1, 2, -3, 4, -5, 6, -7, 8, -9, 10, -11, 12, -13, 14, -15, 16];
+    expect(unary(0x87, Int8Array, bytes, Int16Array)).toEqual([-1, 2, -3, 4, -5, 6, -7, 8]);
+    expect(unary(0x8a, Int8Array, bytes, Int16Array)).toEqual([247, 10, 245, 12, 243, 14, 241, 16]);
+    expect(unary(0xc8, Int32Array, [1, 2, -3, 4], BigInt64Array)).toEqual([-3n, 4n]);
+    expect(unary(0xc9, Int32Array, [-1, 2, 3, 4], BigInt64Array)).toEqual([0xffffffffn, 2n]);
+    expect(unary(0x7c, Int8Array, bytes, Int16Array)).toEqual([1, 1, 1, 1, 1, 1, 1, 1]);
+    expect(unary(0x7d, Int8Array, bytes, Int16Array)).toEqual([257, 257, 257, 257, 257, 257, 257, 257]);
+    expect(unary(0x7e, Int16Array, [-32768, -32768, 1, 2, 3, 4, -5, 5], Int32Array)).toEqual([-65536, 3, 7, 0]);
+    expect(unary(0x7f, Int16Array, [-1, -1, 1, 2, 3, 4, -5, 5], Int32Array)).toEqual([131070, 3, 7, 65536]);
+
+    expect(binary(0x9d, Int8Array, bytes, bytes, Int16Array)).toEqual([81, 100, 121, 144, 169, 196, 225, 256]);
+    expect(binary(0x9e, Int8Array, bytes, bytes, Int16Array)).toEqual([-511, 4, -1527, 16, -2535, 36, -3535, 64]);
+    expect(binary(0xdf, Int32Array, [0, 0, -1, 2], [0, 0, -1, 3], BigInt64Array)).toEqual([-8589934591n, 6n]);
+    expect(binary(0xba, Int16Array, [-32768, -32768, 1, 2, 3, 4, 5, 6], [-32768, -32768, 1, 2, 3, 4, 5, 6], Int32Array))
+        .toEqual([-2147483648, 5, 25, 61]);
+});
+
+test("floating point arithmetic", () => {
+    expect(binary(0xe4, Float32Array, [1.5, -1, 3e38, 0], [2.25, 1, 3e38, -0])).toEqual([3.75, 0, Infinity, 0]);
+    expect(binary(0xe7, Float32Array, [1, -1, 0, 6], [0, 0, 0, 4])).toEqual([Infinity, -Infinity, NaN, 1.5]);
+    expect(binary(0xf2, Float64Array, [1e300, -0.5], [1e10, 3])).toEqual([Infinity, -1.5]);
+    expect(unary(0xef, Float64Array, [2, -1])).toEqual([Math.SQRT2, NaN]);
+    expect(unary(0xe3, Float32Array, [4, 9, 0, -0])).toEqual([2, 3, 0, -0]);
+    expect(unary(0xe0, Float32Array, [-1, -0, NaN, 2])).toEqual([1, 0, NaN, 2]);
+    expect(unary(0xed, Float64Array, [0, -Infinity])).toEqual([-0, Infinity]);
+    expect(unary(0x67, Float32Array, [1.5, -1.5, -0.5, 2])).toEqual([2, -1, -0, 2]);
+    expect(unary(0x75, Float64Array, [1.5, -1.5])).toEqual([1, -2]);
+    expect(unary(0x69, Float32Array, [1.7, -1.7, 0.2, -0.2])).toEqual([1, -1, 0, -0]);
+    expect(unary(0x6a, Float32Array, [0.5, 1.5, 2.5, -0.5])).toEqual([0, 2, 2, -0]);
+});
+
+test("floating point minimum and maximum", () => {
+    const lhs = [-0, 0, NaN, 1];
+    const rhs = [0, -0, 1, 2];
+    expect(binary(0xe8, Float32Array, lhs, rhs)).toEqual([-0, -0, NaN, 1]);
+    expect(binary(0xe9, Float32Array, lhs, rhs)).toEqual([0, 0, NaN, 2]);
+    expect(binary(0xea, Float32Array, lhs, rhs)).toEqual([-0, 0, NaN, 1]);
+    expect(binary(0xeb, Float32Array, lhs, rhs)).toEqual([-0, 0, NaN, 2]);
+    expect(binary(0xf4, Float64Array, [1, -Infinity], [NaN, 0])).toEqual([NaN, -Infinity]);
+    expect(binary(0xf5, Float64Array, [-0, Infinity], [0, 0])).toEqual([0, Infinity]);
+});
+
+test("conversions", () => {
+    expect(unary(0xfa, Int32Array, [-1, 2, 16777217, 0], Float32Array)).toEqual([-1, 2, 16777216, 0]);
+    expect(unary(0xfb, Int32Array, [-1, 2, 0, 0], Float32Array)).toEqual([4294967296, 2, 0, 0]);
+    expect(unary(0xf8, Float32Array, [NaN, -Infinity, 3e9, -1.9], Int32Array)).toEqual([0, -2147483648, 2147483647, -1]);
+    expect(unary(0xf9, Float32Array, [NaN, -1, 5e9, 3e9], Uint32Array)).toEqual([0, 0, 4294967295, 3000000000]);
+    expect(unary(0xfc, Float64Array, [-3e10, 2.5], Int32Array)).toEqual([-2147483648, 2, 0, 0]);
+    expect(unary(0xfd, Float64Array, [4294967295.5, -0.5], Uint32Array)).toEqual([4294967295, 0, 0, 0]);
+    expect(unary(0xfe, Int32Array, [-1, 7, 100, 100], Float64Array)).toEqual([-1, 7]);
+    expect(unary(0xff, Int32Array, [-1, 7, 100, 100], Float64Array)).toEqual([4294967295, 7]);
+    expect(unary(0x5e, Float64Array, [1.5, 1e300], Float32Array)).toEqual([1.5, Infinity, 0, 0]);
+    expect(unary(0x5f, Float32Array, [1.5, -0, 7, 8], Float64Array)).toEqual([1.5, -0]);
+});
+
+test("shuffle and swizzle", () => {
+    const lanes = [0, 17, 2, 19, 4, 21, 6, 23, 31, 30, 29, 28, 3, 3, 3, 3];
+    const module = compile(simd(0x0d, ...lanes), ["v128", "v128"]);
+    const lhs = [...Array(16).keys()].map(i => i + 100);
+    const rhs = [...Array(16).keys()].map(i => i + 200);
+    module.run(v128(Uint8Array, lhs), v128(Uint8Array, rhs));
+    expect(module.load(Uint8Array)).toEqual([100, 201, 102, 203, 104, 205, 106, 207, 215, 214, 213, 212, 103, 103, 103, 103]);
+
+    expect(binary(0x0e, Uint8Array, lhs, [15, 0, 16, 255, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 128]))
+        .toEqual([115, 100, 0, 0, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 0]);
+});
+
+test("lane access", () => {
+    const bytes = v128(Int8Array, [-1, -2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, -16]);
+    expect(compile(simd(0x15, 15), ["v128"], { result: "i32" }).run(bytes)).toBe(-16);
+    expect(compile(simd(0x16, 15), ["v128"], { result: "i32" }).run(bytes)).toBe(240);
+    expect(compile(simd(0x19, 0), ["v128"], { result: "i32" }).run(bytes)).toBe(0xfeff);
+    expect(compile(simd(0x1d, 1), ["v128"], { result: "i64" }).run(v128(BigInt64Array, [1n, -2n]))).toBe(-2n);
+    expect(compile(simd(0x1f, 2), ["v128"], { result: "f32" }).run(v128(Float32Array, [1, 2, 3.5, 4]))).toBe(3.5);
+
+    const replace8 = compile(simd(0x17, 3), ["v128", "i32"]);
+    replace8.run(bytes, 0x1ff);
+    expect(replace8.load(Int8Array).slice(0, 5)).toEqual([-1, -2, 3, -1, 5]);
+
+    const replaceF64 = compile(simd(0x22, 1), ["v128", "f64"]);
+    replaceF64.run(v128(Float64Array, [1, 2]), -0.25);
+    expect(replaceF64.load(Float64Array)).toEqual([1, -0.25]);
+});
+
+test("lane loads and stores", () => {
+    const data = [0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88];
+    const loadLane = compile(simd(0x55, 1, 0, 5), ["i32", "v128"], { data });
+    loadLane.run(2, v128(Int16Array, [1, 2, 3, 4, 5, 6, 7, 8]));
+    expect(loadLane.load(Uint16Array)).toEqual([1, 2, 3, 4, 5, 0x4433, 7, 8]);
+    expect(() => loadLane.run(65535, v128(Int16Array, [1, 2, 3, 4, 5, 6, 7, 8]))).toThrow();
+
+    const loadZero = compile(simd(0x5c, 2, 4), ["i32"], { data });
+    loadZero.run(0);
+    expect(loadZero.load(Uint32Array)).toEqual([0x88776655, 0, 0, 0]);
+    expect(() => loadZero.run(65532)).toThrow();
+
+    const storeLane = compile(simd(0x5b, 0, 0, 1), ["i32", "v128"], { result: "none" });
+    storeLane.run(24, v128(BigInt64Array, [5n, -7n]));
+    expect(storeLane.load(BigInt64Array, 16)).toEqual([0n, -7n]);
+    expect(() => storeLane.run(65530, v128(BigInt64Array, [5n, -7n]))).toThrow();
+});
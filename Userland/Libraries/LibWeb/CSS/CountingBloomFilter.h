@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Assertions.h>
+#include <AK/NumericLimits.h>
+#include <AK/Types.h>
+
+namespace Web::CSS {
+
+// A bloom filter that supports removing keys again, by keeping a small counter per bucket instead of a single bit.
+// Each key is hashed into two buckets, taken from its low and high bits. Counters that saturate are never
+// decremented again, so the filter can only ever err on the side of "may contain".
+template<typename CounterType, size_t key_bits>
+class CountingBloomFilter {
+public:
+    static constexpr size_t bucket_count = 1 << key_bits;
+    static constexpr u32 key_mask = bucket_count - 1;
+
+    void clear()
+    {
+        __builtin_memset(m_buckets, 0, sizeof(m_buckets));
+    }
+
+    void increment(u32 key)
+    {
+        increment_bucket(first_bucket(key));
+        increment_bucket(second_bucket(key));
+    }
+
+    void decrement(u32 key)
+    {
+        decrement_bucket(first_bucket(key));
+        decrement_bucket(second_bucket(key));
+    }
+
+    [[nodiscard]] bool may_contain(u32 key) const
+    {
+        return first_bucket(key) != 0 && second_bucket(key) != 0;
+    }
+
+private:
+    CounterType& first_bucket(u32 key) { return m_buckets[key & key_mask]; }
+    CounterType& second_bucket(u32 key) { return m_buckets[(key >> 16) & key_mask]; }
+    CounterType first_bucket(u32 key) const { return m_buckets[key & key_mask]; }
+    CounterType second_bucket(u32 key) const { return m_buckets[(key >> 16) & key_mask]; }
+
+    static void increment_bucket(CounterType& bucket)
+    {
+        if (bucket < NumericLimits<CounterType>::max())
+            ++bucket;
+    }
+
+    static void decrement_bucket(CounterType& bucket)
+    {
+        VERIFY(bucket > 0);
+        if (bucket < NumericLimits<CounterType>::max())
+            --bucket;
+    }
+
+    CounterType m_buckets[bucket_count] {};
+};
+
+}
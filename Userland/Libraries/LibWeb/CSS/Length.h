@@ -79,6 +79,8 @@ public:
         CSSPixels cap_height;
         CSSPixels zero_advance;
         CSSPixels line_height;
+
+        bool operator==(FontMetrics const&) const = default;
     };
 
     static Optional<Type> unit_from_name(StringView);
@@ -23,6 +23,48 @@ Selector::Selector(Vector<CompoundSelector>&& compound_selectors)
             }
         }
     }
+
+    collect_ancestor_hashes();
+}
+
+void Selector::collect_ancestor_hashes()
+{
+    size_t next_hash_index = 0;
+    auto append_hash = [&](u32 hash) {
+        if (hash == 0 || next_hash_index >= m_ancestor_hashes.size())
+            return;
+        for (size_t i = 0; i < next_hash_index; ++i) {
+            if (m_ancestor_hashes[i] == hash)
+                return;
+        }
+        m_ancestor_hashes[next_hash_index++] = hash;
+    };
+
+    // A compound selector has to match an ancestor of the subject as soon as there is a descendant or child combinator
+    // somewhere to its right. Sibling combinators alone keep us on the subject's level, e.g. `.a > .b + .c` requires an
+    // ancestor with class "a", but nothing is known about the parent of `.b + .c`.
+    bool is_ancestor = false;
+    for (ssize_t compound_index = static_cast<ssize_t>(m_compound_selectors.size()) - 2; compound_index >= 0; --compound_index) {
+        auto combinator = m_compound_selectors[compound_index + 1].combinator;
+        if (combinator == Combinator::Descendant || combinator == Combinator::ImmediateChild)
+            is_ancestor = true;
+        if (!is_ancestor)
+            continue;
+
+        for (auto const& simple_selector : m_compound_selectors[compound_index].simple_selectors) {
+            switch (simple_selector.type) {
+            case SimpleSelector::Type::Id:
+            case SimpleSelector::Type::Class:
+                append_hash(simple_selector.name().hash());
+                break;
+            case SimpleSelector::Type::TagName:
+                append_hash(simple_selector.qualified_name().name.lowercase_name.hash());
+                break;
+            default:
+                break;
+            }
+        }
+    }
 }
 
 // https://www.w3.org/TR/selectors-4/#specificity-rules
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/FlyString.h>
 #include <AK/RefCounted.h>
 #include <AK/String.h>
@@ -241,12 +242,20 @@ public:
     u32 specificity() const;
     String serialize() const;
 
+    // Hashes of the ids, classes and tag names that some ancestor of the subject element must have for this
+    // selector to match. Unused entries are 0. StyleComputer checks these against its ancestor filter.
+    static constexpr size_t max_ancestor_hashes = 8;
+    Array<u32, max_ancestor_hashes> const& ancestor_hashes() const { return m_ancestor_hashes; }
+
 private:
     explicit Selector(Vector<CompoundSelector>&&);
 
+    void collect_ancestor_hashes();
+
     Vector<CompoundSelector> m_compound_selectors;
     mutable Optional<u32> m_specificity;
     Optional<Selector::PseudoElement> m_pseudo_element;
+    Array<u32, max_ancestor_hashes> m_ancestor_hashes {};
 };
 
 String serialize_a_group_of_selectors(Vector<NonnullRefPtr<Selector>> const& selectors);
@@ -6,7 +6,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/BinarySearch.h>
+#include <AK/CharacterTypes.h>
 #include <AK/Debug.h>
 #include <AK/Error.h>
 #include <AK/Find.h>
@@ -53,10 +55,15 @@
 #include <LibWeb/CSS/StyleValues/TransformationStyleValue.h>
 #include <LibWeb/CSS/StyleValues/UnresolvedStyleValue.h>
 #include <LibWeb/CSS/StyleValues/UnsetStyleValue.h>
+#include <LibWeb/DOM/Attr.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
+#include <LibWeb/DOM/NamedNodeMap.h>
+#include <LibWeb/DOM/ShadowRoot.h>
+#include <LibWeb/HTML/AttributeNames.h>
 #include <LibWeb/HTML/HTMLBRElement.h>
 #include <LibWeb/HTML/HTMLHtmlElement.h>
+#include <LibWeb/HTML/HTMLTableElement.h>
 #include <LibWeb/Layout/Node.h>
 #include <LibWeb/Loader/ResourceLoader.h>
 #include <LibWeb/Namespace.h>
@@ -283,23 +290,77 @@ StyleComputer::RuleCache const& StyleComputer::rule_cache_for_cascade_origin(Cas
     return true;
 }
 
+template<typename Callback>
+void StyleComputer::for_each_ancestor_filter_hash(DOM::Element const& element, Callback callback)
+{
+    callback(element.local_name().hash());
+    // Outside of HTML documents, tag names match case-insensitively, and selectors only hash their lowercase name.
+    if (element.document().document_type() != DOM::Document::Type::HTML) {
+        auto lowercase_name = FlyString(MUST(element.local_name().to_string().to_lowercase()));
+        if (lowercase_name != element.local_name())
+            callback(lowercase_name.hash());
+    }
+    if (auto id = element.id(); id.has_value())
+        callback(id->hash());
+    for (auto const& class_name : element.class_names())
+        callback(class_name.hash());
+}
+
+void StyleComputer::push_ancestor(DOM::Element const& element)
+{
+    m_ancestor_filter_elements.append(&element);
+    for_each_ancestor_filter_hash(element, [&](u32 hash) {
+        m_ancestor_filter.increment(hash);
+    });
+}
+
+void StyleComputer::pop_ancestor(DOM::Element const& element)
+{
+    VERIFY(!m_ancestor_filter_elements.is_empty() && m_ancestor_filter_elements.last() == &element);
+    m_ancestor_filter_elements.take_last();
+    for_each_ancestor_filter_hash(element, [&](u32 hash) {
+        m_ancestor_filter.decrement(hash);
+    });
+}
+
+// The filter describes the ancestors of an element only if every one of them has been pushed, which is the case
+// during a style update for the children of the innermost pushed element (and trivially for parentless elements).
+bool StyleComputer::can_use_ancestor_filter_for(DOM::Element const& element) const
+{
+    auto const* innermost_ancestor = m_ancestor_filter_elements.is_empty() ? nullptr : m_ancestor_filter_elements.last();
+    return element.parent_element() == innermost_ancestor;
+}
+
+bool StyleComputer::should_reject_with_ancestor_filter(Selector const& selector) const
+{
+    for (u32 hash : selector.ancestor_hashes()) {
+        if (hash == 0)
+            break;
+        if (!m_ancestor_filter.may_contain(hash))
+            return true;
+    }
+    return false;
+}
+
 Vector<MatchingRule> StyleComputer::collect_matching_rules(DOM::Element const& element, CascadeOrigin cascade_origin, Optional<CSS::Selector::PseudoElement::Type> pseudo_element) const
 {
     auto const& rule_cache = rule_cache_for_cascade_origin(cascade_origin);
+    bool const can_use_ancestor_filter = can_use_ancestor_filter_for(element);
 
     Vector<MatchingRule> rules_to_run;
     auto add_rules_to_run = [&](Vector<MatchingRule> const& rules) {
         rules_to_run.grow_capacity(rules_to_run.size() + rules.size());
-        if (pseudo_element.has_value()) {
-            for (auto const& rule : rules) {
-                if (rule.contains_pseudo_element && filter_namespace_rule(element, rule))
-                    rules_to_run.append(rule);
-            }
-        } else {
-            for (auto const& rule : rules) {
-                if (filter_namespace_rule(element, rule))
-                    rules_to_run.append(rule);
+        m_style_computation_statistics.rules_considered += rules.size();
+        for (auto const& rule : rules) {
+            if (pseudo_element.has_value() && !rule.contains_pseudo_element)
+                continue;
+            if (!filter_namespace_rule(element, rule))
+                continue;
+            if (can_use_ancestor_filter && should_reject_with_ancestor_filter(*rule.rule->selectors()[rule.selector_index])) {
+                ++m_style_computation_statistics.rules_rejected_by_ancestor_filter;
+                continue;
             }
+            rules_to_run.append(rule);
         }
     };
 
@@ -322,6 +383,7 @@ Vector<MatchingRule> StyleComputer::collect_matching_rules(DOM::Element const& e
         if (SelectorEngine::matches(selector, *rule_to_run.sheet, element, pseudo_element))
             matching_rules.append(rule_to_run);
     }
+    m_style_computation_statistics.rules_matched += matching_rules.size();
     return matching_rules;
 }
 
@@ -2134,6 +2196,11 @@ ErrorOr<RefPtr<StyleProperties>> StyleComputer::compute_style_impl(DOM::Element&
         return style;
     }
 
+    if (!pseudo_element.has_value() && mode == ComputeStyleMode::Normal) {
+        if (auto shared_style = find_style_to_share(element))
+            return shared_style;
+    }
+
     auto style = StyleProperties::create();
     // 1. Perform the cascade. This produces the "specified style"
     bool did_match_any_pseudo_element_rules = false;
@@ -2162,7 +2229,7 @@ ErrorOr<RefPtr<StyleProperties>> StyleComputer::compute_style_impl(DOM::Element&
 
 void StyleComputer::build_rule_cache_if_needed() const
 {
-    if (m_author_rule_cache && m_user_rule_cache && m_user_agent_rule_cache)
+    if (m_author_rule_cache && m_user_rule_cache && m_user_agent_rule_cache && m_style_invalidation_data && m_style_sharing_data)
         return;
     const_cast<StyleComputer&>(*this).build_rule_cache();
 }
@@ -2339,6 +2406,356 @@ void StyleComputer::build_rule_cache()
     m_author_rule_cache = make_rule_cache_for_cascade_origin(CascadeOrigin::Author);
     m_user_rule_cache = make_rule_cache_for_cascade_origin(CascadeOrigin::User);
     m_user_agent_rule_cache = make_rule_cache_for_cascade_origin(CascadeOrigin::UserAgent);
+    m_style_invalidation_data = make_style_invalidation_data();
+    m_style_sharing_data = make_style_sharing_data();
+}
+
+// Attributes that pseudo-classes depend on, not only on the element itself but on all of its ancestors.
+static Optional<FlyString> attribute_affecting_descendants_through_pseudo_class(PseudoClass pseudo_class)
+{
+    switch (pseudo_class) {
+    case PseudoClass::Dir:
+        return HTML::AttributeNames::dir;
+    case PseudoClass::Lang:
+        return HTML::AttributeNames::lang;
+    case PseudoClass::Disabled:
+    case PseudoClass::Enabled:
+        return HTML::AttributeNames::disabled;
+    case PseudoClass::ReadOnly:
+    case PseudoClass::ReadWrite:
+        return HTML::AttributeNames::contenteditable;
+    default:
+        return {};
+    }
+}
+
+static bool pseudo_class_depends_on_attributes(PseudoClass pseudo_class)
+{
+    switch (pseudo_class) {
+    case PseudoClass::Active:
+    case PseudoClass::Empty:
+    case PseudoClass::FirstChild:
+    case PseudoClass::FirstOfType:
+    case PseudoClass::Focus:
+    case PseudoClass::FocusVisible:
+    case PseudoClass::FocusWithin:
+    case PseudoClass::Host:
+    case PseudoClass::Hover:
+    case PseudoClass::Is:
+    case PseudoClass::LastChild:
+    case PseudoClass::LastOfType:
+    case PseudoClass::Not:
+    case PseudoClass::NthChild:
+    case PseudoClass::NthLastChild:
+    case PseudoClass::NthLastOfType:
+    case PseudoClass::NthOfType:
+    case PseudoClass::OnlyChild:
+    case PseudoClass::OnlyOfType:
+    case PseudoClass::Root:
+    case PseudoClass::Scope:
+    case PseudoClass::Target:
+    case PseudoClass::TargetWithin:
+    case PseudoClass::Where:
+        return false;
+    default:
+        return true;
+    }
+}
+
+void StyleComputer::StyleInvalidationData::collect_from_selector(Selector const& selector, StyleInvalidationScope extra_scope)
+{
+    auto const& compound_selectors = selector.compound_selectors();
+    for (size_t i = 0; i < compound_selectors.size(); ++i) {
+        // Whatever the compound selector matches relates to the subject through the combinator right after it.
+        auto scope = extra_scope;
+        if (i == compound_selectors.size() - 1) {
+            scope |= StyleInvalidationScope::Self;
+        } else {
+            switch (compound_selectors[i + 1].combinator) {
+            case Selector::Combinator::Descendant:
+            case Selector::Combinator::ImmediateChild:
+                scope |= StyleInvalidationScope::Descendants;
+                break;
+            case Selector::Combinator::NextSibling:
+            case Selector::Combinator::SubsequentSibling:
+                scope |= StyleInvalidationScope::Siblings;
+                break;
+            case Selector::Combinator::None:
+            case Selector::Combinator::Column:
+                scope |= StyleInvalidationScope::Descendants | StyleInvalidationScope::Siblings;
+                break;
+            }
+        }
+
+        for (auto const& simple_selector : compound_selectors[i].simple_selectors) {
+            switch (simple_selector.type) {
+            case Selector::SimpleSelector::Type::Id:
+                ids.ensure(simple_selector.name()) |= scope;
+                break;
+            case Selector::SimpleSelector::Type::Class:
+                classes.ensure(simple_selector.name()) |= scope;
+                break;
+            case Selector::SimpleSelector::Type::Attribute:
+                attribute_names.ensure(simple_selector.attribute().qualified_name.name.lowercase_name) |= scope;
+                break;
+            case Selector::SimpleSelector::Type::PseudoClass: {
+                auto const& pseudo_class = simple_selector.pseudo_class();
+                if (auto attribute_name = attribute_affecting_descendants_through_pseudo_class(pseudo_class.type); attribute_name.has_value())
+                    attribute_names.ensure(*attribute_name) |= scope | StyleInvalidationScope::Descendants;
+                if (pseudo_class_depends_on_attributes(pseudo_class.type))
+                    any_attribute |= scope;
+                // Selectors in arguments, like in :is() or :nth-child(An+B of S), can relate to the subject in ways we don't track.
+                for (auto const& argument_selector : pseudo_class.argument_selector_list)
+                    collect_from_selector(*argument_selector, scope | StyleInvalidationScope::Self | StyleInvalidationScope::Descendants | StyleInvalidationScope::Siblings);
+                break;
+            }
+            default:
+                break;
+            }
+        }
+    }
+}
+
+NonnullOwnPtr<StyleComputer::StyleInvalidationData> StyleComputer::make_style_invalidation_data() const
+{
+    auto data = make<StyleInvalidationData>();
+    for (auto cascade_origin : { CascadeOrigin::UserAgent, CascadeOrigin::User, CascadeOrigin::Author }) {
+        for_each_stylesheet(cascade_origin, [&](auto& sheet) {
+            sheet.for_each_effective_style_rule([&](auto const& rule) {
+                for (auto const& selector : rule.selectors())
+                    data->collect_from_selector(*selector);
+            });
+        });
+    }
+    return data;
+}
+
+StyleInvalidationScope StyleComputer::invalidation_scope_for_class(FlyString const& class_name) const
+{
+    build_rule_cache_if_needed();
+    return m_style_invalidation_data->classes.get(class_name).value_or(StyleInvalidationScope::None);
+}
+
+StyleInvalidationScope StyleComputer::invalidation_scope_for_id(FlyString const& id) const
+{
+    build_rule_cache_if_needed();
+    return m_style_invalidation_data->ids.get(id).value_or(StyleInvalidationScope::None);
+}
+
+StyleInvalidationScope StyleComputer::invalidation_scope_for_attribute(FlyString const& attribute_name) const
+{
+    build_rule_cache_if_needed();
+    auto scope = m_style_invalidation_data->any_attribute;
+    // Attribute selectors are stored by their lowercase name, which they match case-insensitively against.
+    if (any_of(attribute_name.bytes_as_string_view(), is_ascii_upper_alpha))
+        scope |= m_style_invalidation_data->attribute_names.get(FlyString(MUST(attribute_name.to_string().to_lowercase()))).value_or(StyleInvalidationScope::None);
+    else
+        scope |= m_style_invalidation_data->attribute_names.get(attribute_name).value_or(StyleInvalidationScope::None);
+    return scope;
+}
+
+enum class StyleSharingHazard {
+    None,
+    InteractionState,
+    Other,
+};
+
+static StyleSharingHazard style_sharing_hazard_of_selector(Selector const&);
+
+static StyleSharingHazard style_sharing_hazard_of_compound_selector(Selector::CompoundSelector const& compound_selector)
+{
+    auto hazard = StyleSharingHazard::None;
+    for (auto const& simple_selector : compound_selector.simple_selectors) {
+        if (simple_selector.type != Selector::SimpleSelector::Type::PseudoClass)
+            continue;
+        auto const& pseudo_class = simple_selector.pseudo_class();
+        switch (pseudo_class.type) {
+        // These only depend on the attributes and ancestors of the element, which siblings sharing a style have in common.
+        case PseudoClass::AnyLink:
+        case PseudoClass::Lang:
+        case PseudoClass::Link:
+        case PseudoClass::LocalLink:
+        case PseudoClass::Visited:
+        // These only match the root element, which has no siblings.
+        case PseudoClass::Root:
+        case PseudoClass::Scope:
+            break;
+        case PseudoClass::Is:
+        case PseudoClass::Not:
+        case PseudoClass::Where:
+            for (auto const& argument_selector : pseudo_class.argument_selector_list)
+                hazard = max(hazard, style_sharing_hazard_of_selector(*argument_selector));
+            break;
+        case PseudoClass::Active:
+        case PseudoClass::Focus:
+        case PseudoClass::FocusVisible:
+        case PseudoClass::FocusWithin:
+        case PseudoClass::Hover:
+        case PseudoClass::Target:
+        case PseudoClass::TargetWithin:
+            hazard = max(hazard, StyleSharingHazard::InteractionState);
+            break;
+        default:
+            return StyleSharingHazard::Other;
+        }
+    }
+    return hazard;
+}
+
+static StyleSharingHazard style_sharing_hazard_of_selector(Selector const& selector)
+{
+    // Compound selectors left of the subject match its ancestors, or its siblings and their ancestors.
+    auto const& subject = selector.compound_selectors().last();
+    if (subject.combinator == Selector::Combinator::NextSibling || subject.combinator == Selector::Combinator::SubsequentSibling)
+        return StyleSharingHazard::Other;
+    return style_sharing_hazard_of_compound_selector(subject);
+}
+
+void StyleComputer::StyleSharingData::collect_from_selector(Selector const& selector)
+{
+    // Rules for pseudo-elements don't affect the style of the element itself.
+    if (selector.pseudo_element().has_value())
+        return;
+
+    auto hazard = style_sharing_hazard_of_selector(selector);
+    if (hazard == StyleSharingHazard::None)
+        return;
+
+    // Only elements matching the most specific part of the subject can be affected, so that's all we need to exclude.
+    Optional<FlyString> class_name;
+    Optional<FlyString> tag_name;
+    Optional<FlyString> attribute_name;
+    for (auto const& simple_selector : selector.compound_selectors().last().simple_selectors) {
+        switch (simple_selector.type) {
+        case Selector::SimpleSelector::Type::Id:
+            ids.set(simple_selector.name());
+            return;
+        case Selector::SimpleSelector::Type::Class:
+            if (!class_name.has_value())
+                class_name = simple_selector.name();
+            break;
+        case Selector::SimpleSelector::Type::TagName:
+            tag_name = simple_selector.qualified_name().name.lowercase_name;
+            break;
+        case Selector::SimpleSelector::Type::Attribute:
+            if (!attribute_name.has_value())
+                attribute_name = simple_selector.attribute().qualified_name.name.lowercase_name;
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (class_name.has_value())
+        classes.set(class_name.release_value());
+    else if (tag_name.has_value())
+        tag_names.set(tag_name.release_value());
+    else if (attribute_name.has_value())
+        attribute_names.set(attribute_name.release_value());
+    else if (hazard == StyleSharingHazard::InteractionState)
+        depends_on_interaction_state = true;
+    else
+        is_sharing_disabled = true;
+}
+
+NonnullOwnPtr<StyleComputer::StyleSharingData> StyleComputer::make_style_sharing_data() const
+{
+    auto data = make<StyleSharingData>();
+    for (auto cascade_origin : { CascadeOrigin::UserAgent, CascadeOrigin::User, CascadeOrigin::Author }) {
+        for_each_stylesheet(cascade_origin, [&](auto& sheet) {
+            sheet.for_each_effective_style_rule([&](auto const& rule) {
+                for (auto const& selector : rule.selectors())
+                    data->collect_from_selector(*selector);
+            });
+        });
+    }
+    return data;
+}
+
+bool StyleComputer::can_share_style(DOM::Element const& element) const
+{
+    // SVG elements and tables adjust their style based on more than their attributes, and shadow hosts are styled by :host rules.
+    if (element.is_svg_element() || is<HTML::HTMLTableElement>(element) || element.shadow_root())
+        return false;
+    // Declarations in the style attribute may have been modified through CSSOM since it was parsed.
+    if (element.has_attribute(HTML::AttributeNames::style))
+        return false;
+
+    auto const& data = *m_style_sharing_data;
+    if (element.id().has_value() && data.ids.contains(*element.id()))
+        return false;
+    for (auto const& class_name : element.class_names()) {
+        if (data.classes.contains(class_name))
+            return false;
+    }
+    if (data.tag_names.contains(element.local_name()))
+        return false;
+    if (!data.attribute_names.is_empty()) {
+        for (u32 i = 0; i < element.attributes()->length(); ++i) {
+            if (data.attribute_names.contains(element.attributes()->item(i)->local_name()))
+                return false;
+        }
+    }
+
+    if (data.depends_on_interaction_state) {
+        auto const& document = element.document();
+        for (DOM::Node const* node : { document.hovered_node(), static_cast<DOM::Node const*>(document.focused_element()), static_cast<DOM::Node const*>(document.active_element()), static_cast<DOM::Node const*>(document.target_element()) }) {
+            if (node && element.is_inclusive_ancestor_of(*node))
+                return false;
+        }
+    }
+    return true;
+}
+
+static bool have_same_attributes(DOM::Element const& element, DOM::Element const& other)
+{
+    auto const& attributes = *element.attributes();
+    auto const& other_attributes = *other.attributes();
+    if (attributes.length() != other_attributes.length())
+        return false;
+    for (u32 i = 0; i < attributes.length(); ++i) {
+        auto const& attribute = *attributes.item(i);
+        auto const& other_attribute = *other_attributes.item(i);
+        if (attribute.local_name() != other_attribute.local_name() || attribute.namespace_uri() != other_attribute.namespace_uri() || attribute.value() != other_attribute.value())
+            return false;
+    }
+    return true;
+}
+
+static bool has_animations(StyleProperties const& style)
+{
+    auto animation_name = style.maybe_null_property(PropertyID::AnimationName);
+    return animation_name && !(animation_name->is_identifier() && animation_name->to_identifier() == ValueID::None);
+}
+
+// Siblings with the same tag name and attributes usually match exactly the same rules, and inherit from the same parent,
+// so instead of running the cascade again we can reuse the style one of them already computed during this style update.
+RefPtr<StyleProperties> StyleComputer::find_style_to_share(DOM::Element& element) const
+{
+    // Unless we're walking the tree, the style of the siblings may be stale.
+    if (m_style_sharing_data->is_sharing_disabled || !element.parent_element() || !can_use_ancestor_filter_for(element))
+        return nullptr;
+    if (!can_share_style(element))
+        return nullptr;
+
+    size_t candidate_count = 0;
+    for (auto* candidate = element.previous_element_sibling(); candidate && candidate_count < max_style_sharing_candidates; candidate = candidate->previous_element_sibling(), ++candidate_count) {
+        auto* candidate_style = candidate->computed_css_values();
+        if (!candidate_style || candidate->needs_style_update())
+            continue;
+        if (candidate->local_name() != element.local_name() || candidate->namespace_uri() != element.namespace_uri())
+            continue;
+        if (!have_same_attributes(element, *candidate) || !can_share_style(*candidate))
+            continue;
+        // Animations are tracked per element, and modify the style they apply to.
+        if (has_animations(*candidate_style))
+            continue;
+
+        element.set_custom_properties({}, candidate->custom_properties({}));
+        ++m_style_computation_statistics.styles_shared;
+        return candidate_style;
+    }
+    return nullptr;
 }
 
 void StyleComputer::invalidate_rule_cache()
@@ -2354,6 +2771,9 @@ void StyleComputer::invalidate_rule_cache()
     // NOTE: It might not be necessary to throw away the UA rule cache.
     //       If we are sure that it's safe, we could keep it as an optimization.
     m_user_agent_rule_cache = nullptr;
+
+    m_style_invalidation_data = nullptr;
+    m_style_sharing_data = nullptr;
 }
 
 CSSPixelRect StyleComputer::viewport_rect() const
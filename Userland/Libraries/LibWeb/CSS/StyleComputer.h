@@ -7,13 +7,16 @@
 
 #pragma once
 
+#include <AK/EnumBits.h>
 #include <AK/HashMap.h>
+#include <AK/HashTable.h>
 #include <AK/Optional.h>
 #include <AK/OwnPtr.h>
 #include <AK/RedBlackTree.h>
 #include <LibWeb/CSS/CSSFontFaceRule.h>
 #include <LibWeb/CSS/CSSKeyframesRule.h>
 #include <LibWeb/CSS/CSSStyleDeclaration.h>
+#include <LibWeb/CSS/CountingBloomFilter.h>
 #include <LibWeb/CSS/Selector.h>
 #include <LibWeb/CSS/StyleProperties.h>
 #include <LibWeb/Forward.h>
@@ -30,6 +33,16 @@ struct MatchingRule {
     bool contains_pseudo_element { false };
 };
 
+// Which elements may need their style recomputed after a class, id or attribute of an element changed.
+enum class StyleInvalidationScope : u8 {
+    None = 0,
+    Self = 1 << 0,
+    Descendants = 1 << 1,
+    // Subsequent siblings, and their descendants.
+    Siblings = 1 << 2,
+};
+AK_ENUM_BITWISE_OPERATORS(StyleInvalidationScope);
+
 struct FontFaceKey {
     FlyString family_name;
     int weight { 0 };
@@ -49,6 +62,9 @@ public:
 
     NonnullRefPtr<StyleProperties> create_document_style() const;
 
+    // Updated whenever the style of the root element is computed. Root-relative lengths like rem resolve against these.
+    Length::FontMetrics const& root_element_font_metrics() const { return m_root_element_font_metrics; }
+
     ErrorOr<NonnullRefPtr<StyleProperties>> compute_style(DOM::Element&, Optional<CSS::Selector::PseudoElement::Type> = {}) const;
     ErrorOr<RefPtr<StyleProperties>> compute_pseudo_element_style_if_needed(DOM::Element&, Optional<CSS::Selector::PseudoElement::Type>) const;
 
@@ -65,6 +81,26 @@ public:
 
     void invalidate_rule_cache();
 
+    // Based on the selectors of all style rules, these tell which elements need to be restyled when the given
+    // class, id or attribute is added to or removed from an element.
+    StyleInvalidationScope invalidation_scope_for_class(FlyString const&) const;
+    StyleInvalidationScope invalidation_scope_for_id(FlyString const&) const;
+    StyleInvalidationScope invalidation_scope_for_attribute(FlyString const&) const;
+
+    // While the style of a subtree is being recomputed, the elements on the path down to it are kept in a bloom filter,
+    // which lets us reject most rules with descendant combinators without walking up the ancestor chain.
+    void push_ancestor(DOM::Element const&);
+    void pop_ancestor(DOM::Element const&);
+
+    struct StyleComputationStatistics {
+        size_t rules_considered { 0 };
+        size_t rules_rejected_by_ancestor_filter { 0 };
+        size_t rules_matched { 0 };
+        size_t styles_shared { 0 };
+    };
+    StyleComputationStatistics const& style_computation_statistics() const { return m_style_computation_statistics; }
+    void reset_style_computation_statistics() { m_style_computation_statistics = {}; }
+
     Gfx::Font const& initial_font() const;
 
     void did_load_font(FlyString const& family_name);
@@ -151,6 +187,11 @@ private:
     void build_rule_cache();
     void build_rule_cache_if_needed() const;
 
+    bool can_use_ancestor_filter_for(DOM::Element const&) const;
+    bool should_reject_with_ancestor_filter(Selector const&) const;
+    template<typename Callback>
+    static void for_each_ancestor_filter_hash(DOM::Element const&, Callback);
+
     JS::NonnullGCPtr<DOM::Document> m_document;
 
     struct AnimationKeyFrameSet {
@@ -172,6 +213,39 @@ private:
 
     NonnullOwnPtr<RuleCache> make_rule_cache_for_cascade_origin(CascadeOrigin);
 
+    struct StyleInvalidationData {
+        HashMap<FlyString, StyleInvalidationScope> ids;
+        HashMap<FlyString, StyleInvalidationScope> classes;
+        HashMap<FlyString, StyleInvalidationScope> attribute_names;
+        // Pseudo-classes like :checked or :link depend on attributes we don't track individually.
+        StyleInvalidationScope any_attribute { StyleInvalidationScope::None };
+
+        void collect_from_selector(Selector const&, StyleInvalidationScope extra_scope = StyleInvalidationScope::None);
+    };
+
+    NonnullOwnPtr<StyleInvalidationData> make_style_invalidation_data() const;
+
+    // Elements that a selector could tell apart from an otherwise identical sibling, because it depends on their
+    // position among their siblings or on their interaction state. Such elements never share their style.
+    struct StyleSharingData {
+        HashTable<FlyString, ASCIICaseInsensitiveFlyStringTraits> ids;
+        HashTable<FlyString, ASCIICaseInsensitiveFlyStringTraits> classes;
+        HashTable<FlyString, ASCIICaseInsensitiveFlyStringTraits> tag_names;
+        HashTable<FlyString, ASCIICaseInsensitiveFlyStringTraits> attribute_names;
+        // Set by selectors like a bare :hover, which can apply to any element containing the hovered, focused, active or target element.
+        bool depends_on_interaction_state { false };
+        // Set by selectors like a bare :first-child, which can apply to any element.
+        bool is_sharing_disabled { false };
+
+        void collect_from_selector(Selector const&);
+    };
+
+    NonnullOwnPtr<StyleSharingData> make_style_sharing_data() const;
+
+    static constexpr size_t max_style_sharing_candidates = 8;
+    RefPtr<StyleProperties> find_style_to_share(DOM::Element&) const;
+    bool can_share_style(DOM::Element const&) const;
+
     RuleCache const& rule_cache_for_cascade_origin(CascadeOrigin) const;
 
     void ensure_animation_timer() const;
@@ -179,8 +253,14 @@ private:
     OwnPtr<RuleCache> m_author_rule_cache;
     OwnPtr<RuleCache> m_user_rule_cache;
     OwnPtr<RuleCache> m_user_agent_rule_cache;
+    OwnPtr<StyleInvalidationData> m_style_invalidation_data;
+    OwnPtr<StyleSharingData> m_style_sharing_data;
     JS::Handle<CSSStyleSheet> m_user_style_sheet;
 
+    CountingBloomFilter<u8, 14> m_ancestor_filter;
+    Vector<DOM::Element const*> m_ancestor_filter_elements;
+    mutable StyleComputationStatistics m_style_computation_statistics;
+
     using FontLoaderList = Vector<NonnullOwnPtr<FontLoader>>;
     HashMap<FontFaceKey, FontLoaderList> m_loaded_fonts;
 
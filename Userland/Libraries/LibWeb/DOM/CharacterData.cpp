@@ -124,7 +124,10 @@ WebIDL::ExceptionOr<void> CharacterData::replace_data(size_t offset, size_t coun
         static_cast<Layout::TextNode&>(*layout_node).invalidate_text_for_rendering();
 
     set_needs_style_update(true);
-    document().set_needs_layout();
+    // Whether our parent matches :empty depends on whether our data is empty.
+    if (auto* parent_element = this->parent_element())
+        parent_element->set_needs_style_update(true);
+    document().set_needs_layout(*this);
     return {};
 }
 
@@ -951,6 +951,25 @@ AK::URL Document::parse_url(StringView url) const
 }
 
 void Document::set_needs_layout()
+{
+    m_needs_full_layout = true;
+    set_needs_partial_layout();
+}
+
+void Document::set_needs_layout(Node& node)
+{
+    auto* layout_node = node.layout_node();
+    if (!layout_node) {
+        set_needs_layout();
+        return;
+    }
+    layout_node->set_needs_layout_update();
+    set_needs_partial_layout();
+}
+
+// Only the layout nodes marked with Layout::Node::set_needs_layout_update() will be laid out again, along with whatever
+// they affect. Boxes whose contents and size didn't change keep the layout of their contents.
+void Document::set_needs_partial_layout()
 {
     if (m_needs_layout)
         return;
@@ -1033,6 +1052,11 @@ void Document::update_layout()
         if (auto* document_element = this->document_element()) {
             propagate_overflow_to_viewport(*document_element, *m_layout_root);
         }
+    } else if (m_needs_full_layout) {
+        m_layout_root->for_each_in_inclusive_subtree([](auto& layout_node) {
+            layout_node.set_needs_layout_update();
+            return IterationDecision::Continue;
+        });
     }
 
     Layout::LayoutState layout_state;
@@ -1061,6 +1085,12 @@ void Document::update_layout()
 
     layout_state.commit(*m_layout_root);
 
+    m_layout_root->for_each_in_inclusive_subtree([](auto& layout_node) {
+        layout_node.reset_needs_layout_update();
+        return IterationDecision::Continue;
+    });
+    m_needs_full_layout = false;
+
     // Broadcast the current viewport rect to any new paintables, so they know whether they're visible or not.
     inform_all_viewport_clients_about_the_current_viewport_rect();
 
@@ -1077,28 +1107,38 @@ void Document::update_layout()
     m_layout_update_timer->stop();
 }
 
-[[nodiscard]] static Element::RequiredInvalidationAfterStyleChange update_style_recursively(DOM::Node& node)
+[[nodiscard]] static Element::RequiredInvalidationAfterStyleChange update_style_recursively(DOM::Node& node, CSS::StyleComputer& style_computer, bool parent_style_changed)
 {
     bool const needs_full_style_update = node.document().needs_full_style_update();
     Element::RequiredInvalidationAfterStyleChange invalidation;
 
+    // Children inherit from their parent, so whenever an element's style changes, its children need to be restyled too.
+    bool style_changed = parent_style_changed;
     if (is<Element>(node)) {
-        invalidation |= static_cast<Element&>(node).recompute_style();
+        style_changed = false;
+        if (needs_full_style_update || node.needs_style_update() || parent_style_changed) {
+            auto element_invalidation = static_cast<Element&>(node).recompute_style();
+            style_changed = !element_invalidation.is_none();
+            invalidation |= element_invalidation;
+        }
     }
     node.set_needs_style_update(false);
 
-    if (needs_full_style_update || node.child_needs_style_update()) {
+    if (needs_full_style_update || node.child_needs_style_update() || style_changed) {
         if (node.is_element()) {
             if (auto* shadow_root = static_cast<DOM::Element&>(node).shadow_root_internal()) {
-                if (needs_full_style_update || shadow_root->needs_style_update() || shadow_root->child_needs_style_update())
-                    invalidation |= update_style_recursively(*shadow_root);
+                if (needs_full_style_update || shadow_root->needs_style_update() || shadow_root->child_needs_style_update() || style_changed)
+                    invalidation |= update_style_recursively(*shadow_root, style_computer, style_changed);
             }
+            style_computer.push_ancestor(static_cast<DOM::Element&>(node));
         }
         node.for_each_child([&](auto& child) {
-            if (needs_full_style_update || child.needs_style_update() || child.child_needs_style_update())
-                invalidation |= update_style_recursively(child);
+            if (needs_full_style_update || child.needs_style_update() || child.child_needs_style_update() || style_changed)
+                invalidation |= update_style_recursively(child, style_computer, style_changed);
             return IterationDecision::Continue;
         });
+        if (node.is_element())
+            style_computer.pop_ancestor(static_cast<DOM::Element&>(node));
     }
 
     node.set_child_needs_style_update(false);
@@ -1118,12 +1158,19 @@ void Document::update_style()
 
     evaluate_media_rules();
 
-    auto invalidation = update_style_recursively(*this);
+    style_computer().reset_style_computation_statistics();
+    auto invalidation = update_style_recursively(*this, style_computer(), false);
+    if constexpr (LIBWEB_CSS_DEBUG) {
+        auto const& statistics = style_computer().style_computation_statistics();
+        dbgln("Style update: considered {} rules, {} rejected by the ancestor filter, {} matched, {} styles shared",
+            statistics.rules_considered, statistics.rules_rejected_by_ancestor_filter, statistics.rules_matched, statistics.styles_shared);
+    }
     if (invalidation.rebuild_layout_tree) {
         invalidate_layout();
     } else {
+        // NOTE: Elements whose style change affects layout have marked their layout nodes as needing layout.
         if (invalidation.relayout)
-            set_needs_layout();
+            set_needs_partial_layout();
         if (invalidation.rebuild_stacking_context_tree)
             invalidate_stacking_context_tree();
     }
@@ -1709,6 +1756,14 @@ bool Document::is_editable() const
     return m_editable;
 }
 
+// :focus-within and :target-within match every inclusive ancestor of the focused or target element, so all of them need
+// to be restyled when it changes.
+static void invalidate_style_of_inclusive_ancestors(Element& element)
+{
+    for (auto* ancestor = &element; ancestor; ancestor = ancestor->parent_element())
+        ancestor->set_needs_style_update(true);
+}
+
 void Document::set_focused_element(Element* element)
 {
     if (m_focused_element.ptr() == element)
@@ -1716,14 +1771,14 @@ void Document::set_focused_element(Element* element)
 
     if (m_focused_element) {
         m_focused_element->did_lose_focus();
-        m_focused_element->set_needs_style_update(true);
+        invalidate_style_of_inclusive_ancestors(*m_focused_element);
     }
 
     m_focused_element = element;
 
     if (m_focused_element) {
         m_focused_element->did_receive_focus();
-        m_focused_element->set_needs_style_update(true);
+        invalidate_style_of_inclusive_ancestors(*m_focused_element);
     }
 
     if (m_layout_root)
@@ -1755,12 +1810,12 @@ void Document::set_target_element(Element* element)
         return;
 
     if (m_target_element)
-        m_target_element->set_needs_style_update(true);
+        invalidate_style_of_inclusive_ancestors(*m_target_element);
 
     m_target_element = element;
 
     if (m_target_element)
-        m_target_element->set_needs_style_update(true);
+        invalidate_style_of_inclusive_ancestors(*m_target_element);
 
     if (m_layout_root)
         m_layout_root->set_needs_display();
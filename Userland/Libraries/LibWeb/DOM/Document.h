@@ -203,7 +203,10 @@ public:
     void update_style();
     void update_layout();
 
+    // Lays out the whole document again.
     void set_needs_layout();
+    // Lays out the layout node of the given node again, along with whatever it affects.
+    void set_needs_layout(Node&);
 
     void invalidate_layout();
     void invalidate_stacking_context_tree();
@@ -218,6 +221,7 @@ public:
 
     void schedule_style_update();
     void schedule_layout_update();
+    void set_needs_partial_layout();
 
     JS::NonnullGCPtr<HTMLCollection> get_elements_by_name(String const&);
     JS::NonnullGCPtr<HTMLCollection> get_elements_by_class_name(StringView);
@@ -672,6 +676,7 @@ private:
     Vector<WeakPtr<CSS::MediaQueryList>> m_media_query_lists;
 
     bool m_needs_layout { false };
+    bool m_needs_full_layout { false };
 
     bool m_needs_full_style_update { false };
 
@@ -442,7 +442,7 @@ void Element::run_attribute_change_steps(FlyString const& local_name, Optional<S
 
     // AD-HOC: Run our own internal attribute change handler.
     attribute_changed(local_name, value);
-    invalidate_style_after_attribute_change(local_name);
+    invalidate_style_after_attribute_change(local_name, old_value);
 }
 
 void Element::attribute_changed(FlyString const& name, Optional<String> const& value)
@@ -552,8 +552,16 @@ Element::RequiredInvalidationAfterStyleChange Element::recompute_style()
     set_needs_style_update(false);
     VERIFY(parent());
 
+    auto& style_computer = document().style_computer();
+    auto const old_root_element_font_metrics = style_computer.root_element_font_metrics();
+
     // FIXME propagate errors
-    auto new_computed_css_values = MUST(document().style_computer().compute_style(*this));
+    auto new_computed_css_values = MUST(style_computer.compute_style(*this));
+
+    // Root-relative lengths like rem can appear anywhere in the document, not only below elements whose style changed,
+    // so a change to the root element's font means every element has to be restyled.
+    if (is_document_element() && style_computer.root_element_font_metrics() != old_root_element_font_metrics)
+        document().set_needs_full_style_update(true);
 
     // Tables must not inherit -libweb-* values for text-align.
     // FIXME: Find the spec for this.
@@ -572,12 +580,18 @@ Element::RequiredInvalidationAfterStyleChange Element::recompute_style()
     if (invalidation.is_none())
         return invalidation;
 
+    // Table cells take some of their presentational hints from the table's computed style, not only from inherited values.
+    if (m_computed_css_values && is<HTML::HTMLTableElement>(*this))
+        invalidate_style_of_descendants();
+
     m_computed_css_values = move(new_computed_css_values);
     computed_css_values_changed();
 
     if (!invalidation.rebuild_layout_tree && layout_node()) {
         // If we're keeping the layout tree, we can just apply the new style to the existing layout tree.
         layout_node()->apply_style(*m_computed_css_values);
+        if (invalidation.relayout)
+            layout_node()->set_needs_layout_update();
         if (invalidation.repaint)
             layout_node()->set_needs_display();
     }
@@ -1718,13 +1732,63 @@ ErrorOr<void> Element::scroll_into_view(Optional<Variant<bool, ScrollIntoViewOpt
     // FIXME: 8. Optionally perform some other action that brings the element to the user’s attention.
 }
 
-void Element::invalidate_style_after_attribute_change(FlyString const& attribute_name)
+void Element::invalidate_style_after_attribute_change(FlyString const& attribute_name, Optional<String> const& old_value)
 {
-    // FIXME: Only invalidate if the attribute can actually affect style.
-    (void)attribute_name;
+    // OPTIMIZATION: Elements that aren't connected don't have any style yet, and get fully invalidated once inserted.
+    if (!is_connected())
+        return;
+
+    auto const& style_computer = document().style_computer();
+    auto scope = CSS::StyleInvalidationScope::None;
+
+    if (attribute_name == HTML::AttributeNames::class_) {
+        // NOTE: m_classes has already been updated by attribute_changed(), so only the classes added or removed matter.
+        Vector<FlyString> old_classes;
+        if (old_value.has_value()) {
+            for (auto old_class : old_value->bytes_as_string_view().split_view_if(Infra::is_ascii_whitespace))
+                old_classes.append(MUST(FlyString::from_utf8(old_class)));
+        }
+        for (auto const& class_name : old_classes) {
+            if (!m_classes.contains_slow(class_name))
+                scope |= style_computer.invalidation_scope_for_class(class_name);
+        }
+        for (auto const& class_name : m_classes) {
+            if (!old_classes.contains_slow(class_name))
+                scope |= style_computer.invalidation_scope_for_class(class_name);
+        }
+    } else if (attribute_name == HTML::AttributeNames::id) {
+        if (old_value.has_value())
+            scope |= style_computer.invalidation_scope_for_id(FlyString(*old_value));
+        if (m_id.has_value())
+            scope |= style_computer.invalidation_scope_for_id(*m_id);
+    } else {
+        // Any other attribute may affect our own style through presentational hints.
+        scope = CSS::StyleInvalidationScope::Self | style_computer.invalidation_scope_for_attribute(attribute_name);
+        // Table cells take some of their presentational hints from their table.
+        if (is<HTML::HTMLTableElement>(*this))
+            scope |= CSS::StyleInvalidationScope::Descendants;
+    }
 
     // FIXME: This will need to become smarter when we implement the :has() selector.
-    invalidate_style();
+    if (has_flag(scope, CSS::StyleInvalidationScope::Descendants))
+        invalidate_style();
+    else if (has_flag(scope, CSS::StyleInvalidationScope::Self))
+        set_needs_style_update(true);
+
+    if (has_flag(scope, CSS::StyleInvalidationScope::Siblings)) {
+        for (auto* sibling = next_element_sibling(); sibling; sibling = sibling->next_element_sibling())
+            sibling->invalidate_style();
+    }
+}
+
+void Element::invalidate_style_of_descendants()
+{
+    for_each_child([](Node& child) {
+        child.invalidate_style();
+        return IterationDecision::Continue;
+    });
+    if (m_shadow_root)
+        m_shadow_root->invalidate_style();
 }
 
 // https://www.w3.org/TR/wai-aria-1.2/#tree_exclusion
@@ -2054,9 +2118,25 @@ auto Element::pseudo_element_custom_properties() const -> PseudoElementCustomPro
     return *m_pseudo_element_custom_properties;
 }
 
+static bool custom_properties_differ(HashMap<FlyString, CSS::StyleProperty> const& a, HashMap<FlyString, CSS::StyleProperty> const& b)
+{
+    if (a.size() != b.size())
+        return true;
+    for (auto const& it : a) {
+        auto other = b.find(it.key);
+        if (other == b.end() || other->value.important != it.value.important || *other->value.value != *it.value.value)
+            return true;
+    }
+    return false;
+}
+
 void Element::set_custom_properties(Optional<CSS::Selector::PseudoElement::Type> pseudo_element, HashMap<FlyString, CSS::StyleProperty> custom_properties)
 {
     if (!pseudo_element.has_value()) {
+        // Descendants can refer to our custom properties through var(), which isn't reflected in their computed values
+        // changing as ours do, so they all need to be recomputed.
+        if (m_computed_css_values && custom_properties_differ(m_custom_properties, custom_properties))
+            invalidate_style_of_descendants();
         m_custom_properties = move(custom_properties);
         return;
     }
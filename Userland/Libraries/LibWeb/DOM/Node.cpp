@@ -707,8 +707,15 @@ void Node::remove(bool suppress_observers)
     parent->children_changed();
 
     // Since the tree structure has changed, we need to invalidate both style and layout.
-    // In the future, we should find a way to only invalidate the parts that actually need it.
-    document().invalidate_style();
+    // Without :has(), only the former parent and its remaining descendants can be affected by the removal, e.g. through
+    // :empty, :last-child or sibling combinators, unless the hovered or focused node left the document with us.
+    // FIXME: This will need to become smarter when we implement the :has() selector.
+    auto const* hovered_node = document().hovered_node();
+    auto const* focused_element = document().focused_element();
+    if ((hovered_node && is_inclusive_ancestor_of(*hovered_node)) || (focused_element && is_inclusive_ancestor_of(*focused_element)))
+        document().invalidate_style();
+    else
+        parent->invalidate_style();
     document().invalidate_layout();
 }
 
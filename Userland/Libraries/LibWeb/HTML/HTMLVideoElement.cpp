@@ -91,7 +91,7 @@ u32 HTMLVideoElement::video_height() const
 void HTMLVideoElement::set_video_track(JS::GCPtr<HTML::VideoTrack> video_track)
 {
     set_needs_style_update(true);
-    document().set_needs_layout();
+    document().set_needs_layout(*this);
 
     if (m_video_track)
         m_video_track->pause_video({});
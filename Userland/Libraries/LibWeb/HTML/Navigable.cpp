@@ -31,6 +31,7 @@
 #include <LibWeb/Layout/Node.h>
 #include <LibWeb/Loader/GeneratedPagesLoader.h>
 #include <LibWeb/Page/Page.h>
+#include <LibWeb/Painting/ViewportPaintable.h>
 #include <LibWeb/Platform/EventLoopPlugin.h>
 #include <LibWeb/XHR/FormData.h>
 
@@ -1976,6 +1977,8 @@ void Navigable::set_size(CSSPixelSize size)
 
 void Navigable::set_needs_display()
 {
+    if (auto document = active_document(); document && document->paintable())
+        document->paintable()->invalidate_cached_display_lists();
     set_needs_display(viewport_rect());
 }
 
@@ -7,6 +7,7 @@
 #include <LibJS/Runtime/VM.h>
 #include <LibWeb/Bindings/InternalsPrototype.h>
 #include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/CSS/StyleComputer.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Event.h>
 #include <LibWeb/DOM/EventTarget.h>
@@ -61,6 +62,25 @@ JS::Object* Internals::hit_test(double x, double y)
     return nullptr;
 }
 
+JS::Object* Internals::style_computation_statistics(bool restyle_whole_document)
+{
+    auto& document = global_object().associated_document();
+    // NOTE: Either restyle the whole document, so that the statistics cover every element, or only whichever elements
+    //       are dirty, so that they tell how much work the changes since the last style update caused.
+    if (restyle_whole_document)
+        document.set_needs_full_style_update(true);
+    document.style_computer().reset_style_computation_statistics();
+    document.update_style();
+
+    auto const& statistics = document.style_computer().style_computation_statistics();
+    auto result = JS::Object::create(realm(), nullptr);
+    result->define_direct_property("rulesConsidered", JS::Value(statistics.rules_considered), JS::default_attributes);
+    result->define_direct_property("rulesRejectedByAncestorFilter", JS::Value(statistics.rules_rejected_by_ancestor_filter), JS::default_attributes);
+    result->define_direct_property("rulesMatched", JS::Value(statistics.rules_matched), JS::default_attributes);
+    result->define_direct_property("stylesShared", JS::Value(statistics.styles_shared), JS::default_attributes);
+    return result;
+}
+
 void Internals::send_text(HTML::HTMLElement& target, String const& text)
 {
     auto& page = global_object().browsing_context()->page();
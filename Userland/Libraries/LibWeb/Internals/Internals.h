@@ -21,6 +21,7 @@ public:
 
     void gc();
     JS::Object* hit_test(double x, double y);
+    JS::Object* style_computation_statistics(bool restyle_whole_document);
 
     void send_text(HTML::HTMLElement&, String const&);
     void commit_text();
@@ -682,9 +682,15 @@ void BlockFormattingContext::layout_block_level_box(Box const& box, BlockContain
     if (box.is_replaced_box())
         compute_height(box, available_space);
 
+    bool did_reuse_cached_layout = false;
     if (independent_formatting_context) {
         // This box establishes a new formatting context. Pass control to it.
-        independent_formatting_context->run(box, layout_mode, box_state.available_inner_space_or_constraints_from(available_space));
+        auto available_inner_space = box_state.available_inner_space_or_constraints_from(available_space);
+        did_reuse_cached_layout = try_to_reuse_cached_layout(box, layout_mode, available_inner_space);
+        if (!did_reuse_cached_layout) {
+            independent_formatting_context->run(box, layout_mode, available_inner_space);
+            cache_layout_inputs(box, layout_mode, available_inner_space);
+        }
     } else {
         // This box participates in the current block container's flow.
         if (box.children_are_inline()) {
@@ -731,7 +737,7 @@ void BlockFormattingContext::layout_block_level_box(Box const& box, BlockContain
 
     bottom_of_lowest_margin_box = max(bottom_of_lowest_margin_box, box_state.offset.y() + box_state.content_height() + box_state.margin_box_bottom());
 
-    if (independent_formatting_context)
+    if (independent_formatting_context && !did_reuse_cached_layout)
         independent_formatting_context->parent_context_did_dimension_child_root_box();
 }
 
@@ -10,6 +10,7 @@
 #include <LibWeb/Layout/BlockContainer.h>
 #include <LibWeb/Layout/Box.h>
 #include <LibWeb/Layout/FormattingContext.h>
+#include <LibWeb/Layout/LayoutState.h>
 #include <LibWeb/Painting/PaintableBox.h>
 
 namespace Web::Layout {
@@ -28,6 +29,35 @@ Box::~Box()
 {
 }
 
+IntrinsicSizes& Box::cached_intrinsic_sizes() const
+{
+    if (!m_cached_intrinsic_sizes)
+        m_cached_intrinsic_sizes = make<IntrinsicSizes>();
+    return *m_cached_intrinsic_sizes;
+}
+
+bool Box::is_layout_boundary() const
+{
+    // The parent decides on the size of the box without looking inside it.
+    if (!computed_values().width().is_length() || !computed_values().height().is_length())
+        return false;
+
+    // Floats inside the box can only affect the rest of the tree if it doesn't establish a formatting context of its own.
+    if (!FormattingContext::formatting_context_type_created_by_box(*this).has_value())
+        return false;
+
+    // Tables size themselves while laying out their contents, and table cells have their contents aligned afterwards.
+    if (is_table_wrapper() || display().is_table_inside() || display().is_internal())
+        return false;
+
+    return !is_svg_svg_box();
+}
+
+void Box::set_cached_layout(OwnPtr<CachedLayout> cached_layout) const
+{
+    m_cached_layout = move(cached_layout);
+}
+
 // https://www.w3.org/TR/css-overflow-3/#overflow-control
 static bool overflow_value_makes_box_a_scroll_container(CSS::Overflow overflow)
 {
@@ -65,8 +95,27 @@ void Box::set_needs_display()
     if (!navigable())
         return;
 
-    if (paintable_box())
-        navigable()->set_needs_display(paintable_box()->absolute_rect());
+    if (!paintable_box())
+        return;
+
+    paintable_box()->invalidate_cached_display_lists();
+
+    // Only the invalidated rect gets painted again, so it has to include everything painted outside the box as well.
+    auto rect = paintable_box()->absolute_paint_rect();
+    if (computed_values().outline_style() != CSS::OutlineStyle::None) {
+        auto outline_extent = computed_values().outline_width().to_px(*this) + max(CSSPixels(0), computed_values().outline_offset().to_px(*this));
+        rect.inflate(outline_extent, outline_extent, outline_extent, outline_extent);
+    }
+
+    // The box is painted inside its parent, but moves along with everything it paints if it is transformed itself.
+    Optional<CSSPixelRect> rect_on_page = rect;
+    if (!computed_values().transformations().is_empty())
+        rect_on_page = {};
+    else if (auto const* parent = paintable_box()->parent())
+        rect_on_page = parent->absolute_content_rect_on_page(rect);
+
+    // If we can't tell where the box ends up, everything that is visible has to be painted again.
+    navigable()->set_needs_display(rect_on_page.value_or(navigable()->viewport_rect()));
 }
 
 bool Box::is_body() const
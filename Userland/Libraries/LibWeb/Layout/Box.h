@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/HashMap.h>
 #include <AK/OwnPtr.h>
 #include <LibGfx/Rect.h>
 #include <LibJS/Heap/Cell.h>
@@ -18,6 +19,16 @@ struct LineBoxFragmentCoordinate {
     size_t fragment_index { 0 };
 };
 
+struct IntrinsicSizes {
+    Optional<CSSPixels> min_content_width;
+    Optional<CSSPixels> max_content_width;
+
+    HashMap<CSSPixels, Optional<CSSPixels>> min_content_height;
+    HashMap<CSSPixels, Optional<CSSPixels>> max_content_height;
+};
+
+struct CachedLayout;
+
 class Box : public NodeWithStyleAndBoxModelMetrics {
     JS_CELL(Box, NodeWithStyleAndBoxModelMetrics);
 
@@ -56,6 +67,16 @@ public:
 
     bool is_user_scrollable() const;
 
+    // Intrinsic sizes only depend on what's inside the box, so we keep them around until something in there needs layout.
+    IntrinsicSizes& cached_intrinsic_sizes() const;
+    void reset_cached_intrinsic_sizes() const { m_cached_intrinsic_sizes = nullptr; }
+
+    // A layout boundary is a box whose size doesn't depend on its contents, and whose contents only depend on its size.
+    // If nothing inside it changed, its contents can be laid out by reusing the previous layout.
+    bool is_layout_boundary() const;
+    CachedLayout* cached_layout() const { return m_cached_layout.ptr(); }
+    void set_cached_layout(OwnPtr<CachedLayout>) const;
+
 protected:
     Box(DOM::Document&, DOM::Node*, NonnullRefPtr<CSS::StyleProperties>);
     Box(DOM::Document&, DOM::Node*, CSS::ComputedValues);
@@ -66,6 +87,9 @@ private:
     Optional<CSSPixels> m_natural_width;
     Optional<CSSPixels> m_natural_height;
     Optional<CSSPixelFraction> m_natural_aspect_ratio;
+
+    mutable OwnPtr<IntrinsicSizes> m_cached_intrinsic_sizes;
+    mutable OwnPtr<CachedLayout> m_cached_layout;
 };
 
 template<>
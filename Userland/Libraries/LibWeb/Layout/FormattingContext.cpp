@@ -223,15 +223,69 @@ OwnPtr<FormattingContext> FormattingContext::layout_inside(Box const& child_box,
     if (!child_box.can_have_children())
         return {};
 
+    if (try_to_reuse_cached_layout(child_box, layout_mode, available_space))
+        return {};
+
     auto independent_formatting_context = create_independent_formatting_context_if_needed(m_state, child_box);
     if (independent_formatting_context)
         independent_formatting_context->run(child_box, layout_mode, available_space);
     else
         run(child_box, layout_mode, available_space);
 
+    cache_layout_inputs(child_box, layout_mode, available_space);
     return independent_formatting_context;
 }
 
+static CachedLayout::Inputs layout_inputs_for(LayoutState::UsedValues const& box_state, AvailableSpace const& available_space)
+{
+    return CachedLayout::Inputs {
+        .content_width = box_state.content_width(),
+        .content_height = box_state.content_height(),
+        .has_definite_width = box_state.has_definite_width(),
+        .has_definite_height = box_state.has_definite_height(),
+        .padding_left = box_state.padding_left,
+        .padding_right = box_state.padding_right,
+        .padding_top = box_state.padding_top,
+        .padding_bottom = box_state.padding_bottom,
+        .available_space = available_space,
+    };
+}
+
+// Only the layout that ends up being committed is worth remembering, not the ones done to measure intrinsic sizes.
+static bool is_final_layout(LayoutState const& state, LayoutMode layout_mode)
+{
+    return layout_mode == LayoutMode::Normal && !state.m_parent;
+}
+
+bool FormattingContext::try_to_reuse_cached_layout(Box const& box, LayoutMode layout_mode, AvailableSpace const& available_space)
+{
+    if (!is_final_layout(m_state, layout_mode) || box.needs_layout_update() || !box.is_layout_boundary())
+        return false;
+
+    auto const* cached_layout = box.cached_layout();
+    if (!cached_layout || !cached_layout->is_complete)
+        return false;
+    if (cached_layout->inputs != layout_inputs_for(m_state.get(box), available_space))
+        return false;
+
+    for (auto const& it : cached_layout->used_values_of_descendants)
+        m_state.used_values_per_layout_node.set(it.key, make<LayoutState::UsedValues>(*it.value));
+    m_state.get_mutable(box).line_boxes = cached_layout->line_boxes;
+    return true;
+}
+
+void FormattingContext::cache_layout_inputs(Box const& box, LayoutMode layout_mode, AvailableSpace const& available_space)
+{
+    if (!is_final_layout(m_state, layout_mode))
+        return;
+
+    if (!box.is_layout_boundary()) {
+        box.set_cached_layout(nullptr);
+        return;
+    }
+    box.set_cached_layout(make<CachedLayout>(layout_inputs_for(m_state.get(box), available_space)));
+}
+
 CSSPixels FormattingContext::greatest_child_width(Box const& box) const
 {
     CSSPixels max_width = 0;
@@ -1291,9 +1345,7 @@ CSSPixels FormattingContext::calculate_min_content_width(Layout::Box const& box)
     if (box.has_natural_width())
         return *box.natural_width();
 
-    auto& root_state = m_state.m_root;
-
-    auto& cache = *root_state.intrinsic_sizes.ensure(&box, [] { return adopt_own(*new LayoutState::IntrinsicSizes); });
+    auto& cache = box.cached_intrinsic_sizes();
     if (cache.min_content_width.has_value())
         return *cache.min_content_width;
 
@@ -1329,9 +1381,7 @@ CSSPixels FormattingContext::calculate_max_content_width(Layout::Box const& box)
     if (box.has_natural_width())
         return *box.natural_width();
 
-    auto& root_state = m_state.m_root;
-
-    auto& cache = *root_state.intrinsic_sizes.ensure(&box, [] { return adopt_own(*new LayoutState::IntrinsicSizes); });
+    auto& cache = box.cached_intrinsic_sizes();
     if (cache.max_content_width.has_value())
         return *cache.max_content_width;
 
@@ -1373,9 +1423,7 @@ CSSPixels FormattingContext::calculate_min_content_height(Layout::Box const& box
         return *box.natural_height();
 
     auto get_cache_slot = [&]() -> Optional<CSSPixels>* {
-        auto& root_state = m_state.m_root;
-        auto& cache = *root_state.intrinsic_sizes.ensure(&box, [] { return adopt_own(*new LayoutState::IntrinsicSizes); });
-        return &cache.min_content_height.ensure(width);
+        return &box.cached_intrinsic_sizes().min_content_height.ensure(width);
     };
 
     if (auto* cache_slot = get_cache_slot(); cache_slot && cache_slot->has_value())
@@ -1417,9 +1465,7 @@ CSSPixels FormattingContext::calculate_max_content_height(Layout::Box const& box
         return *box.natural_height();
 
     auto get_cache_slot = [&]() -> Optional<CSSPixels>* {
-        auto& root_state = m_state.m_root;
-        auto& cache = *root_state.intrinsic_sizes.ensure(&box, [] { return adopt_own(*new LayoutState::IntrinsicSizes); });
-        return &cache.max_content_height.ensure(width);
+        return &box.cached_intrinsic_sizes().max_content_height.ensure(width);
     };
 
     if (auto* cache_slot = get_cache_slot(); cache_slot && cache_slot->has_value())
@@ -109,6 +109,11 @@ protected:
 
     OwnPtr<FormattingContext> layout_inside(Box const&, LayoutMode, AvailableSpace const&);
 
+    // Layout boundaries that haven't changed since the last layout, and are laid out with the same size and available space,
+    // get the used values of their contents from that layout instead of running their formatting context again.
+    bool try_to_reuse_cached_layout(Box const&, LayoutMode, AvailableSpace const&);
+    void cache_layout_inputs(Box const&, LayoutMode, AvailableSpace const&);
+
     struct SpaceUsedByFloats {
         CSSPixels left { 0 };
         CSSPixels right { 0 };
@@ -368,6 +368,9 @@ void LayoutState::commit(Box& root)
     // Only the top-level LayoutState should ever be committed.
     VERIFY(!m_parent);
 
+    // NOTE: This has to happen before the used values are moved into the paint tree below.
+    save_cached_layouts();
+
     // NOTE: In case this is a relayout of an existing tree, we start by detaching the old paint tree
     //       from the layout tree. This is done to ensure that we don't end up with any old-tree pointers
     //       when text paintables shift around in the tree.
@@ -462,6 +465,38 @@ void LayoutState::commit(Box& root)
     resolve_box_shadow_data();
 }
 
+void LayoutState::save_cached_layouts()
+{
+    for (auto& it : used_values_per_layout_node) {
+        auto const& node = it.value->node();
+        if (!node.is_box())
+            continue;
+        auto const& box = static_cast<Box const&>(node);
+        auto* cached_layout = box.cached_layout();
+        if (!cached_layout || cached_layout->is_complete)
+            continue;
+
+        bool can_reuse_layout = true;
+        box.for_each_in_subtree([&](Node const& descendant) {
+            // Absolutely positioned boxes placed relative to something outside the boundary may move without it changing.
+            if (descendant.is_absolutely_positioned() && (!descendant.containing_block() || !box.is_inclusive_ancestor_of(*descendant.containing_block()))) {
+                can_reuse_layout = false;
+                return IterationDecision::Break;
+            }
+            if (auto const* used_values = used_values_per_layout_node.get(&descendant).value_or(nullptr))
+                cached_layout->used_values_of_descendants.set(&descendant, make<UsedValues>(*used_values));
+            return IterationDecision::Continue;
+        });
+
+        if (!can_reuse_layout) {
+            box.set_cached_layout(nullptr);
+            continue;
+        }
+        cached_layout->line_boxes = it.value->line_boxes;
+        cached_layout->is_complete = true;
+    }
+}
+
 void LayoutState::UsedValues::set_node(NodeWithStyle& node, UsedValues const* containing_block_used_values)
 {
     m_node = &node;
@@ -8,6 +8,7 @@
 
 #include <AK/HashMap.h>
 #include <LibGfx/Point.h>
+#include <LibWeb/Layout/AvailableSpace.h>
 #include <LibWeb/Layout/Box.h>
 #include <LibWeb/Layout/LineBox.h>
 #include <LibWeb/Painting/PaintableBox.h>
@@ -21,9 +22,6 @@ enum class SizeConstraint {
     MaxContent,
 };
 
-class AvailableSize;
-class AvailableSpace;
-
 struct LayoutState {
     LayoutState()
         : m_root(*this)
@@ -169,25 +167,44 @@ struct LayoutState {
 
     HashMap<Layout::Node const*, NonnullOwnPtr<UsedValues>> used_values_per_layout_node;
 
-    // We cache intrinsic sizes once determined, as they will not change over the course of a full layout.
-    // This avoids computing them several times while performing flex layout.
-    struct IntrinsicSizes {
-        Optional<CSSPixels> min_content_width;
-        Optional<CSSPixels> max_content_width;
-
-        HashMap<CSSPixels, Optional<CSSPixels>> min_content_height;
-        HashMap<CSSPixels, Optional<CSSPixels>> max_content_height;
-    };
-
-    HashMap<JS::GCPtr<NodeWithStyle const>, NonnullOwnPtr<IntrinsicSizes>> mutable intrinsic_sizes;
-
     LayoutState const* m_parent { nullptr };
     LayoutState const& m_root;
 
 private:
+    void save_cached_layouts();
     void resolve_relative_positions(Vector<Painting::PaintableWithLines&> const&);
     void resolve_border_radii();
     void resolve_box_shadow_data();
 };
 
+// The used values of everything inside a layout boundary, as of the end of the last layout that laid out its contents.
+struct CachedLayout {
+    // Everything the layout of the contents depends on, apart from the contents themselves.
+    struct Inputs {
+        CSSPixels content_width;
+        CSSPixels content_height;
+        bool has_definite_width { false };
+        bool has_definite_height { false };
+        CSSPixels padding_left;
+        CSSPixels padding_right;
+        CSSPixels padding_top;
+        CSSPixels padding_bottom;
+        AvailableSpace available_space;
+
+        bool operator==(Inputs const&) const = default;
+    };
+
+    explicit CachedLayout(Inputs inputs)
+        : inputs(move(inputs))
+    {
+    }
+
+    Inputs inputs;
+    Vector<LineBox> line_boxes;
+    HashMap<Layout::Node const*, NonnullOwnPtr<LayoutState::UsedValues>> used_values_of_descendants;
+
+    // The inputs are recorded when the contents are laid out, but the used values only once the layout is committed.
+    bool is_complete { false };
+};
+
 }
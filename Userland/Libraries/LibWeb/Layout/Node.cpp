@@ -32,6 +32,7 @@
 #include <LibWeb/Layout/TextNode.h>
 #include <LibWeb/Layout/Viewport.h>
 #include <LibWeb/Page/Page.h>
+#include <LibWeb/Painting/Paintable.h>
 #include <LibWeb/Platform/FontPlugin.h>
 
 namespace Web::Layout {
@@ -227,6 +228,13 @@ Viewport& Node::root()
 
 void Node::set_needs_display()
 {
+    for (auto const* node = this; node; node = node->parent()) {
+        if (auto const* paintable = node->paintable()) {
+            paintable->invalidate_cached_display_lists();
+            break;
+        }
+    }
+
     auto* containing_block = this->containing_block();
     if (!containing_block)
         return;
@@ -234,15 +242,29 @@ void Node::set_needs_display()
         return;
     if (!is<Painting::PaintableWithLines>(*containing_block->paintable_box()))
         return;
-    static_cast<Painting::PaintableWithLines const&>(*containing_block->paintable_box()).for_each_fragment([&](auto& fragment) {
+    auto const& paintable_with_lines = static_cast<Painting::PaintableWithLines const&>(*containing_block->paintable_box());
+    paintable_with_lines.for_each_fragment([&](auto& fragment) {
         if (&fragment.layout_node() == this || is_ancestor_of(fragment.layout_node())) {
-            if (navigable())
-                navigable()->set_needs_display(fragment.absolute_rect());
+            if (navigable()) {
+                auto rect_on_page = paintable_with_lines.absolute_content_rect_on_page(fragment.absolute_rect());
+                navigable()->set_needs_display(rect_on_page.value_or(navigable()->viewport_rect()));
+            }
         }
         return IterationDecision::Continue;
     });
 }
 
+void Node::set_needs_layout_update()
+{
+    // Anything that changes inside a box may change its size too, so its ancestors need layout as well.
+    // If a node already needs layout, so do all of its ancestors.
+    for (Node* node = this; node && !node->m_needs_layout_update; node = node->parent()) {
+        node->m_needs_layout_update = true;
+        if (is<Box>(*node))
+            static_cast<Box const&>(*node).reset_cached_intrinsic_sizes();
+    }
+}
+
 CSSPixelPoint Node::box_type_agnostic_position() const
 {
     if (is<Box>(*this))
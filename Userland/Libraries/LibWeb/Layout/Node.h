@@ -159,6 +159,11 @@ public:
 
     virtual void set_needs_display();
 
+    // Set when this node, or anything inside it, has changed in a way that affects layout since the last layout.
+    bool needs_layout_update() const { return m_needs_layout_update; }
+    void set_needs_layout_update();
+    void reset_needs_layout_update() { m_needs_layout_update = false; }
+
     bool children_are_inline() const { return m_children_are_inline; }
     void set_children_are_inline(bool value) { m_children_are_inline = value; }
 
@@ -196,6 +201,7 @@ private:
     bool m_anonymous { false };
     bool m_has_style { false };
     bool m_children_are_inline { false };
+    bool m_needs_layout_update { true };
     SelectionState m_selection_state { SelectionState::None };
 
     bool m_is_flex_item { false };
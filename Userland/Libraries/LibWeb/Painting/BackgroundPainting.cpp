@@ -134,6 +134,7 @@ void paint_background(PaintContext& context, Layout::NodeWithStyleAndBoxModelMet
         switch (layer.attachment) {
         case CSS::BackgroundAttachment::Fixed:
             background_positioning_area = layout_node.root().navigable()->viewport_rect();
+            context.set_has_painted_viewport_dependent_content(true);
             break;
         case CSS::BackgroundAttachment::Local:
             background_positioning_area = get_box(layer.origin).rect;
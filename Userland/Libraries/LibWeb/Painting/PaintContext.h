@@ -33,6 +33,11 @@ public:
     void set_device_viewport_rect(DevicePixelRect const& rect) { m_device_viewport_rect = rect; }
     CSSPixelRect css_viewport_rect() const;
 
+    // Set while painting something that depends on the viewport rect, like a fixed background, which keeps the
+    // recording of the stacking contexts around it from being reused once the viewport has scrolled.
+    bool has_painted_viewport_dependent_content() const { return m_has_painted_viewport_dependent_content; }
+    void set_has_painted_viewport_dependent_content(bool value) { m_has_painted_viewport_dependent_content = value; }
+
     bool has_focus() const { return m_focus; }
     void set_has_focus(bool focus) { m_focus = focus; }
 
@@ -88,6 +93,7 @@ private:
     bool m_should_show_line_box_borders { false };
     bool m_should_paint_overlay { true };
     bool m_focus { false };
+    bool m_has_painted_viewport_dependent_content { false };
     Gfx::AffineTransform m_svg_transform;
     u32 m_next_corner_clipper_id { 0 };
     HashMap<Painting::PaintableBox const*, ScrollFrame> m_scroll_frames;
@@ -8,6 +8,7 @@
 #include <LibWeb/Layout/BlockContainer.h>
 #include <LibWeb/Painting/Paintable.h>
 #include <LibWeb/Painting/PaintableBox.h>
+#include <LibWeb/Painting/StackingContext.h>
 
 namespace Web::Painting {
 
@@ -95,4 +96,36 @@ StackingContext const* Paintable::stacking_context_rooted_here() const
     return static_cast<PaintableBox const&>(*this).stacking_context();
 }
 
+void Paintable::invalidate_cached_display_lists() const
+{
+    // Changes to the whole viewport, like a new selection or focused element, can affect the painting of any stacking context.
+    if (layout_node().is_viewport()) {
+        if (auto const* stacking_context = stacking_context_rooted_here())
+            stacking_context->invalidate_cached_display_lists_in_subtree();
+        return;
+    }
+
+    for (auto const* paintable = this; paintable; paintable = paintable->parent()) {
+        if (auto const* stacking_context = paintable->stacking_context_rooted_here()) {
+            stacking_context->invalidate_cached_display_list();
+            return;
+        }
+    }
+}
+
+Optional<CSSPixelRect> Paintable::absolute_content_rect_on_page(CSSPixelRect rect) const
+{
+    for (auto const* paintable = this; paintable; paintable = paintable->parent()) {
+        if (!paintable->is_paintable_box())
+            continue;
+        auto const& paintable_box = static_cast<PaintableBox const&>(*paintable);
+        // FIXME: Map the rect through the transform instead.
+        if (!paintable_box.computed_values().transformations().is_empty())
+            return {};
+        if (paintable_box.has_scrollable_overflow())
+            rect.translate_by(-paintable_box.scroll_offset());
+    }
+    return rect;
+}
+
 }
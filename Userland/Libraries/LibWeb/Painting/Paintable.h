@@ -174,6 +174,13 @@ public:
 
     StackingContext const* stacking_context_rooted_here() const;
 
+    // Keeps the commands recorded for the stacking contexts containing this paintable from being reused by the next paint.
+    void invalidate_cached_display_lists() const;
+
+    // Maps the absolute rect of something painted inside this paintable to where it ends up on the page, once the scroll
+    // offsets of this paintable and its ancestors are applied. Returns nothing if it is inside a transformed box.
+    Optional<CSSPixelRect> absolute_content_rect_on_page(CSSPixelRect) const;
+
 protected:
     explicit Paintable(Layout::Node const&);
 
@@ -335,6 +335,7 @@ void PaintableBox::paint_background(PaintContext& context) const
     if (layout_box().is_root_element()) {
         // CSS 2.1 Appendix E.2: If the element is a root element, paint the background over the entire canvas.
         background_rect = context.css_viewport_rect();
+        context.set_has_painted_viewport_dependent_content(true);
 
         // Section 2.11.2: If the computed value of background-image on the root element is none and its background-color is transparent,
         // user agents must instead propagate the computed values of the background properties from that element’s first HTML BODY child element.
@@ -16,12 +16,19 @@
 namespace Web::Painting {
 
 PaintingCommandExecutorCPU::PaintingCommandExecutorCPU(Gfx::Bitmap& bitmap)
+    : PaintingCommandExecutorCPU(bitmap, {})
+{
+}
+
+PaintingCommandExecutorCPU::PaintingCommandExecutorCPU(Gfx::Bitmap& bitmap, Gfx::IntPoint origin)
     : m_target_bitmap(bitmap)
+    , m_origin(origin)
 {
     stacking_contexts.append({ .painter = AK::make<Gfx::Painter>(bitmap),
         .opacity = 1.0f,
         .destination = {},
         .scaling_mode = {} });
+    painter().translate(-origin);
 }
 
 CommandResult PaintingCommandExecutorCPU::draw_glyph_run(Vector<Gfx::DrawGlyphOrEmoji> const& glyph_run, Color const& color)
@@ -97,8 +104,11 @@ CommandResult PaintingCommandExecutorCPU::push_stacking_context(
     CSS::ImageRendering image_rendering, StackingContextTransform transform, Optional<StackingContextMask> mask)
 {
     painter().save();
-    if (is_fixed_position)
+    if (is_fixed_position) {
         painter().translate(-painter().translation());
+        if (&painter() == stacking_contexts.first().painter.ptr())
+            painter().translate(-m_origin);
+    }
 
     if (mask.has_value()) {
         // TODO: Support masks and other stacking context features at the same time.
@@ -56,8 +56,12 @@ public:
 
     PaintingCommandExecutorCPU(Gfx::Bitmap& bitmap);
 
+    // Paints into a bitmap covering only part of the page, whose top left corner is at `origin` in page coordinates.
+    PaintingCommandExecutorCPU(Gfx::Bitmap& bitmap, Gfx::IntPoint origin);
+
 private:
     Gfx::Bitmap& m_target_bitmap;
+    Gfx::IntPoint m_origin;
     Vector<RefPtr<BorderRadiusCornerClipper>> m_corner_clippers;
 
     struct StackingContext {
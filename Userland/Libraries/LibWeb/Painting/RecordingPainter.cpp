@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibGfx/Font/Font.h>
+#include <LibGfx/Matrix4x4.h>
 #include <LibWeb/Painting/RecordingPainter.h>
 #include <LibWeb/Painting/ShadowPainting.h>
 
@@ -440,6 +442,29 @@ void RecordingPainter::apply_scroll_offsets(Vector<Gfx::IntPoint> const& offsets
     }
 }
 
+Vector<RecordingPainter::PaintingCommandWithScrollFrame> RecordingPainter::copy_commands_since(size_t index) const
+{
+    VERIFY(index <= m_painting_commands.size());
+    Vector<PaintingCommandWithScrollFrame> commands;
+    commands.ensure_capacity(m_painting_commands.size() - index);
+    for (size_t i = index; i < m_painting_commands.size(); ++i)
+        commands.unchecked_append(m_painting_commands[i]);
+    return commands;
+}
+
+void RecordingPainter::append_commands(ReadonlySpan<PaintingCommandWithScrollFrame> commands, Function<u32(u32)> const& map_corner_clipper_id)
+{
+    m_painting_commands.ensure_capacity(m_painting_commands.size() + commands.size());
+    for (auto const& command_with_scroll_id : commands) {
+        m_painting_commands.unchecked_append(command_with_scroll_id);
+        auto& command = m_painting_commands.last().command;
+        if (auto* sample_under_corners = command.get_pointer<SampleUnderCorners>())
+            sample_under_corners->id = map_corner_clipper_id(sample_under_corners->id);
+        else if (auto* blit_corner_clipping = command.get_pointer<BlitCornerClipping>())
+            blit_corner_clipping->id = map_corner_clipper_id(blit_corner_clipping->id);
+    }
+}
+
 void RecordingPainter::execute(PaintingCommandExecutor& executor)
 {
     if (executor.needs_prepare_glyphs_texture()) {
@@ -470,11 +495,24 @@ void RecordingPainter::execute(PaintingCommandExecutor& executor)
         executor.update_immutable_bitmap_texture_cache(immutable_bitmaps);
     }
 
+    execute_commands(executor, m_painting_commands.size(), [&](size_t index) -> PaintingCommand const& {
+        return m_painting_commands[index].command;
+    });
+}
+
+void RecordingPainter::execute(PaintingCommandExecutor& executor, ReadonlySpan<size_t> command_indices)
+{
+    execute_commands(executor, command_indices.size(), [&](size_t index) -> PaintingCommand const& {
+        return m_painting_commands[command_indices[index]].command;
+    });
+}
+
+void RecordingPainter::execute_commands(PaintingCommandExecutor& executor, size_t command_count, Function<PaintingCommand const&(size_t)> const& command_at)
+{
     HashTable<u32> skipped_sample_corner_commands;
     size_t next_command_index = 0;
-    while (next_command_index < m_painting_commands.size()) {
-        auto& command_with_scroll_id = m_painting_commands[next_command_index++];
-        auto& command = command_with_scroll_id.command;
+    while (next_command_index < command_count) {
+        auto& command = command_at(next_command_index++);
         auto bounding_rect = command_bounding_rectangle(command);
         if (bounding_rect.has_value() && (bounding_rect->is_empty() || executor.would_be_fully_clipped_by_painter(*bounding_rect))) {
             if (command.has<SampleUnderCorners>()) {
@@ -484,118 +522,14 @@ void RecordingPainter::execute(PaintingCommandExecutor& executor)
             continue;
         }
 
-        auto result = command.visit(
-            [&](DrawGlyphRun const& command) {
-                return executor.draw_glyph_run(command.glyph_run, command.color);
-            },
-            [&](DrawText const& command) {
-                return executor.draw_text(command.rect, command.raw_text, command.alignment, command.color, command.elision, command.wrapping, command.font);
-            },
-            [&](FillRect const& command) {
-                return executor.fill_rect(command.rect, command.color);
-            },
-            [&](DrawScaledBitmap const& command) {
-                return executor.draw_scaled_bitmap(command.dst_rect, command.bitmap, command.src_rect, command.scaling_mode);
-            },
-            [&](DrawScaledImmutableBitmap const& command) {
-                return executor.draw_scaled_immutable_bitmap(command.dst_rect, command.bitmap, command.src_rect, command.scaling_mode);
-            },
-            [&](SetClipRect const& command) {
-                return executor.set_clip_rect(command.rect);
-            },
-            [&](ClearClipRect const&) {
-                return executor.clear_clip_rect();
-            },
-            [&](SetFont const& command) {
-                return executor.set_font(command.font);
-            },
-            [&](PushStackingContext const& command) {
-                return executor.push_stacking_context(command.opacity, command.is_fixed_position, command.source_paintable_rect, command.post_transform_translation, command.image_rendering, command.transform, command.mask);
-            },
-            [&](PopStackingContext const&) {
-                return executor.pop_stacking_context();
-            },
-            [&](PaintLinearGradient const& command) {
-                return executor.paint_linear_gradient(command.gradient_rect, command.linear_gradient_data);
-            },
-            [&](PaintRadialGradient const& command) {
-                return executor.paint_radial_gradient(command.rect, command.radial_gradient_data, command.center, command.size);
-            },
-            [&](PaintConicGradient const& command) {
-                return executor.paint_conic_gradient(command.rect, command.conic_gradient_data, command.position);
-            },
-            [&](PaintOuterBoxShadow const& command) {
-                return executor.paint_outer_box_shadow(command.outer_box_shadow_params);
-            },
-            [&](PaintInnerBoxShadow const& command) {
-                return executor.paint_inner_box_shadow(command.outer_box_shadow_params);
-            },
-            [&](PaintTextShadow const& command) {
-                return executor.paint_text_shadow(command.blur_radius, command.shadow_bounding_rect, command.text_rect, command.glyph_run, command.color, command.fragment_baseline, command.draw_location);
-            },
-            [&](FillRectWithRoundedCorners const& command) {
-                return executor.fill_rect_with_rounded_corners(command.rect, command.color, command.top_left_radius, command.top_right_radius, command.bottom_left_radius, command.bottom_right_radius);
-            },
-            [&](FillPathUsingColor const& command) {
-                return executor.fill_path_using_color(command.path, command.color, command.winding_rule, command.aa_translation);
-            },
-            [&](FillPathUsingPaintStyle const& command) {
-                return executor.fill_path_using_paint_style(command.path, command.paint_style, command.winding_rule, command.opacity, command.aa_translation);
-            },
-            [&](StrokePathUsingColor const& command) {
-                return executor.stroke_path_using_color(command.path, command.color, command.thickness, command.aa_translation);
-            },
-            [&](StrokePathUsingPaintStyle const& command) {
-                return executor.stroke_path_using_paint_style(command.path, command.paint_style, command.thickness, command.opacity, command.aa_translation);
-            },
-            [&](DrawEllipse const& command) {
-                return executor.draw_ellipse(command.rect, command.color, command.thickness);
-            },
-            [&](FillEllipse const& command) {
-                return executor.fill_ellipse(command.rect, command.color, command.blend_mode);
-            },
-            [&](DrawLine const& command) {
-                return executor.draw_line(command.color, command.from, command.to, command.thickness, command.style, command.alternate_color);
-            },
-            [&](DrawSignedDistanceField const& command) {
-                return executor.draw_signed_distance_field(command.rect, command.color, command.sdf, command.smoothing);
-            },
-            [&](PaintFrame const& command) {
-                return executor.paint_frame(command.rect, command.palette, command.style);
-            },
-            [&](ApplyBackdropFilter const& command) {
-                return executor.apply_backdrop_filter(command.backdrop_region, command.backdrop_filter);
-            },
-            [&](DrawRect const& command) {
-                return executor.draw_rect(command.rect, command.color, command.rough);
-            },
-            [&](DrawTriangleWave const& command) {
-                return executor.draw_triangle_wave(command.p1, command.p2, command.color, command.amplitude, command.thickness);
-            },
-            [&](SampleUnderCorners const& command) {
-                return executor.sample_under_corners(command.id, command.corner_radii, command.border_rect, command.corner_clip);
-            },
-            [&](BlitCornerClipping const& command) {
-                if (skipped_sample_corner_commands.contains(command.id)) {
-                    // FIXME: If a sampling command falls outside the viewport and is not executed, the associated blit
-                    //        should also be skipped if it is within the viewport. In a properly generated list of
-                    //        painting commands, sample and blit commands should have matching rectangles, preventing
-                    //        this discrepancy.
-                    dbgln("Skipping blit_corner_clipping command because the sample_under_corners command was skipped.");
-                    return CommandResult::Continue;
-                }
-                return executor.blit_corner_clipping(command.id);
-            },
-            [&](PaintBorders const& command) {
-                return executor.paint_borders(command.border_rect, command.corner_radii, command.borders_data);
-            });
+        auto result = execute_command(executor, command, skipped_sample_corner_commands);
 
         if (result == CommandResult::SkipStackingContext) {
             auto stacking_context_nesting_level = 1;
-            while (next_command_index < m_painting_commands.size()) {
-                if (m_painting_commands[next_command_index].command.has<PushStackingContext>()) {
+            while (next_command_index < command_count) {
+                if (command_at(next_command_index).has<PushStackingContext>()) {
                     stacking_context_nesting_level++;
-                } else if (m_painting_commands[next_command_index].command.has<PopStackingContext>()) {
+                } else if (command_at(next_command_index).has<PopStackingContext>()) {
                     stacking_context_nesting_level--;
                 }
 
@@ -608,4 +542,213 @@ void RecordingPainter::execute(PaintingCommandExecutor& executor)
     }
 }
 
+CommandResult RecordingPainter::execute_command(PaintingCommandExecutor& executor, PaintingCommand const& command, HashTable<u32> const& skipped_sample_corner_commands)
+{
+    return command.visit(
+        [&](DrawGlyphRun const& command) {
+            return executor.draw_glyph_run(command.glyph_run, command.color);
+        },
+        [&](DrawText const& command) {
+            return executor.draw_text(command.rect, command.raw_text, command.alignment, command.color, command.elision, command.wrapping, command.font);
+        },
+        [&](FillRect const& command) {
+            return executor.fill_rect(command.rect, command.color);
+        },
+        [&](DrawScaledBitmap const& command) {
+            return executor.draw_scaled_bitmap(command.dst_rect, command.bitmap, command.src_rect, command.scaling_mode);
+        },
+        [&](DrawScaledImmutableBitmap const& command) {
+            return executor.draw_scaled_immutable_bitmap(command.dst_rect, command.bitmap, command.src_rect, command.scaling_mode);
+        },
+        [&](SetClipRect const& command) {
+            return executor.set_clip_rect(command.rect);
+        },
+        [&](ClearClipRect const&) {
+            return executor.clear_clip_rect();
+        },
+        [&](SetFont const& command) {
+            return executor.set_font(command.font);
+        },
+        [&](PushStackingContext const& command) {
+            return executor.push_stacking_context(command.opacity, command.is_fixed_position, command.source_paintable_rect, command.post_transform_translation, command.image_rendering, command.transform, command.mask);
+        },
+        [&](PopStackingContext const&) {
+            return executor.pop_stacking_context();
+        },
+        [&](PaintLinearGradient const& command) {
+            return executor.paint_linear_gradient(command.gradient_rect, command.linear_gradient_data);
+        },
+        [&](PaintRadialGradient const& command) {
+            return executor.paint_radial_gradient(command.rect, command.radial_gradient_data, command.center, command.size);
+        },
+        [&](PaintConicGradient const& command) {
+            return executor.paint_conic_gradient(command.rect, command.conic_gradient_data, command.position);
+        },
+        [&](PaintOuterBoxShadow const& command) {
+            return executor.paint_outer_box_shadow(command.outer_box_shadow_params);
+        },
+        [&](PaintInnerBoxShadow const& command) {
+            return executor.paint_inner_box_shadow(command.outer_box_shadow_params);
+        },
+        [&](PaintTextShadow const& command) {
+            return executor.paint_text_shadow(command.blur_radius, command.shadow_bounding_rect, command.text_rect, command.glyph_run, command.color, command.fragment_baseline, command.draw_location);
+        },
+        [&](FillRectWithRoundedCorners const& command) {
+            return executor.fill_rect_with_rounded_corners(command.rect, command.color, command.top_left_radius, command.top_right_radius, command.bottom_left_radius, command.bottom_right_radius);
+        },
+        [&](FillPathUsingColor const& command) {
+            return executor.fill_path_using_color(command.path, command.color, command.winding_rule, command.aa_translation);
+        },
+        [&](FillPathUsingPaintStyle const& command) {
+            return executor.fill_path_using_paint_style(command.path, command.paint_style, command.winding_rule, command.opacity, command.aa_translation);
+        },
+        [&](StrokePathUsingColor const& command) {
+            return executor.stroke_path_using_color(command.path, command.color, command.thickness, command.aa_translation);
+        },
+        [&](StrokePathUsingPaintStyle const& command) {
+            return executor.stroke_path_using_paint_style(command.path, command.paint_style, command.thickness, command.opacity, command.aa_translation);
+        },
+        [&](DrawEllipse const& command) {
+            return executor.draw_ellipse(command.rect, command.color, command.thickness);
+        },
+        [&](FillEllipse const& command) {
+            return executor.fill_ellipse(command.rect, command.color, command.blend_mode);
+        },
+        [&](DrawLine const& command) {
+            return executor.draw_line(command.color, command.from, command.to, command.thickness, command.style, command.alternate_color);
+        },
+        [&](DrawSignedDistanceField const& command) {
+            return executor.draw_signed_distance_field(command.rect, command.color, command.sdf, command.smoothing);
+        },
+        [&](PaintFrame const& command) {
+            return executor.paint_frame(command.rect, command.palette, command.style);
+        },
+        [&](ApplyBackdropFilter const& command) {
+            return executor.apply_backdrop_filter(command.backdrop_region, command.backdrop_filter);
+        },
+        [&](DrawRect const& command) {
+            return executor.draw_rect(command.rect, command.color, command.rough);
+        },
+        [&](DrawTriangleWave const& command) {
+            return executor.draw_triangle_wave(command.p1, command.p2, command.color, command.amplitude, command.thickness);
+        },
+        [&](SampleUnderCorners const& command) {
+            return executor.sample_under_corners(command.id, command.corner_radii, command.border_rect, command.corner_clip);
+        },
+        [&](BlitCornerClipping const& command) {
+            if (skipped_sample_corner_commands.contains(command.id)) {
+                // FIXME: If a sampling command falls outside the viewport and is not executed, the associated blit
+                //        should also be skipped if it is within the viewport. In a properly generated list of
+                //        painting commands, sample and blit commands should have matching rectangles, preventing
+                //        this discrepancy.
+                dbgln("Skipping blit_corner_clipping command because the sample_under_corners command was skipped.");
+                return CommandResult::Continue;
+            }
+            return executor.blit_corner_clipping(command.id);
+        },
+        [&](PaintBorders const& command) {
+            return executor.paint_borders(command.border_rect, command.corner_radii, command.borders_data);
+        });
+
+}
+
+
+bool RecordingPainter::can_execute_in_tiles() const
+{
+    // For each stacking context we're in, whether it paints into a bitmap of its own.
+    Vector<bool> stacking_context_has_own_bitmap;
+    for (auto const& command_with_scroll_id : m_painting_commands) {
+        auto const& command = command_with_scroll_id.command;
+        if (auto const* push_stacking_context = command.get_pointer<PushStackingContext>()) {
+            // Scaled or rotated contents get resampled from the pixels around them.
+            auto affine_transform = Gfx::extract_2d_affine_transform(push_stacking_context->transform.matrix);
+            if (!push_stacking_context->mask.has_value() && !affine_transform.is_identity_or_translation())
+                return false;
+            // Fixed position stacking contexts are positioned relative to the bitmap they're painted into.
+            if (push_stacking_context->is_fixed_position && stacking_context_has_own_bitmap.contains_slow(true))
+                return false;
+            stacking_context_has_own_bitmap.append(push_stacking_context->opacity != 1.0f || push_stacking_context->mask.has_value());
+        } else if (command.has<PopStackingContext>()) {
+            if (!stacking_context_has_own_bitmap.is_empty())
+                stacking_context_has_own_bitmap.take_last();
+        } else if (command.has<ApplyBackdropFilter>()) {
+            // Blurring reads the pixels around each pixel, some of which may be in another tile.
+            return false;
+        } else if (command.has<FillPathUsingPaintStyle>() || command.has<StrokePathUsingColor>() || command.has<StrokePathUsingPaintStyle>()) {
+            // These copy the path's reference counted segments, or use paint styles that may cache their state.
+            return false;
+        }
+    }
+    return true;
+}
+
+Vector<Vector<size_t>> RecordingPainter::bin_commands_into_tiles(ReadonlySpan<Gfx::IntRect> tiles) const
+{
+    Vector<Vector<size_t>> command_indices_per_tile;
+    command_indices_per_tile.resize(tiles.size());
+
+    // The offset from the coordinates used inside each stacking context we're in to the coordinates of the target bitmap.
+    Vector<Gfx::IntPoint> stacking_context_offsets;
+    stacking_context_offsets.append({});
+
+    for (size_t command_index = 0; command_index < m_painting_commands.size(); ++command_index) {
+        auto const& command = m_painting_commands[command_index].command;
+        if (auto const* push_stacking_context = command.get_pointer<PushStackingContext>()) {
+            auto offset = push_stacking_context->is_fixed_position ? Gfx::IntPoint {} : stacking_context_offsets.last();
+            offset.translate_by(push_stacking_context->post_transform_translation);
+            if (!push_stacking_context->mask.has_value())
+                offset.translate_by(Gfx::extract_2d_affine_transform(push_stacking_context->transform.matrix).translation().to_rounded<int>());
+            stacking_context_offsets.append(offset);
+        } else if (command.has<PopStackingContext>()) {
+            if (stacking_context_offsets.size() > 1)
+                stacking_context_offsets.take_last();
+        }
+
+        // Commands without a bounding rect, like stacking context pushes and pops and clip rect changes, affect every tile.
+        auto bounding_rect = command_bounding_rectangle(command);
+        if (!bounding_rect.has_value()) {
+            for (auto& command_indices : command_indices_per_tile)
+                command_indices.append(command_index);
+            continue;
+        }
+
+        auto rect = bounding_rect->translated(stacking_context_offsets.last());
+        // Stacking contexts with their own bitmap round their position slightly differently.
+        if (stacking_context_offsets.size() > 1)
+            rect.inflate(2, 2);
+        for (size_t tile_index = 0; tile_index < tiles.size(); ++tile_index) {
+            if (tiles[tile_index].intersects(rect))
+                command_indices_per_tile[tile_index].append(command_index);
+        }
+    }
+
+    return command_indices_per_tile;
+}
+
+void RecordingPainter::prepare_for_concurrent_execution() const
+{
+    auto rasterize_glyphs = [](ReadonlySpan<Gfx::DrawGlyphOrEmoji> glyph_run) {
+        for (auto const& glyph_or_emoji : glyph_run) {
+            if (!glyph_or_emoji.has<Gfx::DrawGlyph>())
+                continue;
+            // NOTE: This matches how Gfx::Painter::draw_glyph() looks up the glyph to draw.
+            auto const& glyph = glyph_or_emoji.get<Gfx::DrawGlyph>();
+            auto top_left = glyph.position + Gfx::FloatPoint(glyph.font->glyph_left_bearing(glyph.code_point), 0);
+            auto glyph_position = Gfx::GlyphRasterPosition::get_nearest_fit_for(top_left);
+            (void)glyph.font->glyph(glyph.code_point, glyph_position.subpixel_offset);
+        }
+    };
+
+    for (auto const& command_with_scroll_id : m_painting_commands) {
+        command_with_scroll_id.command.visit(
+            [&](DrawGlyphRun const& command) { rasterize_glyphs(command.glyph_run); },
+            [&](PaintTextShadow const& command) { rasterize_glyphs(command.glyph_run); },
+            [&](FillPathUsingColor const& command) {
+                (void)command.path.split_lines();
+                (void)command.path.bounding_box();
+            },
+            [&](auto const&) {});
+    }
+}
+
 }
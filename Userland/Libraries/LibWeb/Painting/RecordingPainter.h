@@ -597,6 +597,18 @@ public:
 
     void execute(PaintingCommandExecutor&);
 
+    // Executes only the commands at the given indices, which have to include every stacking context push and pop.
+    void execute(PaintingCommandExecutor&, ReadonlySpan<size_t> command_indices);
+
+    // Whether painting each tile of the target separately, using only the commands returned by bin_commands_into_tiles(),
+    // produces the same pixels as executing all commands at once. This is not the case when a command reads back pixels
+    // around it, or when commands share data that can't be used from multiple threads.
+    bool can_execute_in_tiles() const;
+    Vector<Vector<size_t>> bin_commands_into_tiles(ReadonlySpan<Gfx::IntRect> tiles) const;
+
+    // Fills the caches that painting fills lazily otherwise, so that the commands can be executed on several threads at once.
+    void prepare_for_concurrent_execution() const;
+
     RecordingPainter()
     {
         m_state_stack.append(State());
@@ -604,12 +616,29 @@ public:
 
     void apply_scroll_offsets(Vector<Gfx::IntPoint> const& offsets_by_frame_id);
 
+    struct PaintingCommandWithScrollFrame {
+        Optional<i32> scroll_frame_id;
+        PaintingCommand command;
+    };
+
+    size_t command_count() const { return m_painting_commands.size(); }
+
+    // Copies the commands recorded since the given index, so that they can be appended to a later recording again.
+    Vector<PaintingCommandWithScrollFrame> copy_commands_since(size_t index) const;
+
+    // Appends previously recorded commands. The ids of corner clippers are mapped to new ones using the given callback,
+    // since they are only unique within a single recording.
+    void append_commands(ReadonlySpan<PaintingCommandWithScrollFrame>, Function<u32(u32)> const& map_corner_clipper_id);
+
 private:
     struct State {
         Gfx::AffineTransform translation;
         Optional<Gfx::IntRect> clip_rect;
         Optional<i32> scroll_frame_id;
     };
+    void execute_commands(PaintingCommandExecutor&, size_t command_count, Function<PaintingCommand const&(size_t)> const& command_at);
+    CommandResult execute_command(PaintingCommandExecutor&, PaintingCommand const&, HashTable<u32> const& skipped_sample_corner_commands);
+
     State& state() { return m_state_stack.last(); }
     State const& state() const { return m_state_stack.last(); }
 
@@ -618,11 +647,6 @@ private:
         m_painting_commands.append({ state().scroll_frame_id, command });
     }
 
-    struct PaintingCommandWithScrollFrame {
-        Optional<i32> scroll_frame_id;
-        PaintingCommand command;
-    };
-
     Vector<PaintingCommandWithScrollFrame> m_painting_commands;
     Vector<State> m_state_stack;
 };
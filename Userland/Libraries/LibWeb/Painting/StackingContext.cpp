@@ -360,9 +360,71 @@ void StackingContext::paint(PaintContext& context) const
         }
     }
 
-    context.recording_painter().push_stacking_context(push_stacking_context_params);
-    paint_internal(context);
-    context.recording_painter().pop_stacking_context();
+    auto& recording_painter = context.recording_painter();
+    recording_painter.push_stacking_context(push_stacking_context_params);
+
+    if (m_cached_display_list.has_value() && m_cached_display_list->can_be_reused_in(context)) {
+        // Corner clipper ids are only unique within one recording, so the reused commands get fresh ones.
+        HashMap<u32, u32> corner_clipper_ids;
+        recording_painter.append_commands(m_cached_display_list->commands, [&](u32 id) {
+            return corner_clipper_ids.ensure(id, [&] { return context.allocate_corner_clipper_id(); });
+        });
+        if (m_cached_display_list->device_viewport_rect.has_value())
+            context.set_has_painted_viewport_dependent_content(true);
+    } else {
+        auto first_command_index = recording_painter.command_count();
+        auto generation = m_display_list_generation;
+        auto has_painted_viewport_dependent_content = context.has_painted_viewport_dependent_content();
+        context.set_has_painted_viewport_dependent_content(false);
+
+        paint_internal(context);
+
+        // Painting SVG content applies a transform that isn't part of the recording painter's state.
+        if (generation == m_display_list_generation && context.svg_transform().is_identity()) {
+            m_cached_display_list = CachedDisplayList {
+                .device_pixels_per_css_pixel = context.device_pixels_per_css_pixel(),
+                .palette = &context.palette().impl(),
+                .has_focus = context.has_focus(),
+                .should_show_line_box_borders = context.should_show_line_box_borders(),
+                .should_paint_overlay = context.should_paint_overlay(),
+                .device_viewport_rect = context.has_painted_viewport_dependent_content() ? context.device_viewport_rect() : Optional<DevicePixelRect> {},
+                .commands = recording_painter.copy_commands_since(first_command_index),
+            };
+        }
+
+        if (has_painted_viewport_dependent_content)
+            context.set_has_painted_viewport_dependent_content(true);
+    }
+
+    recording_painter.pop_stacking_context();
+}
+
+bool StackingContext::CachedDisplayList::can_be_reused_in(PaintContext const& context) const
+{
+    if (device_viewport_rect.has_value() && *device_viewport_rect != context.device_viewport_rect())
+        return false;
+    return device_pixels_per_css_pixel == context.device_pixels_per_css_pixel()
+        && palette == &context.palette().impl()
+        && has_focus == context.has_focus()
+        && should_show_line_box_borders == context.should_show_line_box_borders()
+        && should_paint_overlay == context.should_paint_overlay()
+        && context.svg_transform().is_identity();
+}
+
+void StackingContext::invalidate_cached_display_list() const
+{
+    for (auto const* stacking_context = this; stacking_context; stacking_context = stacking_context->parent()) {
+        stacking_context->m_cached_display_list.clear();
+        ++stacking_context->m_display_list_generation;
+    }
+}
+
+void StackingContext::invalidate_cached_display_lists_in_subtree() const
+{
+    m_cached_display_list.clear();
+    ++m_display_list_generation;
+    for (auto const* child : m_children)
+        child->invalidate_cached_display_lists_in_subtree();
 }
 
 Gfx::FloatPoint StackingContext::compute_transform_origin() const
@@ -9,6 +9,8 @@
 #include <AK/Vector.h>
 #include <LibGfx/Matrix4x4.h>
 #include <LibWeb/Painting/Paintable.h>
+#include <LibWeb/Painting/RecordingPainter.h>
+#include <LibWeb/PixelUnits.h>
 
 namespace Web::Painting {
 
@@ -41,7 +43,29 @@ public:
 
     void sort();
 
+    // Drops the commands recorded for this stacking context, and for its ancestors, whose recordings contain them.
+    void invalidate_cached_display_list() const;
+    void invalidate_cached_display_lists_in_subtree() const;
+
 private:
+    // The commands recorded between pushing and popping this stacking context the last time it was painted.
+    // They don't depend on where the stacking context is painted, so they can be reused as long as nothing
+    // inside it changes, and the paint context is set up the same way.
+    struct CachedDisplayList {
+        double device_pixels_per_css_pixel { 0 };
+        Gfx::PaletteImpl const* palette { nullptr };
+        bool has_focus { false };
+        bool should_show_line_box_borders { false };
+        bool should_paint_overlay { false };
+        // Only set if the commands depend on the viewport rect.
+        Optional<DevicePixelRect> device_viewport_rect;
+        Vector<RecordingPainter::PaintingCommandWithScrollFrame> commands;
+
+        bool can_be_reused_in(PaintContext const&) const;
+    };
+    mutable Optional<CachedDisplayList> m_cached_display_list;
+    mutable u64 m_display_list_generation { 0 };
+
     JS::NonnullGCPtr<PaintableBox> m_paintable_box;
     Gfx::FloatMatrix4x4 m_transform;
     Gfx::FloatPoint m_transform_origin;
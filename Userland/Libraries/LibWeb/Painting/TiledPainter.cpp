@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Bitmap.h>
+#include <LibWeb/Painting/PaintingCommandExecutorCPU.h>
+#include <LibWeb/Painting/TiledPainter.h>
+#include <unistd.h>
+
+namespace Web::Painting {
+
+static TiledPainter* s_the;
+
+TiledPainter& TiledPainter::the()
+{
+    if (!s_the)
+        s_the = new TiledPainter;
+    return *s_the;
+}
+
+TiledPainter::TiledPainter()
+{
+    auto processor_count = sysconf(_SC_NPROCESSORS_ONLN);
+    set_thread_count(processor_count > 0 ? processor_count : 1);
+}
+
+void TiledPainter::set_thread_count(size_t thread_count)
+{
+    VERIFY(thread_count > 0);
+    stop_worker_threads();
+
+    for (size_t i = 1; i < thread_count; ++i) {
+        auto thread_or_error = Threading::Thread::try_create([this] {
+            while (true) {
+                {
+                    Threading::MutexLocker locker(m_mutex);
+                    while (!m_should_stop && m_next_job_index >= m_job_count)
+                        m_job_available.wait();
+                    if (m_should_stop)
+                        return 0;
+                }
+                run_jobs_until_none_are_left();
+            }
+        },
+            "Painting"sv);
+        if (thread_or_error.is_error()) {
+            dbgln("Unable to create painting thread: {}", thread_or_error.error());
+            break;
+        }
+        auto thread = thread_or_error.release_value();
+        thread->start();
+        m_worker_threads.append(move(thread));
+    }
+}
+
+void TiledPainter::stop_worker_threads()
+{
+    {
+        Threading::MutexLocker locker(m_mutex);
+        m_should_stop = true;
+        m_job_available.broadcast();
+    }
+    for (auto& thread : m_worker_threads)
+        (void)thread->join();
+    m_worker_threads.clear();
+    m_should_stop = false;
+}
+
+void TiledPainter::execute(RecordingPainter& recording_painter, Gfx::Bitmap& target)
+{
+    execute(recording_painter, target, target.rect());
+}
+
+void TiledPainter::execute(RecordingPainter& recording_painter, Gfx::Bitmap& target, Gfx::IntRect const& damaged_rect)
+{
+    auto execute_on_this_thread = [&] {
+        PaintingCommandExecutorCPU executor { target };
+        recording_painter.execute(executor);
+    };
+
+    auto rect = damaged_rect.intersected(target.rect());
+    if (rect.is_empty())
+        return;
+
+    if (target.scale() != 1 || !recording_painter.can_execute_in_tiles())
+        return execute_on_this_thread();
+
+    // Splitting the whole target into tiles only pays off when there are threads to paint them.
+    bool paints_whole_target = rect == target.rect();
+    if (paints_whole_target && m_worker_threads.is_empty())
+        return execute_on_this_thread();
+
+    Vector<Gfx::IntRect> tiles;
+    for (int y = rect.top(); y < rect.bottom(); y += tile_size) {
+        for (int x = rect.left(); x < rect.right(); x += tile_size)
+            tiles.append(Gfx::IntRect { x, y, tile_size, tile_size }.intersected(rect));
+    }
+    if (paints_whole_target && tiles.size() < 2)
+        return execute_on_this_thread();
+
+    // Each tile is painted through a bitmap sharing its part of the target's pixels, so no pixels have to be copied.
+    Vector<NonnullRefPtr<Gfx::Bitmap>> tile_bitmaps;
+    tile_bitmaps.ensure_capacity(tiles.size());
+    for (auto const& tile : tiles) {
+        auto bitmap_or_error = Gfx::Bitmap::create_wrapper(target.format(), tile.size(), 1, target.pitch(), target.scanline(tile.y()) + tile.x());
+        if (bitmap_or_error.is_error())
+            return execute_on_this_thread();
+        tile_bitmaps.unchecked_append(bitmap_or_error.release_value());
+    }
+
+    auto command_indices_per_tile = recording_painter.bin_commands_into_tiles(tiles);
+    recording_painter.prepare_for_concurrent_execution();
+
+    run_in_parallel(tiles.size(), [&](size_t tile_index) {
+        PaintingCommandExecutorCPU executor { *tile_bitmaps[tile_index], tiles[tile_index].location() };
+        recording_painter.execute(executor, command_indices_per_tile[tile_index]);
+    });
+}
+
+void TiledPainter::run_in_parallel(size_t job_count, Function<void(size_t)> job)
+{
+    {
+        Threading::MutexLocker locker(m_mutex);
+        m_job = move(job);
+        m_job_count = job_count;
+        m_next_job_index = 0;
+        m_unfinished_job_count = job_count;
+        m_job_available.broadcast();
+    }
+
+    run_jobs_until_none_are_left();
+
+    Threading::MutexLocker locker(m_mutex);
+    while (m_unfinished_job_count > 0)
+        m_all_jobs_finished.wait();
+    m_job = nullptr;
+    m_job_count = 0;
+    m_next_job_index = 0;
+}
+
+void TiledPainter::run_jobs_until_none_are_left()
+{
+    while (true) {
+        size_t job_index = 0;
+        {
+            Threading::MutexLocker locker(m_mutex);
+            if (m_next_job_index >= m_job_count)
+                return;
+            job_index = m_next_job_index++;
+        }
+
+        // NOTE: m_job is only replaced once every job has finished, so it's safe to call without holding the lock.
+        m_job(job_index);
+
+        Threading::MutexLocker locker(m_mutex);
+        if (--m_unfinished_job_count == 0)
+            m_all_jobs_finished.broadcast();
+    }
+}
+
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Vector.h>
+#include <LibGfx/Forward.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/Thread.h>
+#include <LibWeb/Painting/RecordingPainter.h>
+
+namespace Web::Painting {
+
+// Executes recorded painting commands on a pool of worker threads. The target bitmap is split into tiles, and each
+// tile is painted separately using only the commands whose bounding rect touches it.
+class TiledPainter {
+public:
+    static constexpr int tile_size = 256;
+
+    static TiledPainter& the();
+
+    // The number of threads painting tiles, including the thread calling execute().
+    size_t thread_count() const { return m_worker_threads.size() + 1; }
+    void set_thread_count(size_t);
+
+    void execute(RecordingPainter&, Gfx::Bitmap& target);
+
+    // Only paints the pixels inside the damaged rect, using only the commands that touch it. The rest of the target is
+    // expected to hold the same pixels the commands would paint there already. When the commands can't be executed
+    // in tiles, the whole target is painted instead.
+    void execute(RecordingPainter&, Gfx::Bitmap& target, Gfx::IntRect const& damaged_rect);
+
+private:
+    TiledPainter();
+
+    void run_in_parallel(size_t job_count, Function<void(size_t)> job);
+    void run_jobs_until_none_are_left();
+    void stop_worker_threads();
+
+    Vector<NonnullRefPtr<Threading::Thread>> m_worker_threads;
+
+    Threading::Mutex m_mutex;
+    Threading::ConditionVariable m_job_available { m_mutex };
+    Threading::ConditionVariable m_all_jobs_finished { m_mutex };
+    Function<void(size_t)> m_job;
+    size_t m_job_count { 0 };
+    size_t m_next_job_index { 0 };
+    size_t m_unfinished_job_count { 0 };
+    bool m_should_stop { false };
+};
+
+}
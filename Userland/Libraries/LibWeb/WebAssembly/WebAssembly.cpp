@@ -290,6 +290,9 @@ JS::ThrowCompletionOr<size_t> instantiate_module(JS::VM& vm, Wasm::Module const&
         return vm.throw_completion<JS::TypeError>(MUST(builder.to_string()));
     }
 
+    if (getenv("LIBWASM_JIT"))
+        s_abstract_machine.enable_jit();
+
     auto instance_result = s_abstract_machine.instantiate(module, link_result.release_value());
     if (instance_result.is_error()) {
         // FIXME: Throw a LinkError instead.
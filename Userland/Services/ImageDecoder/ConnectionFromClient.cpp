@@ -22,10 +22,10 @@ void ConnectionFromClient::die()
     Core::EventLoop::current().quit(0);
 }
 
-static void decode_image_to_bitmaps_and_durations_with_decoder(Gfx::ImageDecoder const& decoder, Vector<Gfx::ShareableBitmap>& bitmaps, Vector<u32>& durations)
+static void decode_image_to_bitmaps_and_durations_with_decoder(Gfx::ImageDecoder const& decoder, Optional<Gfx::IntSize> ideal_size, Vector<Gfx::ShareableBitmap>& bitmaps, Vector<u32>& durations)
 {
     for (size_t i = 0; i < decoder.frame_count(); ++i) {
-        auto frame_or_error = decoder.frame(i);
+        auto frame_or_error = decoder.frame(i, ideal_size);
         if (frame_or_error.is_error()) {
             bitmaps.append(Gfx::ShareableBitmap {});
             durations.append(0);
@@ -37,7 +37,7 @@ static void decode_image_to_bitmaps_and_durations_with_decoder(Gfx::ImageDecoder
     }
 }
 
-static void decode_image_to_details(Core::AnonymousBuffer const& encoded_buffer, Optional<ByteString> const& known_mime_type, bool& is_animated, u32& loop_count, Vector<Gfx::ShareableBitmap>& bitmaps, Vector<u32>& durations)
+static void decode_image_to_details(Core::AnonymousBuffer const& encoded_buffer, Optional<ByteString> const& known_mime_type, Optional<Gfx::IntSize> ideal_size, bool& is_animated, u32& loop_count, Vector<Gfx::ShareableBitmap>& bitmaps, Vector<u32>& durations)
 {
     VERIFY(bitmaps.size() == 0);
     VERIFY(durations.size() == 0);
@@ -54,10 +54,10 @@ static void decode_image_to_details(Core::AnonymousBuffer const& encoded_buffer,
     }
     is_animated = decoder->is_animated();
     loop_count = decoder->loop_count();
-    decode_image_to_bitmaps_and_durations_with_decoder(*decoder, bitmaps, durations);
+    decode_image_to_bitmaps_and_durations_with_decoder(*decoder, ideal_size, bitmaps, durations);
 }
 
-Messages::ImageDecoderServer::DecodeImageResponse ConnectionFromClient::decode_image(Core::AnonymousBuffer const& encoded_buffer, Optional<ByteString> const& mime_type)
+Messages::ImageDecoderServer::DecodeImageResponse ConnectionFromClient::decode_image(Core::AnonymousBuffer const& encoded_buffer, Optional<ByteString> const& mime_type, Optional<Gfx::IntSize> const& ideal_size)
 {
     if (!encoded_buffer.is_valid()) {
         dbgln_if(IMAGE_DECODER_DEBUG, "Encoded data is invalid");
@@ -68,8 +68,136 @@ Messages::ImageDecoderServer::DecodeImageResponse ConnectionFromClient::decode_i
     u32 loop_count = 0;
     Vector<Gfx::ShareableBitmap> bitmaps;
     Vector<u32> durations;
-    decode_image_to_details(encoded_buffer, mime_type, is_animated, loop_count, bitmaps, durations);
+    decode_image_to_details(encoded_buffer, mime_type, ideal_size, is_animated, loop_count, bitmaps, durations);
     return { is_animated, loop_count, bitmaps, durations };
 }
 
+Messages::ImageDecoderServer::BeginDecodeSessionResponse ConnectionFromClient::begin_decode_session(Optional<ByteString> const& mime_type)
+{
+    auto session_id = m_next_session_id++;
+    auto session = make<DecodeSession>();
+    session->mime_type = mime_type;
+    m_sessions.set(session_id, move(session));
+    return session_id;
+}
+
+ConnectionFromClient::DecodeSession* ConnectionFromClient::find_session(i32 session_id)
+{
+    auto session = m_sessions.get(session_id);
+    if (!session.has_value()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "Unknown decode session {}", session_id);
+        return nullptr;
+    }
+    if ((*session)->has_failed)
+        return nullptr;
+    return session.value();
+}
+
+void ConnectionFromClient::append_encoded_data(i32 session_id, ByteBuffer const& data)
+{
+    auto* session = find_session(session_id);
+    if (!session || session->decoder)
+        return;
+
+    if (session->encoded_data.try_append(data).is_error()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "Could not buffer encoded data for decode session {}", session_id);
+        fail_session(session_id, *session);
+        return;
+    }
+
+    if (session->encoded_data.size() >= session->next_partial_decode_size)
+        try_decode_partial_frame(session_id, *session);
+}
+
+void ConnectionFromClient::try_decode_partial_frame(i32 session_id, DecodeSession& session)
+{
+    // Decoding starts over from the beginning every time, so only do it once the data has grown by a good fraction.
+    static constexpr size_t minimum_growth = 16 * KiB;
+    auto size = session.encoded_data.size();
+    session.next_partial_decode_size = max(size + minimum_growth, size + size / 2);
+
+    // The decoder only sees the data received so far, so it's thrown away again once the partial frame is decoded.
+    auto decoder = Gfx::ImageDecoder::try_create_for_raw_bytes(session.encoded_data.bytes(), session.mime_type);
+    if (!decoder)
+        return;
+
+    send_size_if_needed(session_id, session, *decoder);
+
+    auto frame_or_error = decoder->partial_frame(0);
+    if (frame_or_error.is_error()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "Could not decode partial frame for decode session {}: {}", session_id, frame_or_error.error());
+        return;
+    }
+    auto frame = frame_or_error.release_value();
+    async_did_decode_frame(session_id, 0, frame.image->to_shareable_bitmap(), frame.duration, false);
+}
+
+void ConnectionFromClient::finish_encoded_data(i32 session_id)
+{
+    auto* session = find_session(session_id);
+    if (!session || session->decoder)
+        return;
+
+    session->decoder = Gfx::ImageDecoder::try_create_for_raw_bytes(session->encoded_data.bytes(), session->mime_type);
+    if (!session->decoder || !session->decoder->frame_count()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "Could not decode image for decode session {}", session_id);
+        fail_session(session_id, *session);
+        return;
+    }
+
+    auto& decoder = *session->decoder;
+    send_size_if_needed(session_id, *session, decoder);
+    async_did_decode_image_metadata(session_id, decoder.is_animated(), decoder.loop_count(), decoder.frame_count());
+
+    // The other frames of an animation are only decoded once the client asks for them.
+    send_frame(session_id, *session, 0);
+}
+
+void ConnectionFromClient::decode_frame(i32 session_id, u32 frame_index)
+{
+    auto* session = find_session(session_id);
+    if (!session)
+        return;
+
+    if (!session->decoder || frame_index >= session->decoder->frame_count()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "Frame {} can't be decoded for decode session {}", frame_index, session_id);
+        return;
+    }
+    send_frame(session_id, *session, frame_index);
+}
+
+void ConnectionFromClient::end_decode_session(i32 session_id)
+{
+    m_sessions.remove(session_id);
+}
+
+void ConnectionFromClient::send_size_if_needed(i32 session_id, DecodeSession& session, Gfx::ImageDecoder const& decoder)
+{
+    if (session.did_send_size)
+        return;
+    session.did_send_size = true;
+    async_did_decode_image_size(session_id, decoder.size());
+}
+
+void ConnectionFromClient::send_frame(i32 session_id, DecodeSession& session, u32 frame_index)
+{
+    auto frame_or_error = session.decoder->frame(frame_index);
+    if (frame_or_error.is_error()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "Could not decode frame {} for decode session {}: {}", frame_index, session_id, frame_or_error.error());
+        fail_session(session_id, session);
+        return;
+    }
+    auto frame = frame_or_error.release_value();
+    async_did_decode_frame(session_id, frame_index, frame.image->to_shareable_bitmap(), frame.duration, true);
+}
+
+void ConnectionFromClient::fail_session(i32 session_id, DecodeSession& session)
+{
+    // Keep the session around until the client ends it, but drop everything it was holding on to.
+    session.has_failed = true;
+    session.decoder = nullptr;
+    session.encoded_data.clear();
+    async_did_fail_to_decode(session_id);
+}
+
 }
@@ -6,10 +6,13 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
 #include <ImageDecoder/Forward.h>
 #include <ImageDecoder/ImageDecoderClientEndpoint.h>
 #include <ImageDecoder/ImageDecoderServerEndpoint.h>
+#include <LibGfx/ImageFormats/ImageDecoder.h>
 #include <LibIPC/ConnectionFromClient.h>
 
 namespace ImageDecoder {
@@ -26,7 +29,33 @@ public:
 private:
     explicit ConnectionFromClient(NonnullOwnPtr<Core::LocalSocket>);
 
-    virtual Messages::ImageDecoderServer::DecodeImageResponse decode_image(Core::AnonymousBuffer const&, Optional<ByteString> const& mime_type) override;
+    virtual Messages::ImageDecoderServer::DecodeImageResponse decode_image(Core::AnonymousBuffer const&, Optional<ByteString> const& mime_type, Optional<Gfx::IntSize> const& ideal_size) override;
+
+    virtual Messages::ImageDecoderServer::BeginDecodeSessionResponse begin_decode_session(Optional<ByteString> const& mime_type) override;
+    virtual void append_encoded_data(i32 session_id, ByteBuffer const&) override;
+    virtual void finish_encoded_data(i32 session_id) override;
+    virtual void decode_frame(i32 session_id, u32 frame_index) override;
+    virtual void end_decode_session(i32 session_id) override;
+
+    // An image that is decoded while its data is still arriving. Until all of it has been received, the data received
+    // so far is decoded again every time it has grown enough, and whatever could be decoded is sent as a partial frame.
+    struct DecodeSession {
+        Optional<ByteString> mime_type;
+        ByteBuffer encoded_data;
+        RefPtr<Gfx::ImageDecoder> decoder;
+        size_t next_partial_decode_size { 0 };
+        bool did_send_size { false };
+        bool has_failed { false };
+    };
+
+    DecodeSession* find_session(i32 session_id);
+    void try_decode_partial_frame(i32 session_id, DecodeSession&);
+    void send_size_if_needed(i32 session_id, DecodeSession&, Gfx::ImageDecoder const&);
+    void send_frame(i32 session_id, DecodeSession&, u32 frame_index);
+    void fail_session(i32 session_id, DecodeSession&);
+
+    HashMap<i32, NonnullOwnPtr<DecodeSession>> m_sessions;
+    i32 m_next_session_id { 1 };
 };
 
 }
@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/File.h>
+#include <RequestServer/CachedRequest.h>
+
+namespace RequestServer {
+
+CachedRequest::CachedRequest(ConnectionFromClient& client, URL url, NonnullOwnPtr<Core::File>&& output_stream)
+    : Request(client, move(output_stream))
+    , m_url(move(url))
+{
+}
+
+NonnullOwnPtr<CachedRequest> CachedRequest::create(ConnectionFromClient& client, URL url, NonnullOwnPtr<Core::File>&& output_stream)
+{
+    return adopt_own(*new CachedRequest(client, move(url), move(output_stream)));
+}
+
+}
@@ -8,6 +8,7 @@
 #include <AK/NonnullOwnPtr.h>
 #include <LibCore/Proxy.h>
 #include <RequestServer/ConnectionFromClient.h>
+#include <RequestServer/HttpCache.h>
 #include <RequestServer/Protocol.h>
 #include <RequestServer/Request.h>
 #include <RequestServer/RequestClientEndpoint.h>
@@ -170,4 +171,16 @@ void ConnectionFromClient::ensure_connection(URL const& url, ::RequestServer::Ca
         dbgln("EnsureConnection: Invalid URL scheme: '{}'", url.scheme());
 }
 
+Messages::RequestServer::CacheStatisticsResponse ConnectionFromClient::cache_statistics()
+{
+    auto& cache = HttpCache::the();
+    auto const& statistics = cache.statistics();
+    return { statistics.hit_count, statistics.miss_count, statistics.revalidation_count, cache.stored_size(), cache.entry_count() };
+}
+
+void ConnectionFromClient::clear_cache()
+{
+    HttpCache::the().clear();
+}
+
 }
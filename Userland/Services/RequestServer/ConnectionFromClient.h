@@ -36,6 +36,8 @@ private:
     virtual Messages::RequestServer::StopRequestResponse stop_request(i32) override;
     virtual Messages::RequestServer::SetCertificateResponse set_certificate(i32, ByteString const&, ByteString const&) override;
     virtual void ensure_connection(URL const& url, ::RequestServer::CacheLevel const& cache_level) override;
+    virtual Messages::RequestServer::CacheStatisticsResponse cache_statistics() override;
+    virtual void clear_cache() override;
 
     HashMap<i32, OwnPtr<Request>> m_requests;
 };
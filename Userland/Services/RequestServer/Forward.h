@@ -8,9 +8,11 @@
 
 namespace RequestServer {
 
+class CachedRequest;
 class ConnectionFromClient;
 class Request;
 class GeminiProtocol;
+class HttpCache;
 class HttpRequest;
 class HttpProtocol;
 class HttpsRequest;
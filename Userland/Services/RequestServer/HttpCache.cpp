@@ -0,0 +1,406 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/Hex.h>
+#include <AK/JsonObject.h>
+#include <AK/QuickSort.h>
+#include <LibCore/DirIterator.h>
+#include <LibCore/Directory.h>
+#include <LibCore/StandardPaths.h>
+#include <LibCore/System.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <RequestServer/HttpCache.h>
+
+namespace RequestServer {
+
+static HttpCache* s_the;
+
+HttpCache& HttpCache::the()
+{
+    if (!s_the)
+        s_the = new HttpCache;
+    return *s_the;
+}
+
+static constexpr StringView lock_file_name = "lock"sv;
+
+HttpCache::HttpCache()
+{
+    auto base_directory = ByteString::formatted("{}/RequestServer", Core::StandardPaths::cache_directory());
+    for (size_t i = 0; i < max_directory_count; ++i) {
+        auto directory = ByteString::formatted("{}/{}", base_directory, i);
+        if (auto result = Core::Directory::create(directory, Core::Directory::CreateDirectories::Yes); result.is_error()) {
+            dbgln("HttpCache: Unable to create {}, not caching anything: {}", directory, result.error());
+            return;
+        }
+
+        // The lock is held until the process exits, so no other process touches the directory while we use it.
+        m_lock_file_path = ByteString::formatted("{}/{}", directory, lock_file_name);
+        m_lock_file = make<Core::LockFile>(m_lock_file_path.characters());
+        if (m_lock_file->is_held()) {
+            m_directory = move(directory);
+            m_is_usable = true;
+            load_index();
+            return;
+        }
+        m_lock_file = nullptr;
+    }
+    dbgln("HttpCache: All cache directories are in use, not caching anything");
+}
+
+ByteString HttpCache::key_for_url(URL const& url)
+{
+    auto digest = Crypto::Hash::SHA256::hash(url.serialize(URL::ExcludeFragment::Yes));
+    return encode_hex(digest.bytes());
+}
+
+ByteString HttpCache::body_path(StringView key) const
+{
+    return ByteString::formatted("{}/{}.body", m_directory, key);
+}
+
+ByteString HttpCache::metadata_path(StringView key) const
+{
+    return ByteString::formatted("{}/{}.json", m_directory, key);
+}
+
+static JsonObject headers_to_json(auto const& headers)
+{
+    JsonObject object;
+    for (auto const& header : headers)
+        object.set(header.key, header.value);
+    return object;
+}
+
+template<typename HeadersType>
+static HeadersType headers_from_json(JsonObject const& object)
+{
+    HeadersType headers;
+    object.for_each_member([&](auto const& name, auto const& value) {
+        if (value.is_string())
+            headers.set(name, value.as_string());
+    });
+    return headers;
+}
+
+static ErrorOr<HttpCache::Entry> parse_metadata(ByteString key, StringView json)
+{
+    auto value = TRY(JsonValue::from_string(json));
+    if (!value.is_object())
+        return Error::from_string_literal("Metadata isn't an object");
+    auto const& object = value.as_object();
+
+    auto url = object.get_byte_string("url"sv);
+    auto status_code = object.get_u32("status_code"sv);
+    auto response_headers = object.get_object("response_headers"sv);
+    auto varying_request_headers = object.get_object("varying_request_headers"sv);
+    auto request_time = object.get_i64("request_time"sv);
+    auto response_time = object.get_i64("response_time"sv);
+    auto last_used = object.get_i64("last_used"sv);
+    auto body_size = object.get_u64("body_size"sv);
+    if (!url.has_value() || !status_code.has_value() || !response_headers.has_value() || !varying_request_headers.has_value()
+        || !request_time.has_value() || !response_time.has_value() || !last_used.has_value() || !body_size.has_value())
+        return Error::from_string_literal("Metadata is missing a field");
+
+    return HttpCache::Entry {
+        .key = move(key),
+        .url = url.release_value(),
+        .status_code = *status_code,
+        .response_headers = headers_from_json<HTTP::ResponseHeaders>(*response_headers),
+        .varying_request_headers = headers_from_json<HTTP::RequestHeaders>(*varying_request_headers),
+        .request_time = UnixDateTime::from_seconds_since_epoch(*request_time),
+        .response_time = UnixDateTime::from_seconds_since_epoch(*response_time),
+        .last_used = UnixDateTime::from_seconds_since_epoch(*last_used),
+        .body_size = *body_size,
+    };
+}
+
+void HttpCache::load_index()
+{
+    Vector<ByteString> stale_paths;
+    Vector<ByteString> body_keys;
+    Core::DirIterator iterator(m_directory, Core::DirIterator::SkipDots);
+    while (iterator.has_next()) {
+        auto name = iterator.next_path();
+        auto path = ByteString::formatted("{}/{}", m_directory, name);
+        if (name == lock_file_name)
+            continue;
+
+        // Bodies are found through their metadata. Anything else was left behind by an interrupted response of a
+        // process that has exited since, as the processes still running hold the locks of their own directories.
+        if (name.ends_with(".body"sv)) {
+            body_keys.append(name.substring(0, name.length() - ".body"sv.length()));
+            continue;
+        }
+        if (!name.ends_with(".json"sv)) {
+            stale_paths.append(move(path));
+            continue;
+        }
+
+        auto key = name.substring(0, name.length() - ".json"sv.length());
+        auto entry_or_error = [&]() -> ErrorOr<Entry> {
+            auto file = TRY(Core::File::open(path, Core::File::OpenMode::Read));
+            auto json = TRY(file->read_until_eof());
+            auto entry = TRY(parse_metadata(key, json));
+            auto body_size = TRY(Core::System::stat(body_path(key))).st_size;
+            if (static_cast<u64>(body_size) != entry.body_size)
+                return Error::from_string_literal("Body doesn't match the metadata");
+            return entry;
+        }();
+        if (entry_or_error.is_error()) {
+            dbgln_if(REQUESTSERVER_DEBUG, "HttpCache: Discarding corrupt entry {}: {}", key, entry_or_error.error());
+            stale_paths.append(move(path));
+            stale_paths.append(body_path(key));
+            continue;
+        }
+        add_entry(entry_or_error.release_value());
+    }
+
+    for (auto const& key : body_keys) {
+        if (!m_entries.contains(key))
+            stale_paths.append(body_path(key));
+    }
+    for (auto const& path : stale_paths)
+        (void)Core::System::unlink(path);
+    evict_entries_if_needed();
+}
+
+ErrorOr<void> HttpCache::write_metadata(Entry const& entry)
+{
+    JsonObject object;
+    object.set("url", entry.url);
+    object.set("status_code", entry.status_code);
+    object.set("response_headers", headers_to_json(entry.response_headers));
+    object.set("varying_request_headers", headers_to_json(entry.varying_request_headers));
+    object.set("request_time", entry.request_time.seconds_since_epoch());
+    object.set("response_time", entry.response_time.seconds_since_epoch());
+    object.set("last_used", entry.last_used.seconds_since_epoch());
+    object.set("body_size", entry.body_size);
+
+    auto file = TRY(Core::File::open(metadata_path(entry.key), Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+    TRY(file->write_until_depleted(object.serialized<StringBuilder>().bytes()));
+    return {};
+}
+
+void HttpCache::add_entry(Entry entry)
+{
+    if (auto existing_entry = m_entries.get(entry.key); existing_entry.has_value())
+        m_stored_size -= existing_entry->body_size;
+    m_stored_size += entry.body_size;
+    m_entries.set(entry.key, move(entry));
+}
+
+void HttpCache::remove_entry(StringView key)
+{
+    auto entry = m_entries.take(key);
+    if (!entry.has_value())
+        return;
+    m_stored_size -= entry->body_size;
+    (void)Core::System::unlink(metadata_path(key));
+    (void)Core::System::unlink(body_path(key));
+}
+
+void HttpCache::evict_entries_if_needed()
+{
+    if (m_stored_size <= max_stored_size_per_directory)
+        return;
+
+    Vector<Entry const*> entries;
+    entries.ensure_capacity(m_entries.size());
+    for (auto const& it : m_entries)
+        entries.unchecked_append(&it.value);
+    quick_sort(entries, [](auto const* a, auto const* b) { return a->last_used < b->last_used; });
+
+    Vector<ByteString> evicted_keys;
+    u64 remaining_size = m_stored_size;
+    for (auto const* entry : entries) {
+        if (remaining_size <= max_stored_size_per_directory)
+            break;
+        remaining_size -= entry->body_size;
+        evicted_keys.append(entry->key);
+    }
+    for (auto const& key : evicted_keys)
+        remove_entry(key);
+}
+
+Optional<HttpCache::Entry> HttpCache::find(URL const& url, HTTP::RequestHeaders const& request_headers)
+{
+    if (!m_is_usable)
+        return {};
+
+    auto entry = m_entries.get(key_for_url(url));
+    if (!entry.has_value())
+        return {};
+
+    // The request has to agree with the one the response was stored for on every header named by its Vary header.
+    auto varying_request_headers = HTTP::varying_request_headers(request_headers, entry->response_headers);
+    if (!varying_request_headers.has_value() || varying_request_headers->size() != entry->varying_request_headers.size())
+        return {};
+    for (auto const& header : *varying_request_headers) {
+        if (entry->varying_request_headers.get(header.key) != header.value)
+            return {};
+    }
+    return *entry;
+}
+
+ErrorOr<OwnPtr<Core::MappedFile>> HttpCache::map_body(Entry const& entry)
+{
+    if (entry.body_size == 0)
+        return nullptr;
+
+    // The body was written by us, but anything could have happened to it on disk since.
+    auto path = body_path(entry.key);
+    auto file = TRY(Core::File::open(path, Core::File::OpenMode::Read));
+    auto body_size = TRY(Core::System::fstat(file->fd())).st_size;
+    if (static_cast<u64>(body_size) != entry.body_size) {
+        dbgln_if(REQUESTSERVER_DEBUG, "HttpCache: Discarding {}, its body has changed size", entry.url);
+        remove_entry(entry.key);
+        return Error::from_string_literal("Body doesn't match the metadata");
+    }
+    return TRY(Core::MappedFile::map_from_file(move(file), path));
+}
+
+void HttpCache::did_reuse(Entry const& entry, bool was_revalidated)
+{
+    if (was_revalidated)
+        ++m_statistics.revalidation_count;
+    else
+        ++m_statistics.hit_count;
+
+    auto stored_entry = m_entries.get(entry.key);
+    if (!stored_entry.has_value())
+        return;
+    stored_entry->last_used = UnixDateTime::now();
+    (void)write_metadata(*stored_entry);
+}
+
+Optional<HttpCache::Entry> HttpCache::did_revalidate(Entry const& entry, HTTP::ResponseHeaders const& not_modified_response_headers, UnixDateTime request_time)
+{
+    auto stored_entry = m_entries.get(entry.key);
+    if (!stored_entry.has_value())
+        return {};
+
+    HTTP::update_stored_headers(stored_entry->response_headers, not_modified_response_headers);
+    stored_entry->request_time = request_time;
+    stored_entry->response_time = UnixDateTime::now();
+    did_reuse(*stored_entry, true);
+    return *stored_entry;
+}
+
+OwnPtr<HttpCache::Writer> HttpCache::create_writer(Stream& output_stream, URL const& url, HTTP::RequestHeaders const& request_headers, UnixDateTime request_time)
+{
+    if (!m_is_usable)
+        return {};
+
+    // Several requests for the same URL may be in flight, so each of them writes to its own file until it's committed.
+    static u64 s_next_writer_id = 0;
+    auto key = key_for_url(url);
+    auto body_file_path = ByteString::formatted("{}/{}.{}.{}", m_directory, key, getpid(), s_next_writer_id++);
+    auto body_file = Core::File::open(body_file_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate, 0600);
+    if (body_file.is_error()) {
+        dbgln_if(REQUESTSERVER_DEBUG, "HttpCache: Unable to create {}: {}", body_file_path, body_file.error());
+        return {};
+    }
+
+    return adopt_own(*new Writer(output_stream, body_file.release_value(), move(body_file_path), move(key), url.serialize(URL::ExcludeFragment::Yes), request_headers, request_time));
+}
+
+void HttpCache::clear()
+{
+    Vector<ByteString> keys;
+    for (auto const& it : m_entries)
+        keys.append(it.key);
+    for (auto const& key : keys)
+        remove_entry(key);
+    m_statistics = {};
+}
+
+HttpCache::Writer::Writer(Stream& output_stream, NonnullOwnPtr<Core::File> body_file, ByteString body_file_path, ByteString key, ByteString url, HTTP::RequestHeaders request_headers, UnixDateTime request_time)
+    : m_output_stream(output_stream)
+    , m_body_file(move(body_file))
+    , m_body_file_path(move(body_file_path))
+    , m_key(move(key))
+    , m_url(move(url))
+    , m_request_headers(move(request_headers))
+    , m_request_time(request_time)
+{
+}
+
+HttpCache::Writer::~Writer()
+{
+    abandon();
+}
+
+ErrorOr<size_t> HttpCache::Writer::write_some(ReadonlyBytes bytes)
+{
+    auto written = TRY(m_output_stream.write_some(bytes));
+    if (!m_body_file)
+        return written;
+
+    m_body_size += written;
+    if (m_body_size > max_body_size) {
+        abandon();
+        return written;
+    }
+    if (auto result = m_body_file->write_until_depleted(bytes.trim(written)); result.is_error()) {
+        dbgln_if(REQUESTSERVER_DEBUG, "HttpCache: Unable to write {}: {}", m_body_file_path, result.error());
+        abandon();
+    }
+    return written;
+}
+
+void HttpCache::Writer::commit(u32 status_code, HTTP::ResponseHeaders const& response_headers)
+{
+    if (!m_body_file)
+        return;
+
+    auto varying_request_headers = HTTP::varying_request_headers(m_request_headers, response_headers);
+    if (!varying_request_headers.has_value() || !HTTP::is_response_storable(status_code, response_headers))
+        return abandon();
+
+    m_body_file->close();
+    m_body_file = nullptr;
+
+    auto& cache = HttpCache::the();
+    Entry entry {
+        .key = m_key,
+        .url = m_url,
+        .status_code = status_code,
+        .response_headers = response_headers,
+        .varying_request_headers = varying_request_headers.release_value(),
+        .request_time = m_request_time,
+        .response_time = UnixDateTime::now(),
+        .last_used = UnixDateTime::now(),
+        .body_size = m_body_size,
+    };
+
+    // The metadata is written last, so an entry whose body is missing or incomplete is discarded on the next start.
+    if (auto result = Core::System::rename(m_body_file_path, cache.body_path(m_key)); result.is_error()) {
+        (void)Core::System::unlink(m_body_file_path);
+        return;
+    }
+    if (auto result = cache.write_metadata(entry); result.is_error()) {
+        dbgln_if(REQUESTSERVER_DEBUG, "HttpCache: Unable to store {}: {}", m_url, result.error());
+        cache.remove_entry(m_key);
+        (void)Core::System::unlink(cache.body_path(m_key));
+        return;
+    }
+
+    cache.add_entry(move(entry));
+    cache.evict_entries_if_needed();
+}
+
+void HttpCache::Writer::abandon()
+{
+    if (!m_body_file)
+        return;
+    m_body_file->close();
+    m_body_file = nullptr;
+    (void)Core::System::unlink(m_body_file_path);
+}
+
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/Stream.h>
+#include <AK/Time.h>
+#include <AK/URL.h>
+#include <LibCore/File.h>
+#include <LibCore/LockFile.h>
+#include <LibCore/MappedFile.h>
+#include <LibHTTP/CachePolicy.h>
+
+namespace RequestServer {
+
+// A private HTTP cache, storing the responses to GET requests on disk so they can be reused across browsing sessions.
+// Each response is stored as two files named after the SHA-256 of its URL: one holding the body, and a JSON file
+// holding everything else. Once the stored bodies outgrow the size limit, the least recently used ones are evicted.
+//
+// Every RequestServer process keeps its own index, so each of them locks one of a few numbered directories for
+// itself. Processes starting while all of them are locked don't cache anything on disk.
+class HttpCache {
+public:
+    static constexpr size_t max_directory_count = 4;
+    static constexpr u64 max_stored_size = 256 * MiB;
+    static constexpr u64 max_stored_size_per_directory = max_stored_size / max_directory_count;
+    static constexpr u64 max_body_size = 32 * MiB;
+
+    static HttpCache& the();
+
+    bool is_usable() const { return m_is_usable; }
+    ByteString const& directory() const { return m_directory; }
+
+    struct Entry {
+        ByteString key;
+        ByteString url;
+        u32 status_code { 0 };
+        HTTP::ResponseHeaders response_headers;
+        HTTP::RequestHeaders varying_request_headers;
+        UnixDateTime request_time;
+        UnixDateTime response_time;
+        UnixDateTime last_used;
+        u64 body_size { 0 };
+    };
+
+    struct Statistics {
+        u64 hit_count { 0 };
+        u64 miss_count { 0 };
+        u64 revalidation_count { 0 };
+    };
+
+    // Tees the body of a response into a file while it's being written to the client. The response is only added to
+    // the cache once it has been committed.
+    class Writer final : public Stream {
+    public:
+        virtual ~Writer() override;
+
+        virtual ErrorOr<Bytes> read_some(Bytes) override { return Error::from_errno(EBADF); }
+        virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
+        virtual bool is_eof() const override { return m_output_stream.is_eof(); }
+        virtual bool is_open() const override { return m_output_stream.is_open(); }
+        virtual void close() override { m_output_stream.close(); }
+
+        // Stores the response if it may be reused, and discards it otherwise.
+        void commit(u32 status_code, HTTP::ResponseHeaders const&);
+
+    private:
+        friend class HttpCache;
+        Writer(Stream& output_stream, NonnullOwnPtr<Core::File> body_file, ByteString body_file_path, ByteString key, ByteString url, HTTP::RequestHeaders request_headers, UnixDateTime request_time);
+
+        void abandon();
+
+        Stream& m_output_stream;
+        OwnPtr<Core::File> m_body_file;
+        ByteString m_body_file_path;
+        ByteString m_key;
+        ByteString m_url;
+        HTTP::RequestHeaders m_request_headers;
+        UnixDateTime m_request_time;
+        u64 m_body_size { 0 };
+    };
+
+    // Returns the stored response for a GET request to the URL, if its Vary header allows reusing it for this request.
+    Optional<Entry> find(URL const&, HTTP::RequestHeaders const&);
+
+    // Maps the stored body of a response into memory, or returns null if it's empty. Fails, and forgets the response,
+    // if the body doesn't have the stored size anymore.
+    ErrorOr<OwnPtr<Core::MappedFile>> map_body(Entry const&);
+
+    // Marks a stored response as used, counting it as a hit or a successful revalidation.
+    void did_reuse(Entry const&, bool was_revalidated);
+    void did_miss() { ++m_statistics.miss_count; }
+
+    // Freshens a stored response with the headers of a 304 (Not Modified) response, and returns the updated entry.
+    Optional<Entry> did_revalidate(Entry const&, HTTP::ResponseHeaders const& not_modified_response_headers, UnixDateTime request_time);
+
+    OwnPtr<Writer> create_writer(Stream& output_stream, URL const&, HTTP::RequestHeaders const&, UnixDateTime request_time);
+
+    Statistics const& statistics() const { return m_statistics; }
+    u64 stored_size() const { return m_stored_size; }
+    size_t entry_count() const { return m_entries.size(); }
+
+    void clear();
+
+private:
+    HttpCache();
+
+    static ByteString key_for_url(URL const&);
+    ByteString body_path(StringView key) const;
+    ByteString metadata_path(StringView key) const;
+
+    void load_index();
+    ErrorOr<void> write_metadata(Entry const&);
+    void add_entry(Entry);
+    void remove_entry(StringView key);
+    void evict_entries_if_needed();
+
+    ByteString m_directory;
+    ByteString m_lock_file_path;
+    OwnPtr<Core::LockFile> m_lock_file;
+    bool m_is_usable { false };
+    HashMap<ByteString, Entry> m_entries;
+    u64 m_stored_size { 0 };
+    Statistics m_statistics;
+};
+
+}
@@ -13,7 +13,9 @@
 #include <AK/Optional.h>
 #include <AK/OwnPtr.h>
 #include <AK/Types.h>
+#include <LibHTTP/CachePolicy.h>
 #include <LibHTTP/HttpRequest.h>
+#include <RequestServer/CachedRequest.h>
 #include <RequestServer/ConnectionCache.h>
 #include <RequestServer/ConnectionFromClient.h>
 #include <RequestServer/Request.h>
@@ -24,6 +26,10 @@ template<typename TSelf, typename TJob>
 void init(TSelf* self, TJob job)
 {
     job->on_headers_received = [self](auto& headers, auto response_code) {
+        // The empty response confirming that a stored response is still valid is replaced with the stored one once
+        // the job has finished.
+        if (self->entry_being_revalidated().has_value() && response_code == 304u)
+            return;
         if (response_code.has_value())
             self->set_status_code(response_code.value());
         self->set_response_headers(headers);
@@ -34,6 +40,20 @@ void init(TSelf* self, TJob job)
             ConnectionCache::request_did_finish(url, socket);
         });
         if (auto* response = self->job().response()) {
+            if (success && self->entry_being_revalidated().has_value() && response->code() == 304) {
+                auto entry = HttpCache::the().did_revalidate(*self->entry_being_revalidated(), response->headers(), self->request_time());
+                if (!entry.has_value())
+                    return self->did_finish(false);
+                auto body = HttpCache::the().map_body(*entry);
+                if (body.is_error())
+                    return self->did_finish(false);
+                return self->respond_from_cache(*entry, body.release_value());
+            }
+            if (success) {
+                if (auto* cache_writer = self->cache_writer())
+                    cache_writer->commit(response->code(), response->headers());
+            }
+
             self->set_status_code(response->code());
             self->set_response_headers(response->headers());
             self->set_downloaded_size(response->downloaded_size());
@@ -70,6 +90,32 @@ OwnPtr<Request> start_request(TBadgedProtocol&& protocol, ConnectionFromClient&
         return {};
     }
 
+    auto output_stream = MUST(Core::File::adopt_fd(pipe_result.value().write_fd, Core::File::OpenMode::Write));
+
+    auto request_time = UnixDateTime::now();
+    auto can_use_cache = HTTP::can_use_cache_for_request(method, headers);
+    auto request_headers = headers;
+    Optional<HttpCache::Entry> cache_entry;
+    if (can_use_cache)
+        cache_entry = HttpCache::the().find(url, headers);
+
+    if (cache_entry.has_value()) {
+        if (!HTTP::needs_revalidation(headers, cache_entry->response_headers, cache_entry->request_time, cache_entry->response_time, request_time)) {
+            if (auto body = HttpCache::the().map_body(*cache_entry); !body.is_error()) {
+                HttpCache::the().did_reuse(*cache_entry, false);
+                auto cached_request = CachedRequest::create(client, url, move(output_stream));
+                cached_request->set_request_fd(pipe_result.value().read_fd);
+                cached_request->respond_from_cache(*cache_entry, body.release_value());
+                return cached_request;
+            }
+            cache_entry.clear();
+        } else if (!HTTP::add_validators_to_request(request_headers, cache_entry->response_headers)) {
+            cache_entry.clear();
+        }
+    }
+    if (can_use_cache && !cache_entry.has_value())
+        HttpCache::the().did_miss();
+
     HTTP::HttpRequest request;
     if (method.equals_ignoring_ascii_case("post"sv))
         request.set_method(HTTP::HttpRequest::Method::POST);
@@ -90,17 +136,23 @@ OwnPtr<Request> start_request(TBadgedProtocol&& protocol, ConnectionFromClient&
     else
         request.set_method(HTTP::HttpRequest::Method::GET);
     request.set_url(url);
-    request.set_headers(headers);
+    request.set_headers(request_headers);
 
     auto allocated_body_result = ByteBuffer::copy(body);
     if (allocated_body_result.is_error())
         return {};
     request.set_body(allocated_body_result.release_value());
 
-    auto output_stream = MUST(Core::File::adopt_fd(pipe_result.value().write_fd, Core::File::OpenMode::Write));
-    auto job = TJob::construct(move(request), *output_stream);
+    // The response body is written to the cache as it's passed on to the client.
+    OwnPtr<HttpCache::Writer> cache_writer;
+    if (can_use_cache)
+        cache_writer = HttpCache::the().create_writer(*output_stream, url, headers, request_time);
+    Stream& job_output_stream = cache_writer ? static_cast<Stream&>(*cache_writer) : *output_stream;
+
+    auto job = TJob::construct(move(request), job_output_stream);
     auto protocol_request = TRequest::create_with_job(forward<TBadgedProtocol>(protocol), client, (TJob&)*job, move(output_stream));
     protocol_request->set_request_fd(pipe_result.value().read_fd);
+    protocol_request->set_http_cache_state(move(cache_writer), move(cache_entry), request_time);
 
     if constexpr (IsSame<typename TBadgedProtocol::Type, HttpsProtocol>)
         ConnectionCache::get_or_create_connection(ConnectionCache::g_tls_connection_cache, url, *job, proxy_data);
@@ -6,6 +6,7 @@
 
 #include <RequestServer/ConnectionFromClient.h>
 #include <RequestServer/Request.h>
+#include <errno.h>
 
 namespace RequestServer {
 
@@ -46,6 +47,47 @@ void Request::did_progress(Optional<u64> total_size, u64 downloaded_size)
     m_client.did_progress_request({}, *this);
 }
 
+void Request::respond_from_cache(HttpCache::Entry const& entry, OwnPtr<Core::MappedFile> body)
+{
+    m_cached_response = entry;
+    m_cached_body = move(body);
+
+    // NOTE: Nothing may be sent to the client before it knows about this request, which a fresh response from the
+    //       cache is answered from right away. So everything is sent once the response pipe can be written to.
+    m_cached_body_notifier = Core::Notifier::construct(m_output_stream->fd(), Core::Notifier::Type::Write);
+    m_cached_body_notifier->on_activation = [this] {
+        write_cached_body();
+    };
+}
+
+void Request::write_cached_body()
+{
+    if (m_cached_response.has_value()) {
+        auto response = m_cached_response.release_value();
+        set_status_code(response.status_code);
+        set_response_headers(response.response_headers);
+    }
+
+    auto body = m_cached_body ? m_cached_body->bytes() : ReadonlyBytes {};
+    while (m_cached_body_offset < body.size()) {
+        auto result = m_output_stream->write_some(body.slice(m_cached_body_offset));
+        if (result.is_error()) {
+            if (result.error().is_errno() && result.error().code() == EINTR)
+                continue;
+            if (result.error().is_errno() && result.error().code() == EAGAIN)
+                return did_progress(body.size(), m_cached_body_offset);
+            dbgln("Request: Unable to write the stored response: {}", result.error());
+            m_cached_body_notifier->set_enabled(false);
+            return did_finish(false);
+        }
+        m_cached_body_offset += result.value();
+    }
+
+    m_cached_body_notifier->set_enabled(false);
+    did_progress(body.size(), body.size());
+    did_finish(true);
+}
+
 void Request::did_request_certificates()
 {
     m_client.did_request_certificates({}, *this);
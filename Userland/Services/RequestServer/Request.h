@@ -11,7 +11,9 @@
 #include <AK/Optional.h>
 #include <AK/RefCounted.h>
 #include <AK/URL.h>
+#include <LibCore/Notifier.h>
 #include <RequestServer/Forward.h>
+#include <RequestServer/HttpCache.h>
 
 namespace RequestServer {
 
@@ -42,10 +44,26 @@ public:
     void set_downloaded_size(size_t size) { m_downloaded_size = size; }
     Core::File const& output_stream() const { return *m_output_stream; }
 
+    // Answers the request with a stored response, writing its body into the response pipe as fast as the client reads
+    // it. The request is finished once the whole body has been written.
+    void respond_from_cache(HttpCache::Entry const&, OwnPtr<Core::MappedFile> body);
+
+    void set_http_cache_state(OwnPtr<HttpCache::Writer> cache_writer, Optional<HttpCache::Entry> entry_being_revalidated, UnixDateTime request_time)
+    {
+        m_cache_writer = move(cache_writer);
+        m_entry_being_revalidated = move(entry_being_revalidated);
+        m_request_time = request_time;
+    }
+    HttpCache::Writer* cache_writer() { return m_cache_writer.ptr(); }
+    Optional<HttpCache::Entry> const& entry_being_revalidated() const { return m_entry_being_revalidated; }
+    UnixDateTime request_time() const { return m_request_time; }
+
 protected:
     explicit Request(ConnectionFromClient&, NonnullOwnPtr<Core::File>&&);
 
 private:
+    void write_cached_body();
+
     ConnectionFromClient& m_client;
     i32 m_id { 0 };
     int m_request_fd { -1 }; // Passed to client.
@@ -54,6 +72,15 @@ private:
     size_t m_downloaded_size { 0 };
     NonnullOwnPtr<Core::File> m_output_stream;
     HashMap<ByteString, ByteString, CaseInsensitiveStringTraits> m_response_headers;
+
+    OwnPtr<HttpCache::Writer> m_cache_writer;
+    Optional<HttpCache::Entry> m_entry_being_revalidated;
+    UnixDateTime m_request_time;
+
+    Optional<HttpCache::Entry> m_cached_response;
+    OwnPtr<Core::MappedFile> m_cached_body;
+    size_t m_cached_body_offset { 0 };
+    RefPtr<Core::Notifier> m_cached_body_notifier;
 };
 
 }
@@ -17,7 +17,7 @@
 #include <LibWeb/HTML/TraversableNavigable.h>
 #include <LibWeb/Layout/Viewport.h>
 #include <LibWeb/Painting/PaintableBox.h>
-#include <LibWeb/Painting/PaintingCommandExecutorCPU.h>
+#include <LibWeb/Painting/TiledPainter.h>
 #include <LibWeb/Painting/ViewportPaintable.h>
 #include <LibWeb/Platform/Timer.h>
 #include <LibWebView/Attribute.h>
@@ -57,11 +57,16 @@ PageClient::PageClient(PageHost& owner, u64 id)
             return;
         }
 
-        auto& back_bitmap = *client().backing_stores().back_bitmap;
-        auto viewport_rect = page().css_to_device_rect(page().top_level_traversable()->viewport_rect());
-        paint(viewport_rect, back_bitmap);
+        // Layout may invalidate more of the page, which has to be known before deciding what to paint.
+        if (auto* document = page().top_level_browsing_context().active_document())
+            document->update_layout();
 
         auto& backing_stores = client().backing_stores();
+        auto& back_bitmap = *backing_stores.back_bitmap;
+        auto viewport_rect = page().css_to_device_rect(page().top_level_traversable()->viewport_rect());
+        auto damaged_rect = take_damaged_rect_of_back_bitmap(viewport_rect, backing_stores.back_bitmap_id);
+        paint(viewport_rect, back_bitmap, {}, damaged_rect);
+
         swap(backing_stores.front_bitmap, backing_stores.back_bitmap);
         swap(backing_stores.front_bitmap_id, backing_stores.back_bitmap_id);
         client().did_paint(viewport_rect.to_type<int>(), backing_stores.front_bitmap_id);
@@ -80,6 +85,32 @@ void PageClient::schedule_repaint()
         m_repaint_timer->start();
 }
 
+Gfx::IntRect PageClient::take_damaged_rect_of_back_bitmap(Web::DevicePixelRect const& viewport_rect, i32 back_bitmap_id)
+{
+    Gfx::IntRect bitmap_rect { {}, viewport_rect.size().to_type<int>() };
+
+    Gfx::IntRect damaged_rect;
+    for (auto const& rect : m_damaged_rects) {
+        // There's no telling whether an invalidated rect belongs to fixed position content, which is painted relative
+        // to the viewport instead of the page, so both places are painted again.
+        damaged_rect = damaged_rect.united(rect.translated(-viewport_rect.location()).to_type<int>().intersected(bitmap_rect));
+        damaged_rect = damaged_rect.united(rect.to_type<int>().intersected(bitmap_rect));
+    }
+    m_damaged_rects.clear();
+
+    // The back bitmap holds the frame before the previous one, so it is missing the changes of the previous frame as well.
+    auto rect_to_paint = bitmap_rect;
+    if (m_frame_before_previous.bitmap_id == back_bitmap_id
+        && m_frame_before_previous.viewport_rect == viewport_rect
+        && m_previous_frame.viewport_rect == viewport_rect) {
+        rect_to_paint = damaged_rect.united(m_previous_frame.damaged_rect);
+    }
+
+    m_frame_before_previous = m_previous_frame;
+    m_previous_frame = { .bitmap_id = back_bitmap_id, .viewport_rect = viewport_rect, .damaged_rect = damaged_rect };
+    return rect_to_paint;
+}
+
 void PageClient::visit_edges(JS::Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
@@ -93,7 +124,11 @@ ConnectionFromClient& PageClient::client() const
 
 void PageClient::set_has_focus(bool has_focus)
 {
+    if (m_has_focus == has_focus)
+        return;
     m_has_focus = has_focus;
+    if (page().top_level_traversable_is_initialized())
+        page().top_level_traversable()->set_needs_display();
 }
 
 void PageClient::setup_palette()
@@ -123,6 +158,8 @@ void PageClient::set_palette_impl(Gfx::PaletteImpl& impl)
     m_palette_impl = impl;
     if (auto* document = page().top_level_browsing_context().active_document())
         document->invalidate_style();
+    if (page().top_level_traversable_is_initialized())
+        page().top_level_traversable()->set_needs_display();
 }
 
 void PageClient::set_preferred_color_scheme(Web::CSS::PreferredColorScheme color_scheme)
@@ -164,6 +201,11 @@ Gfx::Color PageClient::background_color() const
 }
 
 void PageClient::paint(Web::DevicePixelRect const& content_rect, Gfx::Bitmap& target, Web::PaintOptions paint_options)
+{
+    paint(content_rect, target, paint_options, target.rect());
+}
+
+void PageClient::paint(Web::DevicePixelRect const& content_rect, Gfx::Bitmap& target, Web::PaintOptions paint_options, Gfx::IntRect const& damaged_rect)
 {
     Gfx::IntRect bitmap_rect { {}, content_rect.size().to_type<int>() };
 
@@ -211,19 +253,20 @@ void PageClient::paint(Web::DevicePixelRect const& content_rect, Gfx::Bitmap& ta
         }
 #endif
     } else {
-        Web::Painting::PaintingCommandExecutorCPU painting_command_executor(target);
-        recording_painter.execute(painting_command_executor);
+        Web::Painting::TiledPainter::the().execute(recording_painter, target, damaged_rect);
     }
 }
 
 void PageClient::set_viewport_rect(Web::DevicePixelRect const& rect)
 {
     page().top_level_traversable()->set_viewport_rect(page().device_to_css_rect(rect));
+    m_damaged_rects.append(rect);
     schedule_repaint();
 }
 
-void PageClient::page_did_invalidate(Web::CSSPixelRect const&)
+void PageClient::page_did_invalidate(Web::CSSPixelRect const& rect)
 {
+    m_damaged_rects.append(page().enclosing_device_rect(rect));
     schedule_repaint();
 }
 
@@ -139,6 +139,9 @@ private:
     void setup_palette();
     ConnectionFromClient& client() const;
 
+    void paint(Web::DevicePixelRect const& content_rect, Gfx::Bitmap&, Web::PaintOptions, Gfx::IntRect const& damaged_rect);
+    Gfx::IntRect take_damaged_rect_of_back_bitmap(Web::DevicePixelRect const& viewport_rect, i32 back_bitmap_id);
+
     PageHost& m_owner;
     JS::NonnullGCPtr<Web::Page> m_page;
     RefPtr<Gfx::PaletteImpl> m_palette_impl;
@@ -151,6 +154,17 @@ private:
 
     RefPtr<Web::Platform::Timer> m_repaint_timer;
 
+    // The rects invalidated since the last paint, in device pixels relative to the top of the page.
+    Vector<Web::DevicePixelRect> m_damaged_rects;
+
+    struct PaintedFrame {
+        i32 bitmap_id { -1 };
+        Web::DevicePixelRect viewport_rect;
+        Gfx::IntRect damaged_rect;
+    };
+    PaintedFrame m_previous_frame;
+    PaintedFrame m_frame_before_previous;
+
     Web::CSS::PreferredColorScheme m_preferred_color_scheme { Web::CSS::PreferredColorScheme::Auto };
 
     RefPtr<WebDriverConnection> m_webdriver;
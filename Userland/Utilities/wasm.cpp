@@ -282,6 +282,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool export_all_imports = false;
     bool shell_mode = false;
     bool wasi = false;
+    bool jit = false;
     ByteString exported_function_to_execute;
     Vector<u64> values_to_push;
     Vector<ByteString> modules_to_link_in;
@@ -297,6 +298,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     parser.add_option(export_all_imports, "Export noop functions corresponding to imports", "export-noop", 0);
     parser.add_option(shell_mode, "Launch a REPL in the module's context (implies -i)", "shell", 's');
     parser.add_option(wasi, "Enable WASI", "wasi", 'w');
+    parser.add_option(jit, "Compile functions to native code where possible", "jit", 0);
     parser.add_option(Core::ArgsParser::Option {
         .argument_mode = Core::ArgsParser::OptionArgumentMode::Required,
         .help_string = "Directory mappings to expose via WASI",
@@ -373,6 +375,8 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     if (attempt_instantiate) {
         Wasm::AbstractMachine machine;
+        if (jit)
+            machine.enable_jit();
         Optional<Wasm::Wasi::Implementation> wasi_impl;
 
         if (wasi) {
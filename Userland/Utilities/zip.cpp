@@ -6,6 +6,7 @@
 
 #include <AK/LexicalPath.h>
 #include <LibArchive/Zip.h>
+#include <LibCompress/ParallelDeflate.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/DateTime.h>
 #include <LibCore/DirIterator.h>
@@ -19,15 +20,23 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     Vector<StringView> source_paths;
     bool recurse = false;
     bool force = false;
+    size_t thread_count = 1;
 
     Core::ArgsParser args_parser;
     args_parser.add_positional_argument(zip_path, "Zip file path", "zipfile", Core::ArgsParser::Required::Yes);
     args_parser.add_positional_argument(source_paths, "Input files to be archived", "files", Core::ArgsParser::Required::Yes);
     args_parser.add_option(recurse, "Travel the directory structure recursively", "recurse-paths", 'r');
     args_parser.add_option(force, "Overwrite existing zip file", "force", 'f');
+    args_parser.add_option(thread_count, "Number of threads to compress with", "threads", 'T', "count");
     args_parser.parse(arguments);
 
-    TRY(Core::System::pledge("stdio rpath wpath cpath"));
+    if (thread_count == 0) {
+        warnln("The number of threads has to be at least 1");
+        return 1;
+    }
+    thread_count = min(thread_count, Compress::ParallelDeflateCompressor::max_thread_count);
+
+    TRY(Core::System::pledge("stdio rpath wpath cpath thread"));
 
     auto cwd = TRY(Core::System::getcwd());
     TRY(Core::System::unveil(LexicalPath::absolute_path(cwd, zip_path), "wc"sv));
@@ -47,7 +56,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     outln("Archive: {}", zip_path);
     auto file_stream = TRY(Core::File::open(zip_path, Core::File::OpenMode::Write));
-    Archive::ZipOutputStream zip_stream(move(file_stream));
+    Archive::ZipOutputStream zip_stream(move(file_stream), thread_count);
 
     auto add_file = [&](StringView path) -> ErrorOr<void> {
         auto canonicalized_path = TRY(String::from_byte_string(LexicalPath::canonicalized_path(path)));